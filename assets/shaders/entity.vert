@@ -3,19 +3,32 @@
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec3 a_normal;
 layout(location = 2) in vec2 a_uv;
+layout(location = 3) in float a_bone;
+
+// Must match kMaxGpuSkinBones in EntitySkinning.h.
+const int MAX_BONES = 48;
 
 uniform mat4 u_viewProjection;
 uniform mat4 u_model;
+uniform bool u_skinned;
+uniform mat4 u_bones[MAX_BONES];
 
 out vec2 v_uv;
 out vec3 v_normal;
 out vec3 v_worldPos;
 
 void main() {
-    vec4 worldPos = u_model * vec4(a_position, 1.0);
+    vec4 localPos = vec4(a_position, 1.0);
+    vec3 localNormal = a_normal;
+    if (u_skinned) {
+        mat4 bone = u_bones[int(a_bone)];
+        localPos = bone * localPos;
+        localNormal = normalize(mat3(bone) * localNormal);
+    }
+    vec4 worldPos = u_model * localPos;
     v_worldPos = worldPos.xyz;
     mat3 normalMat = transpose(inverse(mat3(u_model)));
-    v_normal = normalize(normalMat * a_normal);
+    v_normal = normalize(normalMat * localNormal);
     v_uv = a_uv;
     gl_Position = u_viewProjection * worldPos;
 }
@@ -2,13 +2,23 @@
 
 layout(location = 0) in vec3 a_position;
 layout(location = 2) in vec2 a_uv;
+layout(location = 3) in float a_bone;
+
+// Must match kMaxGpuSkinBones in EntitySkinning.h.
+const int MAX_BONES = 48;
 
 uniform mat4 u_lightViewProjection;
 uniform mat4 u_model;
+uniform bool u_skinned;
+uniform mat4 u_bones[MAX_BONES];
 
 out vec2 v_uv;
 
 void main() {
-    gl_Position = u_lightViewProjection * u_model * vec4(a_position, 1.0);
+    vec4 localPos = vec4(a_position, 1.0);
+    if (u_skinned) {
+        localPos = u_bones[int(a_bone)] * localPos;
+    }
+    gl_Position = u_lightViewProjection * u_model * localPos;
     v_uv = a_uv;
 }
@@ -45,6 +45,8 @@ public:
     void setPosition(float x, float y, float z);
 
     void setVelocity(const glm::vec3& vel) { m_velocity = vel; }
+    // Adds `impulse` to the velocity and wakes the entity.
+    void applyImpulse(const glm::vec3& impulse);
     void setViewDirection(const glm::vec3& viewDir) { m_viewDirection = viewDir; }
     void accelerate(const glm::vec3& accel) { m_acceleration += accel; }
     void accelerate(float x, float y, float z) { m_acceleration += glm::vec3(x, y, z); }
@@ -64,6 +66,18 @@ public:
 
     bool isNoClip() const { return hasTag(EntityTags::NoClip); }
 
+    /// @name Sleep
+    /// An entity resting on the ground with no input for sleepDelayTicks updates
+    /// falls asleep: update() still runs its components but skips gravity,
+    /// integration and collision until input, a velocity change, an impulse, a
+    /// teleport or WorldEntities (block edits, contact) wakes it.
+    /// @{
+    bool isSleeping() const { return m_sleeping; }
+    // Awake and above the rest thresholds on its last update.
+    bool isMoving() const { return !m_sleeping && m_restTicks == 0; }
+    void wake();
+    /// @}
+
     void addUpdateComponent(IUpdateEntityComponent* component);
     void removeUpdateComponent(IUpdateEntityComponent* component);
 
@@ -74,6 +88,10 @@ public:
     virtual void render(const EntityRenderContext& ctx,
                         const glm::mat4& modelMatrix,
                         bool shouldRender);
+    // The render components' part of render(), for callers that draw the model themselves.
+    void renderComponents(const EntityRenderContext& ctx,
+                          const glm::mat4& modelMatrix,
+                          bool shouldRender);
 
     void setModel(Asset::Handle<EntityModelAsset> model);
     const Asset::Handle<EntityModelAsset>& model() const { return m_model; }
@@ -88,6 +106,12 @@ public:
 
     EntityChunk* currentChunk() const { return m_currentChunk; }
     void setCurrentChunk(EntityChunk* chunk) { m_currentChunk = chunk; }
+    // Position inside currentChunk()'s entity list, maintained by EntityChunk.
+    uint32_t chunkSlot() const { return m_chunkSlot; }
+    void setChunkSlot(uint32_t slot) { m_chunkSlot = slot; }
+    // Bounds reach counted by WorldEntities while the entity is bucketed.
+    float bucketReach() const { return m_bucketReach; }
+    void setBucketReach(float reach) { m_bucketReach = reach; }
 
 protected:
     virtual void onCollide(Axis axis) { (void)axis; }
@@ -113,6 +137,12 @@ protected:
     float m_hitpoints = 10.0f;
     float m_age = 0.0f;
     float m_floorFriction = 0.1f;
+    // Below this speed, and with input that would not reach it in one update, the
+    // entity counts as resting.
+    float m_sleepSpeed = 0.05f;
+    uint32_t m_sleepDelayTicks = 40;
+    uint32_t m_restTicks = 0;
+    bool m_sleeping = false;
 
     Aabb m_localBounds{glm::vec3(-0.5f), glm::vec3(0.5f)};
     Aabb m_worldBounds{};
@@ -122,6 +152,8 @@ protected:
     std::vector<IRenderEntityComponent*> m_renderComponents;
 
     EntityChunk* m_currentChunk = nullptr;
+    uint32_t m_chunkSlot = 0;
+    float m_bucketReach = 0.0f;
     Asset::Handle<EntityModelAsset> m_model;
     std::unique_ptr<IEntityModelInstance> m_modelInstance;
     glm::vec4 m_renderTint{1.0f};
@@ -2,6 +2,7 @@
 
 #include <glm/vec3.hpp>
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -14,6 +15,12 @@ struct EntityKeyframe {
     glm::vec3 value{0.0f};
 };
 
+// Index of the last key at or before the previous sample. Forward playback only
+// steps past the keys it crossed; going backwards (or looping) falls back to a search.
+struct EntityTrackCursor {
+    uint32_t key = 0;
+};
+
 struct EntityAnimationTrack {
     std::vector<EntityKeyframe> keys;
 
@@ -21,6 +28,11 @@ struct EntityAnimationTrack {
                      bool loop,
                      float duration,
                      const glm::vec3& defaultValue) const;
+    glm::vec3 sample(float time,
+                     bool loop,
+                     float duration,
+                     const glm::vec3& defaultValue,
+                     EntityTrackCursor& cursor) const;
 };
 
 struct EntityBoneAnimation {
@@ -37,6 +49,13 @@ struct EntityAnimation {
     const EntityBoneAnimation* findBone(std::string_view name) const;
 };
 
+// An animation resolved against one model's bone list: `bones[i]` holds the tracks
+// for model bone i, or null when the animation does not drive it.
+struct EntityAnimationClip {
+    const EntityAnimation* animation = nullptr;
+    std::vector<const EntityBoneAnimation*> bones;
+};
+
 struct EntityAnimationSet {
     std::unordered_map<std::string, EntityAnimation> animations;
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Rigel/Voxel/RenderConfig.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace Rigel::Entity {
+
+// What one model instance may spend on animation this frame.
+struct EntityAnimationLod {
+    // Frames between pose evaluations; 0 holds the current pose.
+    uint32_t updateInterval = 1;
+    size_t maxAnimations = std::numeric_limits<size_t>::max();
+};
+
+EntityAnimationLod selectAnimationLod(const Voxel::EntityAnimationLodConfig& config, float distance);
+
+// Component-wise blend of two bone palettes of equal size into `out`; shows a
+// throttled pose moving between its last two evaluations.
+void blendPalettes(std::span<const glm::mat4> from,
+                   std::span<const glm::mat4> to,
+                   float alpha,
+                   std::span<glm::mat4> out);
+
+} // namespace Rigel::Entity
@@ -11,6 +11,9 @@ namespace Rigel::Entity {
 
 class EntityRegion;
 
+// Bucket of entity pointers. Each entity records its slot (Entity::chunkSlot), so
+// add/remove/contains are O(1); an entity belongs to at most one chunk at a time
+// and must be removed before it is added elsewhere.
 class EntityChunk {
 public:
     explicit EntityChunk(Voxel::ChunkCoord coord);
@@ -25,6 +28,7 @@ public:
     bool hasEntities() const { return !m_entities.empty(); }
 
     void forEach(const std::function<void(Entity*)>& fn) const;
+    const std::vector<Entity*>& entities() const { return m_entities; }
 
 private:
     Voxel::ChunkCoord m_coord{};
@@ -24,6 +24,7 @@ struct ShaderAsset;
 namespace Rigel::Entity {
 
 class IEntityModelInstance;
+struct EntitySkinMesh;
 
 enum class EntityLightingMode {
     Lit,
@@ -77,12 +78,22 @@ struct EntityModelAsset : public Asset::AssetBase,
     std::unordered_map<std::string, size_t> boneLookup;
     Asset::Handle<EntityAnimationSetAsset> animationSet;
     std::string defaultAnimation;
+    // animationSet's animations compiled against `bones` (see compileAnimationClips).
+    std::unordered_map<const EntityAnimation*, EntityAnimationClip> animationClips;
+    // Bind-pose cube mesh shared by all instances (built by the loader).
+    std::shared_ptr<const EntitySkinMesh> skinMesh;
 
     const EntityBone* findBone(std::string_view name) const;
+    const EntityAnimationClip* findClip(const EntityAnimation* animation) const;
+    // Rebuilds animationClips; call after bones or animationSet change.
+    void compileAnimationClips();
 
     std::unique_ptr<IEntityModelInstance> createInstance(
         Asset::AssetManager& assets,
         const Asset::Handle<Asset::ShaderAsset>& shader) const override;
 };
 
+EntityAnimationClip compileAnimationClip(const EntityAnimation& animation,
+                                         const std::vector<EntityBone>& bones);
+
 } // namespace Rigel::Entity
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "EntityModel.h"
+#include "EntityAnimationLod.h"
 #include "EntityRenderContext.h"
+#include "EntitySkinning.h"
 
 #include <Rigel/Asset/Handle.h>
 
@@ -12,6 +14,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -25,6 +28,7 @@ struct ShaderAsset;
 namespace Rigel::Entity {
 
 class Entity;
+struct EntitySkinMeshBuffer;
 
 class IEntityModelInstance {
 public:
@@ -47,6 +51,8 @@ public:
     virtual void removeAnimation(const EntityAnimation* animation) = 0;
 
     virtual const EntityModelAsset* model() const = 0;
+    // Equal for instances playing the same set of animations; used to group draws.
+    virtual uint64_t animationStateKey() const { return 0; }
 };
 
 class EntityModelInstance : public IEntityModelInstance {
@@ -73,22 +79,65 @@ public:
     void removeAnimation(const EntityAnimation* animation) override;
 
     const EntityModelAsset* model() const override { return m_model.get(); }
+    uint64_t animationStateKey() const override;
+
+    // Runs this frame's animation step ahead of the next render() or renderShadow(),
+    // which then skip it; lets the renderer pose a batch before drawing it.
+    void advance(const EntityRenderContext& ctx, const glm::mat4& modelMatrix);
+    // Evaluates every pose that is due. CPU-skinned instances sharing a bind mesh are
+    // skinned together with skinMeshBatch; the rest pose as render() would.
+    static void poseBatch(std::span<EntityModelInstance* const> instances);
+    // Batched drawing for a run of instances of one model. prepareDraw() poses the
+    // instance and readies its buffers, false when there is nothing to draw. The
+    // bind*State() call binds the shader, frame uniforms, textures and GL state once
+    // for every instance that canShareDrawState() with the binding one. Then
+    // draw*Bound() sets only the per-instance uniforms, and end*State() restores GL
+    // state after the run.
+    bool prepareDraw();
+    bool canShareDrawState(const EntityModelInstance& other) const;
+    void bindDrawState(const EntityRenderContext& ctx) const;
+    void drawBound(const glm::mat4& modelMatrix, float ambientOcclusion);
+    static void endDrawState();
+    void bindShadowState(const Asset::ShaderAsset& shadowShader, const glm::mat4& lightViewProjection) const;
+    void drawShadowBound(const Asset::ShaderAsset& shadowShader, const glm::mat4& modelMatrix);
+    static void endShadowState();
+
+    // Posed vertices when skinning on the CPU; empty for GPU skinning.
+    const std::vector<EntitySkinVertex>& cpuVertices() const { return m_cpuVertices; }
 
 private:
-    struct Vertex {
-        glm::vec3 position{0.0f};
-        glm::vec3 normal{0.0f, 1.0f, 0.0f};
-        glm::vec2 uv{0.0f};
+    // An active animation with its bone-indexed clip and per-track keyframe cursors
+    // (position, rotation, scale for each bone).
+    struct ActiveAnimation {
+        const EntityAnimation* animation = nullptr;
+        const EntityAnimationClip* clip = nullptr;
+        // Compiled here when the model has no clip for the animation.
+        std::shared_ptr<const EntityAnimationClip> ownedClip;
+        std::vector<EntityTrackCursor> cursors;
     };
 
-    void rebuildMesh(const EntityRenderContext& ctx);
-    void updateAnimations(const EntityRenderContext& ctx);
+    // Recomputes the bone palette and, when skinning on the CPU, the posed vertices.
+    void updatePose();
+    // updatePose() without the CPU skinning step.
+    void updatePalette();
+    // Advances the animation clock and decides, from the LOD tier at this distance,
+    // whether the pose is re-evaluated this frame.
+    void updateAnimations(const EntityRenderContext& ctx, const glm::mat4& modelMatrix);
+    // Palette to draw with: the latest pose, or a blend toward it between
+    // throttled evaluations (GPU skinning only).
+    const std::vector<glm::mat4>& drawPalette();
+    void activateAnimation(const EntityAnimation* animation);
     glm::vec3 sampleTrack(const EntityAnimationTrack& track,
                           const EntityAnimation& animation,
-                          const glm::vec3& defaultValue) const;
+                          const glm::vec3& defaultValue,
+                          EntityTrackCursor& cursor) const;
 
+    void bindSkinning(const Asset::ShaderAsset& shader);
     void ensureGpuResources();
     void releaseGpuResources();
+    GLuint drawVao() const;
+    // Binds drawVao() unless the run already has it bound, then draws.
+    void drawVertices() const;
 
     std::shared_ptr<const EntityModelAsset> m_model;
     const EntityAnimationSet* m_animationSet = nullptr;
@@ -96,15 +145,32 @@ private:
     std::unordered_map<std::string, Asset::Handle<Asset::TextureAsset>> m_textures;
 
     glm::vec4 m_tint{1.0f};
-    std::vector<const EntityAnimation*> m_activeAnimations;
+    std::vector<ActiveAnimation> m_activeAnimations;
     float m_globalAnimTime = 0.0f;
     uint64_t m_lastAnimFrame = 0;
 
+    // CPU skinning only; GPU-skinned instances draw from m_bindBuffer.
     GLuint m_vao = 0;
     GLuint m_vbo = 0;
     size_t m_vertexCount = 0;
-    std::vector<Vertex> m_cpuVertices;
-    bool m_meshDirty = true;
+    // The model's bind mesh; the GPU path draws it from one upload shared by every
+    // instance of the mesh and poses it with m_palette in the vertex shader, the CPU
+    // path skins it into m_cpuVertices.
+    std::shared_ptr<const EntitySkinMesh> m_skinMesh;
+    std::shared_ptr<EntitySkinMeshBuffer> m_bindBuffer;
+    std::vector<glm::mat4> m_palette;
+    // Pose from the evaluation before m_palette, and the blend drawn between them.
+    std::vector<glm::mat4> m_previousPalette;
+    std::vector<glm::mat4> m_blendedPalette;
+    EntityAnimationLod m_lod;
+    uint32_t m_framesSincePose = 0;
+    bool m_hasPose = false;
+    bool m_blendDirty = false;
+    std::vector<EntitySkinVertex> m_cpuVertices;
+    bool m_gpuSkinning = false;
+    bool m_poseDirty = true;
+    bool m_vboDirty = true;
+    bool m_advanced = false;
 };
 
 } // namespace Rigel::Entity
@@ -6,16 +6,28 @@
 
 #include <cstdint>
 #include <span>
+#include <vector>
 
 namespace Rigel::Entity {
 
 using EntityPersistedEntity = Persistence::EntityPersistedEntity;
 using EntityPersistedChunk = Persistence::EntityPersistedChunk;
 
+// Writes the current (version 2) layout: strings and (type, model) pairs are stored
+// once per region and entity fields as columns.
 std::vector<uint8_t> encodeEntityRegionPayload(
     const std::vector<EntityPersistedChunk>& chunks);
 
+// Reads both the current layout and the version 1 inline layout.
 bool decodeEntityRegionPayload(std::span<const uint8_t> payload,
                                std::vector<EntityPersistedChunk>& outChunks);
 
+namespace detail {
+
+// The version 1 layout, every entity written inline; kept to test old saves.
+std::vector<uint8_t> encodeEntityRegionPayloadInline(
+    const std::vector<EntityPersistedChunk>& chunks);
+
+} // namespace detail
+
 } // namespace Rigel::Entity
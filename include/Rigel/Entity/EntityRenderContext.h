@@ -38,6 +38,7 @@ struct EntityRenderContext {
     uint64_t frameIndex = 0;
     float ambientOcclusion = 1.0f;
     EntityShadowContext shadow;
+    Voxel::EntityAnimationLodConfig animationLod;
 };
 
 } // namespace Rigel::Entity
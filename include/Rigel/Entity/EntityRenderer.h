@@ -8,6 +8,9 @@
 #include <glm/mat4x4.hpp>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace Rigel::Asset {
 class AssetManager;
@@ -21,24 +24,73 @@ class World;
 namespace Rigel::Entity {
 
 struct Aabb;
+class Entity;
+class EntityModelInstance;
+class WorldEntities;
+struct EntityModelAsset;
+
+struct EntityDrawItem {
+    Entity* entity = nullptr;
+    glm::mat4 modelMatrix{1.0f};
+    // Sort keys, read once when the list is built.
+    const EntityModelAsset* model = nullptr;
+    uint64_t animationKey = 0;
+};
+
+// Entities split by one frustum: visible ones sorted into runs that share a model and
+// animation state, culled ones kept so they can still advance cheaply. The renderer
+// poses each run together and draws it with its shader, textures and vertex array
+// bound once.
+struct EntityDrawList {
+    struct Batch {
+        const EntityModelAsset* model = nullptr;
+        uint64_t animationKey = 0;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    std::vector<EntityDrawItem> visible;
+    std::vector<Batch> batches;
+    std::vector<Entity*> culled;
+
+    void clear();
+};
 
 class EntityRenderer {
 public:
     void initialize(Asset::AssetManager& assets);
+    // Culled entities get no model instance, AO sampling or pose evaluation.
     void render(Voxel::World& world, const EntityRenderContext& ctx);
+    // Only entities inside the cascade's light frustum are drawn.
     void renderShadowCasters(Voxel::World& world,
                              const EntityRenderContext& ctx,
                              const Voxel::ShadowCascadeContext& shadowCtx);
 
     static bool isVisible(const Aabb& bounds, const glm::mat4& viewProjection);
+    static void buildDrawList(WorldEntities& entities,
+                              const glm::mat4& viewProjection,
+                              EntityDrawList& out);
 
 private:
     static std::array<glm::vec4, 6> extractPlanes(const glm::mat4& viewProjection);
     static bool isVisible(const Aabb& bounds, const std::array<glm::vec4, 6>& planes);
+    // Creates the batch's model instances, runs their animation step and poses them
+    // together, so CPU-skinned instances of one model share a skinning pass.
+    void poseBatch(const EntityDrawList& list, const EntityDrawList::Batch& batch,
+                   const EntityRenderContext& ctx);
+    void drawBatch(Voxel::World& world, const EntityDrawList::Batch& batch,
+                   const EntityRenderContext& ctx);
+    void drawShadowBatch(const EntityDrawList::Batch& batch,
+                         const EntityRenderContext& ctx,
+                         const glm::mat4& lightViewProjection);
 
     Asset::AssetManager* m_assets = nullptr;
     Asset::Handle<Asset::ShaderAsset> m_shader;
     Asset::Handle<Asset::ShaderAsset> m_shadowShader;
+    EntityDrawList m_drawList;
+    EntityDrawList m_shadowDrawList;
+    std::vector<EntityModelInstance*> m_poseScratch;
+    std::vector<float> m_aoScratch;
 };
 
 } // namespace Rigel::Entity
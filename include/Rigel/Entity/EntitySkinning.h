@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Rigel::Entity {
+
+struct EntityModelAsset;
+
+// Must match MAX_BONES in shaders/entity.vert and shaders/entity_shadow_depth.vert.
+// Models with more bones are skinned on the CPU.
+constexpr size_t kMaxGpuSkinBones = 48;
+
+struct EntitySkinVertex {
+    glm::vec3 position{0.0f};
+    glm::vec3 normal{0.0f, 1.0f, 0.0f};
+    glm::vec2 uv{0.0f};
+    // Index into the bone palette; float so it feeds a plain vertex attribute.
+    float bone = 0.0f;
+};
+
+// A model's cube mesh in bind pose: every vertex is in its bone's space, so a pose is
+// just a palette of one model-space matrix per bone. Built once per model.
+struct EntitySkinMesh {
+    std::vector<EntitySkinVertex> vertices;
+    size_t boneCount = 0;
+};
+
+std::shared_ptr<const EntitySkinMesh> buildSkinMesh(const EntityModelAsset& model);
+
+// Poses the bind mesh with `palette` (one matrix per bone) into mesh.vertices.size()
+// vertices at `out`.
+void skinMesh(const EntitySkinMesh& mesh, std::span<const glm::mat4> palette, EntitySkinVertex* out);
+
+// Poses `count` instances of one mesh: `palettes` holds count * boneCount matrices,
+// instance after instance, and `out` receives the instances' vertices in the same
+// order. Each bind vertex is read once for the whole batch.
+void skinMeshBatch(const EntitySkinMesh& mesh,
+                   std::span<const glm::mat4> palettes,
+                   size_t count,
+                   EntitySkinVertex* out);
+
+namespace detail {
+
+// Builds the posed mesh directly from the cubes, one fully transformed cube at a
+// time; the reference skinMesh is tested against.
+void buildPosedMesh(const EntityModelAsset& model,
+                    std::span<const glm::mat4> palette,
+                    std::vector<EntitySkinVertex>& out);
+
+} // namespace detail
+
+} // namespace Rigel::Entity
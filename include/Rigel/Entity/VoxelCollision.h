@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Aabb.h"
+#include "Entity.h"
+
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+namespace Rigel::Voxel {
+class BlockRegistry;
+class World;
+struct BlockState;
+}
+
+namespace Rigel::Entity {
+
+// Gap kept between a resolved box and the block it stopped against.
+constexpr float kCollisionEpsilon = 1.0e-4f;
+
+// Solid-block queries for one entity move. The subchunks covering `reach` are
+// resolved once up front; a cell test is then an array read plus a bit test
+// against BlockRegistry::isSolid. Cells outside `reach` fall back to World::getBlock.
+class VoxelCollisionQuery {
+public:
+    VoxelCollisionQuery(const Voxel::World& world, const Aabb& reach);
+
+    bool isSolid(int x, int y, int z) const;
+    bool intersectsSolid(const Aabb& box) const;
+
+    // Moves `box` by up to `delta` along `axis`. Block layers are visited in travel
+    // order and the walk stops at the first solid one, so the cost follows the
+    // distance travelled and fast movers cannot tunnel through thin walls.
+    // Returns the allowed displacement; `hit` reports whether a block stopped it.
+    float sweep(const Aabb& box, Axis axis, float delta, bool& hit) const;
+
+private:
+    bool isSolidSlow(int x, int y, int z) const;
+
+    const Voxel::World* m_world = nullptr;
+    const Voxel::BlockRegistry* m_registry = nullptr;
+    // Grid of subchunk storage in world subchunk coordinates; nullptr for all-air
+    // or unloaded subchunks.
+    glm::ivec3 m_origin{0};
+    glm::ivec3 m_extent{0};
+    std::vector<const Voxel::BlockState*> m_subchunks;
+};
+
+} // namespace Rigel::Entity
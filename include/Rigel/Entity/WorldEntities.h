@@ -3,8 +3,15 @@
 #include "Entity.h"
 #include "EntityRegion.h"
 
+#include "Rigel/Voxel/ChunkTasks.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace Rigel::Voxel {
@@ -13,6 +20,18 @@ class World;
 
 namespace Rigel::Entity {
 
+// Slot index plus the slot's generation at the time the handle was taken; lookups
+// through a handle whose entity has since despawned return nullptr.
+struct EntityHandle {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == kInvalidIndex; }
+    bool operator==(const EntityHandle&) const = default;
+};
+
 class WorldEntities {
 public:
     void bind(Voxel::World* world);
@@ -22,26 +41,119 @@ public:
     Entity* get(const EntityId& id);
     const Entity* get(const EntityId& id) const;
 
+    EntityHandle handle(const EntityId& id) const;
+    Entity* get(EntityHandle handle);
+    const Entity* get(EntityHandle handle) const;
+
     void forEach(const std::function<void(Entity&)>& fn);
     void forEach(const std::function<void(const Entity&)>& fn) const;
     void tick(float dt);
     void clear();
 
-    size_t size() const { return m_entities.size(); }
+    // Opt-in parallel tick. With threads > 0, tick() groups entities by EntityRegion
+    // and runs Entity::update for the groups on a worker pool (the calling thread
+    // helps). Chunk membership, despawns and spawns are then applied on the calling
+    // thread in a fixed order, so results match a serial tick. While the parallel
+    // phase runs, updates may only read the world and modify their own entity.
+    // In either mode spawn() and despawn() are queued until the tick ends; spawns
+    // apply after despawns, ordered by the requesting entity's dense index and then
+    // by its call order.
+    void setUpdateThreads(size_t threads);
+    size_t updateThreads() const { return m_updatePool ? m_updatePool->threadCount() : 0; }
+
+    size_t size() const { return m_dense.size(); }
+    // Pre-sizes slot storage and the id index for `count` live entities, so a bulk
+    // load spawns without regrowing them. Grows at least geometrically, so calling it
+    // once per loaded batch stays amortized O(1) per entity.
+    void reserve(size_t count);
 
     void updateEntityChunk(Entity& entity);
 
+    // Wakes every entity touching the block at (wx, wy, wz) or one of its
+    // neighbours; called by the world when a block changes.
+    void wakeNearBlock(int wx, int wy, int wz);
+
+    /// @name Broadphase
+    /// Queries over the EntityChunk buckets; only chunks near the query are visited.
+    /// Results are appended to `out`, which callers can reuse between queries.
+    /// @{
+
+    // Entities whose world bounds intersect `box`.
+    void queryAabb(const Aabb& box, std::vector<Entity*>& out) const;
+    // Entities whose position lies within `radius` of `center`.
+    void queryRadius(const glm::vec3& center, float radius, std::vector<Entity*>& out) const;
+    // Closest entity to `center` within `maxRadius` accepted by `filter` (all when empty).
+    Entity* findNearest(const glm::vec3& center,
+                        float maxRadius,
+                        const std::function<bool(const Entity&)>& filter = {}) const;
+    // Every pair of entities whose world bounds intersect, each pair once. `fn` must not
+    // spawn, despawn or move entities; collect what to change and apply it afterwards.
+    void forEachOverlappingPair(const std::function<void(Entity&, Entity&)>& fn) const;
+    // Furthest any bucketed entity's bounds extend from its position on one axis.
+    float maxBoundsReach() const;
+
+    /// @}
+
 private:
+    // Entities live in generation-counted slots; m_dense packs the live slot indices
+    // so iteration is a linear walk. Despawns swap-remove from m_dense and recycle
+    // the slot; during tick() they are deferred so the walk stays stable.
+    struct Slot {
+        std::unique_ptr<Entity> entity;
+        uint32_t generation = 0;
+        uint32_t denseIndex = 0;
+    };
+
+    Entity* slotEntity(uint32_t slot) const { return m_slots[slot].entity.get(); }
+    void releaseSlot(uint32_t slot);
+    void updateSerial(float dt, size_t count);
+    void updateParallel(float dt, size_t count);
+    void applyDeferred();
+    // Entities that moved this tick wake what they touch, and the wake spreads
+    // through touching entities, so a resting pile sleeps and wakes as one island.
+    void wakeContacts();
+
     EntityRegion& getOrCreateRegion(Voxel::ChunkCoord coord);
     EntityChunk& getOrCreateChunk(Voxel::ChunkCoord coord);
     EntityChunk* findChunk(Voxel::ChunkCoord coord) const;
+    // Calls fn for each non-empty bucket whose chunk lies in [min, max].
+    template <typename Fn>
+    void forEachChunkIn(Voxel::ChunkCoord min, Voxel::ChunkCoord max, Fn&& fn) const;
     void removeFromChunk(Entity& entity);
+    void countBoundsReach(float reach);
+    void uncountBoundsReach(float reach);
 
     Voxel::World* m_world = nullptr;
-    std::unordered_map<EntityId, std::unique_ptr<Entity>, EntityIdHash> m_entities;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<uint32_t> m_dense;
+    std::unordered_map<EntityId, uint32_t, EntityIdHash> m_slotById;
     std::unordered_map<EntityRegionCoord, std::unique_ptr<EntityRegion>, EntityRegionCoordHash> m_regions;
     std::unordered_map<Voxel::ChunkCoord, EntityChunk*, Voxel::ChunkCoordHash> m_chunkIndex;
     std::vector<EntityId> m_pendingDespawns;
+    struct PendingSpawn {
+        static constexpr uint32_t kNoSpawner = 0xFFFFFFFFu;
+
+        uint32_t spawnerIndex = kNoSpawner;
+        uint32_t sequence = 0;
+        std::unique_ptr<Entity> entity;
+    };
+    std::vector<PendingSpawn> m_pendingSpawns;
+    uint32_t m_unscopedSpawnSequence = 0;
+    std::mutex m_deferredMutex;
+
+    std::unique_ptr<Voxel::detail::ThreadPool> m_updatePool;
+    // Per-tick grouping of dense indices by region, reused between ticks.
+    std::unordered_map<EntityRegionCoord, uint32_t, EntityRegionCoordHash> m_partitionIndex;
+    std::vector<std::vector<uint32_t>> m_partitions;
+    size_t m_partitionCount = 0;
+    std::vector<std::pair<uint32_t, EntityId>> m_despawnOrder;
+    // Entities are bucketed by position; their bounds reach at most maxBoundsReach()
+    // from it, which is how far past a query box neighbouring buckets must be searched.
+    // Counted per reach so the bound shrinks again when large entities leave.
+    std::map<float, uint32_t> m_boundsReachCounts;
+    std::vector<Entity*> m_wakeQueue;
+    std::vector<Entity*> m_wakeScratch;
     bool m_isTicking = false;
 };
 
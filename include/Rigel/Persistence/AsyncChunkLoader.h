@@ -6,10 +6,13 @@
 #include "Rigel/Voxel/ChunkTasks.h"
 #include "Rigel/Voxel/WorldGenerator.h"
 
+#include <glm/vec3.hpp>
+
 #include <atomic>
-#include <deque>
 #include <functional>
+#include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -30,14 +33,21 @@ public:
                      size_t workerThreads,
                      int viewDistanceChunks,
                      std::shared_ptr<Voxel::WorldGenerator> generator);
+    ~AsyncChunkLoader();
 
     bool request(Voxel::ChunkCoord coord);
     bool isPending(Voxel::ChunkCoord coord) const;
     void cancel(Voxel::ChunkCoord coord);
+    // Drops cached region data after the region was rewritten on disk. Loads and
+    // streams of the old file still in flight are discarded when they complete.
+    void invalidateRegion(const RegionKey& key);
 
     void drainCompletions(size_t budget);
 
     void setMaxCachedRegions(size_t maxRegions);
+    // Upper bound on decoded region data kept in the cache (0 = unlimited). The most
+    // recently used region is always kept.
+    void setMaxCachedBytes(size_t maxBytes);
     void setMaxInFlightRegions(size_t maxRegions);
     void setPrefetchRadius(int radius);
     void setPrefetchPerRequest(size_t count);
@@ -45,6 +55,15 @@ public:
     void setLoadQueueLimit(size_t maxPending);
     void setChunkAppliedCallback(ChunkAppliedCallback callback);
 
+    // Feeds the viewer position (world units) once per frame. The smoothed velocity
+    // steers prefetch ahead of the heading, and entering a new region prefetches
+    // around it.
+    void updateViewer(const glm::vec3& position, float dtSeconds);
+
+    size_t cachedRegionCount() const { return m_cache.size(); }
+    size_t cachedBytes() const { return m_cachedBytes; }
+    bool hasCachedRegion(const RegionKey& key) const { return m_cache.find(key) != m_cache.end(); }
+
 private:
     struct RegionKeyHash {
         size_t operator()(const RegionKey& key) const;
@@ -56,11 +75,52 @@ private:
         std::unordered_map<Voxel::ChunkCoord,
                            std::vector<const ChunkSnapshot*>,
                            Voxel::ChunkCoordHash> spansByCoord;
+        // Random-access formats fill an entry one chunk read at a time: `probed` holds
+        // every coord read so far (stored or not) and `pieces` owns their snapshots.
+        bool partial = false;
+        std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash> probed;
+        std::unordered_map<Voxel::ChunkCoord,
+                           std::shared_ptr<ChunkRegionSnapshot>,
+                           Voxel::ChunkCoordHash> pieces;
+        // Regions streamed frame by frame own one snapshot per decoded frame.
+        std::vector<std::shared_ptr<ChunkRegionSnapshot>> frames;
+        // Estimated decoded size, counted against m_maxCachedBytes.
+        size_t bytes = 0;
     };
 
+    // Multi-frame regions stream: the IO job posts a header (`streamed`, with the
+    // coords each frame can hold) and then one result per decoded frame (`frameIndex`
+    // and `piece`), so chunks apply as soon as every frame that may hold them is in.
     struct RegionResult {
         RegionKey key;
+        // Region invalidation generation the load was dispatched under.
+        uint64_t generation = 0;
+        RegionEntry entry;
+        bool ok = false;
+        bool exists = false;
+        bool streamed = false;
+        std::vector<std::vector<Voxel::ChunkCoord>> frameCoords;
+        std::optional<size_t> frameIndex;
+        std::shared_ptr<ChunkRegionSnapshot> piece;
+    };
+
+    struct RegionStream {
+        uint64_t generation = 0;
         RegionEntry entry;
+        std::vector<std::vector<Voxel::ChunkCoord>> frameCoords;
+        // Frames still decoding that may hold each coord; frames of unknown extent
+        // hold back every coord.
+        std::unordered_map<Voxel::ChunkCoord, size_t, Voxel::ChunkCoordHash> outstanding;
+        size_t unknownOutstanding = 0;
+        size_t remaining = 0;
+        bool ok = true;
+    };
+
+    struct ChunkReadResult {
+        RegionKey key;
+        Voxel::ChunkCoord coord;
+        uint64_t generation = 0;
+        std::shared_ptr<ChunkRegionSnapshot> piece;
         bool ok = false;
         bool exists = false;
     };
@@ -75,29 +135,49 @@ private:
     };
 
     void drainRegionCompletions(size_t budget);
+    void beginRegionStream(RegionResult& header);
+    void applyRegionFrame(RegionResult& frame);
+    void finishRegionStream(const RegionKey& key);
+    bool streamCoordReady(const RegionStream& stream, Voxel::ChunkCoord coord) const;
     void drainPayloadCompletions(size_t budget);
+    void drainChunkReadCompletions(size_t budget);
     bool queueRegionLoad(const RegionKey& key);
+    bool queueChunkRead(const RegionKey& key, Voxel::ChunkCoord coord);
     void queuePayloadBuild(const RegionEntry& entry, Voxel::ChunkCoord coord);
     void prefetchNeighbors(const RegionKey& center);
     void touch(const RegionKey& key);
     void evictIfNeeded();
+    void eraseCacheEntry(const RegionKey& key);
+    void refreshEntryBytes(RegionEntry& entry);
     int estimateRegionSpan() const;
     bool regionMayExist(const RegionKey& key);
+    uint64_t regionGeneration(const RegionKey& key) const;
 
     bool applyPayload(const ChunkPayload& payload);
 
     PersistenceService* m_service = nullptr;
     PersistenceContext m_context;
-    std::unique_ptr<PersistenceFormat> m_format;
+    // Shared with in-flight IO and decode jobs.
+    std::shared_ptr<PersistenceFormat> m_format;
     Voxel::World* m_world = nullptr;
     uint32_t m_worldGenVersion = 0;
     std::string m_zoneId = "rigel:default";
     size_t m_maxCachedRegions = 8;
+    size_t m_maxCachedBytes = 0;
+    size_t m_cachedBytes = 0;
     size_t m_maxInFlightRegions = 8;
     size_t m_loadQueueLimit = 0;
     int m_prefetchRadius = 1;
     size_t m_prefetchPerRequest = 12;
     size_t m_regionDrainBudget = 32;
+    bool m_chunkReads = false;
+    int m_regionSpan = 1;
+
+    bool m_hasViewer = false;
+    glm::vec3 m_viewerChunkPos{0.0f};
+    // Chunks per second, exponentially smoothed.
+    glm::vec3 m_viewerVelocity{0.0f};
+    std::optional<RegionKey> m_viewerRegion;
 
     std::shared_ptr<Voxel::WorldGenerator> m_generator;
 
@@ -105,21 +185,29 @@ private:
     Voxel::detail::ThreadPool m_workerPool;
     Voxel::detail::ConcurrentQueue<RegionResult> m_regionComplete;
     Voxel::detail::ConcurrentQueue<ChunkPayload> m_chunkComplete;
+    Voxel::detail::ConcurrentQueue<ChunkReadResult> m_chunkReadComplete;
 
     std::unordered_map<RegionKey, RegionEntry, RegionKeyHash> m_cache;
     std::unordered_set<RegionKey, RegionKeyHash> m_inFlight;
+    // In-flight regions whose frames are still arriving (also listed in m_inFlight).
+    std::unordered_map<RegionKey, RegionStream, RegionKeyHash> m_streams;
     std::unordered_map<RegionKey,
                        std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash>,
                        RegionKeyHash> m_regionPending;
     std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash> m_pendingChunks;
     std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash> m_payloadInFlight;
-    std::deque<RegionKey> m_lru;
+    std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash> m_chunkReadInFlight;
+    // Least recently used first; m_lruIndex makes touch/erase O(1).
+    std::list<RegionKey> m_lru;
+    std::unordered_map<RegionKey, std::list<RegionKey>::iterator, RegionKeyHash> m_lruIndex;
 
     struct RegionPresence {
         bool exists = false;
         std::chrono::steady_clock::time_point nextCheck{};
     };
     std::unordered_map<RegionKey, RegionPresence, RegionKeyHash> m_regionPresence;
+    // Bumped by invalidateRegion(); results stamped with an older value are stale.
+    std::unordered_map<RegionKey, uint64_t, RegionKeyHash> m_regionGenerations;
     ChunkAppliedCallback m_chunkAppliedCallback;
 };
 
@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -81,4 +82,106 @@ public:
     static void write(ByteWriter& writer, const CRBinDocument& doc);
 };
 
+// Root fields a compiled schema did not bind (or bound with a different stored type),
+// kept in file order so a read/write round trip preserves them. Bound array fields
+// stored as null are recorded here too, with a null value.
+struct CRBinUnknownFields {
+    std::vector<CRSchemaEntry> entries;
+    // The document's alt schemas; object-typed unknown fields index into them.
+    std::vector<CRSchema> altSchemas;
+    CRBinObject values;
+};
+
+namespace detail {
+
+template <typename V>
+struct CRBinFieldType;
+
+template <> struct CRBinFieldType<int8_t> { static constexpr CRSchemaType value = CRSchemaType::Byte; };
+template <> struct CRBinFieldType<int16_t> { static constexpr CRSchemaType value = CRSchemaType::Short; };
+template <> struct CRBinFieldType<int32_t> { static constexpr CRSchemaType value = CRSchemaType::Int; };
+template <> struct CRBinFieldType<int64_t> { static constexpr CRSchemaType value = CRSchemaType::Long; };
+template <> struct CRBinFieldType<float> { static constexpr CRSchemaType value = CRSchemaType::Float; };
+template <> struct CRBinFieldType<double> { static constexpr CRSchemaType value = CRSchemaType::Double; };
+template <> struct CRBinFieldType<bool> { static constexpr CRSchemaType value = CRSchemaType::Boolean; };
+template <> struct CRBinFieldType<std::string> { static constexpr CRSchemaType value = CRSchemaType::String; };
+template <> struct CRBinFieldType<std::vector<int8_t>> { static constexpr CRSchemaType value = CRSchemaType::ByteArray; };
+template <> struct CRBinFieldType<std::vector<int16_t>> { static constexpr CRSchemaType value = CRSchemaType::ShortArray; };
+template <> struct CRBinFieldType<std::vector<int32_t>> { static constexpr CRSchemaType value = CRSchemaType::IntArray; };
+template <> struct CRBinFieldType<std::vector<int64_t>> { static constexpr CRSchemaType value = CRSchemaType::LongArray; };
+template <> struct CRBinFieldType<std::vector<float>> { static constexpr CRSchemaType value = CRSchemaType::FloatArray; };
+template <> struct CRBinFieldType<std::vector<double>> { static constexpr CRSchemaType value = CRSchemaType::DoubleArray; };
+template <> struct CRBinFieldType<std::vector<std::string>> { static constexpr CRSchemaType value = CRSchemaType::StringArray; };
+
+// One bound root field. `member` returns the field inside the struct; its C++ type is
+// the one CRBinFieldType maps to `type`.
+struct CRBinFieldBinding {
+    std::string name;
+    CRSchemaType type = CRSchemaType::SchemaEnd;
+    void* (*member)(void* object) = nullptr;
+};
+
+void readCompiled(ByteReader& reader,
+                  const std::vector<CRBinFieldBinding>& fields,
+                  void* object,
+                  CRBinUnknownFields* unknown);
+void writeCompiled(ByteWriter& writer,
+                   const std::vector<CRBinFieldBinding>& fields,
+                   const void* object,
+                   const CRBinUnknownFields* unknown);
+
+} // namespace detail
+
+// Reads and writes a CRBin document whose root fields map onto a plain struct,
+// without building CRBinValue/CRBinObject trees for them. Fields are bound by name:
+//
+//   static const auto schema = CRBinStructSchema<Header>()
+//       .field<&Header::version>("version")
+//       .field<&Header::name>("name");
+//
+// Stored fields the schema does not know fall back to the dynamic reader and land in
+// `unknown` (dropped when it is null); bound fields missing from the file keep their
+// value in the struct. A stored null array reads as an empty vector and is recorded in
+// `unknown`; write() restores the null while the vector is still empty. The wire
+// format is the one CRBinReader/CRBinWriter use.
+template <typename T>
+class CRBinStructSchema {
+public:
+    template <auto Member>
+    CRBinStructSchema& field(std::string name) {
+        using Value = std::remove_cvref_t<decltype(std::declval<T&>().*Member)>;
+        detail::CRBinFieldBinding binding;
+        binding.name = std::move(name);
+        binding.type = detail::CRBinFieldType<Value>::value;
+        binding.member = [](void* object) -> void* { return &(static_cast<T*>(object)->*Member); };
+        m_fields.push_back(std::move(binding));
+        return *this;
+    }
+
+    CRSchema schema() const {
+        CRSchema out;
+        for (const auto& binding : m_fields) {
+            out.entries.push_back(CRSchemaEntry{binding.name, binding.type});
+        }
+        return out;
+    }
+
+    void read(ByteReader& reader, T& out, CRBinUnknownFields* unknown = nullptr) const {
+        detail::readCompiled(reader, m_fields, &out, unknown);
+    }
+
+    T read(ByteReader& reader, CRBinUnknownFields* unknown = nullptr) const {
+        T out{};
+        read(reader, out, unknown);
+        return out;
+    }
+
+    void write(ByteWriter& writer, const T& value, const CRBinUnknownFields* unknown = nullptr) const {
+        detail::writeCompiled(writer, m_fields, &value, unknown);
+    }
+
+private:
+    std::vector<detail::CRBinFieldBinding> m_fields;
+};
+
 } // namespace Rigel::Persistence::Backends::CR
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Rigel/Voxel/Block.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Rigel::Persistence::Backends::CR {
+
+// A CR block layer is 16x16 palette indices (x fastest). Packed layers store 1, 2, 4
+// or 8 bits per index, low bits first within each byte.
+constexpr size_t kLayerIndexCount = 256;
+
+// Palette padded to 256 entries so any 8-bit index resolves without a bounds check;
+// indices past the palette map to air.
+using LayerPaletteLut = std::array<Voxel::BlockID, kLayerIndexCount>;
+
+bool isPackedLayerWidth(int bitsPerIndex);
+size_t packedLayerBytes(int bitsPerIndex);
+
+LayerPaletteLut makeLayerPaletteLut(std::span<const Voxel::BlockID> palette);
+
+// Expands one packed layer into 256 indices. SSE2 when available.
+void unpackLayerIndices(const uint8_t* packed, int bitsPerIndex, uint8_t* indices);
+
+// Packs 256 indices; bits above bitsPerIndex are dropped. SSE2 when available.
+void packLayerIndices(const uint16_t* indices, int bitsPerIndex, uint8_t* packed);
+
+// Fused unpack + palette lookup into 256 block states (metadata and light cleared).
+void unpackLayerBlocks(const uint8_t* packed,
+                       int bitsPerIndex,
+                       const LayerPaletteLut& lut,
+                       Voxel::BlockState* out);
+
+namespace detail {
+
+// One index at a time; the reference the vector paths are tested against.
+void unpackLayerIndicesScalar(const uint8_t* packed, int bitsPerIndex, uint8_t* indices);
+void packLayerIndicesScalar(const uint16_t* indices, int bitsPerIndex, uint8_t* packed);
+
+} // namespace detail
+
+} // namespace Rigel::Persistence::Backends::CR
@@ -11,6 +11,13 @@ public:
     static int compressBound(int inputSize);
     static int compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
     static int decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+    // Dictionary variants; the same dictionary bytes must be passed to both sides.
+    static bool dictionaryAvailable();
+    static int compressWithDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                                const uint8_t* dict, size_t dictSize);
+    static int decompressWithDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                                  const uint8_t* dict, size_t dictSize);
 };
 
 } // namespace Rigel::Persistence::Backends::CR
@@ -8,6 +8,13 @@ inline constexpr const char* kCRSettingsProviderId = "rigel:persistence.cr";
 
 struct CRPersistenceSettings final : public Provider {
     bool enableLz4 = false;
+    // Per-world opt-in: write framed regions (independently compressed columns,
+    // random-access reads) that Cosmic Reach itself cannot read. Off keeps the
+    // version 4 layout.
+    bool columnFrames = false;
+    // With lz4 + columnFrames, store a shared per-region dictionary when it shrinks the
+    // file. Ignored for worlds that did not opt into columnFrames.
+    bool lz4Dictionary = false;
 };
 
 } // namespace Rigel::Persistence::Backends::CR
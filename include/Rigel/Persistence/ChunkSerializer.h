@@ -4,10 +4,15 @@
 #include "Rigel/Voxel/Chunk.h"
 #include "Rigel/Voxel/BlockRegistry.h"
 
+#include <span>
+
 namespace Rigel::Persistence {
 
 ChunkData serializeChunk(const Voxel::Chunk& chunk);
 ChunkData serializeChunkSpan(const Voxel::Chunk& chunk, const ChunkSpan& span);
 void applyChunkData(const ChunkData& data, Voxel::Chunk& chunk, const Voxel::BlockRegistry& registry);
+// Writes the span into a dense Chunk::VOLUME array laid out like Voxel::ChunkBuffer
+// (x + y * SIZE + z * SIZE * SIZE), one row copy per (y, z).
+void applyChunkData(const ChunkData& data, std::span<Voxel::BlockState> blocks);
 
 } // namespace Rigel::Persistence
@@ -14,10 +14,14 @@ struct ChunkSpanMergeResult {
     bool loadedFromDisk = false;
     bool fullSpan = false;
     uint8_t subchunkMask = 0;
+    // The spans together cover every cell, so no base fill is needed.
+    bool fullyCovered = false;
     bool appliedBase = false;
 };
 
 using ChunkBaseFillFn = std::function<void(Voxel::Chunk&, const Voxel::BlockRegistry&)>;
+// Fills a dense Chunk::VOLUME array (Voxel::ChunkBuffer layout).
+using ChunkBlocksBaseFillFn = std::function<void(std::span<Voxel::BlockState>)>;
 
 ChunkSpanMergeResult mergeChunkSpans(
     Voxel::Chunk& chunk,
@@ -25,4 +29,11 @@ ChunkSpanMergeResult mergeChunkSpans(
     std::span<const ChunkSnapshot* const> spans,
     const ChunkBaseFillFn& baseFill);
 
+// Same merge into a dense block array, e.g. a loader payload buffer. The base fill
+// runs only when some cell is left uncovered by the spans.
+ChunkSpanMergeResult mergeChunkSpans(
+    std::span<Voxel::BlockState> blocks,
+    std::span<const ChunkSnapshot* const> spans,
+    const ChunkBlocksBaseFillFn& baseFill);
+
 } // namespace Rigel::Persistence
@@ -2,6 +2,9 @@
 
 #include "Rigel/Persistence/Types.h"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -9,6 +12,19 @@
 
 namespace Rigel::Persistence {
 
+// Decodes one independently stored slice of a region (a compressed column frame, for
+// example) into chunk snapshots. Safe to run on any thread while the container that
+// produced it is alive.
+using ChunkFrameDecoder = std::function<std::vector<ChunkSnapshot>()>;
+
+// One frame of a whole-region read (ChunkContainer::readRegionFrames).
+struct RegionFrame {
+    ChunkFrameDecoder decode;
+    // Stored keys the frame can hold, when the container knows them before decoding
+    // (every key of a CR column). Empty means it may hold any chunk of the region.
+    std::vector<ChunkKey> keys;
+};
+
 class ChunkContainer {
 public:
     virtual ~ChunkContainer() = default;
@@ -25,6 +41,40 @@ public:
         return false;
     }
 
+    // Reads only the listed stored chunks of a region; keys that are not stored are
+    // skipped. Containers with a per-chunk index (FormatCapabilities::supportsRandomAccess)
+    // override this to avoid decoding the rest of the region.
+    virtual ChunkRegionSnapshot loadRegionChunks(const RegionKey& key, const std::vector<ChunkKey>& keys) {
+        ChunkRegionSnapshot region = loadRegion(key);
+        std::erase_if(region.chunks, [&](const ChunkSnapshot& chunk) {
+            return std::find(keys.begin(), keys.end(), chunk.key) == keys.end();
+        });
+        return region;
+    }
+
+    // Split form of loadRegionChunks: performs the IO here and returns one decoder per
+    // stored frame, so callers can spread decompression over a worker pool. The
+    // default decodes eagerly and hands back a single decoder holding the result.
+    virtual std::vector<ChunkFrameDecoder> readChunkFrames(const RegionKey& key,
+                                                           const std::vector<ChunkKey>& keys) {
+        auto chunks = std::make_shared<std::vector<ChunkSnapshot>>(loadRegionChunks(key, keys).chunks);
+        return {[chunks]() { return std::move(*chunks); }};
+    }
+
+    // Split form of loadRegion: parses the region index and reads every stored frame
+    // here, leaving decompression and decoding to the returned frames. The default
+    // decodes eagerly and hands back a single frame of unknown extent.
+    virtual std::vector<RegionFrame> readRegionFrames(const RegionKey& key) {
+        auto chunks = std::make_shared<std::vector<ChunkSnapshot>>(loadRegion(key).chunks);
+        std::vector<RegionFrame> frames(1);
+        frames.front().decode = [chunks]() { return std::move(*chunks); };
+        return frames;
+    }
+
+    // Drops anything cached for the region (open file handles, parsed indexes). Needed
+    // only when the region was rewritten through a different container instance.
+    virtual void invalidateRegion(const RegionKey& key) { (void)key; }
+
     virtual bool supportsChunkIO() const { return false; }
     virtual void saveChunk(const ChunkSnapshot&) {
         throw std::runtime_error("Chunk-level IO not supported by this container");
@@ -15,10 +15,28 @@ struct ProviderConfig {
     std::string getString(std::string_view key, const std::string& fallback) const;
 };
 
+// Background incremental save of edited chunks (see WorldSaveService).
+struct AutosaveConfig {
+    bool enabled = true;
+    // Chunks snapshotted per frame.
+    int chunksPerFrame = 8;
+    // Region writes allowed in flight before snapshotting pauses.
+    int maxInFlightRegions = 4;
+    // A dirty chunk is saved once it has been unchanged this long...
+    float settleSeconds = 2.0f;
+    // ...or once it has been dirty this long, whichever comes first.
+    float maxDirtyAgeSeconds = 30.0f;
+    int ioThreads = 1;
+    // Regions queued in the same frame commit as one storage batch: one data sync
+    // and one commit record instead of one per region.
+    bool batchCommits = true;
+};
+
 struct PersistenceConfig {
     std::string format = "cr";
     std::string zoneId;
     std::vector<ProviderConfig> providers;
+    AutosaveConfig autosave;
 
     const ProviderConfig* findProvider(std::string_view id) const;
     void applyYaml(const char* sourceName, const std::string& yaml);
@@ -2,6 +2,10 @@
 
 #include "Rigel/Persistence/FormatRegistry.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace Rigel::Persistence {
 
 class PersistenceService {
@@ -10,6 +14,19 @@ public:
 
     std::unique_ptr<PersistenceFormat> openFormat(const PersistenceContext& context) const;
 
+    // Returns one format instance per distinct context (root, format, storage, providers,
+    // policies), constructed on first use. Formats are stateless after construction
+    // apart from internal caches, so the handle may be used from any thread; writers
+    // sharing it keep those caches (open region files, indexes) current.
+    std::shared_ptr<PersistenceFormat> sharedFormat(const PersistenceContext& context) const;
+
+    // Drop cached shared formats when what they were opened for goes away: a world's
+    // provider registry, a storage backend, or everything. Handles already returned
+    // stay valid.
+    void releaseWorldFormats(const std::shared_ptr<ProviderRegistry>& providers);
+    void releaseStorageFormats(const std::shared_ptr<StorageBackend>& storage);
+    void clearSharedFormats();
+
     void saveWorld(const WorldSnapshot& snapshot, SaveScope scope, const PersistenceContext& context);
     WorldMetadata loadWorldMetadata(const PersistenceContext& context);
 
@@ -23,7 +40,22 @@ public:
     EntityRegionSnapshot loadEntities(const EntityRegionKey& key, const PersistenceContext& context);
 
 private:
+    struct SharedFormatEntry {
+        std::string rootPath;
+        std::string preferredFormat;
+        std::string manifestPath;
+        PersistencePolicies policies{};
+        // Weak handles compare by owner, so a new object at a recycled address never
+        // matches, and an expired entry is pruned on the next lookup.
+        std::weak_ptr<StorageBackend> storage;
+        std::weak_ptr<ProviderRegistry> providers;
+        bool hasProviders = false;
+        std::shared_ptr<PersistenceFormat> format;
+    };
+
     FormatRegistry& m_registry;
+    mutable std::mutex m_sharedMutex;
+    mutable std::vector<SharedFormatEntry> m_sharedFormats;
 
     std::unique_ptr<PersistenceFormat> resolve(const PersistenceContext& context) const;
     void handleUnsupportedFeature(const PersistenceContext& context, const std::string& message) const;
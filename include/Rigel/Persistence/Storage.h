@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -54,6 +55,8 @@ public:
     virtual void abort() = 0;
 };
 
+class StorageBatch;
+
 class StorageBackend {
 public:
     virtual ~StorageBackend() = default;
@@ -64,6 +67,28 @@ public:
     virtual std::vector<std::string> list(const std::string& path) = 0;
     virtual void mkdirs(const std::string& path) = 0;
     virtual void remove(const std::string& path) = 0;
+
+    // Starts a group of writes that commit together, with its commit record under
+    // `root`. Returns nullptr when the backend has no batched commits.
+    virtual std::shared_ptr<StorageBatch> beginBatch(const std::string& root) {
+        (void)root;
+        return nullptr;
+    }
+
+    // Finishes or rolls back batches interrupted under `root`. Call before reading
+    // a world that may have been written with batches.
+    virtual void recoverBatches(const std::string& root) { (void)root; }
+};
+
+// Writes and removals staged through a batch stay invisible (reads through the batch
+// see them) until commit() publishes all of them. After a crash, recoverBatches()
+// leaves either every change of a batch in place or none of them. commit() throws
+// only if the batch did not commit; once its commit record exists it returns, and a
+// backend that could not apply it yet must do so before any later write.
+class StorageBatch : public StorageBackend {
+public:
+    virtual void commit() = 0;
+    virtual void abort() = 0;
 };
 
 class FilesystemBackend : public StorageBackend {
@@ -74,6 +99,22 @@ public:
     std::vector<std::string> list(const std::string& path) override;
     void mkdirs(const std::string& path) override;
     void remove(const std::string& path) override;
+
+    // Batched commits share one data sync (syncfs on Linux, per-file fsync elsewhere),
+    // one fsync'd commit record and one fsync per touched directory.
+    std::shared_ptr<StorageBatch> beginBatch(const std::string& root) override;
+    void recoverBatches(const std::string& root) override;
+
+    // Queues the journal of a committed batch that could not be applied in place.
+    // beginBatch(), openWrite() and remove() roll queued journals forward first and
+    // throw while that still fails, so nothing newer lands under a stale journal.
+    void deferJournal(const std::string& journalPath);
+
+private:
+    void completeDeferredJournals();
+
+    std::mutex m_deferredMutex;
+    std::vector<std::string> m_deferredJournals;
 };
 
 } // namespace Rigel::Persistence
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Rigel/Persistence/PersistenceConfig.h"
+#include "Rigel/Persistence/PersistenceService.h"
+#include "Rigel/Persistence/Storage.h"
+#include "Rigel/Persistence/Types.h"
+#include "Rigel/Voxel/ChunkCoord.h"
+#include "Rigel/Voxel/ChunkTasks.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Rigel::Voxel { class World; }
+
+namespace Rigel::Persistence {
+
+struct WorldSaveMetrics {
+    size_t dirtyChunks = 0;
+    // Dirty chunks that are due (settled or past the age bound) but not yet snapshotted.
+    size_t dueChunks = 0;
+    size_t inFlightRegions = 0;
+    float oldestDirtySeconds = 0.0f;
+    // Updates that had due chunks but were held back by maxInFlightRegions.
+    uint64_t throttledUpdates = 0;
+    uint64_t chunksSaved = 0;
+    uint64_t regionsWritten = 0;
+    uint64_t writeFailures = 0;
+    float lastWriteMs = 0.0f;
+};
+
+// Incremental background save of persist-dirty chunks.
+//
+// update() runs on the main thread: it tracks how long each chunk has been dirty,
+// snapshots a bounded batch of due chunks per call and hands them to the IO pool,
+// which merges them into their region and commits it atomically. With
+// AutosaveConfig::batchCommits the regions queued by one update() share a single
+// StorageBatch and become durable together. persistDirty is
+// cleared only after the commit, and only if the chunk was not edited again in
+// between (Chunk::persistRevision()).
+class WorldSaveService {
+public:
+    using RegionSavedCallback = std::function<void(const RegionKey&)>;
+
+    WorldSaveService(PersistenceService& service,
+                     PersistenceContext context,
+                     Voxel::World& world,
+                     size_t ioThreads);
+    ~WorldSaveService();
+
+    WorldSaveService(const WorldSaveService&) = delete;
+    WorldSaveService& operator=(const WorldSaveService&) = delete;
+
+    void setConfig(const AutosaveConfig& config);
+    const AutosaveConfig& config() const { return m_config; }
+
+    // Invoked on the main thread after each committed region write.
+    void setRegionSavedCallback(RegionSavedCallback callback);
+
+    void update();
+
+    // Snapshots every dirty chunk regardless of budgets and waits for the writes.
+    void flush();
+
+    const WorldSaveMetrics& metrics() const { return m_metrics; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct RegionKeyHash {
+        size_t operator()(const RegionKey& key) const;
+    };
+
+    struct DirtyState {
+        uint32_t revision = 0;
+        Clock::time_point firstDirty;
+        Clock::time_point lastChange;
+        Clock::time_point retryAt;
+        bool inFlight = false;
+    };
+
+    struct RegionWrite {
+        RegionKey key;
+        // Storage keys rewritten by this batch; all-air spans are dropped from the region.
+        std::vector<ChunkKey> replacedKeys;
+        std::vector<ChunkSnapshot> snapshots;
+        std::vector<std::pair<Voxel::ChunkCoord, uint32_t>> chunks;
+    };
+
+    struct RegionWriteResult {
+        RegionKey key;
+        std::vector<std::pair<Voxel::ChunkCoord, uint32_t>> chunks;
+        bool ok = false;
+        float writeMs = 0.0f;
+    };
+
+    // Region writes queued together into one StorageBatch; the last job to finish
+    // commits the batch and reports every region's result.
+    struct PendingBatch {
+        std::shared_ptr<StorageBatch> storage;
+        std::shared_ptr<PersistenceFormat> format;
+        std::mutex mutex;
+        std::vector<RegionWriteResult> results;
+        size_t remaining = 0;
+    };
+
+    void scanDirtyChunks(Clock::time_point now);
+    bool isDue(const DirtyState& state, Clock::time_point now) const;
+    // Snapshots up to `budget` chunks (oldest first) into at most `regionSlots` new
+    // region writes. Returns the number of chunks snapshotted.
+    size_t queueDueChunks(Clock::time_point now, size_t budget, size_t regionSlots, bool ignoreTiming);
+    std::shared_ptr<PendingBatch> beginBatch(size_t regions);
+    void queueRegionWrite(RegionWrite write, std::shared_ptr<PendingBatch> batch);
+    void finishBatch(PendingBatch& batch);
+    void drainCompletions();
+    void refreshMetrics(Clock::time_point now);
+
+    PersistenceService* m_service = nullptr;
+    PersistenceContext m_context;
+    std::shared_ptr<PersistenceFormat> m_format;
+    Voxel::World* m_world = nullptr;
+    std::string m_zoneId;
+    AutosaveConfig m_config;
+    RegionSavedCallback m_regionSavedCallback;
+    WorldSaveMetrics m_metrics;
+
+    Clock::time_point m_nextScan;
+    std::unordered_map<Voxel::ChunkCoord, DirtyState, Voxel::ChunkCoordHash> m_dirty;
+    std::unordered_set<RegionKey, RegionKeyHash> m_inFlight;
+
+    Voxel::detail::ThreadPool m_ioPool;
+    Voxel::detail::ConcurrentQueue<RegionWriteResult> m_complete;
+};
+
+} // namespace Rigel::Persistence
@@ -7,6 +7,10 @@ struct VoxelSvoConfig;
 struct VoxelSvoTelemetry;
 }
 
+namespace Rigel::Persistence {
+struct WorldSaveMetrics;
+}
+
 namespace Rigel::UI {
 
 bool init(GLFWwindow* window);
@@ -17,7 +21,8 @@ void endFrame();
 
 void renderProfilerWindow(bool enabled,
                           const Rigel::Voxel::VoxelSvoConfig* voxelSvoConfig = nullptr,
-                          const Rigel::Voxel::VoxelSvoTelemetry* voxelSvoTelemetry = nullptr);
+                          const Rigel::Voxel::VoxelSvoTelemetry* voxelSvoTelemetry = nullptr,
+                          const Rigel::Persistence::WorldSaveMetrics* saveMetrics = nullptr);
 
 bool wantsCaptureKeyboard();
 bool wantsCaptureMouse();
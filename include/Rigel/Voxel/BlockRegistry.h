@@ -77,6 +77,18 @@ public:
         return m_types[id.type];
     }
 
+    /**
+     * @brief Check if a block type is solid.
+     *
+     * Reads a packed per-ID bitset instead of the full BlockType.
+     *
+     * @param id The block ID
+     * @return True if the type is solid; unknown IDs are not solid
+     */
+    bool isSolid(BlockID id) const {
+        return id.type < m_solid.size() && m_solid[id.type];
+    }
+
     /**
      * @brief Find block ID by string identifier.
      *
@@ -114,6 +126,7 @@ public:
 
 private:
     std::vector<BlockType> m_types;
+    std::vector<bool> m_solid;
     std::unordered_map<std::string, BlockID> m_identifierMap;
 };
 
@@ -82,6 +82,20 @@ public:
      */
     BlockState getBlock(int x, int y, int z) const;
 
+    /**
+     * @brief Raw block storage of one subchunk.
+     *
+     * @param sx Subchunk X (0 or 1)
+     * @param sy Subchunk Y (0 or 1)
+     * @param sz Subchunk Z (0 or 1)
+     * @return SUBCHUNK_VOLUME states indexed [x + y*SUBCHUNK_SIZE + z*SUBCHUNK_SIZE^2]
+     *         (subchunk-local coordinates), or nullptr while the subchunk is all air
+     */
+    const BlockState* subchunkBlocks(int sx, int sy, int sz) const {
+        const Subchunk& subchunk = m_subchunks[sx + sy * 2 + sz * 4];
+        return subchunk.blocks ? subchunk.blocks->data() : nullptr;
+    }
+
     /**
      * @brief Set block at local coordinates.
      *
@@ -151,7 +165,14 @@ public:
     }
 
     /// Mark chunk as needing persistence write
-    void markPersistDirty() { m_persistDirty = true; }
+    void markPersistDirty() {
+        m_persistDirty = true;
+        ++m_persistRevision;
+    }
+
+    /// Bumped by every change that marks the chunk persist-dirty; lets a background
+    /// save tell whether the data it wrote is still current.
+    uint32_t persistRevision() const { return m_persistRevision; }
 
     /// Check if chunk contains only air blocks
     bool isEmpty() const { return m_nonAirCount == 0; }
@@ -223,6 +244,7 @@ private:
     uint32_t m_nonAirCount = 0;
     uint32_t m_opaqueCount = 0;
     uint32_t m_meshRevision = 0;
+    uint32_t m_persistRevision = 0;
     uint32_t m_worldGenVersion = 0;
 
     /// Convert 3D coordinates to flat array index
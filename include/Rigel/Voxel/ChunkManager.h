@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <memory>
 #include <functional>
+#include <utility>
 #include <vector>
 
 namespace Rigel::Voxel {
@@ -48,6 +49,9 @@ class BlockRegistry;
  */
 class ChunkManager {
 public:
+    /// Receives the world coordinates of a block whose state changed.
+    using BlockChangedCallback = std::function<void(int wx, int wy, int wz)>;
+
     ChunkManager() = default;
 
     /// @name Chunk Access
@@ -114,6 +118,15 @@ public:
      */
     void setBlock(int wx, int wy, int wz, BlockState state);
 
+    /**
+     * @brief Set a callback invoked by setBlock() after a block actually changes.
+     *
+     * World uses it to wake sleeping entities next to the edit.
+     */
+    void setBlockChangedCallback(BlockChangedCallback callback) {
+        m_blockChanged = std::move(callback);
+    }
+
     /// @}
 
     /// @name Lifecycle
@@ -193,6 +206,7 @@ public:
 private:
     std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash> m_chunks;
     const BlockRegistry* m_registry = nullptr;
+    BlockChangedCallback m_blockChanged;
 };
 
 } // namespace Rigel::Voxel
@@ -119,6 +119,7 @@ private:
     struct VoxelGpuMeshEntry {
         VoxelPageKey key{};
         uint64_t revision = 0;
+        int spanPages = 1;
         glm::vec3 worldMin{0.0f};
         GpuMesh mesh;
     };
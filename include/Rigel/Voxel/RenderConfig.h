@@ -34,6 +34,20 @@ struct TaaConfig {
     float jitterScale = 1.0f;
 };
 
+// Entity animation level of detail by camera distance. Inside fullDistance poses
+// are evaluated every frame; the reduced and low tiers evaluate every N frames
+// (blended in between) with fewer animations; beyond freezeDistance poses hold.
+struct EntityAnimationLodConfig {
+    bool enabled = false;
+    float fullDistance = 24.0f;
+    float reducedDistance = 64.0f;
+    int reducedInterval = 2;
+    int reducedMaxAnimations = 2;
+    float freezeDistance = 160.0f;
+    int lowInterval = 4;
+    int lowMaxAnimations = 1;
+};
+
 struct VoxelSvoConfig {
     bool enabled = false;
 
@@ -48,6 +62,7 @@ struct VoxelSvoConfig {
     int levels = 4;
     int pageSizeVoxels = 64;   // Level 0 page dimensions (power of two).
     int minLeafVoxels = 1;     // MVP: global min leaf size (power of two).
+    int clusterPages = 1;      // Merge far meshes across N^3 same-level pages (1 = off).
 
     // Budgets (pages per frame).
     int buildBudgetPagesPerFrame = 1;
@@ -58,6 +73,9 @@ struct VoxelSvoConfig {
     int maxResidentPages = 512;
     int64_t maxCpuBytes = 256 * 1024 * 1024;
     int64_t maxGpuBytes = 256 * 1024 * 1024;
+
+    // Persist built far pages under the world save and restore them on revisit.
+    bool diskCache = false;
 };
 
 
@@ -67,6 +85,7 @@ struct WorldRenderConfig {
     float transparentAlpha = 1.0f;
     ShadowConfig shadow;
     TaaConfig taa;
+    EntityAnimationLodConfig entityAnimationLod;
     VoxelSvoConfig svoVoxel;
     bool profilingEnabled = false;
 };
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Rigel/Persistence/Storage.h"
+#include "Rigel/Voxel/ChunkTasks.h"
+#include "Rigel/Voxel/VoxelLod/VoxelPageCpu.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Rigel::Voxel {
+
+// Versioned on-disk cache of built far-LOD pages (l0 samples + mip pyramid).
+//
+// One file per page under <rootPath>/<content hash>/<level>/, written atomically.
+// The content hash covers everything that changes what a page samples to (world seed,
+// generator version and config, page layout), so a config or generator change simply
+// misses into a fresh directory. Edits invalidate individual pages through invalidate().
+//
+// invalidate() never touches storage on the calling thread: the page is tombstoned in
+// memory (load() misses it) and its file is removed on the cache's own IO thread.
+// All methods are safe to call from build workers. A store() racing an invalidate()
+// of the same page never leaves the pre-invalidation data on disk.
+class VoxelPageDiskCache {
+public:
+    static constexpr uint32_t kMagic = 0x43505652; // "RVPC"
+    static constexpr uint16_t kFormatVersion = 1;
+
+    // Bound on remembered invalidations; past it every store captured earlier is dropped.
+    static constexpr size_t kMaxTrackedInvalidations = 4096;
+
+    VoxelPageDiskCache(std::shared_ptr<Persistence::StorageBackend> storage,
+                       std::string rootPath,
+                       uint64_t contentHash);
+    ~VoxelPageDiskCache();
+
+    VoxelPageDiskCache(const VoxelPageDiskCache&) = delete;
+    VoxelPageDiskCache& operator=(const VoxelPageDiskCache&) = delete;
+
+    static uint64_t makeContentHash(uint32_t worldSeed,
+                                    uint32_t generatorVersion,
+                                    uint64_t generatorConfigHash,
+                                    int pageSizeVoxels);
+
+    uint64_t contentHash() const { return m_contentHash; }
+    std::string pagePath(const VoxelPageKey& key) const;
+
+    // Returns false on miss, version/hash mismatch or a corrupt entry (which is removed).
+    bool load(const VoxelPageKey& key, int pageSizeVoxels, VoxelPageCpu& out) const;
+
+    // Capture before sampling a page and pass to store(); invalidations in between
+    // make the store a no-op.
+    uint64_t generation(const VoxelPageKey& key) const;
+    bool store(const VoxelPageCpu& page, uint64_t generation);
+    void invalidate(const VoxelPageKey& key);
+
+    // Blocks until every removal queued by invalidate() has reached storage.
+    void flush();
+
+private:
+    bool generationMatches(const VoxelPageKey& key, uint64_t generation) const;
+    bool isTombstoned(const VoxelPageKey& key) const;
+    void removeQuietly(const std::string& path) const;
+
+    std::shared_ptr<Persistence::StorageBackend> m_storage;
+    std::string m_rootPath;
+    uint64_t m_contentHash = 0;
+
+    mutable std::mutex m_generationMutex;
+    uint64_t m_epoch = 0;
+    // Stores captured before this epoch are rejected; raised when m_invalidated is pruned.
+    uint64_t m_floorEpoch = 0;
+    std::unordered_map<VoxelPageKey, uint64_t, VoxelPageKeyHash> m_invalidated;
+    // Pages with removals still queued, by count; load() misses them.
+    std::unordered_map<VoxelPageKey, uint32_t, VoxelPageKeyHash> m_tombstones;
+
+    // Declared last so queued removals drain before the rest of the cache goes away.
+    detail::ThreadPool m_io{1};
+};
+
+} // namespace Rigel::Voxel
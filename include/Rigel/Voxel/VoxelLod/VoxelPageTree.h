@@ -2,7 +2,7 @@
 
 #include "Rigel/Voxel/VoxelLod/VoxelPageCpu.h"
 
-#include <array>
+#include <bit>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -23,6 +23,9 @@ enum class VoxelMaterialClass : uint8_t {
     Transparent = 3,
 };
 
+// Nodes are stored depth-first: a Mixed node's present children occupy one contiguous block
+// (in child-slot order) located `childOffset` entries after the node itself, and each child's
+// own block follows later in the array.
 struct VoxelSvoNode {
     static constexpr uint32_t kInvalidChild = std::numeric_limits<uint32_t>::max();
 
@@ -30,13 +33,11 @@ struct VoxelSvoNode {
     VoxelMaterialClass materialClass = VoxelMaterialClass::Air;
     VoxelId materialId = 0;
     uint16_t leafSizeVoxels = 0; // power-of-two in L0 voxels for leaf nodes
-    uint8_t childMask = 0; // bit i set when children[i] is valid
-    std::array<uint32_t, 8> children = {
-        kInvalidChild, kInvalidChild, kInvalidChild, kInvalidChild,
-        kInvalidChild, kInvalidChild, kInvalidChild, kInvalidChild
-    };
+    uint8_t childMask = 0; // bit i set when child slot i is present
+    uint32_t childOffset = 0; // Mixed only: relative index of the first present child
 
     bool isLeaf() const { return kind != VoxelSvoNodeKind::Mixed; }
+    int childCount() const { return std::popcount(static_cast<unsigned>(childMask)); }
 };
 
 struct VoxelPageTree {
@@ -47,7 +48,19 @@ struct VoxelPageTree {
     std::vector<VoxelSvoNode> nodes;
 
     bool empty() const { return nodes.empty() || root == VoxelSvoNode::kInvalidChild; }
-    size_t cpuBytes() const { return nodes.size() * sizeof(VoxelSvoNode); }
+    size_t cpuBytes() const { return nodes.capacity() * sizeof(VoxelSvoNode); }
+
+    // Absolute index of child slot `slot` (0..7, bit0=x, bit1=y, bit2=z) of `nodeIndex`,
+    // or kInvalidChild when that slot is absent.
+    uint32_t childIndex(uint32_t nodeIndex, int slot) const {
+        const VoxelSvoNode& node = nodes[nodeIndex];
+        const unsigned bit = 1u << slot;
+        if ((node.childMask & bit) == 0) {
+            return VoxelSvoNode::kInvalidChild;
+        }
+        const unsigned before = static_cast<unsigned>(node.childMask) & (bit - 1u);
+        return nodeIndex + node.childOffset + static_cast<uint32_t>(std::popcount(before));
+    }
 };
 
 using VoxelMaterialClassifier = std::function<VoxelMaterialClass(VoxelId)>;
@@ -60,6 +73,10 @@ using VoxelMaterialClassifier = std::function<VoxelMaterialClass(VoxelId)>;
 //
 // Empty regions are omitted from the tree (except when the entire page is empty, in which case the
 // root is a single Empty leaf).
+//
+// The builder reads only the mip pyramid: occupancy is resolved bottom-up from the uniform bits,
+// uniform subtrees are emitted as a single leaf and never descended, and the node array is
+// allocated once at its exact final size.
 VoxelPageTree buildVoxelPageTree(const VoxelPageCpu& page,
                                  int minLeafVoxels,
                                  const VoxelMaterialClassifier& classify);
@@ -11,6 +11,24 @@
 
 namespace Rigel::Voxel {
 
+// Greedy quads of one page, placed in a page cluster.
+//
+// `cellOffset` is the page origin in cluster-local macro cells
+// (page offset in pages * macro cells per page edge).
+struct SurfaceQuadPage {
+    glm::ivec3 cellOffset{0};
+    std::span<const SurfaceQuad> quads;
+};
+
+// Merge coplanar, same-material quads across page boundaries.
+//
+// Per-page greedy extraction cannot merge past its own grid, so large flat surfaces
+// (oceans, plains) are split at every page seam. This re-runs the greedy 2D merge per
+// face plane over the union of all pages and appends the result to `out`, in
+// cluster-local macro cells. Covered area and materials are preserved exactly.
+void mergeSurfaceQuadsAcrossPages(std::span<const SurfaceQuadPage> pages,
+                                  std::vector<SurfaceQuad>& out);
+
 // Build a ChunkMesh (opaque-only for now) from macro surface quads.
 //
 // Vertex positions are emitted in *page-local voxel coordinates*; the caller is
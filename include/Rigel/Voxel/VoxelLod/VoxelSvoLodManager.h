@@ -8,7 +8,9 @@
 #include "Rigel/Voxel/VoxelLod/GeneratorSource.h"
 #include "Rigel/Voxel/VoxelLod/VoxelSource.h"
 #include "Rigel/Voxel/VoxelLod/VoxelPageCpu.h"
+#include "Rigel/Voxel/VoxelLod/VoxelPageDiskCache.h"
 #include "Rigel/Voxel/VoxelLod/VoxelPageTree.h"
+#include "Rigel/Voxel/VoxelLod/VoxelSurfaceExtraction.h"
 
 #include <glm/vec3.hpp>
 #include <array>
@@ -36,6 +38,8 @@ struct VoxelSvoTelemetry {
     uint64_t persistenceHits = 0;
     uint64_t generatorHits = 0;
     uint64_t mipBuildMicros = 0;
+    uint64_t diskCacheHits = 0;
+    uint64_t diskCacheWrites = 0;
     uint32_t activePages = 0;
     uint32_t pagesQueued = 0;
     uint32_t pagesBuilding = 0;
@@ -45,11 +49,14 @@ struct VoxelSvoTelemetry {
     uint32_t evictedQueued = 0;
     uint32_t evictedReadyCpu = 0;
     uint32_t evictedReadyMesh = 0;
+    uint32_t buildsInFlight = 0;
+    uint32_t buildsCancelled = 0;
     uint32_t meshBlockedMissingNeighbors = 0;
     uint32_t meshBlockedLeafMismatch = 0;
     uint32_t desiredVisibleCount = 0;
     uint32_t desiredBuildCount = 0;
     uint32_t visibleReadyMeshCount = 0;
+    uint32_t activeClusters = 0;
     std::array<uint32_t, 16> readyCpuPagesPerLevel{};
     std::array<uint64_t, 16> readyCpuNodesPerLevel{};
     uint64_t cpuBytesCurrent = 0;
@@ -88,6 +95,9 @@ public:
         uint64_t revision = 0;
         glm::vec3 worldMin{0.0f};
         const ChunkMesh* mesh = nullptr;
+        // Pages per edge covered by this mesh. Cluster meshes (> 1) are keyed by
+        // their min-corner page and replace all member page meshes.
+        int spanPages = 1;
     };
 
     void setConfig(const VoxelSvoConfig& config);
@@ -96,7 +106,11 @@ public:
     void setBuildThreads(size_t threadCount);
     void setChunkGenerator(GeneratorSource::ChunkGenerateCallback generator);
     void setPersistenceSource(std::shared_ptr<const IVoxelSource> source);
+    // Optional: restore built pages from disk instead of resampling them.
+    void setPageCache(std::shared_ptr<VoxelPageDiskCache> cache);
     void invalidateChunk(ChunkCoord coord);
+    // Drops disk-cached pages covering a chunk; call for block edits only.
+    void invalidateCachedPages(ChunkCoord coord);
 
     void bind(const ChunkManager* chunkManager,
               const BlockRegistry* registry,
@@ -126,6 +140,7 @@ private:
         uint64_t lastTouchedFrame = 0;
         uint64_t lastVisibleFrame = 0;
         uint64_t lastBuildFrame = 0;
+        float buildScore = 0.0f; // Squared camera distance of an in-flight build; lower is better.
         bool desiredVisible = false;
         bool desiredBuild = false;
         bool meshQueued = false;
@@ -135,6 +150,18 @@ private:
         VoxelPageCpu cpu;
         VoxelPageTree tree;
         ChunkMesh mesh;
+        std::vector<SurfaceQuad> quads; // Greedy quads, merged by page clusters.
+    };
+
+    // Cross-page merged mesh for clusterPages^3 pages of one level.
+    struct ClusterRecord {
+        VoxelPageKey key{}; // Cluster coordinates: page coordinates floor-divided by clusterPages.
+        uint64_t meshSignature = 0;
+        uint64_t queuedSignature = 0;
+        uint64_t revision = 0;
+        bool queued = false;
+        bool active = false;
+        ChunkMesh mesh;
     };
 
     struct PageBuildOutput {
@@ -147,6 +174,8 @@ private:
         uint64_t persistenceHits = 0;
         uint64_t generatorHits = 0;
         uint64_t mipBuildMicros = 0;
+        bool diskCacheHit = false;
+        bool diskCacheWrite = false;
         VoxelPageCpu cpu;
         VoxelPageTree tree;
     };
@@ -155,6 +184,13 @@ private:
         VoxelPageKey key{};
         uint64_t revision = 0;
         ChunkMesh mesh;
+        std::vector<SurfaceQuad> quads;
+    };
+
+    struct ClusterBuildOutput {
+        VoxelPageKey key{};
+        uint64_t signature = 0;
+        ChunkMesh mesh;
     };
 
     static VoxelSvoConfig sanitizeConfig(VoxelSvoConfig config);
@@ -163,16 +199,29 @@ private:
     void processMeshCompletions();
     void seedDesiredPages(const glm::vec3& cameraPos);
     void enqueueBuild(const VoxelPageKey& key, uint64_t revision);
+    void rescoreInFlightBuilds(const glm::vec3& cameraPos);
+    bool preemptWorstBuild(float candidateScore);
+    size_t maxInFlightBuilds() const;
     void enqueueMeshBuilds();
     bool canMeshPage(const VoxelPageKey& key,
                      uint16_t cellSizeVoxels,
                      bool* outMissingNeighbors = nullptr,
                      bool* outLeafMismatch = nullptr) const;
     void queueMissingNeighborsForMesh(const VoxelPageKey& key);
+    void processClusterCompletions();
+    void updatePageClusters();
+    bool clusterSignature(const VoxelPageKey& clusterKey,
+                          uint64_t* outSignature,
+                          uint16_t* outCellSizeVoxels) const;
+    VoxelPageKey clusterKeyForPage(const VoxelPageKey& key) const;
+    const ClusterRecord* findActiveCluster(const VoxelPageKey& pageKey) const;
     void enforcePageLimit(const glm::vec3& cameraPos);
     void rebuildFaceTextureLayers();
     static uint64_t estimatePageCpuBytes(const PageRecord& record);
     static uint64_t estimatePageGpuBytes(const PageRecord& record);
+    static uint64_t estimateClusterCpuBytes(const ClusterRecord& cluster);
+    static uint64_t estimateClusterGpuBytes(const ClusterRecord& cluster);
+    bool pageNeedsQuads(const PageRecord& record) const;
     PageRecord* findPage(const VoxelPageKey& key);
     const PageRecord* findPage(const VoxelPageKey& key) const;
 
@@ -184,10 +233,14 @@ private:
     size_t m_buildThreads = 1;
     GeneratorSource::ChunkGenerateCallback m_chunkGenerator;
     std::shared_ptr<const IVoxelSource> m_persistenceSource;
+    std::shared_ptr<VoxelPageDiskCache> m_pageCache;
     std::unique_ptr<detail::ThreadPool> m_buildPool;
     detail::ConcurrentQueue<PageBuildOutput> m_buildComplete;
     detail::ConcurrentQueue<MeshBuildOutput> m_meshBuildComplete;
+    detail::ConcurrentQueue<ClusterBuildOutput> m_clusterBuildComplete;
     std::unordered_map<VoxelPageKey, PageRecord, VoxelPageKeyHash> m_pages;
+    std::unordered_map<VoxelPageKey, ClusterRecord, VoxelPageKeyHash> m_clusters;
+    uint64_t m_clusterRevisionCounter = 0;
     std::deque<VoxelPageKey> m_buildQueue;
     std::unordered_set<VoxelPageKey, VoxelPageKeyHash> m_buildQueued;
     std::vector<std::array<uint16_t, DirectionCount>> m_faceTextureLayers;
@@ -196,6 +249,9 @@ private:
     bool m_hasSeedAnchor = false;
     uint32_t m_seedHoldFrames = 0;
     glm::vec3 m_lastCameraPos{0.0f};
+    glm::ivec3 m_lastScoreAnchor{0};
+    bool m_hasScoreAnchor = false;
+    size_t m_buildsInFlight = 0;
     bool m_initialized = false;
 };
 
@@ -151,6 +151,7 @@ struct WorldGenConfig {
         int loadRegionDrainBudget = 32;
         int loadQueueLimit = 0;
         int loadMaxCachedRegions = 8;
+        int loadMaxCachedMegabytes = 256;  // 0 = no byte cap
         int loadMaxInFlightRegions = 8;
         int loadPrefetchRadius = 1;
         int loadPrefetchPerRequest = 12;
@@ -177,6 +178,10 @@ struct WorldGenConfig {
     void applyYaml(const char* sourceName, const std::string& yaml);
     bool isStageEnabled(const std::string& stage) const;
     bool isFlagEnabled(const std::string& name) const;
+
+    /// Hash of every field that changes generated blocks (all but stream settings
+    /// and overlay sources, whose effect is already folded into the other fields).
+    uint64_t generationHash() const;
 };
 
 } // namespace Rigel::Voxel
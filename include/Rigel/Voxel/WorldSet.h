@@ -45,7 +45,7 @@ public:
     const Persistence::PersistenceService& persistenceService() const { return m_persistenceService; }
 
     void setPersistenceRoot(std::string rootPath) { m_persistenceRoot = std::move(rootPath); }
-    void setPersistenceStorage(std::shared_ptr<Persistence::StorageBackend> storage) { m_persistenceStorage = std::move(storage); }
+    void setPersistenceStorage(std::shared_ptr<Persistence::StorageBackend> storage);
     void setPersistencePolicies(Persistence::PersistencePolicies policies) { m_persistencePolicies = std::move(policies); }
     void setPersistencePreferredFormat(std::string formatId) { m_persistencePreferredFormat = std::move(formatId); }
     void setPersistenceZoneId(std::string zoneId) { m_persistenceZoneId = std::move(zoneId); }
@@ -65,6 +65,7 @@ public:
     void setChunkLoadDrain(ChunkStreamer::ChunkLoadDrainCallback drain);
     void setChunkLoadCancel(ChunkStreamer::ChunkLoadCancelCallback cancel);
     void setVoxelPersistenceSource(std::shared_ptr<const IVoxelSource> source);
+    void setVoxelPageCache(std::shared_ptr<VoxelPageDiskCache> cache);
     void invalidateVoxelSvoChunk(ChunkCoord coord);
     void setStreamConfig(const WorldGenConfig::StreamConfig& config);
     void setBenchmark(ChunkBenchmarkStats* stats);
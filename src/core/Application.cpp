@@ -14,6 +14,7 @@
 #include "Rigel/Voxel/WorldSet.h"
 #include "Rigel/Voxel/WorldConfigProvider.h"
 #include "Rigel/Persistence/WorldPersistence.h"
+#include "Rigel/Persistence/WorldSaveService.h"
 #include "Rigel/Render/DebugOverlay.h"
 #include "Rigel/Voxel/WorldConfigBootstrap.h"
 #include "Rigel/Voxel/WorldSpawn.h"
@@ -147,6 +148,7 @@ struct Application::Impl {
         Voxel::World* world = nullptr;
         Voxel::WorldView* worldView = nullptr;
         std::shared_ptr<Persistence::AsyncChunkLoader> chunkLoader;
+        std::unique_ptr<Persistence::WorldSaveService> saveService;
         bool debugBlockCatalogEnabled = false;
         bool ready = false;
         Voxel::BlockID placeBlock = Voxel::BlockRegistry::airId();
@@ -546,6 +548,8 @@ Application::Application() : m_impl(std::make_unique<Impl>()) {
         if (const auto* provider = persistenceConfig.findProvider(Persistence::Backends::CR::kCRSettingsProviderId)) {
             auto crSettings = std::make_shared<Persistence::Backends::CR::CRPersistenceSettings>();
             crSettings->enableLz4 = provider->getBool("lz4", crSettings->enableLz4);
+            crSettings->columnFrames = provider->getBool("column_frames", crSettings->columnFrames);
+            crSettings->lz4Dictionary = provider->getBool("lz4_dictionary", crSettings->lz4Dictionary);
             m_impl->world.world->persistenceProviders().add(
                 Persistence::Backends::CR::kCRSettingsProviderId,
                 crSettings);
@@ -559,6 +563,10 @@ Application::Application() : m_impl(std::make_unique<Impl>()) {
 
         Persistence::PersistenceContext persistenceContext =
             m_impl->world.worldSet.persistenceContext(m_impl->world.activeWorldId);
+        // Finish or roll back autosave batches cut short by a crash before anything reads regions.
+        if (persistenceContext.storage) {
+            persistenceContext.storage->recoverBatches(persistenceContext.rootPath);
+        }
         if (Core::shouldLoadWorldFromDisk(m_impl->world.debugBlockCatalogEnabled)) {
             Persistence::loadWorldFromDisk(
                 *m_impl->world.world,
@@ -593,6 +601,8 @@ Application::Application() : m_impl(std::make_unique<Impl>()) {
                 static_cast<size_t>(std::max(0, config.stream.loadRegionDrainBudget)));
             m_impl->world.chunkLoader->setMaxCachedRegions(
                 static_cast<size_t>(std::max(0, config.stream.loadMaxCachedRegions)));
+            m_impl->world.chunkLoader->setMaxCachedBytes(
+                static_cast<size_t>(std::max(0, config.stream.loadMaxCachedMegabytes)) * 1024u * 1024u);
             m_impl->world.chunkLoader->setMaxInFlightRegions(
                 static_cast<size_t>(std::max(0, config.stream.loadMaxInFlightRegions)));
             m_impl->world.chunkLoader->setPrefetchRadius(
@@ -631,6 +641,21 @@ Application::Application() : m_impl(std::make_unique<Impl>()) {
             m_impl->world.worldView->setChunkLoadDrain({});
             m_impl->world.worldView->setChunkLoadCancel({});
         }
+        if (Core::shouldSaveWorldToDisk(m_impl->world.debugBlockCatalogEnabled) &&
+            persistenceConfig.autosave.enabled) {
+            m_impl->world.saveService = std::make_unique<Persistence::WorldSaveService>(
+                m_impl->world.worldSet.persistenceService(),
+                m_impl->world.worldSet.persistenceContext(m_impl->world.activeWorldId),
+                *m_impl->world.world,
+                static_cast<size_t>(std::max(0, persistenceConfig.autosave.ioThreads)));
+            m_impl->world.saveService->setConfig(persistenceConfig.autosave);
+            m_impl->world.saveService->setRegionSavedCallback(
+                [loader = m_impl->world.chunkLoader](const Persistence::RegionKey& key) {
+                    if (loader) {
+                        loader->invalidateRegion(key);
+                    }
+                });
+        }
         if (Core::shouldWireVoxelPersistenceSource(m_impl->world.debugBlockCatalogEnabled)) {
             auto persistenceSource = std::make_shared<Voxel::PersistenceSource>(
                 &m_impl->world.worldSet.persistenceService(),
@@ -657,6 +682,23 @@ Application::Application() : m_impl(std::make_unique<Impl>()) {
         }
         m_impl->world.worldView->setRenderConfig(renderConfig);
         Core::Profiler::setEnabled(renderConfig.profilingEnabled);
+        if (renderConfig.svoVoxel.diskCache &&
+            Core::shouldWireVoxelPersistenceSource(m_impl->world.debugBlockCatalogEnabled)) {
+            Persistence::PersistenceContext cacheContext =
+                m_impl->world.worldSet.persistenceContext(m_impl->world.activeWorldId);
+            if (cacheContext.storage) {
+                m_impl->world.worldView->setVoxelPageCache(std::make_shared<Voxel::VoxelPageDiskCache>(
+                    cacheContext.storage,
+                    cacheContext.rootPath + "/lod_cache",
+                    Voxel::VoxelPageDiskCache::makeContentHash(
+                        config.seed,
+                        worldGenVersion,
+                        generator->config().generationHash(),
+                        renderConfig.svoVoxel.pageSizeVoxels)));
+            }
+        } else {
+            m_impl->world.worldView->setVoxelPageCache({});
+        }
         m_impl->world.worldView->setStreamConfig(config.stream);
         if (m_impl->timing.benchmarkEnabled) {
             m_impl->world.worldView->setBenchmark(&m_impl->timing.benchmark);
@@ -702,6 +744,11 @@ Application::~Application() {
     if (m_impl && m_impl->world.ready && m_impl->world.world &&
         Core::shouldSaveWorldToDisk(m_impl->world.debugBlockCatalogEnabled)) {
         try {
+            // Autosave has already written most edits; flush the rest on its IO pool so
+            // the full save below only has entities and metadata left to write.
+            if (m_impl->world.saveService) {
+                m_impl->world.saveService->flush();
+            }
             Persistence::saveWorldToDisk(
                 *m_impl->world.world,
                 m_impl->world.worldSet.persistenceService(),
@@ -733,6 +780,7 @@ Application::~Application() {
             m_impl->world.worldView->setChunkLoadDrain({});
             m_impl->world.worldView->setChunkLoadCancel({});
         }
+        m_impl->world.saveService.reset();
         m_impl->world.chunkLoader.reset();
 
         if (m_impl->world.worldView) {
@@ -875,6 +923,9 @@ void Application::run() {
                     PROFILE_SCOPE("Streaming");
                     {
                         PROFILE_SCOPE("Streaming/Update");
+                        if (m_impl->world.chunkLoader) {
+                            m_impl->world.chunkLoader->updateViewer(m_impl->camera.position, deltaTime);
+                        }
                         m_impl->world.worldView->updateStreaming(m_impl->camera.position);
                     }
                     {
@@ -883,6 +934,10 @@ void Application::run() {
                     }
                 }
 
+                if (m_impl->world.saveService) {
+                    m_impl->world.saveService->update();
+                }
+
                 {
                     PROFILE_SCOPE("Render");
                     m_impl->world.worldView->render(view, projection, m_impl->camera.position,
@@ -922,7 +977,8 @@ void Application::run() {
                     UI::renderProfilerWindow(
                         m_impl->debug.imguiEnabled,
                         &m_impl->world.worldView->svoVoxelConfig(),
-                        &m_impl->world.worldView->svoVoxelTelemetry()
+                        &m_impl->world.worldView->svoVoxelTelemetry(),
+                        m_impl->world.saveService ? &m_impl->world.saveService->metrics() : nullptr
                     );
 #else
                     (void)width;
@@ -1,6 +1,7 @@
 #include "Rigel/Entity/Entity.h"
 
 #include "Rigel/Entity/EntityUtils.h"
+#include "Rigel/Entity/VoxelCollision.h"
 #include "Rigel/Voxel/World.h"
 
 #include <algorithm>
@@ -10,57 +11,7 @@
 namespace Rigel::Entity {
 
 namespace {
-constexpr float kEpsilon = 1.0e-4f;
-
-bool isSolidAt(Voxel::World& world, int x, int y, int z) {
-    Voxel::BlockState state = world.getBlock(x, y, z);
-    if (state.isAir()) {
-        return false;
-    }
-    return world.blockRegistry().getType(state.id).isSolid;
-}
-
-struct AxisRange {
-    int min = 0;
-    int max = 0;
-};
-
-AxisRange toBlockRange(float minCoord, float maxCoord) {
-    int minBlock = static_cast<int>(std::floor(minCoord));
-    int maxBlock = static_cast<int>(std::floor(maxCoord - kEpsilon));
-    if (maxBlock < minBlock) {
-        maxBlock = minBlock;
-    }
-    return {minBlock, maxBlock};
-}
-
-bool intersectsSolidBlocks(Voxel::World& world, const Aabb& box) {
-    AxisRange xRange = toBlockRange(box.min.x, box.max.x);
-    AxisRange yRange = toBlockRange(box.min.y, box.max.y);
-    AxisRange zRange = toBlockRange(box.min.z, box.max.z);
-
-    for (int bx = xRange.min; bx <= xRange.max; ++bx) {
-        for (int by = yRange.min; by <= yRange.max; ++by) {
-            for (int bz = zRange.min; bz <= zRange.max; ++bz) {
-                if (!isSolidAt(world, bx, by, bz)) {
-                    continue;
-                }
-                Aabb block{
-                    glm::vec3(static_cast<float>(bx),
-                              static_cast<float>(by),
-                              static_cast<float>(bz)),
-                    glm::vec3(static_cast<float>(bx + 1),
-                              static_cast<float>(by + 1),
-                              static_cast<float>(bz + 1))
-                };
-                if (box.intersects(block)) {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
-}
+constexpr float kEpsilon = kCollisionEpsilon;
 
 float axisValue(const glm::vec3& value, Axis axis) {
     switch (axis) {
@@ -79,7 +30,7 @@ void setAxisValue(glm::vec3& value, Axis axis, float axisValue) {
     }
 }
 
-void resolveAxis(Voxel::World& world,
+void resolveAxis(const VoxelCollisionQuery& query,
                  const Aabb& localBounds,
                  glm::vec3& position,
                  glm::vec3& velocity,
@@ -92,99 +43,9 @@ void resolveAxis(Voxel::World& world,
         return;
     }
 
-    glm::vec3 testPos = position;
-    setAxisValue(testPos, axis, axisValue(position, axis) + delta);
-    Aabb moved = localBounds.translated(testPos);
-
-    AxisRange xRange = toBlockRange(moved.min.x, moved.max.x);
-    AxisRange yRange = toBlockRange(moved.min.y, moved.max.y);
-    AxisRange zRange = toBlockRange(moved.min.z, moved.max.z);
-
     bool hit = false;
-    float resolved = axisValue(testPos, axis);
-    if (delta > 0.0f) {
-        float maxAllowed = resolved;
-        for (int bx = xRange.min; bx <= xRange.max; ++bx) {
-            for (int by = yRange.min; by <= yRange.max; ++by) {
-                for (int bz = zRange.min; bz <= zRange.max; ++bz) {
-                    if (!isSolidAt(world, bx, by, bz)) {
-                        continue;
-                    }
-                    Aabb block{
-                        glm::vec3(static_cast<float>(bx),
-                                  static_cast<float>(by),
-                                  static_cast<float>(bz)),
-                        glm::vec3(static_cast<float>(bx + 1),
-                                  static_cast<float>(by + 1),
-                                  static_cast<float>(bz + 1))
-                    };
-                    if (!moved.intersects(block)) {
-                        continue;
-                    }
-                    float candidate = 0.0f;
-                    switch (axis) {
-                        case Axis::X:
-                            candidate = block.min.x - localBounds.max.x - kEpsilon;
-                            break;
-                        case Axis::Y:
-                            candidate = block.min.y - localBounds.max.y - kEpsilon;
-                            break;
-                        case Axis::Z:
-                            candidate = block.min.z - localBounds.max.z - kEpsilon;
-                            break;
-                    }
-                    maxAllowed = std::min(maxAllowed, candidate);
-                    hit = true;
-                }
-            }
-        }
-        if (hit) {
-            setAxisValue(position, axis, maxAllowed);
-        } else {
-            setAxisValue(position, axis, resolved);
-        }
-    } else {
-        float minAllowed = resolved;
-        for (int bx = xRange.min; bx <= xRange.max; ++bx) {
-            for (int by = yRange.min; by <= yRange.max; ++by) {
-                for (int bz = zRange.min; bz <= zRange.max; ++bz) {
-                    if (!isSolidAt(world, bx, by, bz)) {
-                        continue;
-                    }
-                    Aabb block{
-                        glm::vec3(static_cast<float>(bx),
-                                  static_cast<float>(by),
-                                  static_cast<float>(bz)),
-                        glm::vec3(static_cast<float>(bx + 1),
-                                  static_cast<float>(by + 1),
-                                  static_cast<float>(bz + 1))
-                    };
-                    if (!moved.intersects(block)) {
-                        continue;
-                    }
-                    float candidate = 0.0f;
-                    switch (axis) {
-                        case Axis::X:
-                            candidate = block.max.x - localBounds.min.x + kEpsilon;
-                            break;
-                        case Axis::Y:
-                            candidate = block.max.y - localBounds.min.y + kEpsilon;
-                            break;
-                        case Axis::Z:
-                            candidate = block.max.z - localBounds.min.z + kEpsilon;
-                            break;
-                    }
-                    minAllowed = std::max(minAllowed, candidate);
-                    hit = true;
-                }
-            }
-        }
-        if (hit) {
-            setAxisValue(position, axis, minAllowed);
-        } else {
-            setAxisValue(position, axis, resolved);
-        }
-    }
+    float allowed = query.sweep(localBounds.translated(position), axis, delta, hit);
+    setAxisValue(position, axis, axisValue(position, axis) + allowed);
 
     if (hit) {
         collided = true;
@@ -208,12 +69,23 @@ void Entity::setPosition(const glm::vec3& pos) {
     m_position = pos;
     m_lastPosition = pos;
     updateWorldBounds();
+    wake();
 }
 
 void Entity::setPosition(float x, float y, float z) {
     setPosition(glm::vec3(x, y, z));
 }
 
+void Entity::applyImpulse(const glm::vec3& impulse) {
+    m_velocity += impulse;
+    wake();
+}
+
+void Entity::wake() {
+    m_sleeping = false;
+    m_restTicks = 0;
+}
+
 void Entity::setLocalBounds(const Aabb& bounds) {
     m_localBounds = bounds;
     updateWorldBounds();
@@ -256,7 +128,12 @@ void Entity::render(const EntityRenderContext& ctx,
         m_modelInstance->setTint(m_renderTint);
         m_modelInstance->render(ctx, *this, modelMatrix, shouldRender);
     }
+    renderComponents(ctx, modelMatrix, shouldRender);
+}
 
+void Entity::renderComponents(const EntityRenderContext& ctx,
+                              const glm::mat4& modelMatrix,
+                              bool shouldRender) {
     for (IRenderEntityComponent* component : m_renderComponents) {
         if (component) {
             component->render(*this, ctx, modelMatrix, shouldRender);
@@ -309,13 +186,23 @@ void Entity::resolveCollisions(Voxel::World& world, float dt) {
     m_collidedZ = false;
     m_onGround = false;
 
-    resolveAxis(world, m_localBounds, m_position, m_velocity, Axis::X, dt, m_collidedX, m_onGround);
-    resolveAxis(world, m_localBounds, m_position, m_velocity, Axis::Y, dt, m_collidedY, m_onGround);
-    resolveAxis(world, m_localBounds, m_position, m_velocity, Axis::Z, dt, m_collidedZ, m_onGround);
+    // One lookup of the covering subchunks for the whole move: the start box
+    // stretched by this step's travel, plus room for the ground probe.
+    const Aabb start = m_localBounds.translated(m_position);
+    const glm::vec3 travel = m_velocity * dt;
+    const glm::vec3 margin(kEpsilon * 4.0f);
+    const VoxelCollisionQuery query(
+        world,
+        Aabb{glm::min(start.min, start.min + travel) - margin,
+             glm::max(start.max, start.max + travel) + margin});
+
+    resolveAxis(query, m_localBounds, m_position, m_velocity, Axis::X, dt, m_collidedX, m_onGround);
+    resolveAxis(query, m_localBounds, m_position, m_velocity, Axis::Y, dt, m_collidedY, m_onGround);
+    resolveAxis(query, m_localBounds, m_position, m_velocity, Axis::Z, dt, m_collidedZ, m_onGround);
 
     if (!m_onGround) {
         Aabb probe = m_localBounds.translated(m_position + glm::vec3(0.0f, -kEpsilon * 2.0f, 0.0f));
-        if (intersectsSolidBlocks(world, probe)) {
+        if (query.intersectsSolid(probe)) {
             m_onGround = true;
         }
     }
@@ -337,6 +224,14 @@ void Entity::update(Voxel::World& world, float dt) {
         component->update(world, *this, dt);
     }
 
+    const glm::vec3 input = m_acceleration;
+    if (m_sleeping) {
+        if (glm::dot(input, input) == 0.0f && glm::dot(m_velocity, m_velocity) == 0.0f) {
+            return;
+        }
+        wake();
+    }
+
     if (!isNoClip()) {
         m_acceleration += glm::vec3(0.0f, -29.4f, 0.0f) * m_gravityModifier;
     }
@@ -349,6 +244,18 @@ void Entity::update(Voxel::World& world, float dt) {
     }
 
     m_acceleration = glm::vec3(0.0f);
+
+    const float sleepSpeedSq = m_sleepSpeed * m_sleepSpeed;
+    const glm::vec3 inputStep = input * dt;
+    const bool resting = m_onGround && !isNoClip() && !hasTag(EntityTags::NoSleep) &&
+        glm::dot(m_velocity, m_velocity) < sleepSpeedSq &&
+        glm::dot(inputStep, inputStep) < sleepSpeedSq;
+    if (!resting) {
+        m_restTicks = 0;
+    } else if (++m_restTicks >= m_sleepDelayTicks) {
+        m_sleeping = true;
+        m_velocity = glm::vec3(0.0f);
+    }
 }
 
 } // namespace Rigel::Entity
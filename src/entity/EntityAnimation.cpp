@@ -19,6 +19,15 @@ float clampTime(float time, bool loop, float duration) {
     }
     return std::clamp(time, 0.0f, duration);
 }
+
+glm::vec3 interpolate(const EntityKeyframe& lower, const EntityKeyframe& upper, float t) {
+    float span = upper.time - lower.time;
+    if (span <= 0.0f) {
+        return upper.value;
+    }
+    float alpha = (t - lower.time) / span;
+    return lower.value + (upper.value - lower.value) * alpha;
+}
 } // namespace
 
 glm::vec3 EntityAnimationTrack::sample(float time,
@@ -49,12 +58,43 @@ glm::vec3 EntityAnimationTrack::sample(float time,
     }
 
     auto lower = upper - 1;
-    float span = upper->time - lower->time;
-    if (span <= 0.0f) {
-        return upper->value;
+    return interpolate(*lower, *upper, t);
+}
+
+glm::vec3 EntityAnimationTrack::sample(float time,
+                                       bool loop,
+                                       float duration,
+                                       const glm::vec3& defaultValue,
+                                       EntityTrackCursor& cursor) const {
+    if (keys.size() < 2) {
+        return sample(time, loop, duration, defaultValue);
+    }
+
+    float t = clampTime(time, loop, duration);
+    if (t <= keys.front().time) {
+        cursor.key = 0;
+        return keys.front().value;
+    }
+    if (t >= keys.back().time) {
+        cursor.key = static_cast<uint32_t>(keys.size() - 1);
+        return keys.back().value;
+    }
+
+    // keys.front().time < t < keys.back().time, so the walk stops before the last key.
+    size_t lower = cursor.key;
+    if (lower >= keys.size() || keys[lower].time > t) {
+        auto upper = std::upper_bound(
+            keys.begin(), keys.end(), t,
+            [](float value, const EntityKeyframe& frame) { return value < frame.time; }
+        );
+        lower = static_cast<size_t>(upper - keys.begin()) - 1;
+    } else {
+        while (keys[lower + 1].time <= t) {
+            ++lower;
+        }
     }
-    float alpha = (t - lower->time) / span;
-    return lower->value + (upper->value - lower->value) * alpha;
+    cursor.key = static_cast<uint32_t>(lower);
+    return interpolate(keys[lower], keys[lower + 1], t);
 }
 
 const EntityBoneAnimation* EntityAnimation::findBone(std::string_view name) const {
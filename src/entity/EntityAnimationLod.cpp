@@ -0,0 +1,38 @@
+#include "Rigel/Entity/EntityAnimationLod.h"
+
+#include <algorithm>
+
+namespace Rigel::Entity {
+
+EntityAnimationLod selectAnimationLod(const Voxel::EntityAnimationLodConfig& config, float distance) {
+    EntityAnimationLod lod;
+    if (!config.enabled || distance < config.fullDistance) {
+        return lod;
+    }
+    if (distance < config.reducedDistance) {
+        lod.updateInterval = static_cast<uint32_t>(std::max(config.reducedInterval, 1));
+        lod.maxAnimations = static_cast<size_t>(std::max(config.reducedMaxAnimations, 1));
+        return lod;
+    }
+    // A frozen instance still needs one pose; it is built like a low-tier one.
+    lod.updateInterval = distance >= config.freezeDistance
+        ? 0u
+        : static_cast<uint32_t>(std::max(config.lowInterval, 1));
+    lod.maxAnimations = static_cast<size_t>(std::max(config.lowMaxAnimations, 1));
+    return lod;
+}
+
+void blendPalettes(std::span<const glm::mat4> from,
+                   std::span<const glm::mat4> to,
+                   float alpha,
+                   std::span<glm::mat4> out) {
+    const size_t count = std::min({from.size(), to.size(), out.size()});
+    const float keep = 1.0f - alpha;
+    for (size_t i = 0; i < count; ++i) {
+        for (int column = 0; column < 4; ++column) {
+            out[i][column] = from[i][column] * keep + to[i][column] * alpha;
+        }
+    }
+}
+
+} // namespace Rigel::Entity
@@ -1,7 +1,5 @@
 #include "Rigel/Entity/EntityChunk.h"
 
-#include <algorithm>
-
 namespace Rigel::Entity {
 
 EntityChunk::EntityChunk(Voxel::ChunkCoord coord)
@@ -9,27 +7,32 @@ EntityChunk::EntityChunk(Voxel::ChunkCoord coord)
 {}
 
 void EntityChunk::addEntity(Entity* entity) {
-    if (!entity) {
+    if (!entity || contains(entity)) {
         return;
     }
-    if (std::find(m_entities.begin(), m_entities.end(), entity) == m_entities.end()) {
-        m_entities.push_back(entity);
-        entity->setCurrentChunk(this);
-    }
+    entity->setChunkSlot(static_cast<uint32_t>(m_entities.size()));
+    entity->setCurrentChunk(this);
+    m_entities.push_back(entity);
 }
 
 void EntityChunk::removeEntity(Entity* entity) {
-    if (!entity) {
+    if (!entity || !contains(entity)) {
         return;
     }
-    auto it = std::remove(m_entities.begin(), m_entities.end(), entity);
-    if (it != m_entities.end()) {
-        m_entities.erase(it, m_entities.end());
-    }
+    // Swap-remove: the last entity takes the vacated slot.
+    const uint32_t slot = entity->chunkSlot();
+    Entity* last = m_entities.back();
+    m_entities[slot] = last;
+    last->setChunkSlot(slot);
+    m_entities.pop_back();
 }
 
 bool EntityChunk::contains(Entity* entity) const {
-    return std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end();
+    if (!entity || entity->currentChunk() != this) {
+        return false;
+    }
+    const uint32_t slot = entity->chunkSlot();
+    return slot < m_entities.size() && m_entities[slot] == entity;
 }
 
 void EntityChunk::forEach(const std::function<void(Entity*)>& fn) const {
@@ -16,6 +16,36 @@ const EntityBone* EntityModelAsset::findBone(std::string_view name) const {
     return &bones[it->second];
 }
 
+const EntityAnimationClip* EntityModelAsset::findClip(const EntityAnimation* animation) const {
+    auto it = animationClips.find(animation);
+    if (it == animationClips.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void EntityModelAsset::compileAnimationClips() {
+    animationClips.clear();
+    if (!animationSet) {
+        return;
+    }
+    animationClips.reserve(animationSet->set.animations.size());
+    for (const auto& [name, animation] : animationSet->set.animations) {
+        animationClips.emplace(&animation, compileAnimationClip(animation, bones));
+    }
+}
+
+EntityAnimationClip compileAnimationClip(const EntityAnimation& animation,
+                                         const std::vector<EntityBone>& bones) {
+    EntityAnimationClip clip;
+    clip.animation = &animation;
+    clip.bones.resize(bones.size(), nullptr);
+    for (size_t i = 0; i < bones.size(); ++i) {
+        clip.bones[i] = animation.findBone(bones[i].name);
+    }
+    return clip;
+}
+
 std::unique_ptr<IEntityModelInstance> EntityModelAsset::createInstance(
     Asset::AssetManager& assets,
     const Asset::Handle<Asset::ShaderAsset>& shader) const {
@@ -6,119 +6,87 @@
 #include <spdlog/spdlog.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <array>
+#include <glm/geometric.hpp>
 #include <algorithm>
-#include <cmath>
 #include <cstddef>
+#include <functional>
+#include <utility>
 
 namespace Rigel::Entity {
 
-namespace {
-constexpr glm::vec3 kCubeCorners[8] = {
-    {-0.5f, -0.5f, -0.5f}, // 000
-    {-0.5f,  0.5f, -0.5f}, // 010
-    { 0.5f, -0.5f, -0.5f}, // 100
-    { 0.5f,  0.5f, -0.5f}, // 110
-    {-0.5f, -0.5f,  0.5f}, // 001
-    {-0.5f,  0.5f,  0.5f}, // 011
-    { 0.5f, -0.5f,  0.5f}, // 101
-    { 0.5f,  0.5f,  0.5f}  // 111
-};
+// The bind mesh of one EntitySkinMesh on the GPU, shared by every GPU-skinned instance
+// drawing it; released with the last of them.
+struct EntitySkinMeshBuffer {
+    std::shared_ptr<const EntitySkinMesh> mesh;
+    GLuint vao = 0;
+    GLuint vbo = 0;
 
-struct FaceUvRect {
-    glm::vec2 a{0.0f};
-    glm::vec2 b{1.0f};
+    ~EntitySkinMeshBuffer();
 };
 
-glm::mat4 rotationYawPitchRoll(const glm::vec3& degrees) {
-    glm::mat4 rot(1.0f);
-    rot = glm::rotate(rot, glm::radians(degrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    rot = glm::rotate(rot, glm::radians(degrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    rot = glm::rotate(rot, glm::radians(degrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    return rot;
-}
+namespace {
 
-void setFaceUv(FaceUvRect& rect, const glm::vec2& uvA, const glm::vec2& uvB,
-               float invW, float invH) {
-    rect.a = glm::vec2(uvA.x * invW, 1.0f - (uvA.y * invH));
-    rect.b = glm::vec2(uvB.x * invW, 1.0f - (uvB.y * invH));
-}
+// Vertex array bound by the current draw state; reset whenever that state is (re)bound.
+GLuint g_boundVao = 0;
 
-void computeFaceUvs(const EntityModelCube& cube,
-                    const EntityModelAsset& model,
-                    std::array<FaceUvRect, 6>& out) {
-    if (!cube.hasUv || model.texWidth <= 0.0f || model.texHeight <= 0.0f) {
-        for (auto& rect : out) {
-            rect = {};
-        }
-        return;
-    }
-
-    float csx = std::floor(cube.size.x);
-    float csy = std::floor(cube.size.y);
-    float csz = std::floor(cube.size.z);
-    float u0 = cube.uv.x;
-    float v0 = cube.uv.y;
-    float invW = 1.0f / model.texWidth;
-    float invH = 1.0f / model.texHeight;
+std::unordered_map<const EntitySkinMesh*, std::weak_ptr<EntitySkinMeshBuffer>>& bindBufferCache() {
+    static std::unordered_map<const EntitySkinMesh*, std::weak_ptr<EntitySkinMeshBuffer>> cache;
+    return cache;
+}
 
-    glm::vec2 uvA;
-    glm::vec2 uvB;
+// Describes EntitySkinVertex to the bound vertex array, reading the bound buffer.
+void setSkinVertexLayout() {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(EntitySkinVertex),
+                          reinterpret_cast<void*>(offsetof(EntitySkinVertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(EntitySkinVertex),
+                          reinterpret_cast<void*>(offsetof(EntitySkinVertex, normal)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(EntitySkinVertex),
+                          reinterpret_cast<void*>(offsetof(EntitySkinVertex, uv)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(EntitySkinVertex),
+                          reinterpret_cast<void*>(offsetof(EntitySkinVertex, bone)));
+}
 
-    // -Z
-    uvB = glm::vec2(u0 + csz, v0 + csz);
-    uvA = uvB + glm::vec2(csx, csy);
-    if (cube.mirror) {
-        uvB = glm::vec2(u0 + csz + csx, v0 + csz);
-        uvA = uvB + glm::vec2(-csx, csy);
+std::shared_ptr<EntitySkinMeshBuffer> acquireBindBuffer(const std::shared_ptr<const EntitySkinMesh>& mesh) {
+    std::weak_ptr<EntitySkinMeshBuffer>& cached = bindBufferCache()[mesh.get()];
+    if (std::shared_ptr<EntitySkinMeshBuffer> existing = cached.lock()) {
+        return existing;
     }
-    setFaceUv(out[0], uvA, uvB, invW, invH);
 
-    // +Z
-    uvA = glm::vec2(u0 + csz + csx + csz, v0 + csz);
-    uvB = uvA + glm::vec2(csx, csy);
-    if (cube.mirror) {
-        uvA = glm::vec2(u0 + csz + csx + csx + csz, v0 + csz);
-        uvB = uvA + glm::vec2(-csx, csy);
-    }
-    setFaceUv(out[1], uvA, uvB, invW, invH);
+    auto buffer = std::make_shared<EntitySkinMeshBuffer>();
+    buffer->mesh = mesh;
+    glGenVertexArrays(1, &buffer->vao);
+    glGenBuffers(1, &buffer->vbo);
+    glBindVertexArray(buffer->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(mesh->vertices.size() * sizeof(EntitySkinVertex)),
+                 mesh->vertices.data(),
+                 GL_STATIC_DRAW);
+    setSkinVertexLayout();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    cached = buffer;
+    return buffer;
+}
 
-    // -Y
-    uvB = glm::vec2(u0 + csz + csx, v0 + csz);
-    uvA = uvB + glm::vec2(csx, -csz);
-    if (cube.mirror) {
-        uvB = glm::vec2(u0 + csz + csx + csx, v0 + csz);
-        uvA = uvB + glm::vec2(-csx, -csz);
-    }
-    setFaceUv(out[2], uvA, uvB, invW, invH);
+} // namespace
 
-    // +Y
-    uvB = glm::vec2(u0 + csz, v0);
-    uvA = uvB + glm::vec2(csx, csz);
-    if (cube.mirror) {
-        uvB = glm::vec2(u0 + csz + csx, v0);
-        uvA = uvB + glm::vec2(-csx, csz);
+EntitySkinMeshBuffer::~EntitySkinMeshBuffer() {
+    if (vao != 0) {
+        glDeleteVertexArrays(1, &vao);
     }
-    setFaceUv(out[3], uvA, uvB, invW, invH);
-
-    // -X
-    uvB = glm::vec2(u0 + csx + csz, v0 + csz);
-    uvA = uvB + glm::vec2(csz, csy);
-    if (cube.mirror) {
-        uvB = glm::vec2(u0 + csz, v0 + csz);
-        uvA = uvB + glm::vec2(-csz, csy);
+    if (vbo != 0) {
+        glDeleteBuffers(1, &vbo);
     }
-    setFaceUv(out[4], uvA, uvB, invW, invH);
-
-    // +X
-    uvB = glm::vec2(u0, v0 + csz);
-    uvA = uvB + glm::vec2(csz, csy);
-    if (cube.mirror) {
-        uvA = glm::vec2(u0 + csz + csz + csx, v0 + csz);
-        uvB = uvA + glm::vec2(-csz, csy);
+    auto& cache = bindBufferCache();
+    auto it = cache.find(mesh.get());
+    if (it != cache.end() && it->second.expired()) {
+        cache.erase(it);
     }
-    setFaceUv(out[5], uvA, uvB, invW, invH);
-}
 }
 
 EntityModelInstance::EntityModelInstance(std::shared_ptr<const EntityModelAsset> model,
@@ -134,7 +102,7 @@ EntityModelInstance::EntityModelInstance(std::shared_ptr<const EntityModelAsset>
     if (m_model && !m_model->defaultAnimation.empty() && m_animationSet) {
         const EntityAnimation* anim = m_animationSet->find(m_model->defaultAnimation);
         if (anim) {
-            m_activeAnimations.push_back(anim);
+            activateAnimation(anim);
         }
     }
 }
@@ -151,12 +119,27 @@ void EntityModelInstance::addAnimation(std::string_view name) {
     if (!anim) {
         return;
     }
-    if (std::find(m_activeAnimations.begin(), m_activeAnimations.end(), anim) == m_activeAnimations.end()) {
-        m_activeAnimations.push_back(anim);
-        m_meshDirty = true;
+    auto it = std::find_if(m_activeAnimations.begin(), m_activeAnimations.end(),
+                           [anim](const ActiveAnimation& active) { return active.animation == anim; });
+    if (it == m_activeAnimations.end()) {
+        activateAnimation(anim);
+        m_poseDirty = true;
     }
 }
 
+void EntityModelInstance::activateAnimation(const EntityAnimation* animation) {
+    ActiveAnimation active;
+    active.animation = animation;
+    active.clip = m_model->findClip(animation);
+    if (!active.clip) {
+        active.ownedClip = std::make_shared<EntityAnimationClip>(
+            compileAnimationClip(*animation, m_model->bones));
+        active.clip = active.ownedClip.get();
+    }
+    active.cursors.resize(m_model->bones.size() * 3);
+    m_activeAnimations.push_back(std::move(active));
+}
+
 void EntityModelInstance::removeAnimation(std::string_view name) {
     if (!m_animationSet) {
         return;
@@ -169,9 +152,17 @@ void EntityModelInstance::removeAnimation(std::string_view name) {
 }
 
 void EntityModelInstance::removeAnimation(const EntityAnimation* animation) {
-    auto it = std::remove(m_activeAnimations.begin(), m_activeAnimations.end(), animation);
-    m_activeAnimations.erase(it, m_activeAnimations.end());
-    m_meshDirty = true;
+    std::erase_if(m_activeAnimations,
+                  [animation](const ActiveAnimation& active) { return active.animation == animation; });
+    m_poseDirty = true;
+}
+
+uint64_t EntityModelInstance::animationStateKey() const {
+    uint64_t key = 0;
+    for (const ActiveAnimation& active : m_activeAnimations) {
+        key = key * 0x100000001b3ULL ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(active.animation));
+    }
+    return key;
 }
 
 void EntityModelInstance::render(const EntityRenderContext& ctx,
@@ -179,28 +170,63 @@ void EntityModelInstance::render(const EntityRenderContext& ctx,
                                  const glm::mat4& modelMatrix,
                                  bool shouldRender) {
     (void)entity;
-    updateAnimations(ctx);
-    if (m_meshDirty) {
-        rebuildMesh(ctx);
+    if (!std::exchange(m_advanced, false)) {
+        updateAnimations(ctx, modelMatrix);
     }
-    if (!shouldRender || m_cpuVertices.empty() || !m_shader) {
+    if (!shouldRender || !m_shader || !prepareDraw()) {
         return;
     }
+    bindDrawState(ctx);
+    drawBound(modelMatrix, ctx.ambientOcclusion);
+    endDrawState();
+}
 
-    ensureGpuResources();
-    if (m_vertexCount == 0) {
+void EntityModelInstance::renderShadow(const EntityRenderContext& ctx,
+                                       Entity& entity,
+                                       const glm::mat4& modelMatrix,
+                                       const glm::mat4& lightViewProjection,
+                                       const Asset::Handle<Asset::ShaderAsset>& shadowShader,
+                                       bool shouldRender) {
+    (void)entity;
+    if (!shadowShader) {
         return;
     }
+    if (!std::exchange(m_advanced, false)) {
+        updateAnimations(ctx, modelMatrix);
+    }
+    if (!shouldRender || !prepareDraw()) {
+        return;
+    }
+    bindShadowState(*shadowShader, lightViewProjection);
+    drawShadowBound(*shadowShader, modelMatrix);
+    endShadowState();
+}
 
+bool EntityModelInstance::prepareDraw() {
+    m_advanced = false;
+    if (m_poseDirty) {
+        updatePose();
+    }
+    if (m_vertexCount == 0) {
+        return false;
+    }
+    ensureGpuResources();
+    return m_vertexCount != 0;
+}
+
+bool EntityModelInstance::canShareDrawState(const EntityModelInstance& other) const {
+    return m_shader == other.m_shader && m_textures == other.m_textures;
+}
+
+void EntityModelInstance::bindDrawState(const EntityRenderContext& ctx) const {
+    if (!m_shader) {
+        return;
+    }
     m_shader->bind();
     GLint locViewProjection = m_shader->uniform("u_viewProjection");
     if (locViewProjection >= 0) {
         glUniformMatrix4fv(locViewProjection, 1, GL_FALSE, glm::value_ptr(ctx.viewProjection));
     }
-    GLint locModel = m_shader->uniform("u_model");
-    if (locModel >= 0) {
-        glUniformMatrix4fv(locModel, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-    }
     GLint locSun = m_shader->uniform("u_sunDirection");
     if (locSun >= 0) {
         glUniform3fv(locSun, 1, glm::value_ptr(ctx.sunDirection));
@@ -213,15 +239,6 @@ void EntityModelInstance::render(const EntityRenderContext& ctx,
     if (locAmbient >= 0) {
         glUniform1f(locAmbient, ctx.ambientStrength);
     }
-    GLint locAo = m_shader->uniform("u_ao");
-    if (locAo >= 0) {
-        glUniform1f(locAo, ctx.ambientOcclusion);
-    }
-    GLint locTint = m_shader->uniform("u_tintColor");
-    if (locTint >= 0) {
-        glUniform4fv(locTint, 1, glm::value_ptr(m_tint));
-    }
-
     GLint locDiffuse = m_shader->uniform("u_diffuse");
     auto texIt = m_textures.find("diffuse");
     if (locDiffuse >= 0) {
@@ -324,50 +341,46 @@ void EntityModelInstance::render(const EntityRenderContext& ctx,
     glDisable(GL_CULL_FACE);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
-
-    glDisable(GL_BLEND);
-    glEnable(GL_CULL_FACE);
-    glBindVertexArray(0);
-    glUseProgram(0);
+    g_boundVao = 0;
 }
 
-void EntityModelInstance::renderShadow(const EntityRenderContext& ctx,
-                                       Entity& entity,
-                                       const glm::mat4& modelMatrix,
-                                       const glm::mat4& lightViewProjection,
-                                       const Asset::Handle<Asset::ShaderAsset>& shadowShader,
-                                       bool shouldRender) {
-    (void)entity;
-    if (!shadowShader) {
+void EntityModelInstance::drawBound(const glm::mat4& modelMatrix, float ambientOcclusion) {
+    if (!m_shader) {
         return;
     }
-    updateAnimations(ctx);
-    if (m_meshDirty) {
-        rebuildMesh(ctx);
+    GLint locModel = m_shader->uniform("u_model");
+    if (locModel >= 0) {
+        glUniformMatrix4fv(locModel, 1, GL_FALSE, glm::value_ptr(modelMatrix));
     }
-    if (!shouldRender || m_cpuVertices.empty()) {
-        return;
+    GLint locAo = m_shader->uniform("u_ao");
+    if (locAo >= 0) {
+        glUniform1f(locAo, ambientOcclusion);
     }
-
-    ensureGpuResources();
-    if (m_vertexCount == 0) {
-        return;
+    GLint locTint = m_shader->uniform("u_tintColor");
+    if (locTint >= 0) {
+        glUniform4fv(locTint, 1, glm::value_ptr(m_tint));
     }
+    bindSkinning(*m_shader);
+    drawVertices();
+}
 
-    shadowShader->bind();
-    GLint locLightVP = shadowShader->uniform("u_lightViewProjection");
+void EntityModelInstance::endDrawState() {
+    glDisable(GL_BLEND);
+    glEnable(GL_CULL_FACE);
+    glBindVertexArray(0);
+    glUseProgram(0);
+    g_boundVao = 0;
+}
+
+void EntityModelInstance::bindShadowState(const Asset::ShaderAsset& shadowShader,
+                                          const glm::mat4& lightViewProjection) const {
+    shadowShader.bind();
+    GLint locLightVP = shadowShader.uniform("u_lightViewProjection");
     if (locLightVP >= 0) {
         glUniformMatrix4fv(locLightVP, 1, GL_FALSE, glm::value_ptr(lightViewProjection));
     }
-    GLint locModel = shadowShader->uniform("u_model");
-    if (locModel >= 0) {
-        glUniformMatrix4fv(locModel, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-    }
-    GLint locDiffuse = shadowShader->uniform("u_diffuse");
-    GLint locUseAlphaTest = shadowShader->uniform("u_useAlphaTest");
+    GLint locDiffuse = shadowShader.uniform("u_diffuse");
+    GLint locUseAlphaTest = shadowShader.uniform("u_useAlphaTest");
     auto diffuseIt = m_textures.find("diffuse");
     bool hasDiffuse = diffuseIt != m_textures.end() && diffuseIt->second;
     if (locDiffuse >= 0 && hasDiffuse) {
@@ -382,15 +395,42 @@ void EntityModelInstance::renderShadow(const EntityRenderContext& ctx,
     glDepthMask(GL_TRUE);
     glDisable(GL_BLEND);
     glDisable(GL_CULL_FACE);
+    g_boundVao = 0;
+}
 
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
+void EntityModelInstance::drawShadowBound(const Asset::ShaderAsset& shadowShader, const glm::mat4& modelMatrix) {
+    GLint locModel = shadowShader.uniform("u_model");
+    if (locModel >= 0) {
+        glUniformMatrix4fv(locModel, 1, GL_FALSE, glm::value_ptr(modelMatrix));
+    }
+    bindSkinning(shadowShader);
+    drawVertices();
+}
 
+void EntityModelInstance::endShadowState() {
     glBindVertexArray(0);
     glUseProgram(0);
+    g_boundVao = 0;
+}
+
+void EntityModelInstance::drawVertices() const {
+    // GPU-skinned instances of one mesh share a vertex array, so a run binds it once.
+    const GLuint vao = drawVao();
+    if (vao != g_boundVao) {
+        glBindVertexArray(vao);
+        g_boundVao = vao;
+    }
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertexCount));
+}
+
+void EntityModelInstance::advance(const EntityRenderContext& ctx, const glm::mat4& modelMatrix) {
+    if (!m_advanced) {
+        updateAnimations(ctx, modelMatrix);
+        m_advanced = true;
+    }
 }
 
-void EntityModelInstance::updateAnimations(const EntityRenderContext& ctx) {
+void EntityModelInstance::updateAnimations(const EntityRenderContext& ctx, const glm::mat4& modelMatrix) {
     if (m_activeAnimations.empty()) {
         return;
     }
@@ -404,40 +444,139 @@ void EntityModelInstance::updateAnimations(const EntityRenderContext& ctx) {
         m_lastAnimFrame = ctx.frameIndex;
     }
     m_globalAnimTime += ctx.deltaTime;
-    m_meshDirty = true;
+
+    m_lod = selectAnimationLod(ctx.animationLod, glm::distance(ctx.cameraPos, glm::vec3(modelMatrix[3])));
+    ++m_framesSincePose;
+    m_blendDirty = true;
+    if (!m_hasPose || (m_lod.updateInterval != 0 && m_framesSincePose >= m_lod.updateInterval)) {
+        m_poseDirty = true;
+    }
+}
+
+const std::vector<glm::mat4>& EntityModelInstance::drawPalette() {
+    if (!m_gpuSkinning || m_lod.updateInterval <= 1 || m_previousPalette.size() != m_palette.size()) {
+        return m_palette;
+    }
+    if (m_blendDirty) {
+        float alpha = std::min(1.0f, static_cast<float>(m_framesSincePose) /
+                                     static_cast<float>(m_lod.updateInterval));
+        m_blendedPalette.resize(m_palette.size());
+        blendPalettes(m_previousPalette, m_palette, alpha, m_blendedPalette);
+        m_blendDirty = false;
+    }
+    return m_blendedPalette;
 }
 
 glm::vec3 EntityModelInstance::sampleTrack(const EntityAnimationTrack& track,
                                            const EntityAnimation& animation,
-                                           const glm::vec3& defaultValue) const {
-    return track.sample(m_globalAnimTime, animation.loop, animation.duration, defaultValue);
+                                           const glm::vec3& defaultValue,
+                                           EntityTrackCursor& cursor) const {
+    return track.sample(m_globalAnimTime, animation.loop, animation.duration, defaultValue, cursor);
 }
 
-void EntityModelInstance::rebuildMesh(const EntityRenderContext& ctx) {
-    (void)ctx;
-    m_cpuVertices.clear();
-    m_vertexCount = 0;
-    m_meshDirty = false;
+void EntityModelInstance::updatePose() {
+    updatePalette();
+    if (m_model && !m_gpuSkinning) {
+        skinMesh(*m_skinMesh, m_palette, m_cpuVertices.data());
+        m_vboDirty = true;
+    }
+}
 
+void EntityModelInstance::poseBatch(std::span<EntityModelInstance* const> instances) {
+    std::vector<EntityModelInstance*> cpuSkinned;
+    for (EntityModelInstance* instance : instances) {
+        if (!instance->m_poseDirty) {
+            continue;
+        }
+        instance->updatePalette();
+        if (instance->m_model && !instance->m_gpuSkinning) {
+            cpuSkinned.push_back(instance);
+        }
+    }
+    if (cpuSkinned.empty()) {
+        return;
+    }
+
+    // One pass over each bind mesh poses all of its instances.
+    std::stable_sort(cpuSkinned.begin(), cpuSkinned.end(),
+                     [](const EntityModelInstance* a, const EntityModelInstance* b) {
+                         return std::less<const EntitySkinMesh*>{}(a->m_skinMesh.get(), b->m_skinMesh.get());
+                     });
+    std::vector<glm::mat4> palettes;
+    std::vector<EntitySkinVertex> posed;
+    for (size_t first = 0; first < cpuSkinned.size();) {
+        const EntitySkinMesh& mesh = *cpuSkinned[first]->m_skinMesh;
+        size_t last = first + 1;
+        while (last < cpuSkinned.size() && cpuSkinned[last]->m_skinMesh.get() == &mesh) {
+            ++last;
+        }
+        const size_t count = last - first;
+        if (count == 1) {
+            EntityModelInstance& instance = *cpuSkinned[first];
+            skinMesh(mesh, instance.m_palette, instance.m_cpuVertices.data());
+            instance.m_vboDirty = true;
+        } else {
+            palettes.clear();
+            for (size_t i = first; i < last; ++i) {
+                const std::vector<glm::mat4>& palette = cpuSkinned[i]->m_palette;
+                palettes.insert(palettes.end(), palette.begin(), palette.begin() + mesh.boneCount);
+            }
+            const size_t vertexCount = mesh.vertices.size();
+            posed.resize(count * vertexCount);
+            skinMeshBatch(mesh, palettes, count, posed.data());
+            for (size_t i = first; i < last; ++i) {
+                auto slice = posed.begin() + static_cast<std::ptrdiff_t>((i - first) * vertexCount);
+                std::copy(slice, slice + static_cast<std::ptrdiff_t>(vertexCount),
+                          cpuSkinned[i]->m_cpuVertices.begin());
+                cpuSkinned[i]->m_vboDirty = true;
+            }
+        }
+        first = last;
+    }
+}
+
+void EntityModelInstance::updatePalette() {
+    m_poseDirty = false;
     if (!m_model) {
         return;
     }
+    m_framesSincePose = 0;
+    m_hasPose = true;
+    m_blendDirty = true;
+
+    if (!m_skinMesh) {
+        m_skinMesh = m_model->skinMesh ? m_model->skinMesh : buildSkinMesh(*m_model);
+        m_gpuSkinning = m_shader && m_skinMesh->boneCount <= kMaxGpuSkinBones &&
+            m_shader->uniform("u_bones") >= 0;
+        if (!m_gpuSkinning) {
+            m_cpuVertices.resize(m_skinMesh->vertices.size());
+        }
+        m_vertexCount = m_skinMesh->vertices.size();
+        m_vboDirty = true;
+    }
+
+    // Throttled GPU poses blend from the previous evaluation toward this one.
+    if (m_gpuSkinning) {
+        std::swap(m_previousPalette, m_palette);
+    }
+    const size_t animationCount = std::min(m_activeAnimations.size(), m_lod.maxAnimations);
 
-    std::vector<glm::mat4> boneTransforms(m_model->bones.size(), glm::mat4(1.0f));
+    // Bone transforms are accumulated down the hierarchy, then model scale is applied.
+    m_palette.assign(m_model->bones.size(), glm::mat4(1.0f));
     for (size_t i = 0; i < m_model->bones.size(); ++i) {
         const EntityBone& bone = m_model->bones[i];
         glm::vec3 animPos(0.0f);
         glm::vec3 animRot(0.0f);
         glm::vec3 animScale(1.0f);
 
-        for (const EntityAnimation* animation : m_activeAnimations) {
-            if (!animation) {
-                continue;
-            }
-            if (const EntityBoneAnimation* boneAnim = animation->findBone(bone.name)) {
-                animPos += sampleTrack(boneAnim->position, *animation, glm::vec3(0.0f));
-                animRot += sampleTrack(boneAnim->rotation, *animation, glm::vec3(0.0f));
-                glm::vec3 scaleSample = sampleTrack(boneAnim->scale, *animation, glm::vec3(1.0f));
+        for (size_t a = 0; a < animationCount; ++a) {
+            ActiveAnimation& active = m_activeAnimations[a];
+            if (const EntityBoneAnimation* boneAnim = active.clip->bones[i]) {
+                const EntityAnimation& animation = *active.animation;
+                EntityTrackCursor* cursors = &active.cursors[i * 3];
+                animPos += sampleTrack(boneAnim->position, animation, glm::vec3(0.0f), cursors[0]);
+                animRot += sampleTrack(boneAnim->rotation, animation, glm::vec3(0.0f), cursors[1]);
+                glm::vec3 scaleSample = sampleTrack(boneAnim->scale, animation, glm::vec3(1.0f), cursors[2]);
                 animScale *= scaleSample;
             }
         }
@@ -453,126 +592,77 @@ void EntityModelInstance::rebuildMesh(const EntityRenderContext& ctx) {
         local = glm::translate(local, animPos);
 
         if (bone.parentIndex >= 0) {
-            boneTransforms[i] = boneTransforms[static_cast<size_t>(bone.parentIndex)] * local;
+            m_palette[i] = m_palette[static_cast<size_t>(bone.parentIndex)] * local;
         } else {
-            boneTransforms[i] = local;
+            m_palette[i] = local;
         }
     }
 
-    glm::mat4 scaleMat(1.0f);
     if (m_model->modelScale != 1.0f) {
-        scaleMat = glm::scale(scaleMat, glm::vec3(m_model->modelScale));
-    }
-
-    constexpr size_t kFaceVertices = 6;
-    constexpr size_t kCubeFaces = 6;
-    m_cpuVertices.reserve(m_model->bones.size() * kFaceVertices * kCubeFaces);
-
-    for (size_t boneIndex = 0; boneIndex < m_model->bones.size(); ++boneIndex) {
-        const EntityBone& bone = m_model->bones[boneIndex];
-        const glm::mat4& boneTransform = boneTransforms[boneIndex];
-
-        for (const EntityModelCube& cube : bone.cubes) {
-            glm::vec3 size = cube.size;
-            glm::vec3 pivot = cube.pivot;
-            float inflate = cube.inflate;
-
-            glm::mat4 cubeMat(1.0f);
-            cubeMat = glm::translate(cubeMat, cube.origin);
-            cubeMat = glm::translate(cubeMat, size * 0.5f);
-            cubeMat = glm::scale(cubeMat, size + glm::vec3(inflate));
-
-            glm::mat4 rotMat(1.0f);
-            rotMat = glm::translate(rotMat, pivot);
-            rotMat *= rotationYawPitchRoll(cube.rotation);
-            rotMat = glm::translate(rotMat, -pivot);
-            cubeMat = rotMat * cubeMat;
-
-            glm::mat4 finalTransform = scaleMat * boneTransform * cubeMat;
-            std::array<glm::vec3, 8> corners{};
-            for (size_t c = 0; c < corners.size(); ++c) {
-                glm::vec4 pos = finalTransform * glm::vec4(kCubeCorners[c], 1.0f);
-                corners[c] = glm::vec3(pos);
-            }
-
-            std::array<FaceUvRect, 6> faceUvs{};
-            computeFaceUvs(cube, *m_model, faceUvs);
-
-            glm::vec3 normalZ = glm::normalize((corners[0] + corners[3]) * 0.5f -
-                                               (corners[4] + corners[7]) * 0.5f);
-            glm::vec3 normalY = glm::normalize((corners[0] + corners[6]) * 0.5f -
-                                               (corners[1] + corners[7]) * 0.5f);
-            glm::vec3 normalX = glm::normalize((corners[0] + corners[5]) * 0.5f -
-                                               (corners[2] + corners[7]) * 0.5f);
-
-            auto emitRect = [&](const glm::vec3& c00,
-                                const glm::vec3& c10,
-                                const glm::vec3& c11,
-                                const glm::vec3& c01,
-                                const glm::vec3& normal,
-                                const FaceUvRect& uv) {
-                Vertex v0{c00, normal, glm::vec2(uv.a.x, uv.a.y)};
-                Vertex v1{c10, normal, glm::vec2(uv.a.x, uv.b.y)};
-                Vertex v2{c11, normal, glm::vec2(uv.b.x, uv.b.y)};
-                Vertex v3{c01, normal, glm::vec2(uv.b.x, uv.a.y)};
-                m_cpuVertices.push_back(v0);
-                m_cpuVertices.push_back(v1);
-                m_cpuVertices.push_back(v2);
-                m_cpuVertices.push_back(v0);
-                m_cpuVertices.push_back(v2);
-                m_cpuVertices.push_back(v3);
-            };
-
-            emitRect(corners[0], corners[1], corners[3], corners[2], normalZ, faceUvs[0]);       // -Z
-            emitRect(corners[5], corners[4], corners[6], corners[7], -normalZ, faceUvs[1]);      // +Z
-            emitRect(corners[4], corners[0], corners[2], corners[6], normalY, faceUvs[2]);       // -Y
-            emitRect(corners[1], corners[5], corners[7], corners[3], -normalY, faceUvs[3]);      // +Y
-            emitRect(corners[4], corners[5], corners[1], corners[0], normalX, faceUvs[4]);       // -X
-            emitRect(corners[2], corners[3], corners[7], corners[6], -normalX, faceUvs[5]);      // +X
+        glm::mat4 scaleMat = glm::scale(glm::mat4(1.0f), glm::vec3(m_model->modelScale));
+        for (glm::mat4& bone : m_palette) {
+            bone = scaleMat * bone;
         }
     }
 
-    m_vertexCount = m_cpuVertices.size();
+    if (m_previousPalette.size() != m_palette.size()) {
+        m_previousPalette = m_palette;
+    }
+}
 
-    if (m_vao != 0 && m_vbo != 0) {
-        glBindVertexArray(m_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(m_cpuVertices.size() * sizeof(Vertex)),
-                     m_cpuVertices.data(),
-                     GL_DYNAMIC_DRAW);
+void EntityModelInstance::bindSkinning(const Asset::ShaderAsset& shader) {
+    GLint locSkinned = shader.uniform("u_skinned");
+    if (locSkinned >= 0) {
+        glUniform1i(locSkinned, m_gpuSkinning ? 1 : 0);
+    }
+    GLint locBones = shader.uniform("u_bones");
+    if (m_gpuSkinning && locBones >= 0 && !m_palette.empty()) {
+        const std::vector<glm::mat4>& palette = drawPalette();
+        glUniformMatrix4fv(locBones,
+                           static_cast<GLsizei>(palette.size()),
+                           GL_FALSE,
+                           glm::value_ptr(palette.front()));
     }
 }
 
 void EntityModelInstance::ensureGpuResources() {
+    // The bind mesh goes up once per mesh; CPU-skinned vertices change with every pose.
+    if (m_gpuSkinning) {
+        if (!m_bindBuffer) {
+            m_bindBuffer = acquireBindBuffer(m_skinMesh);
+        }
+        return;
+    }
+
     if (m_vao == 0) {
         glGenVertexArrays(1, &m_vao);
-    }
-    if (m_vbo == 0) {
         glGenBuffers(1, &m_vbo);
+
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        setSkinVertexLayout();
+        glBindVertexArray(0);
+        m_vboDirty = true;
+    }
+    if (!m_vboDirty) {
+        return;
     }
 
-    glBindVertexArray(m_vao);
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
     glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(m_cpuVertices.size() * sizeof(Vertex)),
+                 static_cast<GLsizeiptr>(m_cpuVertices.size() * sizeof(EntitySkinVertex)),
                  m_cpuVertices.data(),
                  GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_vboDirty = false;
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void*>(offsetof(Vertex, position)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void*>(offsetof(Vertex, normal)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void*>(offsetof(Vertex, uv)));
-
-    glBindVertexArray(0);
+GLuint EntityModelInstance::drawVao() const {
+    return m_bindBuffer ? m_bindBuffer->vao : m_vao;
 }
 
 void EntityModelInstance::releaseGpuResources() {
+    m_bindBuffer.reset();
     if (m_vao != 0) {
         glDeleteVertexArrays(1, &m_vao);
         m_vao = 0;
@@ -581,7 +671,7 @@ void EntityModelInstance::releaseGpuResources() {
         glDeleteBuffers(1, &m_vbo);
         m_vbo = 0;
     }
-    m_vertexCount = 0;
+    m_vboDirty = true;
 }
 
 } // namespace Rigel::Entity
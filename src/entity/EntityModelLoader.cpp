@@ -1,6 +1,7 @@
 #include "Rigel/Entity/EntityModelLoader.h"
 
 #include "Rigel/Entity/EntityModel.h"
+#include "Rigel/Entity/EntitySkinning.h"
 #include "Rigel/Asset/AssetManager.h"
 
 #include <ryml.hpp>
@@ -262,6 +263,9 @@ std::shared_ptr<Asset::AssetBase> EntityModelLoader::load(const Asset::LoadConte
         bone.parentIndex = static_cast<int>(lookupIt->second);
     }
 
+    asset->compileAnimationClips();
+    asset->skinMesh = buildSkinMesh(*asset);
+
     return asset;
 }
 
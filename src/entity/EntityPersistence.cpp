@@ -2,12 +2,52 @@
 
 #include <bit>
 #include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 namespace Rigel::Entity {
 
 namespace {
 constexpr uint32_t kEntityRegionMagic = 0x52474531; // "RGE1"
-constexpr uint16_t kEntityRegionVersion = 1;
+// Version 1 wrote every entity inline. Version 2 stores each distinct string once in
+// a region string table, each distinct (type, model) pair once in a type table, and
+// the entities as columns:
+//   header, chunk count
+//   string table: count, strings
+//   type table: count, (type string, model string) index pairs
+//   chunk directory: (x, y, z, entity count) per chunk
+//   columns over all entities in chunk order: type index, id, position, velocity,
+//   view direction
+constexpr uint16_t kEntityRegionVersionInline = 1;
+constexpr uint16_t kEntityRegionVersion = 2;
+// Bytes per entity across the version 2 columns.
+constexpr size_t kEntityColumnBytes = 4 + 16 + 3 * 12;
+
+void storeU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>((value >> 24) & 0xFF);
+    out[1] = static_cast<uint8_t>((value >> 16) & 0xFF);
+    out[2] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    out[3] = static_cast<uint8_t>(value & 0xFF);
+}
+
+uint32_t loadU32(const uint8_t* in) {
+    return (static_cast<uint32_t>(in[0]) << 24) |
+           (static_cast<uint32_t>(in[1]) << 16) |
+           (static_cast<uint32_t>(in[2]) << 8) |
+           static_cast<uint32_t>(in[3]);
+}
+
+void storeVec3(uint8_t* out, const glm::vec3& value) {
+    storeU32(out, std::bit_cast<uint32_t>(value.x));
+    storeU32(out + 4, std::bit_cast<uint32_t>(value.y));
+    storeU32(out + 8, std::bit_cast<uint32_t>(value.z));
+}
+
+glm::vec3 loadVec3(const uint8_t* in) {
+    return glm::vec3(std::bit_cast<float>(loadU32(in)),
+                     std::bit_cast<float>(loadU32(in + 4)),
+                     std::bit_cast<float>(loadU32(in + 8)));
+}
 
 class BufferWriter {
 public:
@@ -37,7 +77,7 @@ public:
         writeU32(bits);
     }
 
-    void writeString(const std::string& value) {
+    void writeString(std::string_view value) {
         writeU32(static_cast<uint32_t>(value.size()));
         if (!value.empty()) {
             m_data.insert(m_data.end(),
@@ -46,6 +86,13 @@ public:
         }
     }
 
+    // Appends `bytes` bytes and returns where they start, for filling a column in place.
+    uint8_t* extend(size_t bytes) {
+        const size_t offset = m_data.size();
+        m_data.resize(offset + bytes);
+        return m_data.data() + offset;
+    }
+
     std::vector<uint8_t> take() {
         return std::move(m_data);
     }
@@ -121,9 +168,23 @@ public:
         return true;
     }
 
+    // Consumes `len` bytes and returns where they start, or nullptr if too few remain.
+    const uint8_t* take(size_t len) {
+        if (!ensure(len)) {
+            return nullptr;
+        }
+        const uint8_t* data = m_data.data() + m_pos;
+        m_pos += len;
+        return data;
+    }
+
+    size_t remaining() const {
+        return m_data.size() - m_pos;
+    }
+
 private:
     bool ensure(size_t len) const {
-        return m_pos + len <= m_data.size();
+        return len <= m_data.size() - m_pos;
     }
 
     std::span<const uint8_t> m_data;
@@ -140,16 +201,224 @@ bool readVec3(BufferReader& reader, glm::vec3& value) {
     return reader.readF32(value.x) && reader.readF32(value.y) && reader.readF32(value.z);
 }
 
+bool readChunkCoord(BufferReader& reader, Voxel::ChunkCoord& coord) {
+    uint32_t cx = 0;
+    uint32_t cy = 0;
+    uint32_t cz = 0;
+    if (!reader.readU32(cx) || !reader.readU32(cy) || !reader.readU32(cz)) {
+        return false;
+    }
+    coord.x = static_cast<int32_t>(cx);
+    coord.y = static_cast<int32_t>(cy);
+    coord.z = static_cast<int32_t>(cz);
+    return true;
+}
+
+bool decodeInlineChunks(BufferReader& reader,
+                        uint32_t chunkCount,
+                        std::vector<EntityPersistedChunk>& outChunks) {
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        EntityPersistedChunk chunk;
+        if (!readChunkCoord(reader, chunk.coord)) {
+            return false;
+        }
+
+        uint32_t entityCount = 0;
+        if (!reader.readU32(entityCount)) {
+            return false;
+        }
+        for (uint32_t e = 0; e < entityCount; ++e) {
+            EntityPersistedEntity entity;
+            if (!reader.readString(entity.typeId)) {
+                return false;
+            }
+            if (!reader.readU64(entity.id.time) ||
+                !reader.readU32(entity.id.random) ||
+                !reader.readU32(entity.id.counter)) {
+                return false;
+            }
+            if (!readVec3(reader, entity.position) ||
+                !readVec3(reader, entity.velocity) ||
+                !readVec3(reader, entity.viewDirection)) {
+                return false;
+            }
+            if (!reader.readString(entity.modelId)) {
+                return false;
+            }
+            chunk.entities.push_back(std::move(entity));
+        }
+
+        outChunks.push_back(std::move(chunk));
+    }
+    return true;
+}
+
+bool decodeColumnarChunks(BufferReader& reader,
+                          uint32_t chunkCount,
+                          std::vector<EntityPersistedChunk>& outChunks) {
+    uint32_t stringCount = 0;
+    if (!reader.readU32(stringCount) || stringCount > reader.remaining() / 4) {
+        return false;
+    }
+    std::vector<std::string> strings(stringCount);
+    for (std::string& value : strings) {
+        if (!reader.readString(value)) {
+            return false;
+        }
+    }
+
+    uint32_t typeCount = 0;
+    if (!reader.readU32(typeCount) || typeCount > reader.remaining() / 8) {
+        return false;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> types(typeCount);
+    for (auto& [typeString, modelString] : types) {
+        if (!reader.readU32(typeString) || !reader.readU32(modelString) ||
+            typeString >= stringCount || modelString >= stringCount) {
+            return false;
+        }
+    }
+
+    if (chunkCount > reader.remaining() / 16) {
+        return false;
+    }
+    uint64_t total = 0;
+    outChunks.resize(chunkCount);
+    for (EntityPersistedChunk& chunk : outChunks) {
+        uint32_t entityCount = 0;
+        if (!readChunkCoord(reader, chunk.coord) || !reader.readU32(entityCount)) {
+            return false;
+        }
+        total += entityCount;
+        if (total > reader.remaining() / kEntityColumnBytes) {
+            return false;
+        }
+        chunk.entities.resize(entityCount);
+    }
+
+    const size_t count = static_cast<size_t>(total);
+    const uint8_t* typeColumn = reader.take(count * 4);
+    const uint8_t* idColumn = reader.take(count * 16);
+    const uint8_t* positionColumn = reader.take(count * 12);
+    const uint8_t* velocityColumn = reader.take(count * 12);
+    const uint8_t* viewColumn = reader.take(count * 12);
+    if (!typeColumn || !idColumn || !positionColumn || !velocityColumn || !viewColumn) {
+        return false;
+    }
+
+    for (EntityPersistedChunk& chunk : outChunks) {
+        for (EntityPersistedEntity& entity : chunk.entities) {
+            const uint32_t type = loadU32(typeColumn);
+            if (type >= typeCount) {
+                return false;
+            }
+            entity.typeId = strings[types[type].first];
+            entity.modelId = strings[types[type].second];
+            entity.id.time = (static_cast<uint64_t>(loadU32(idColumn)) << 32) | loadU32(idColumn + 4);
+            entity.id.random = loadU32(idColumn + 8);
+            entity.id.counter = loadU32(idColumn + 12);
+            entity.position = loadVec3(positionColumn);
+            entity.velocity = loadVec3(velocityColumn);
+            entity.viewDirection = loadVec3(viewColumn);
+
+            typeColumn += 4;
+            idColumn += 16;
+            positionColumn += 12;
+            velocityColumn += 12;
+            viewColumn += 12;
+        }
+    }
+    return true;
+}
+
 } // namespace
 
 std::vector<uint8_t> encodeEntityRegionPayload(
     const std::vector<EntityPersistedChunk>& chunks) {
+    // Tables are built in first-appearance order; the views point into `chunks`.
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, uint32_t> stringIndex;
+    auto internString = [&](std::string_view value) {
+        auto [it, inserted] = stringIndex.try_emplace(value, static_cast<uint32_t>(strings.size()));
+        if (inserted) {
+            strings.push_back(value);
+        }
+        return it->second;
+    };
+
+    std::vector<std::pair<uint32_t, uint32_t>> types;
+    std::unordered_map<uint64_t, uint32_t> typeIndex;
+    std::vector<uint32_t> entityTypes;
+    for (const auto& chunk : chunks) {
+        for (const auto& entity : chunk.entities) {
+            const uint32_t typeString = internString(entity.typeId);
+            const uint32_t modelString = internString(entity.modelId);
+            const uint64_t key = (static_cast<uint64_t>(typeString) << 32) | modelString;
+            auto [it, inserted] = typeIndex.try_emplace(key, static_cast<uint32_t>(types.size()));
+            if (inserted) {
+                types.emplace_back(typeString, modelString);
+            }
+            entityTypes.push_back(it->second);
+        }
+    }
+
     BufferWriter writer;
     writer.writeU32(kEntityRegionMagic);
     writer.writeU16(kEntityRegionVersion);
     writer.writeU16(0);
     writer.writeU32(static_cast<uint32_t>(chunks.size()));
 
+    writer.writeU32(static_cast<uint32_t>(strings.size()));
+    for (std::string_view value : strings) {
+        writer.writeString(value);
+    }
+    writer.writeU32(static_cast<uint32_t>(types.size()));
+    for (const auto& [typeString, modelString] : types) {
+        writer.writeU32(typeString);
+        writer.writeU32(modelString);
+    }
+    for (const auto& chunk : chunks) {
+        writer.writeU32(static_cast<uint32_t>(chunk.coord.x));
+        writer.writeU32(static_cast<uint32_t>(chunk.coord.y));
+        writer.writeU32(static_cast<uint32_t>(chunk.coord.z));
+        writer.writeU32(static_cast<uint32_t>(chunk.entities.size()));
+    }
+
+    const size_t count = entityTypes.size();
+    uint8_t* typeColumn = writer.extend(count * kEntityColumnBytes);
+    uint8_t* idColumn = typeColumn + count * 4;
+    uint8_t* positionColumn = idColumn + count * 16;
+    uint8_t* velocityColumn = positionColumn + count * 12;
+    uint8_t* viewColumn = velocityColumn + count * 12;
+    size_t index = 0;
+    for (const auto& chunk : chunks) {
+        for (const auto& entity : chunk.entities) {
+            storeU32(typeColumn + index * 4, entityTypes[index]);
+            uint8_t* id = idColumn + index * 16;
+            storeU32(id, static_cast<uint32_t>(entity.id.time >> 32));
+            storeU32(id + 4, static_cast<uint32_t>(entity.id.time & 0xFFFFFFFFu));
+            storeU32(id + 8, entity.id.random);
+            storeU32(id + 12, entity.id.counter);
+            storeVec3(positionColumn + index * 12, entity.position);
+            storeVec3(velocityColumn + index * 12, entity.velocity);
+            storeVec3(viewColumn + index * 12, entity.viewDirection);
+            ++index;
+        }
+    }
+
+    return writer.take();
+}
+
+namespace detail {
+
+std::vector<uint8_t> encodeEntityRegionPayloadInline(
+    const std::vector<EntityPersistedChunk>& chunks) {
+    BufferWriter writer;
+    writer.writeU32(kEntityRegionMagic);
+    writer.writeU16(kEntityRegionVersionInline);
+    writer.writeU16(0);
+    writer.writeU32(static_cast<uint32_t>(chunks.size()));
+
     for (const auto& chunk : chunks) {
         writer.writeU32(static_cast<uint32_t>(chunk.coord.x));
         writer.writeU32(static_cast<uint32_t>(chunk.coord.y));
@@ -171,6 +440,8 @@ std::vector<uint8_t> encodeEntityRegionPayload(
     return writer.take();
 }
 
+} // namespace detail
+
 bool decodeEntityRegionPayload(std::span<const uint8_t> payload,
                                std::vector<EntityPersistedChunk>& outChunks) {
     BufferReader reader(payload);
@@ -180,7 +451,8 @@ bool decodeEntityRegionPayload(std::span<const uint8_t> payload,
     if (!reader.readU32(magic) || magic != kEntityRegionMagic) {
         return false;
     }
-    if (!reader.readU16(version) || version != kEntityRegionVersion) {
+    if (!reader.readU16(version) ||
+        (version != kEntityRegionVersion && version != kEntityRegionVersionInline)) {
         return false;
     }
     if (!reader.readU16(reserved)) {
@@ -193,50 +465,10 @@ bool decodeEntityRegionPayload(std::span<const uint8_t> payload,
     }
 
     outChunks.clear();
-    outChunks.reserve(chunkCount);
-
-    for (uint32_t i = 0; i < chunkCount; ++i) {
-        EntityPersistedChunk chunk;
-        uint32_t cx = 0;
-        uint32_t cy = 0;
-        uint32_t cz = 0;
-        if (!reader.readU32(cx) || !reader.readU32(cy) || !reader.readU32(cz)) {
-            return false;
-        }
-        chunk.coord.x = static_cast<int32_t>(cx);
-        chunk.coord.y = static_cast<int32_t>(cy);
-        chunk.coord.z = static_cast<int32_t>(cz);
-
-        uint32_t entityCount = 0;
-        if (!reader.readU32(entityCount)) {
-            return false;
-        }
-        chunk.entities.reserve(entityCount);
-        for (uint32_t e = 0; e < entityCount; ++e) {
-            EntityPersistedEntity entity;
-            if (!reader.readString(entity.typeId)) {
-                return false;
-            }
-            if (!reader.readU64(entity.id.time) ||
-                !reader.readU32(entity.id.random) ||
-                !reader.readU32(entity.id.counter)) {
-                return false;
-            }
-            if (!readVec3(reader, entity.position) ||
-                !readVec3(reader, entity.velocity) ||
-                !readVec3(reader, entity.viewDirection)) {
-                return false;
-            }
-            if (!reader.readString(entity.modelId)) {
-                return false;
-            }
-            chunk.entities.push_back(std::move(entity));
-        }
-
-        outChunks.push_back(std::move(chunk));
+    if (version == kEntityRegionVersionInline) {
+        return decodeInlineChunks(reader, chunkCount, outChunks);
     }
-
-    return true;
+    return decodeColumnarChunks(reader, chunkCount, outChunks);
 }
 
 } // namespace Rigel::Entity
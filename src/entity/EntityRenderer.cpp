@@ -2,6 +2,8 @@
 
 #include "Rigel/Entity/Entity.h"
 #include "Rigel/Entity/Aabb.h"
+#include "Rigel/Entity/EntityModelInstance.h"
+#include "Rigel/Entity/WorldEntities.h"
 #include "Rigel/Voxel/World.h"
 #include "Rigel/Asset/AssetManager.h"
 
@@ -9,6 +11,7 @@
 #include <glm/gtc/matrix_access.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <functional>
 #include <spdlog/spdlog.h>
 
 namespace Rigel::Entity {
@@ -44,8 +47,30 @@ float computeEntityAo(const Voxel::World& world, const Aabb& bounds) {
     return std::clamp(ao, 0.3f, 1.0f);
 }
 
+glm::mat4 modelMatrixFor(const Entity& entity) {
+    glm::vec3 renderOffset(0.0f);
+    if (const auto& model = entity.model()) {
+        renderOffset = model->renderOffset;
+    }
+    return glm::translate(glm::mat4(1.0f), entity.position() + renderOffset);
+}
+
+EntityDrawItem drawItemFor(Entity& entity) {
+    const IEntityModelInstance* instance = entity.modelInstance();
+    return EntityDrawItem{&entity,
+                          modelMatrixFor(entity),
+                          entity.model().get(),
+                          instance ? instance->animationStateKey() : 0};
+}
+
 } // namespace
 
+void EntityDrawList::clear() {
+    visible.clear();
+    batches.clear();
+    culled.clear();
+}
+
 void EntityRenderer::initialize(Asset::AssetManager& assets) {
     m_assets = &assets;
     if (assets.exists("shaders/entity")) {
@@ -65,25 +90,17 @@ void EntityRenderer::render(Voxel::World& world, const EntityRenderContext& ctx)
         return;
     }
 
-    std::array<glm::vec4, 6> planes = extractPlanes(ctx.viewProjection);
-
-    world.entities().forEach([&](Entity& entity) {
-        const Aabb& bounds = entity.worldBounds();
-        bool visible = isVisible(bounds, planes);
+    buildDrawList(world.entities(), ctx.viewProjection, m_drawList);
 
-        if (!entity.ensureModelInstance(*m_assets, m_shader)) {
-            return;
-        }
+    // Culled entities only let their components and animation clocks see the frame.
+    for (Entity* entity : m_drawList.culled) {
+        entity->render(ctx, modelMatrixFor(*entity), false);
+    }
 
-        glm::vec3 renderOffset(0.0f);
-        if (const auto& model = entity.model()) {
-            renderOffset = model->renderOffset;
-        }
-        glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), entity.position() + renderOffset);
-        EntityRenderContext localCtx = ctx;
-        localCtx.ambientOcclusion = computeEntityAo(world, bounds);
-        entity.render(localCtx, modelMatrix, visible);
-    });
+    for (const EntityDrawList::Batch& batch : m_drawList.batches) {
+        poseBatch(m_drawList, batch, ctx);
+        drawBatch(world, batch, ctx);
+    }
 }
 
 void EntityRenderer::renderShadowCasters(Voxel::World& world,
@@ -93,25 +110,143 @@ void EntityRenderer::renderShadowCasters(Voxel::World& world,
         return;
     }
 
-    world.entities().forEach([&](Entity& entity) {
-        const Aabb& bounds = entity.worldBounds();
-        if (!entity.ensureModelInstance(*m_assets, m_shader)) {
-            return;
+    buildDrawList(world.entities(), shadowCtx.lightViewProjection, m_shadowDrawList);
+    for (const EntityDrawList::Batch& batch : m_shadowDrawList.batches) {
+        poseBatch(m_shadowDrawList, batch, ctx);
+        drawShadowBatch(batch, ctx, shadowCtx.lightViewProjection);
+    }
+}
+
+void EntityRenderer::poseBatch(const EntityDrawList& list,
+                               const EntityDrawList::Batch& batch,
+                               const EntityRenderContext& ctx) {
+    m_poseScratch.clear();
+    for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+        const EntityDrawItem& item = list.visible[i];
+        if (!item.entity->ensureModelInstance(*m_assets, m_shader)) {
+            continue;
+        }
+        if (auto* instance = dynamic_cast<EntityModelInstance*>(item.entity->modelInstance())) {
+            instance->advance(ctx, item.modelMatrix);
+            m_poseScratch.push_back(instance);
         }
+    }
+    EntityModelInstance::poseBatch(m_poseScratch);
+}
 
-        auto* instance = entity.modelInstance();
+void EntityRenderer::drawBatch(Voxel::World& world,
+                               const EntityDrawList::Batch& batch,
+                               const EntityRenderContext& ctx) {
+    m_aoScratch.assign(batch.count, 1.0f);
+    const EntityModelInstance* bound = nullptr;
+    for (size_t i = 0; i < batch.count; ++i) {
+        const EntityDrawItem& item = m_drawList.visible[batch.first + i];
+        Entity& entity = *item.entity;
+        IEntityModelInstance* base = entity.modelInstance();
+        if (!base) {
+            continue;
+        }
+        m_aoScratch[i] = computeEntityAo(world, entity.worldBounds());
+        auto* instance = dynamic_cast<EntityModelInstance*>(base);
         if (!instance) {
-            return;
+            // Other instance types draw themselves, with their components.
+            if (bound) {
+                EntityModelInstance::endDrawState();
+                bound = nullptr;
+            }
+            EntityRenderContext localCtx = ctx;
+            localCtx.ambientOcclusion = m_aoScratch[i];
+            entity.render(localCtx, item.modelMatrix, true);
+            continue;
+        }
+        instance->setTint(entity.renderTint());
+        if (!instance->prepareDraw()) {
+            continue;
         }
+        if (!bound || !bound->canShareDrawState(*instance)) {
+            instance->bindDrawState(ctx);
+            bound = instance;
+        }
+        instance->drawBound(item.modelMatrix, m_aoScratch[i]);
+    }
+    if (bound) {
+        EntityModelInstance::endDrawState();
+    }
 
-        glm::vec3 renderOffset(0.0f);
-        if (const auto& model = entity.model()) {
-            renderOffset = model->renderOffset;
+    // Components run after the run's GL state is released.
+    for (size_t i = 0; i < batch.count; ++i) {
+        const EntityDrawItem& item = m_drawList.visible[batch.first + i];
+        if (dynamic_cast<EntityModelInstance*>(item.entity->modelInstance())) {
+            EntityRenderContext localCtx = ctx;
+            localCtx.ambientOcclusion = m_aoScratch[i];
+            item.entity->renderComponents(localCtx, item.modelMatrix, true);
+        }
+    }
+}
+
+void EntityRenderer::drawShadowBatch(const EntityDrawList::Batch& batch,
+                                     const EntityRenderContext& ctx,
+                                     const glm::mat4& lightViewProjection) {
+    const EntityModelInstance* bound = nullptr;
+    for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+        const EntityDrawItem& item = m_shadowDrawList.visible[i];
+        IEntityModelInstance* base = item.entity->modelInstance();
+        if (!base) {
+            continue;
+        }
+        auto* instance = dynamic_cast<EntityModelInstance*>(base);
+        if (!instance) {
+            if (bound) {
+                EntityModelInstance::endShadowState();
+                bound = nullptr;
+            }
+            base->renderShadow(ctx, *item.entity, item.modelMatrix, lightViewProjection, m_shadowShader, true);
+            continue;
+        }
+        if (!instance->prepareDraw()) {
+            continue;
+        }
+        if (!bound || !bound->canShareDrawState(*instance)) {
+            instance->bindShadowState(*m_shadowShader, lightViewProjection);
+            bound = instance;
+        }
+        instance->drawShadowBound(*m_shadowShader, item.modelMatrix);
+    }
+    if (bound) {
+        EntityModelInstance::endShadowState();
+    }
+}
+
+void EntityRenderer::buildDrawList(WorldEntities& entities,
+                                   const glm::mat4& viewProjection,
+                                   EntityDrawList& out) {
+    out.clear();
+    std::array<glm::vec4, 6> planes = extractPlanes(viewProjection);
+    entities.forEach([&](Entity& entity) {
+        if (isVisible(entity.worldBounds(), planes)) {
+            out.visible.push_back(drawItemFor(entity));
+        } else {
+            out.culled.push_back(&entity);
         }
-        glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), entity.position() + renderOffset);
-        instance->renderShadow(ctx, entity, modelMatrix, shadowCtx.lightViewProjection,
-                               m_shadowShader, true);
     });
+
+    // Stable, so entities within a run keep their world order.
+    std::stable_sort(out.visible.begin(), out.visible.end(),
+                     [](const EntityDrawItem& a, const EntityDrawItem& b) {
+                         if (a.model != b.model) {
+                             return std::less<const EntityModelAsset*>{}(a.model, b.model);
+                         }
+                         return a.animationKey < b.animationKey;
+                     });
+
+    for (size_t i = 0; i < out.visible.size(); ++i) {
+        const EntityDrawItem& item = out.visible[i];
+        if (out.batches.empty() || out.batches.back().model != item.model ||
+            out.batches.back().animationKey != item.animationKey) {
+            out.batches.push_back(EntityDrawList::Batch{item.model, item.animationKey, i, 0});
+        }
+        ++out.batches.back().count;
+    }
 }
 
 bool EntityRenderer::isVisible(const Aabb& bounds, const glm::mat4& viewProjection) {
@@ -0,0 +1,260 @@
+#include "Rigel/Entity/EntitySkinning.h"
+
+#include "Rigel/Entity/EntityModel.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace Rigel::Entity {
+
+namespace {
+constexpr glm::vec3 kCubeCorners[8] = {
+    {-0.5f, -0.5f, -0.5f}, // 000
+    {-0.5f,  0.5f, -0.5f}, // 010
+    { 0.5f, -0.5f, -0.5f}, // 100
+    { 0.5f,  0.5f, -0.5f}, // 110
+    {-0.5f, -0.5f,  0.5f}, // 001
+    {-0.5f,  0.5f,  0.5f}, // 011
+    { 0.5f, -0.5f,  0.5f}, // 101
+    { 0.5f,  0.5f,  0.5f}  // 111
+};
+
+struct FaceUvRect {
+    glm::vec2 a{0.0f};
+    glm::vec2 b{1.0f};
+};
+
+glm::mat4 rotationYawPitchRoll(const glm::vec3& degrees) {
+    glm::mat4 rot(1.0f);
+    rot = glm::rotate(rot, glm::radians(degrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    rot = glm::rotate(rot, glm::radians(degrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    rot = glm::rotate(rot, glm::radians(degrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    return rot;
+}
+
+void setFaceUv(FaceUvRect& rect, const glm::vec2& uvA, const glm::vec2& uvB,
+               float invW, float invH) {
+    rect.a = glm::vec2(uvA.x * invW, 1.0f - (uvA.y * invH));
+    rect.b = glm::vec2(uvB.x * invW, 1.0f - (uvB.y * invH));
+}
+
+void computeFaceUvs(const EntityModelCube& cube,
+                    const EntityModelAsset& model,
+                    std::array<FaceUvRect, 6>& out) {
+    if (!cube.hasUv || model.texWidth <= 0.0f || model.texHeight <= 0.0f) {
+        for (auto& rect : out) {
+            rect = {};
+        }
+        return;
+    }
+
+    float csx = std::floor(cube.size.x);
+    float csy = std::floor(cube.size.y);
+    float csz = std::floor(cube.size.z);
+    float u0 = cube.uv.x;
+    float v0 = cube.uv.y;
+    float invW = 1.0f / model.texWidth;
+    float invH = 1.0f / model.texHeight;
+
+    glm::vec2 uvA;
+    glm::vec2 uvB;
+
+    // -Z
+    uvB = glm::vec2(u0 + csz, v0 + csz);
+    uvA = uvB + glm::vec2(csx, csy);
+    if (cube.mirror) {
+        uvB = glm::vec2(u0 + csz + csx, v0 + csz);
+        uvA = uvB + glm::vec2(-csx, csy);
+    }
+    setFaceUv(out[0], uvA, uvB, invW, invH);
+
+    // +Z
+    uvA = glm::vec2(u0 + csz + csx + csz, v0 + csz);
+    uvB = uvA + glm::vec2(csx, csy);
+    if (cube.mirror) {
+        uvA = glm::vec2(u0 + csz + csx + csx + csz, v0 + csz);
+        uvB = uvA + glm::vec2(-csx, csy);
+    }
+    setFaceUv(out[1], uvA, uvB, invW, invH);
+
+    // -Y
+    uvB = glm::vec2(u0 + csz + csx, v0 + csz);
+    uvA = uvB + glm::vec2(csx, -csz);
+    if (cube.mirror) {
+        uvB = glm::vec2(u0 + csz + csx + csx, v0 + csz);
+        uvA = uvB + glm::vec2(-csx, -csz);
+    }
+    setFaceUv(out[2], uvA, uvB, invW, invH);
+
+    // +Y
+    uvB = glm::vec2(u0 + csz, v0);
+    uvA = uvB + glm::vec2(csx, csz);
+    if (cube.mirror) {
+        uvB = glm::vec2(u0 + csz + csx, v0);
+        uvA = uvB + glm::vec2(-csx, csz);
+    }
+    setFaceUv(out[3], uvA, uvB, invW, invH);
+
+    // -X
+    uvB = glm::vec2(u0 + csx + csz, v0 + csz);
+    uvA = uvB + glm::vec2(csz, csy);
+    if (cube.mirror) {
+        uvB = glm::vec2(u0 + csz, v0 + csz);
+        uvA = uvB + glm::vec2(-csz, csy);
+    }
+    setFaceUv(out[4], uvA, uvB, invW, invH);
+
+    // +X
+    uvB = glm::vec2(u0, v0 + csz);
+    uvA = uvB + glm::vec2(csz, csy);
+    if (cube.mirror) {
+        uvA = glm::vec2(u0 + csz + csz + csx, v0 + csz);
+        uvB = uvA + glm::vec2(-csz, csy);
+    }
+    setFaceUv(out[5], uvA, uvB, invW, invH);
+}
+
+glm::mat4 cubeMatrix(const EntityModelCube& cube) {
+    glm::mat4 cubeMat(1.0f);
+    cubeMat = glm::translate(cubeMat, cube.origin);
+    cubeMat = glm::translate(cubeMat, cube.size * 0.5f);
+    cubeMat = glm::scale(cubeMat, cube.size + glm::vec3(cube.inflate));
+
+    glm::mat4 rotMat(1.0f);
+    rotMat = glm::translate(rotMat, cube.pivot);
+    rotMat *= rotationYawPitchRoll(cube.rotation);
+    rotMat = glm::translate(rotMat, -cube.pivot);
+    return rotMat * cubeMat;
+}
+
+// Emits the 36 vertices of `cube` with `transform` applied to its unit corners.
+void emitCube(const EntityModelCube& cube,
+              const EntityModelAsset& model,
+              const glm::mat4& transform,
+              float bone,
+              std::vector<EntitySkinVertex>& out) {
+    std::array<glm::vec3, 8> corners{};
+    for (size_t c = 0; c < corners.size(); ++c) {
+        glm::vec4 pos = transform * glm::vec4(kCubeCorners[c], 1.0f);
+        corners[c] = glm::vec3(pos);
+    }
+
+    std::array<FaceUvRect, 6> faceUvs{};
+    computeFaceUvs(cube, model, faceUvs);
+
+    glm::vec3 normalZ = glm::normalize((corners[0] + corners[3]) * 0.5f -
+                                       (corners[4] + corners[7]) * 0.5f);
+    glm::vec3 normalY = glm::normalize((corners[0] + corners[6]) * 0.5f -
+                                       (corners[1] + corners[7]) * 0.5f);
+    glm::vec3 normalX = glm::normalize((corners[0] + corners[5]) * 0.5f -
+                                       (corners[2] + corners[7]) * 0.5f);
+
+    auto emitRect = [&](const glm::vec3& c00,
+                        const glm::vec3& c10,
+                        const glm::vec3& c11,
+                        const glm::vec3& c01,
+                        const glm::vec3& normal,
+                        const FaceUvRect& uv) {
+        EntitySkinVertex v0{c00, normal, glm::vec2(uv.a.x, uv.a.y), bone};
+        EntitySkinVertex v1{c10, normal, glm::vec2(uv.a.x, uv.b.y), bone};
+        EntitySkinVertex v2{c11, normal, glm::vec2(uv.b.x, uv.b.y), bone};
+        EntitySkinVertex v3{c01, normal, glm::vec2(uv.b.x, uv.a.y), bone};
+        out.push_back(v0);
+        out.push_back(v1);
+        out.push_back(v2);
+        out.push_back(v0);
+        out.push_back(v2);
+        out.push_back(v3);
+    };
+
+    emitRect(corners[0], corners[1], corners[3], corners[2], normalZ, faceUvs[0]);       // -Z
+    emitRect(corners[5], corners[4], corners[6], corners[7], -normalZ, faceUvs[1]);      // +Z
+    emitRect(corners[4], corners[0], corners[2], corners[6], normalY, faceUvs[2]);       // -Y
+    emitRect(corners[1], corners[5], corners[7], corners[3], -normalY, faceUvs[3]);      // +Y
+    emitRect(corners[4], corners[5], corners[1], corners[0], normalX, faceUvs[4]);       // -X
+    emitRect(corners[2], corners[3], corners[7], corners[6], -normalX, faceUvs[5]);      // +X
+}
+
+size_t cubeVertexCount(const EntityModelAsset& model) {
+    constexpr size_t kCubeVertices = 36;
+    size_t cubes = 0;
+    for (const EntityBone& bone : model.bones) {
+        cubes += bone.cubes.size();
+    }
+    return cubes * kCubeVertices;
+}
+
+void requirePalette(const EntitySkinMesh& mesh, size_t paletteSize, size_t count) {
+    if (paletteSize < mesh.boneCount * count) {
+        throw std::invalid_argument("EntitySkinning: palette smaller than bone count");
+    }
+}
+
+EntitySkinVertex skinVertex(const EntitySkinVertex& vertex, const glm::mat4& bone) {
+    EntitySkinVertex out = vertex;
+    out.position = glm::vec3(bone * glm::vec4(vertex.position, 1.0f));
+    out.normal = glm::normalize(glm::mat3(bone) * vertex.normal);
+    return out;
+}
+
+} // namespace
+
+std::shared_ptr<const EntitySkinMesh> buildSkinMesh(const EntityModelAsset& model) {
+    auto mesh = std::make_shared<EntitySkinMesh>();
+    mesh->boneCount = model.bones.size();
+    mesh->vertices.reserve(cubeVertexCount(model));
+    for (size_t boneIndex = 0; boneIndex < model.bones.size(); ++boneIndex) {
+        for (const EntityModelCube& cube : model.bones[boneIndex].cubes) {
+            emitCube(cube, model, cubeMatrix(cube), static_cast<float>(boneIndex), mesh->vertices);
+        }
+    }
+    return mesh;
+}
+
+void skinMesh(const EntitySkinMesh& mesh, std::span<const glm::mat4> palette, EntitySkinVertex* out) {
+    requirePalette(mesh, palette.size(), 1);
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const EntitySkinVertex& vertex = mesh.vertices[i];
+        out[i] = skinVertex(vertex, palette[static_cast<size_t>(vertex.bone)]);
+    }
+}
+
+void skinMeshBatch(const EntitySkinMesh& mesh,
+                   std::span<const glm::mat4> palettes,
+                   size_t count,
+                   EntitySkinVertex* out) {
+    requirePalette(mesh, palettes.size(), count);
+    const size_t vertexCount = mesh.vertices.size();
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const EntitySkinVertex& vertex = mesh.vertices[i];
+        const size_t bone = static_cast<size_t>(vertex.bone);
+        for (size_t instance = 0; instance < count; ++instance) {
+            out[instance * vertexCount + i] = skinVertex(vertex, palettes[instance * mesh.boneCount + bone]);
+        }
+    }
+}
+
+namespace detail {
+
+void buildPosedMesh(const EntityModelAsset& model,
+                    std::span<const glm::mat4> palette,
+                    std::vector<EntitySkinVertex>& out) {
+    if (palette.size() < model.bones.size()) {
+        throw std::invalid_argument("EntitySkinning: palette smaller than bone count");
+    }
+    out.clear();
+    out.reserve(cubeVertexCount(model));
+    for (size_t boneIndex = 0; boneIndex < model.bones.size(); ++boneIndex) {
+        for (const EntityModelCube& cube : model.bones[boneIndex].cubes) {
+            emitCube(cube, model, palette[boneIndex] * cubeMatrix(cube),
+                     static_cast<float>(boneIndex), out);
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace Rigel::Entity
@@ -0,0 +1,190 @@
+#include "Rigel/Entity/VoxelCollision.h"
+
+#include "Rigel/Voxel/Chunk.h"
+#include "Rigel/Voxel/World.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Rigel::Entity {
+
+namespace {
+
+constexpr int kSubchunkSize = Voxel::Chunk::SUBCHUNK_SIZE;
+// Past this many subchunks (a teleport-sized step) the grid is skipped and every
+// cell goes through the world lookup.
+constexpr size_t kMaxGridSubchunks = 4096;
+
+int floorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+        --quotient;
+    }
+    return quotient;
+}
+
+struct AxisRange {
+    int min = 0;
+    int max = 0;
+};
+
+AxisRange toBlockRange(float minCoord, float maxCoord) {
+    int minBlock = static_cast<int>(std::floor(minCoord));
+    int maxBlock = static_cast<int>(std::floor(maxCoord - kCollisionEpsilon));
+    if (maxBlock < minBlock) {
+        maxBlock = minBlock;
+    }
+    return {minBlock, maxBlock};
+}
+
+int axisIndex(Axis axis) {
+    switch (axis) {
+        case Axis::X: return 0;
+        case Axis::Y: return 1;
+        case Axis::Z: return 2;
+    }
+    return 0;
+}
+
+} // namespace
+
+VoxelCollisionQuery::VoxelCollisionQuery(const Voxel::World& world, const Aabb& reach)
+    : m_world(&world)
+    , m_registry(&world.blockRegistry())
+{
+    AxisRange ranges[3] = {
+        toBlockRange(reach.min.x, reach.max.x),
+        toBlockRange(reach.min.y, reach.max.y),
+        toBlockRange(reach.min.z, reach.max.z)
+    };
+    size_t count = 1;
+    for (int a = 0; a < 3; ++a) {
+        m_origin[a] = floorDiv(ranges[a].min, kSubchunkSize);
+        m_extent[a] = floorDiv(ranges[a].max, kSubchunkSize) - m_origin[a] + 1;
+        count *= static_cast<size_t>(m_extent[a]);
+    }
+    if (count > kMaxGridSubchunks) {
+        m_extent = glm::ivec3(0);
+        return;
+    }
+
+    m_subchunks.assign(count, nullptr);
+    const Voxel::ChunkManager& chunks = world.chunkManager();
+    const Voxel::Chunk* chunk = nullptr;
+    Voxel::ChunkCoord chunkCoord{0, 0, 0};
+    bool haveChunk = false;
+    size_t slot = 0;
+    for (int sz = 0; sz < m_extent.z; ++sz) {
+        for (int sy = 0; sy < m_extent.y; ++sy) {
+            for (int sx = 0; sx < m_extent.x; ++sx, ++slot) {
+                const glm::ivec3 sub = m_origin + glm::ivec3(sx, sy, sz);
+                const Voxel::ChunkCoord coord{floorDiv(sub.x, 2), floorDiv(sub.y, 2), floorDiv(sub.z, 2)};
+                if (!haveChunk || coord != chunkCoord) {
+                    chunk = chunks.getChunk(coord);
+                    chunkCoord = coord;
+                    haveChunk = true;
+                }
+                if (chunk) {
+                    m_subchunks[slot] = chunk->subchunkBlocks(sub.x - coord.x * 2,
+                                                              sub.y - coord.y * 2,
+                                                              sub.z - coord.z * 2);
+                }
+            }
+        }
+    }
+}
+
+bool VoxelCollisionQuery::isSolid(int x, int y, int z) const {
+    const int sx = floorDiv(x, kSubchunkSize);
+    const int sy = floorDiv(y, kSubchunkSize);
+    const int sz = floorDiv(z, kSubchunkSize);
+    const int gx = sx - m_origin.x;
+    const int gy = sy - m_origin.y;
+    const int gz = sz - m_origin.z;
+    if (gx < 0 || gy < 0 || gz < 0 || gx >= m_extent.x || gy >= m_extent.y || gz >= m_extent.z) {
+        return isSolidSlow(x, y, z);
+    }
+    const Voxel::BlockState* blocks =
+        m_subchunks[static_cast<size_t>(gx + m_extent.x * (gy + m_extent.y * gz))];
+    if (!blocks) {
+        return false;
+    }
+    const int lx = x - sx * kSubchunkSize;
+    const int ly = y - sy * kSubchunkSize;
+    const int lz = z - sz * kSubchunkSize;
+    const Voxel::BlockState& state = blocks[lx + ly * kSubchunkSize + lz * kSubchunkSize * kSubchunkSize];
+    return m_registry->isSolid(state.id);
+}
+
+bool VoxelCollisionQuery::isSolidSlow(int x, int y, int z) const {
+    return m_registry->isSolid(m_world->getBlock(x, y, z).id);
+}
+
+bool VoxelCollisionQuery::intersectsSolid(const Aabb& box) const {
+    AxisRange xRange = toBlockRange(box.min.x, box.max.x);
+    AxisRange yRange = toBlockRange(box.min.y, box.max.y);
+    AxisRange zRange = toBlockRange(box.min.z, box.max.z);
+    for (int bz = zRange.min; bz <= zRange.max; ++bz) {
+        for (int by = yRange.min; by <= yRange.max; ++by) {
+            for (int bx = xRange.min; bx <= xRange.max; ++bx) {
+                if (isSolid(bx, by, bz)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+float VoxelCollisionQuery::sweep(const Aabb& box, Axis axis, float delta, bool& hit) const {
+    hit = false;
+    if (delta == 0.0f) {
+        return 0.0f;
+    }
+
+    const int a = axisIndex(axis);
+    const int u = (a + 1) % 3;
+    const int v = (a + 2) % 3;
+    const AxisRange uRange = toBlockRange(box.min[u], box.max[u]);
+    const AxisRange vRange = toBlockRange(box.min[v], box.max[v]);
+
+    auto layerSolid = [&](int layer) {
+        glm::ivec3 cell;
+        cell[a] = layer;
+        for (int cv = vRange.min; cv <= vRange.max; ++cv) {
+            cell[v] = cv;
+            for (int cu = uRange.min; cu <= uRange.max; ++cu) {
+                cell[u] = cu;
+                if (isSolid(cell.x, cell.y, cell.z)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    // The first layer is the one the leading face already sits in, so a box that
+    // starts overlapping a block is pushed back out of it.
+    if (delta > 0.0f) {
+        const int first = static_cast<int>(std::floor(box.max[a] - kCollisionEpsilon));
+        const int last = static_cast<int>(std::floor(box.max[a] + delta - kCollisionEpsilon));
+        for (int layer = first; layer <= last; ++layer) {
+            if (layerSolid(layer)) {
+                hit = true;
+                return std::min(delta, static_cast<float>(layer) - box.max[a] - kCollisionEpsilon);
+            }
+        }
+    } else {
+        const int first = static_cast<int>(std::floor(box.min[a]));
+        const int last = static_cast<int>(std::floor(box.min[a] + delta));
+        for (int layer = first; layer >= last; --layer) {
+            if (layerSolid(layer)) {
+                hit = true;
+                return std::max(delta, static_cast<float>(layer + 1) - box.min[a] + kCollisionEpsilon);
+            }
+        }
+    }
+    return delta;
+}
+
+} // namespace Rigel::Entity
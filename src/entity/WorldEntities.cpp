@@ -1,13 +1,57 @@
 #include "Rigel/Entity/WorldEntities.h"
 
 #include "Rigel/Entity/EntityUtils.h"
+#include "Rigel/Voxel/Chunk.h"
 #include "Rigel/Voxel/World.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <tuple>
 #include <vector>
 
 namespace Rigel::Entity {
 
+namespace {
+
+// The entity whose update is running on this thread. Spawns it requests are ordered
+// by (its dense index, call sequence), whichever thread ran it.
+struct SpawnerContext {
+    const WorldEntities* owner = nullptr;
+    uint32_t denseIndex = 0;
+    uint32_t sequence = 0;
+};
+
+thread_local SpawnerContext t_spawner;
+
+class SpawnerScope {
+public:
+    SpawnerScope(const WorldEntities* owner, uint32_t denseIndex) {
+        t_spawner = SpawnerContext{owner, denseIndex, 0};
+    }
+    ~SpawnerScope() { t_spawner = SpawnerContext{}; }
+
+    SpawnerScope(const SpawnerScope&) = delete;
+    SpawnerScope& operator=(const SpawnerScope&) = delete;
+};
+
+// Marks a tick in progress and clears the mark however the walk ends.
+class TickScope {
+public:
+    explicit TickScope(bool& ticking) : m_ticking(ticking) { m_ticking = true; }
+    ~TickScope() { m_ticking = false; }
+
+    TickScope(const TickScope&) = delete;
+    TickScope& operator=(const TickScope&) = delete;
+
+private:
+    bool& m_ticking;
+};
+
+} // namespace
+
 void WorldEntities::bind(Voxel::World* world) {
     m_world = world;
 }
@@ -16,62 +60,142 @@ EntityId WorldEntities::spawn(std::unique_ptr<Entity> entity) {
     if (!entity) {
         return EntityId::Null();
     }
+    if (m_isTicking) {
+        // EntityId::New() is not thread-safe; the duplicate check runs when applied.
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        if (entity->id().isNull()) {
+            entity->setId(EntityId::New());
+        }
+        const EntityId id = entity->id();
+        PendingSpawn pending;
+        if (t_spawner.owner == this) {
+            pending.spawnerIndex = t_spawner.denseIndex;
+            pending.sequence = t_spawner.sequence++;
+        } else {
+            // Not requested by an update: after every spawner, in arrival order.
+            pending.spawnerIndex = PendingSpawn::kNoSpawner;
+            pending.sequence = m_unscopedSpawnSequence++;
+        }
+        pending.entity = std::move(entity);
+        m_pendingSpawns.push_back(std::move(pending));
+        return id;
+    }
     EntityId id = entity->id();
     if (id.isNull()) {
         id = EntityId::New();
         entity->setId(id);
     }
-    entity->setCurrentChunk(nullptr);
-    auto [it, inserted] = m_entities.emplace(id, std::move(entity));
-    if (!inserted) {
+    if (m_slotById.find(id) != m_slotById.end()) {
         return EntityId::Null();
     }
-    updateEntityChunk(*it->second);
+
+    uint32_t slot = 0;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    entity->setCurrentChunk(nullptr);
+    m_slots[slot].entity = std::move(entity);
+    m_slots[slot].denseIndex = static_cast<uint32_t>(m_dense.size());
+    m_dense.push_back(slot);
+    m_slotById.emplace(id, slot);
+    updateEntityChunk(*m_slots[slot].entity);
     return id;
 }
 
 bool WorldEntities::despawn(const EntityId& id) {
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) {
+        return false;
+    }
     if (m_isTicking) {
-        if (m_entities.find(id) == m_entities.end()) {
-            return false;
-        }
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
         m_pendingDespawns.push_back(id);
         return true;
     }
-    auto it = m_entities.find(id);
-    if (it == m_entities.end()) {
-        return false;
-    }
-    removeFromChunk(*it->second);
-    m_entities.erase(it);
+    const uint32_t slot = it->second;
+    m_slotById.erase(it);
+    releaseSlot(slot);
     return true;
 }
 
+void WorldEntities::reserve(size_t count) {
+    if (count <= m_dense.capacity()) {
+        return;
+    }
+    // Loaders reserve once per region; growing at least geometrically keeps many small
+    // reservations from reallocating (and rehashing) everything each time.
+    const size_t target = std::max(count, m_dense.capacity() * 2);
+    m_slots.reserve(target);
+    m_dense.reserve(target);
+    m_slotById.reserve(target);
+}
+
+void WorldEntities::releaseSlot(uint32_t slot) {
+    Slot& released = m_slots[slot];
+    removeFromChunk(*released.entity);
+
+    const uint32_t denseIndex = released.denseIndex;
+    const uint32_t moved = m_dense.back();
+    m_dense[denseIndex] = moved;
+    m_slots[moved].denseIndex = denseIndex;
+    m_dense.pop_back();
+
+    released.entity.reset();
+    ++released.generation;
+    m_freeSlots.push_back(slot);
+}
+
 Entity* WorldEntities::get(const EntityId& id) {
-    auto it = m_entities.find(id);
-    if (it == m_entities.end()) {
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) {
         return nullptr;
     }
-    return it->second.get();
+    return slotEntity(it->second);
 }
 
 const Entity* WorldEntities::get(const EntityId& id) const {
-    auto it = m_entities.find(id);
-    if (it == m_entities.end()) {
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) {
         return nullptr;
     }
-    return it->second.get();
+    return slotEntity(it->second);
+}
+
+EntityHandle WorldEntities::handle(const EntityId& id) const {
+    auto it = m_slotById.find(id);
+    if (it == m_slotById.end()) {
+        return EntityHandle{};
+    }
+    return EntityHandle{it->second, m_slots[it->second].generation};
+}
+
+Entity* WorldEntities::get(EntityHandle handle) {
+    if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation) {
+        return nullptr;
+    }
+    return slotEntity(handle.index);
+}
+
+const Entity* WorldEntities::get(EntityHandle handle) const {
+    if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation) {
+        return nullptr;
+    }
+    return slotEntity(handle.index);
 }
 
 void WorldEntities::forEach(const std::function<void(Entity&)>& fn) {
-    for (auto& [_, entity] : m_entities) {
-        fn(*entity);
+    for (uint32_t slot : m_dense) {
+        fn(*slotEntity(slot));
     }
 }
 
 void WorldEntities::forEach(const std::function<void(const Entity&)>& fn) const {
-    for (const auto& [_, entity] : m_entities) {
-        fn(*entity);
+    for (uint32_t slot : m_dense) {
+        fn(*slotEntity(slot));
     }
 }
 
@@ -79,39 +203,223 @@ void WorldEntities::tick(float dt) {
     if (!m_world) {
         return;
     }
-    m_isTicking = true;
-    std::vector<EntityId> ids;
-    ids.reserve(m_entities.size());
-    for (auto& [id, _] : m_entities) {
-        ids.push_back(id);
+    // Spawns and despawns requested during the walk are applied once it ends, in the
+    // same order for serial and parallel ticks; spawned entities update next tick.
+    std::exception_ptr failure;
+    {
+        TickScope ticking(m_isTicking);
+        const size_t count = m_dense.size();
+        try {
+            if (m_updatePool && count > 1) {
+                updateParallel(dt, count);
+            } else {
+                updateSerial(dt, count);
+            }
+            wakeContacts();
+        } catch (...) {
+            failure = std::current_exception();
+        }
     }
-    for (const EntityId& id : ids) {
-        auto it = m_entities.find(id);
-        if (it == m_entities.end()) {
-            continue;
+
+    // Applied even when an update threw, so requests made before it are neither lost
+    // nor carried into the next tick.
+    applyDeferred();
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void WorldEntities::updateSerial(float dt, size_t count) {
+    std::exception_ptr failure;
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            SpawnerScope spawner(this, static_cast<uint32_t>(i));
+            slotEntity(m_dense[i])->update(*m_world, dt);
+        }
+    } catch (...) {
+        failure = std::current_exception();
+    }
+
+    // Chunk membership moves only after every update, as in the parallel tick, so
+    // broadphase queries during update see the same buckets in both modes.
+    for (size_t i = 0; i < count; ++i) {
+        updateEntityChunk(*slotEntity(m_dense[i]));
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void WorldEntities::wakeContacts() {
+    // Runs after every update, in dense order, so serial and parallel ticks agree.
+    m_wakeQueue.clear();
+    size_t resting = 0;
+    for (uint32_t slot : m_dense) {
+        Entity* entity = slotEntity(slot);
+        if (entity->isMoving()) {
+            m_wakeQueue.push_back(entity);
+        } else {
+            ++resting;
         }
-        Entity* entity = it->second.get();
-        entity->update(*m_world, dt);
-        if (m_entities.find(id) != m_entities.end()) {
-            updateEntityChunk(*entity);
+    }
+    if (resting == 0) {
+        return;
+    }
+    // Woken entities join the queue; each entity enters it at most once per tick
+    // because only resting or sleeping ones are woken.
+    for (size_t i = 0; i < m_wakeQueue.size(); ++i) {
+        m_wakeScratch.clear();
+        queryAabb(m_wakeQueue[i]->worldBounds(), m_wakeScratch);
+        for (Entity* other : m_wakeScratch) {
+            if (!other->isMoving()) {
+                other->wake();
+                m_wakeQueue.push_back(other);
+            }
         }
     }
-    m_isTicking = false;
+}
 
+void WorldEntities::wakeNearBlock(int wx, int wy, int wz) {
+    const glm::vec3 block(static_cast<float>(wx), static_cast<float>(wy), static_cast<float>(wz));
+    m_wakeScratch.clear();
+    queryAabb(Aabb{block - glm::vec3(1.0f), block + glm::vec3(2.0f)}, m_wakeScratch);
+    for (Entity* entity : m_wakeScratch) {
+        entity->wake();
+    }
+}
+
+void WorldEntities::setUpdateThreads(size_t threads) {
+    if (threads == updateThreads()) {
+        return;
+    }
+    m_updatePool.reset();
+    if (threads > 0) {
+        m_updatePool = std::make_unique<Voxel::detail::ThreadPool>(threads);
+    }
+}
+
+void WorldEntities::updateParallel(float dt, size_t count) {
+    // Partition by region in dense order; partitions keep their capacity across ticks.
+    m_partitionIndex.clear();
+    for (size_t p = 0; p < m_partitionCount; ++p) {
+        m_partitions[p].clear();
+    }
+    m_partitionCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Entity* entity = slotEntity(m_dense[i]);
+        const EntityChunk* chunk = entity->currentChunk();
+        const EntityRegionCoord region = chunk && chunk->region()
+            ? chunk->region()->coord()
+            : chunkToRegion(chunk ? chunk->coord() : Voxel::ChunkCoord{});
+        auto [it, inserted] = m_partitionIndex.try_emplace(region, static_cast<uint32_t>(m_partitionCount));
+        if (inserted) {
+            if (m_partitions.size() <= m_partitionCount) {
+                m_partitions.emplace_back();
+            }
+            ++m_partitionCount;
+        }
+        m_partitions[it->second].push_back(static_cast<uint32_t>(i));
+    }
+
+    std::atomic<size_t> nextPartition{0};
+    std::exception_ptr failure;
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    size_t running = 0;
+
+    auto runPartitions = [&]() {
+        for (;;) {
+            const size_t p = nextPartition.fetch_add(1);
+            if (p >= m_partitionCount) {
+                return;
+            }
+            try {
+                for (uint32_t denseIndex : m_partitions[p]) {
+                    SpawnerScope spawner(this, denseIndex);
+                    slotEntity(m_dense[denseIndex])->update(*m_world, dt);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    };
+
+    const size_t helpers = std::min(m_updatePool->threadCount(), m_partitionCount - 1);
+    running = helpers;
+    for (size_t h = 0; h < helpers; ++h) {
+        m_updatePool->enqueue([&]() {
+            runPartitions();
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--running == 0) {
+                doneCv.notify_one();
+            }
+        });
+    }
+    runPartitions();
+    {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCv.wait(lock, [&]() { return running == 0; });
+    }
+
+    // Merge: chunk membership changes in dense order, as the serial tick does.
+    for (size_t i = 0; i < count; ++i) {
+        updateEntityChunk(*slotEntity(m_dense[i]));
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void WorldEntities::applyDeferred() {
+    // Despawns run back to front in dense order so the outcome does not depend on
+    // which thread asked first.
     if (!m_pendingDespawns.empty()) {
-        std::vector<EntityId> pending = std::move(m_pendingDespawns);
+        m_despawnOrder.clear();
+        for (const EntityId& id : m_pendingDespawns) {
+            auto it = m_slotById.find(id);
+            if (it != m_slotById.end()) {
+                m_despawnOrder.emplace_back(m_slots[it->second].denseIndex, id);
+            }
+        }
         m_pendingDespawns.clear();
-        for (const EntityId& id : pending) {
+        std::sort(m_despawnOrder.begin(), m_despawnOrder.end(), [](const auto& a, const auto& b) {
+            return a.first > b.first;
+        });
+        for (const auto& [denseIndex, id] : m_despawnOrder) {
             despawn(id);
         }
     }
+
+    if (!m_pendingSpawns.empty()) {
+        std::vector<PendingSpawn> spawns = std::move(m_pendingSpawns);
+        m_pendingSpawns.clear();
+        m_unscopedSpawnSequence = 0;
+        std::sort(spawns.begin(), spawns.end(), [](const PendingSpawn& a, const PendingSpawn& b) {
+            return std::tie(a.spawnerIndex, a.sequence) < std::tie(b.spawnerIndex, b.sequence);
+        });
+        for (PendingSpawn& pending : spawns) {
+            spawn(std::move(pending.entity));
+        }
+    }
 }
 
 void WorldEntities::clear() {
-    m_entities.clear();
+    m_pendingSpawns.clear();
+    m_unscopedSpawnSequence = 0;
+    // Slots are kept and released one by one so their generations move on; handles
+    // taken before clear() must not resolve to entities spawned after it.
+    while (!m_dense.empty()) {
+        releaseSlot(m_dense.back());
+    }
+    m_slotById.clear();
+    m_wakeQueue.clear();
     m_regions.clear();
     m_chunkIndex.clear();
     m_pendingDespawns.clear();
+    m_boundsReachCounts.clear();
 }
 
 void WorldEntities::updateEntityChunk(Entity& entity) {
@@ -125,7 +433,19 @@ void WorldEntities::updateEntityChunk(Entity& entity) {
         static_cast<int>(std::floor(pos.z))
     );
 
+    const Aabb& local = entity.localBounds();
+    const float reach = std::max({std::abs(local.min.x), std::abs(local.min.y), std::abs(local.min.z),
+                                  std::abs(local.max.x), std::abs(local.max.y), std::abs(local.max.z)});
+
     EntityChunk* current = entity.currentChunk();
+    if (!current) {
+        countBoundsReach(reach);
+        entity.setBucketReach(reach);
+    } else if (entity.bucketReach() != reach) {
+        uncountBoundsReach(entity.bucketReach());
+        countBoundsReach(reach);
+        entity.setBucketReach(reach);
+    }
     if (current && current->coord() == coord) {
         return;
     }
@@ -137,6 +457,201 @@ void WorldEntities::updateEntityChunk(Entity& entity) {
     target.addEntity(&entity);
 }
 
+namespace {
+
+Voxel::ChunkCoord chunkAt(const glm::vec3& pos) {
+    return Voxel::worldToChunk(static_cast<int>(std::floor(pos.x)),
+                               static_cast<int>(std::floor(pos.y)),
+                               static_cast<int>(std::floor(pos.z)));
+}
+
+float distanceSquared(const glm::vec3& a, const glm::vec3& b) {
+    const glm::vec3 d = a - b;
+    return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+
+} // namespace
+
+template <typename Fn>
+void WorldEntities::forEachChunkIn(Voxel::ChunkCoord min, Voxel::ChunkCoord max, Fn&& fn) const {
+    const double span = (static_cast<double>(max.x) - min.x + 1.0) *
+        (static_cast<double>(max.y) - min.y + 1.0) *
+        (static_cast<double>(max.z) - min.z + 1.0);
+    // Wide queries scan the occupied buckets instead of every coordinate in range.
+    if (span > static_cast<double>(m_chunkIndex.size())) {
+        for (const auto& [coord, chunk] : m_chunkIndex) {
+            if (chunk->hasEntities() &&
+                coord.x >= min.x && coord.x <= max.x &&
+                coord.y >= min.y && coord.y <= max.y &&
+                coord.z >= min.z && coord.z <= max.z) {
+                fn(*chunk);
+            }
+        }
+        return;
+    }
+    for (int32_t z = min.z; z <= max.z; ++z) {
+        for (int32_t y = min.y; y <= max.y; ++y) {
+            for (int32_t x = min.x; x <= max.x; ++x) {
+                EntityChunk* chunk = findChunk(Voxel::ChunkCoord{x, y, z});
+                if (chunk && chunk->hasEntities()) {
+                    fn(*chunk);
+                }
+            }
+        }
+    }
+}
+
+void WorldEntities::queryAabb(const Aabb& box, std::vector<Entity*>& out) const {
+    const glm::vec3 reach(maxBoundsReach());
+    forEachChunkIn(chunkAt(box.min - reach), chunkAt(box.max + reach), [&](const EntityChunk& chunk) {
+        for (Entity* entity : chunk.entities()) {
+            if (entity->worldBounds().intersects(box)) {
+                out.push_back(entity);
+            }
+        }
+    });
+}
+
+void WorldEntities::queryRadius(const glm::vec3& center, float radius, std::vector<Entity*>& out) const {
+    if (radius < 0.0f) {
+        return;
+    }
+    const float radiusSq = radius * radius;
+    const glm::vec3 extent(radius);
+    forEachChunkIn(chunkAt(center - extent), chunkAt(center + extent), [&](const EntityChunk& chunk) {
+        for (Entity* entity : chunk.entities()) {
+            if (distanceSquared(entity->position(), center) <= radiusSq) {
+                out.push_back(entity);
+            }
+        }
+    });
+}
+
+Entity* WorldEntities::findNearest(const glm::vec3& center,
+                                   float maxRadius,
+                                   const std::function<bool(const Entity&)>& filter) const {
+    if (maxRadius < 0.0f) {
+        return nullptr;
+    }
+    Entity* best = nullptr;
+    float bestSq = maxRadius * maxRadius;
+    const glm::vec3 extent(maxRadius);
+    forEachChunkIn(chunkAt(center - extent), chunkAt(center + extent), [&](const EntityChunk& chunk) {
+        for (Entity* entity : chunk.entities()) {
+            const float dSq = distanceSquared(entity->position(), center);
+            if (dSq <= bestSq && (!filter || filter(*entity))) {
+                best = entity;
+                bestSq = dSq;
+            }
+        }
+    });
+    return best;
+}
+
+void WorldEntities::forEachOverlappingPair(const std::function<void(Entity&, Entity&)>& fn) const {
+    // Two overlapping entities are bucketed at most `ring` chunks apart on each axis.
+    const int ring = 1 + static_cast<int>(2.0f * maxBoundsReach() / static_cast<float>(Voxel::Chunk::SIZE));
+
+    // Each bucket is sorted along x once, as a span of `sorted`, so pairs inside a bucket
+    // and pairs across neighbouring buckets are both swept. Local so concurrent const
+    // callers never share it.
+    struct Span {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+    std::vector<Entity*> sorted;
+    sorted.reserve(m_dense.size());
+    std::unordered_map<const EntityChunk*, Span> spans;
+    spans.reserve(m_chunkIndex.size());
+    for (const auto& [coord, chunk] : m_chunkIndex) {
+        if (!chunk->hasEntities()) {
+            continue;
+        }
+        const size_t begin = sorted.size();
+        sorted.insert(sorted.end(), chunk->entities().begin(), chunk->entities().end());
+        std::sort(sorted.begin() + static_cast<std::ptrdiff_t>(begin), sorted.end(),
+                  [](const Entity* a, const Entity* b) {
+                      return a->worldBounds().min.x < b->worldBounds().min.x;
+                  });
+        spans.emplace(chunk, Span{begin, sorted.size()});
+    }
+
+    // Walks two sorted spans together; whichever entity starts first is tested against
+    // the other span's entities that start before it ends.
+    auto sweepBetween = [&](Span a, Span b) {
+        size_t i = a.begin;
+        size_t j = b.begin;
+        while (i < a.end && j < b.end) {
+            if (sorted[i]->worldBounds().min.x <= sorted[j]->worldBounds().min.x) {
+                const Aabb& box = sorted[i]->worldBounds();
+                for (size_t k = j; k < b.end && sorted[k]->worldBounds().min.x <= box.max.x; ++k) {
+                    if (box.intersects(sorted[k]->worldBounds())) {
+                        fn(*sorted[i], *sorted[k]);
+                    }
+                }
+                ++i;
+            } else {
+                const Aabb& box = sorted[j]->worldBounds();
+                for (size_t k = i; k < a.end && sorted[k]->worldBounds().min.x <= box.max.x; ++k) {
+                    if (box.intersects(sorted[k]->worldBounds())) {
+                        fn(*sorted[k], *sorted[j]);
+                    }
+                }
+                ++j;
+            }
+        }
+    };
+
+    for (const auto& [coord, chunk] : m_chunkIndex) {
+        auto own = spans.find(chunk);
+        if (own == spans.end()) {
+            continue;
+        }
+        const Span span = own->second;
+
+        for (size_t i = span.begin; i < span.end; ++i) {
+            const Aabb& a = sorted[i]->worldBounds();
+            for (size_t j = i + 1; j < span.end; ++j) {
+                const Aabb& b = sorted[j]->worldBounds();
+                if (b.min.x > a.max.x) {
+                    break;
+                }
+                if (a.intersects(b)) {
+                    fn(*sorted[i], *sorted[j]);
+                }
+            }
+        }
+
+        // Neighbouring buckets, visiting each unordered bucket pair from one side only.
+        for (int dz = 0; dz <= ring; ++dz) {
+            for (int dy = (dz == 0 ? 0 : -ring); dy <= ring; ++dy) {
+                for (int dx = (dz == 0 && dy == 0 ? 1 : -ring); dx <= ring; ++dx) {
+                    EntityChunk* other = findChunk(Voxel::ChunkCoord{coord.x + dx, coord.y + dy, coord.z + dz});
+                    auto otherSpan = spans.find(other);
+                    if (otherSpan != spans.end()) {
+                        sweepBetween(span, otherSpan->second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+float WorldEntities::maxBoundsReach() const {
+    return m_boundsReachCounts.empty() ? 0.0f : m_boundsReachCounts.rbegin()->first;
+}
+
+void WorldEntities::countBoundsReach(float reach) {
+    ++m_boundsReachCounts[reach];
+}
+
+void WorldEntities::uncountBoundsReach(float reach) {
+    auto it = m_boundsReachCounts.find(reach);
+    if (it != m_boundsReachCounts.end() && --it->second == 0) {
+        m_boundsReachCounts.erase(it);
+    }
+}
+
 EntityRegion& WorldEntities::getOrCreateRegion(Voxel::ChunkCoord coord) {
     EntityRegionCoord regionCoord = chunkToRegion(coord);
     auto it = m_regions.find(regionCoord);
@@ -171,6 +686,7 @@ void WorldEntities::removeFromChunk(Entity& entity) {
     EntityChunk* chunk = entity.currentChunk();
     if (chunk) {
         chunk->removeEntity(&entity);
+        uncountBoundsReach(entity.bucketReach());
     }
     entity.setCurrentChunk(nullptr);
 }
@@ -7,11 +7,15 @@
 #include "Rigel/Voxel/World.h"
 #include "Rigel/Core/Profiler.h"
 
+#include <glm/geometric.hpp>
+
 #include <algorithm>
 #include <chrono>
-#include <deque>
+#include <cmath>
 #include <exception>
+#include <iterator>
 #include <limits>
+#include <mutex>
 
 #include <spdlog/spdlog.h>
 
@@ -19,6 +23,23 @@ namespace Rigel::Persistence {
 namespace {
 
 constexpr const char* kDefaultZoneId = "rigel:default";
+// Viewer velocity smoothing time constant; a frame's motion contributes dt / this.
+constexpr float kVelocitySmoothingSeconds = 0.5f;
+// Prefetch reaches this far ahead of the viewer along its heading, in seconds of
+// travel, beyond the configured radius.
+constexpr float kPrefetchLookaheadSeconds = 2.0f;
+// Below this speed (regions per second) prefetch stays a plain ring.
+constexpr float kMinHeadingSpeed = 0.05f;
+// How strongly alignment with the heading outranks distance when ordering loads.
+constexpr float kHeadingWeight = 0.75f;
+
+size_t regionBytes(const ChunkRegionSnapshot& region) {
+    size_t bytes = sizeof(ChunkRegionSnapshot);
+    for (const auto& chunk : region.chunks) {
+        bytes += sizeof(ChunkSnapshot) + chunk.data.blocks.size() * sizeof(Voxel::BlockState);
+    }
+    return bytes;
+}
 
 std::string resolveZoneId(PersistenceService& service, const PersistenceContext& context) {
     if (!context.zoneId.empty()) {
@@ -66,11 +87,15 @@ AsyncChunkLoader::AsyncChunkLoader(PersistenceService& service,
     if (m_context.zoneId.empty()) {
         m_context.zoneId = m_zoneId;
     }
-    m_format = m_service->openFormat(m_context);
+    m_format = m_service->sharedFormat(m_context);
+    // Formats with a per-chunk index serve requests chunk by chunk instead of
+    // decoding whole regions.
+    m_chunkReads = m_format && m_format->descriptor().capabilities.supportsRandomAccess;
     int regionSpan = estimateRegionSpan();
     if (regionSpan < 1) {
         regionSpan = 1;
     }
+    m_regionSpan = regionSpan;
     int radius = viewDistanceChunks / regionSpan;
     if (radius < 1) {
         radius = 1;
@@ -81,10 +106,21 @@ AsyncChunkLoader::AsyncChunkLoader(PersistenceService& service,
     m_prefetchRadius = radius;
 }
 
+AsyncChunkLoader::~AsyncChunkLoader() {
+    // IO jobs hand frame decodes to the worker pool, and both push into the
+    // completion queues: drain IO first, then workers, before members go away.
+    m_ioPool.stop();
+    m_workerPool.stop();
+}
+
 void AsyncChunkLoader::setMaxCachedRegions(size_t maxRegions) {
     m_maxCachedRegions = maxRegions;
 }
 
+void AsyncChunkLoader::setMaxCachedBytes(size_t maxBytes) {
+    m_maxCachedBytes = maxBytes;
+}
+
 void AsyncChunkLoader::setMaxInFlightRegions(size_t maxRegions) {
     m_maxInFlightRegions = maxRegions;
 }
@@ -109,6 +145,30 @@ void AsyncChunkLoader::setChunkAppliedCallback(ChunkAppliedCallback callback) {
     m_chunkAppliedCallback = std::move(callback);
 }
 
+void AsyncChunkLoader::updateViewer(const glm::vec3& position, float dtSeconds) {
+    if (!m_format) {
+        return;
+    }
+    const glm::vec3 chunkPos = position / static_cast<float>(Voxel::Chunk::SIZE);
+    if (m_hasViewer && dtSeconds > 0.0f) {
+        const glm::vec3 instant = (chunkPos - m_viewerChunkPos) / dtSeconds;
+        const float blend = std::min(1.0f, dtSeconds / kVelocitySmoothingSeconds);
+        m_viewerVelocity += (instant - m_viewerVelocity) * blend;
+    }
+    m_viewerChunkPos = chunkPos;
+    m_hasViewer = true;
+
+    Voxel::ChunkCoord coord{static_cast<int>(std::floor(chunkPos.x)),
+                            static_cast<int>(std::floor(chunkPos.y)),
+                            static_cast<int>(std::floor(chunkPos.z))};
+    RegionKey region = m_format->regionLayout().regionForChunk(m_zoneId, coord);
+    if (m_viewerRegion && *m_viewerRegion == region) {
+        return;
+    }
+    m_viewerRegion = region;
+    prefetchNeighbors(region);
+}
+
 bool AsyncChunkLoader::request(Voxel::ChunkCoord coord) {
     if (!m_format || !m_world) {
         return false;
@@ -122,20 +182,49 @@ bool AsyncChunkLoader::request(Voxel::ChunkCoord coord) {
     RegionKey key = m_format->regionLayout().regionForChunk(m_zoneId, coord);
     auto cacheIt = m_cache.find(key);
     if (cacheIt != m_cache.end()) {
-        if (cacheIt->second.present.find(coord) == cacheIt->second.present.end()) {
+        RegionEntry& entry = cacheIt->second;
+        if (entry.partial && entry.probed.find(coord) == entry.probed.end()) {
+            m_pendingChunks.insert(coord);
+            queueChunkRead(key, coord);
+            touch(key);
+            return true;
+        }
+        if (entry.present.find(coord) == entry.present.end()) {
             return false;
         }
         m_pendingChunks.insert(coord);
-        queuePayloadBuild(cacheIt->second, coord);
+        queuePayloadBuild(entry, coord);
         touch(key);
         return true;
     }
-    if (m_inFlight.find(key) == m_inFlight.end()) {
+    auto streamIt = m_streams.find(key);
+    if (streamIt != m_streams.end() && streamCoordReady(streamIt->second, coord)) {
+        RegionStream& stream = streamIt->second;
+        if (stream.entry.present.find(coord) == stream.entry.present.end()) {
+            return false;
+        }
+        m_pendingChunks.insert(coord);
+        queuePayloadBuild(stream.entry, coord);
+        return true;
+    }
+    const bool inFlight = m_inFlight.find(key) != m_inFlight.end();
+    if (!inFlight) {
         if (!regionMayExist(key)) {
             return false;
         }
     }
 
+    // A region already on its way (a prefetch) is cheaper to wait for than to read around.
+    if (m_chunkReads && !inFlight) {
+        RegionEntry& entry = m_cache[key];
+        entry.partial = true;
+        touch(key);
+        evictIfNeeded();
+        m_pendingChunks.insert(coord);
+        queueChunkRead(key, coord);
+        return true;
+    }
+
     m_pendingChunks.insert(coord);
     m_regionPending[key].insert(coord);
     if (queueRegionLoad(key)) {
@@ -163,6 +252,30 @@ void AsyncChunkLoader::cancel(Voxel::ChunkCoord coord) {
     }
 }
 
+void AsyncChunkLoader::invalidateRegion(const RegionKey& key) {
+    if (m_format) {
+        m_format->chunkContainer().invalidateRegion(key);
+    }
+    eraseCacheEntry(key);
+    RegionPresence& presence = m_regionPresence[key];
+    presence.exists = true;
+    presence.nextCheck = std::chrono::steady_clock::time_point{};
+
+    // Reads of the old file cannot be stopped; stamping makes their results stale.
+    // Coords waiting on a whole-region load get a fresh one, chunk reads are
+    // reissued as their stale results drain.
+    ++m_regionGenerations[key];
+    m_streams.erase(key);
+    if (m_inFlight.erase(key) > 0 && m_regionPending.find(key) != m_regionPending.end()) {
+        queueRegionLoad(key);
+    }
+}
+
+uint64_t AsyncChunkLoader::regionGeneration(const RegionKey& key) const {
+    auto it = m_regionGenerations.find(key);
+    return it == m_regionGenerations.end() ? 0 : it->second;
+}
+
 void AsyncChunkLoader::drainCompletions(size_t budget) {
     {
         PROFILE_SCOPE("Streaming/LoadRegionDrain");
@@ -174,6 +287,7 @@ void AsyncChunkLoader::drainCompletions(size_t budget) {
             regionBudget = std::min(regionBudget, budget);
         }
         drainRegionCompletions(regionBudget);
+        drainChunkReadCompletions(regionBudget);
     }
     {
         PROFILE_SCOPE("Streaming/LoadPayloadDrain");
@@ -186,9 +300,22 @@ void AsyncChunkLoader::drainRegionCompletions(size_t budget) {
     RegionResult result;
     while (drained < budget && m_regionComplete.tryPop(result)) {
         ++drained;
-        m_inFlight.erase(result.key);
+        if (result.generation != regionGeneration(result.key)) {
+            continue;
+        }
+        if (result.frameIndex) {
+            applyRegionFrame(result);
+            continue;
+        }
         auto now = std::chrono::steady_clock::now();
         RegionPresence& presence = m_regionPresence[result.key];
+        if (result.streamed) {
+            presence.exists = true;
+            presence.nextCheck = std::chrono::steady_clock::time_point{};
+            beginRegionStream(result);
+            continue;
+        }
+        m_inFlight.erase(result.key);
         if (!result.ok) {
             presence.exists = false;
             presence.nextCheck = now + std::chrono::seconds(2);
@@ -205,7 +332,10 @@ void AsyncChunkLoader::drainRegionCompletions(size_t budget) {
             presence.exists = false;
             presence.nextCheck = now + std::chrono::seconds(2);
         }
-        m_cache[result.key] = std::move(result.entry);
+        RegionEntry& slot = m_cache[result.key];
+        m_cachedBytes -= slot.bytes;
+        slot = std::move(result.entry);
+        refreshEntryBytes(slot);
         touch(result.key);
         evictIfNeeded();
 
@@ -227,6 +357,214 @@ void AsyncChunkLoader::drainRegionCompletions(size_t budget) {
     }
 }
 
+void AsyncChunkLoader::beginRegionStream(RegionResult& header) {
+    RegionStream& stream = m_streams[header.key];
+    stream = RegionStream{};
+    stream.generation = header.generation;
+    stream.entry.region = std::make_shared<ChunkRegionSnapshot>();
+    stream.entry.region->key = header.key;
+    stream.frameCoords = std::move(header.frameCoords);
+    stream.remaining = stream.frameCoords.size();
+    for (const auto& coords : stream.frameCoords) {
+        if (coords.empty()) {
+            ++stream.unknownOutstanding;
+        }
+        for (const auto& coord : coords) {
+            ++stream.outstanding[coord];
+        }
+    }
+
+    // Coords no frame can hold are settled already: nothing is stored for them.
+    auto pendingIt = m_regionPending.find(header.key);
+    if (pendingIt == m_regionPending.end() || stream.unknownOutstanding > 0) {
+        return;
+    }
+    for (auto it = pendingIt->second.begin(); it != pendingIt->second.end();) {
+        if (stream.outstanding.find(*it) == stream.outstanding.end()) {
+            m_pendingChunks.erase(*it);
+            it = pendingIt->second.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AsyncChunkLoader::applyRegionFrame(RegionResult& frame) {
+    auto streamIt = m_streams.find(frame.key);
+    if (streamIt == m_streams.end() || streamIt->second.generation != frame.generation ||
+        *frame.frameIndex >= streamIt->second.frameCoords.size()) {
+        return;
+    }
+    RegionStream& stream = streamIt->second;
+    RegionEntry& entry = stream.entry;
+    stream.ok = stream.ok && frame.ok;
+    if (frame.piece && !frame.piece->chunks.empty()) {
+        for (const auto& snapshot : frame.piece->chunks) {
+            const ChunkSpan& span = snapshot.data.span;
+            Voxel::ChunkCoord coord{span.chunkX, span.chunkY, span.chunkZ};
+            entry.present.insert(coord);
+            entry.spansByCoord[coord].push_back(&snapshot);
+        }
+        entry.frames.push_back(std::move(frame.piece));
+    }
+    --stream.remaining;
+
+    // Settle the coords this frame was holding back.
+    std::vector<Voxel::ChunkCoord> settled;
+    const auto& coords = stream.frameCoords[*frame.frameIndex];
+    if (coords.empty()) {
+        if (--stream.unknownOutstanding == 0) {
+            for (const auto& [coord, count] : stream.outstanding) {
+                if (count == 0) {
+                    settled.push_back(coord);
+                }
+            }
+        }
+    } else {
+        for (const auto& coord : coords) {
+            auto it = stream.outstanding.find(coord);
+            if (it != stream.outstanding.end() && --it->second == 0) {
+                settled.push_back(coord);
+            }
+        }
+    }
+
+    auto pendingIt = m_regionPending.find(frame.key);
+    if (pendingIt != m_regionPending.end() && stream.ok) {
+        for (const auto& coord : settled) {
+            if (!streamCoordReady(stream, coord) || pendingIt->second.erase(coord) == 0) {
+                continue;
+            }
+            if (entry.present.find(coord) == entry.present.end()) {
+                m_pendingChunks.erase(coord);
+                continue;
+            }
+            queuePayloadBuild(entry, coord);
+        }
+    }
+
+    if (stream.remaining == 0) {
+        finishRegionStream(frame.key);
+    }
+}
+
+void AsyncChunkLoader::finishRegionStream(const RegionKey& key) {
+    auto streamIt = m_streams.find(key);
+    if (streamIt == m_streams.end()) {
+        return;
+    }
+    RegionStream stream = std::move(streamIt->second);
+    m_streams.erase(streamIt);
+    m_inFlight.erase(key);
+
+    if (!stream.ok) {
+        spdlog::warn("Region load failed ({} {} {}), treating as empty", key.x, key.y, key.z);
+        RegionPresence& presence = m_regionPresence[key];
+        presence.exists = false;
+        presence.nextCheck = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        stream.entry = RegionEntry{};
+        stream.entry.region = std::make_shared<ChunkRegionSnapshot>();
+        stream.entry.region->key = key;
+    }
+
+    RegionEntry& slot = m_cache[key];
+    m_cachedBytes -= slot.bytes;
+    slot = std::move(stream.entry);
+    refreshEntryBytes(slot);
+    touch(key);
+    evictIfNeeded();
+
+    // Anything still pending was requested after its frames settled or the load failed.
+    auto pendingIt = m_regionPending.find(key);
+    if (pendingIt == m_regionPending.end()) {
+        return;
+    }
+    auto cacheIt = m_cache.find(key);
+    for (const auto& coord : pendingIt->second) {
+        if (cacheIt == m_cache.end() ||
+            cacheIt->second.present.find(coord) == cacheIt->second.present.end()) {
+            m_pendingChunks.erase(coord);
+            continue;
+        }
+        queuePayloadBuild(cacheIt->second, coord);
+    }
+    m_regionPending.erase(pendingIt);
+}
+
+bool AsyncChunkLoader::streamCoordReady(const RegionStream& stream, Voxel::ChunkCoord coord) const {
+    if (stream.unknownOutstanding > 0) {
+        return false;
+    }
+    auto it = stream.outstanding.find(coord);
+    return it == stream.outstanding.end() || it->second == 0;
+}
+
+void AsyncChunkLoader::drainChunkReadCompletions(size_t budget) {
+    size_t drained = 0;
+    ChunkReadResult result;
+    while (drained < budget && m_chunkReadComplete.tryPop(result)) {
+        ++drained;
+        m_chunkReadInFlight.erase(result.coord);
+        if (result.generation != regionGeneration(result.key)) {
+            // Read from a file rewritten since; ask again if the coord still wants it.
+            if (m_pendingChunks.find(result.coord) != m_pendingChunks.end() &&
+                !request(result.coord)) {
+                m_pendingChunks.erase(result.coord);
+            }
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        RegionPresence& presence = m_regionPresence[result.key];
+        if (result.ok && result.exists) {
+            presence.exists = true;
+            presence.nextCheck = std::chrono::steady_clock::time_point{};
+        } else {
+            presence.exists = false;
+            presence.nextCheck = now + std::chrono::seconds(2);
+        }
+
+        // Evicted while the read was in flight: the next request() reads again.
+        auto cacheIt = m_cache.find(result.key);
+        if (cacheIt == m_cache.end()) {
+            continue;
+        }
+        RegionEntry& entry = cacheIt->second;
+        if (entry.partial) {
+            if (result.ok && !result.exists) {
+                // Nothing stored for this region at all; answer every coord at once.
+                m_cachedBytes -= entry.bytes;
+                entry = RegionEntry{};
+                entry.region = std::make_shared<ChunkRegionSnapshot>();
+                entry.region->key = result.key;
+            } else {
+                entry.probed.insert(result.coord);
+                if (result.ok && result.piece && !result.piece->chunks.empty()) {
+                    auto& spans = entry.spansByCoord[result.coord];
+                    spans.clear();
+                    for (const auto& snapshot : result.piece->chunks) {
+                        spans.push_back(&snapshot);
+                    }
+                    entry.present.insert(result.coord);
+                    entry.pieces[result.coord] = std::move(result.piece);
+                }
+            }
+            refreshEntryBytes(entry);
+            // Keeps `entry` alive: the most recently used region is never evicted.
+            touch(result.key);
+            evictIfNeeded();
+        }
+
+        if (m_pendingChunks.find(result.coord) == m_pendingChunks.end()) {
+            continue;
+        }
+        if (entry.present.find(result.coord) == entry.present.end()) {
+            m_pendingChunks.erase(result.coord);
+            continue;
+        }
+        queuePayloadBuild(entry, result.coord);
+    }
+}
+
 void AsyncChunkLoader::drainPayloadCompletions(size_t budget) {
     size_t applied = 0;
     ChunkPayload payload;
@@ -289,14 +627,12 @@ bool AsyncChunkLoader::queueRegionLoad(const RegionKey& key) {
     }
 
     m_inFlight.insert(key);
-    PersistenceService* servicePtr = m_service;
-    PersistenceContext contextCopy = m_context;
-
-    auto job = [this, servicePtr, contextCopy, key]() mutable {
+    const uint64_t generation = regionGeneration(key);
+    auto job = [this, jobFormat = m_format, key, generation]() {
         RegionResult result;
         result.key = key;
+        result.generation = generation;
         try {
-            auto jobFormat = servicePtr->openFormat(contextCopy);
             result.exists = jobFormat->chunkContainer().regionExists(key);
             if (!result.exists) {
                 RegionEntry entry;
@@ -307,7 +643,57 @@ bool AsyncChunkLoader::queueRegionLoad(const RegionKey& key) {
                 m_regionComplete.push(std::move(result));
                 return;
             }
-            ChunkRegionSnapshot region = jobFormat->chunkContainer().loadRegion(key);
+            std::vector<RegionFrame> frames = jobFormat->chunkContainer().readRegionFrames(key);
+            if (frames.size() > 1) {
+                result.streamed = true;
+                result.ok = true;
+                const RegionLayout& layout = jobFormat->regionLayout();
+                result.frameCoords.reserve(frames.size());
+                for (const auto& frame : frames) {
+                    std::vector<Voxel::ChunkCoord> coords;
+                    for (const auto& storageKey : frame.keys) {
+                        ChunkSpan span = layout.spanForStorageKey(storageKey);
+                        Voxel::ChunkCoord coord{span.chunkX, span.chunkY, span.chunkZ};
+                        if (std::find(coords.begin(), coords.end(), coord) == coords.end()) {
+                            coords.push_back(coord);
+                        }
+                    }
+                    result.frameCoords.push_back(std::move(coords));
+                }
+                // The header is queued before any frame so the main thread sees it first.
+                m_regionComplete.push(std::move(result));
+                for (size_t i = 0; i < frames.size(); ++i) {
+                    auto decodeJob = [this, jobFormat, key, generation, i,
+                                      decode = std::move(frames[i].decode)]() {
+                        RegionResult part;
+                        part.key = key;
+                        part.generation = generation;
+                        part.frameIndex = i;
+                        part.piece = std::make_shared<ChunkRegionSnapshot>();
+                        part.piece->key = key;
+                        try {
+                            part.piece->chunks = decode();
+                            part.ok = true;
+                        } catch (const std::exception& e) {
+                            spdlog::warn("Async region frame decode failed ({} {} {}): {}",
+                                         key.x, key.y, key.z, e.what());
+                        }
+                        m_regionComplete.push(std::move(part));
+                    };
+                    if (m_workerPool.threadCount() > 0) {
+                        m_workerPool.enqueue(std::move(decodeJob));
+                    } else {
+                        decodeJob();
+                    }
+                }
+                return;
+            }
+
+            ChunkRegionSnapshot region;
+            region.key = key;
+            if (!frames.empty()) {
+                region.chunks = frames.front().decode();
+            }
             RegionEntry entry;
             entry.region = std::make_shared<ChunkRegionSnapshot>(std::move(region));
             entry.present.reserve(entry.region->chunks.size());
@@ -337,6 +723,90 @@ bool AsyncChunkLoader::queueRegionLoad(const RegionKey& key) {
     return true;
 }
 
+bool AsyncChunkLoader::queueChunkRead(const RegionKey& key, Voxel::ChunkCoord coord) {
+    if (!m_chunkReadInFlight.insert(coord).second) {
+        return false;
+    }
+
+    std::vector<ChunkKey> storageKeys = m_format->regionLayout().storageKeysForChunk(m_zoneId, coord);
+
+    const uint64_t generation = regionGeneration(key);
+    auto job = [this, jobFormat = m_format, key, coord, generation,
+                storageKeys = std::move(storageKeys)]() mutable {
+        ChunkReadResult result;
+        result.key = key;
+        result.coord = coord;
+        result.generation = generation;
+        std::vector<ChunkFrameDecoder> frames;
+        try {
+            ChunkContainer& container = jobFormat->chunkContainer();
+            result.exists = container.regionExists(key);
+            if (result.exists) {
+                frames = container.readChunkFrames(key, storageKeys);
+            }
+            result.ok = true;
+        } catch (const std::exception& e) {
+            spdlog::warn("Async chunk read failed ({} {} {}): {}",
+                         coord.x, coord.y, coord.z, e.what());
+            result.ok = false;
+        }
+        result.piece = std::make_shared<ChunkRegionSnapshot>();
+        result.piece->key = key;
+
+        if (frames.size() <= 1 || m_workerPool.threadCount() == 0) {
+            try {
+                for (auto& decode : frames) {
+                    auto chunks = decode();
+                    std::move(chunks.begin(), chunks.end(), std::back_inserter(result.piece->chunks));
+                }
+            } catch (const std::exception& e) {
+                spdlog::warn("Async chunk decode failed ({} {} {}): {}",
+                             coord.x, coord.y, coord.z, e.what());
+                result.ok = false;
+            }
+            m_chunkReadComplete.push(std::move(result));
+            return;
+        }
+
+        // Independent frames (CR columns) decompress in parallel; the last one to
+        // finish publishes the result. jobFormat keeps the container alive meanwhile.
+        struct FrameJoin {
+            std::mutex mutex;
+            ChunkReadResult result;
+            size_t remaining = 0;
+        };
+        auto join = std::make_shared<FrameJoin>();
+        join->result = std::move(result);
+        join->remaining = frames.size();
+        for (auto& decode : frames) {
+            m_workerPool.enqueue([this, join, jobFormat, decode = std::move(decode), coord]() {
+                std::vector<ChunkSnapshot> chunks;
+                bool ok = true;
+                try {
+                    chunks = decode();
+                } catch (const std::exception& e) {
+                    spdlog::warn("Async chunk decode failed ({} {} {}): {}",
+                                 coord.x, coord.y, coord.z, e.what());
+                    ok = false;
+                }
+                std::lock_guard<std::mutex> lock(join->mutex);
+                std::move(chunks.begin(), chunks.end(), std::back_inserter(join->result.piece->chunks));
+                join->result.ok = join->result.ok && ok;
+                if (--join->remaining == 0) {
+                    m_chunkReadComplete.push(std::move(join->result));
+                }
+            });
+        }
+    };
+
+    if (m_ioPool.threadCount() > 0) {
+        m_ioPool.enqueue(std::move(job));
+    } else {
+        job();
+    }
+    return true;
+}
+
 void AsyncChunkLoader::queuePayloadBuild(const RegionEntry& entry, Voxel::ChunkCoord coord) {
     if (!m_generator || !m_world) {
         return;
@@ -348,44 +818,47 @@ void AsyncChunkLoader::queuePayloadBuild(const RegionEntry& entry, Voxel::ChunkC
     if (spanIt == entry.spansByCoord.end()) {
         return;
     }
-    if (!entry.region) {
+    // Snapshots the spans point into; the job keeps them alive past eviction.
+    std::vector<std::shared_ptr<ChunkRegionSnapshot>> owners;
+    if (entry.partial) {
+        auto pieceIt = entry.pieces.find(coord);
+        if (pieceIt != entry.pieces.end()) {
+            owners.push_back(pieceIt->second);
+        }
+    } else if (!entry.frames.empty()) {
+        owners = entry.frames;
+    } else if (entry.region) {
+        owners.push_back(entry.region);
+    }
+    if (owners.empty()) {
         return;
     }
 
     m_payloadInFlight.insert(coord);
     auto generator = m_generator;
-    auto registry = &m_world->blockRegistry();
     std::vector<const ChunkSnapshot*> spans = spanIt->second;
-    std::shared_ptr<ChunkRegionSnapshot> region = entry.region;
 
-    auto job = [this, coord, spans = std::move(spans), generator, registry, region]() mutable {
+    auto job = [this, coord, spans = std::move(spans), generator, owners = std::move(owners)]() mutable {
         ChunkPayload payload;
         payload.coord = coord;
         payload.worldGenVersion = generator ? generator->config().world.version : 0;
         payload.loadedFromDisk = true;
-        if (!region) {
-            payload.cancelled = true;
-            m_chunkComplete.push(std::move(payload));
-            return;
-        }
 
-        Voxel::Chunk temp(coord);
-    ChunkBaseFillFn baseFill;
-    bool allowBaseFill = false;
-    if (m_format) {
-        allowBaseFill = m_format->descriptor().capabilities.fillMissingChunkSpans;
-    }
-    if (allowBaseFill && generator) {
-        baseFill = [generator, coord](Voxel::Chunk& target, const Voxel::BlockRegistry& reg) {
-            Voxel::ChunkBuffer buffer;
-            generator->generate(coord, buffer, nullptr);
-            target.copyFrom(buffer.blocks, reg);
-            target.clearPersistDirty();
-        };
-    }
-        auto mergeResult = mergeChunkSpans(temp, *registry, spans, baseFill);
-        temp.copyBlocks(payload.blocks.blocks);
-        payload.empty = temp.isEmpty();
+        // Spans are written straight into the payload buffer. The generator only
+        // runs when they leave cells uncovered, and it writes into the same buffer.
+        ChunkBlocksBaseFillFn baseFill;
+        bool allowBaseFill = false;
+        if (m_format) {
+            allowBaseFill = m_format->descriptor().capabilities.fillMissingChunkSpans;
+        }
+        if (allowBaseFill && generator) {
+            baseFill = [generator, coord, &payload](std::span<Voxel::BlockState>) {
+                generator->generate(coord, payload.blocks, nullptr);
+            };
+        }
+        auto mergeResult = mergeChunkSpans(payload.blocks.blocks, spans, baseFill);
+        payload.empty = std::all_of(payload.blocks.blocks.begin(), payload.blocks.blocks.end(),
+                                    [](const Voxel::BlockState& block) { return block.isAir(); });
         payload.cancelled = false;
         payload.loadedFromDisk = mergeResult.loadedFromDisk;
         m_chunkComplete.push(std::move(payload));
@@ -403,27 +876,50 @@ void AsyncChunkLoader::prefetchNeighbors(const RegionKey& center) {
         return;
     }
     struct Candidate {
-        int distSq;
+        float score;
         int dx;
         int dy;
         int dz;
     };
+
+    // Moving viewers extend the ring into a tube along their heading, as far as they
+    // travel in kPrefetchLookaheadSeconds (capped at twice the radius).
+    const int radius = m_prefetchRadius;
+    glm::vec3 heading(0.0f);
+    int lookahead = 0;
+    const float speed = glm::length(m_viewerVelocity) / static_cast<float>(m_regionSpan);
+    if (speed > kMinHeadingSpeed) {
+        heading = m_viewerVelocity / glm::length(m_viewerVelocity);
+        lookahead = std::min(radius * 2,
+                             static_cast<int>(std::ceil(speed * kPrefetchLookaheadSeconds)));
+    }
+    const int reach = radius + lookahead;
+
     std::vector<Candidate> candidates;
-    int radius = std::max(1, m_prefetchRadius);
-    for (int dz = -radius; dz <= radius; ++dz) {
-        for (int dy = -radius; dy <= radius; ++dy) {
-            for (int dx = -radius; dx <= radius; ++dx) {
+    for (int dz = -reach; dz <= reach; ++dz) {
+        for (int dy = -reach; dy <= reach; ++dy) {
+            for (int dx = -reach; dx <= reach; ++dx) {
                 if (dx == 0 && dy == 0 && dz == 0) {
                     continue;
                 }
-                int distSq = dx * dx + dy * dy + dz * dz;
-                candidates.push_back({distSq, dx, dy, dz});
+                const glm::vec3 offset(static_cast<float>(dx), static_cast<float>(dy), static_cast<float>(dz));
+                const float dist = glm::length(offset);
+                const float along = glm::dot(offset, heading);
+                const bool inRing = std::max({std::abs(dx), std::abs(dy), std::abs(dz)}) <= radius;
+                if (!inRing) {
+                    const float lateralSq = std::max(0.0f, dist * dist - along * along);
+                    if (along <= 0.0f || along > static_cast<float>(reach) ||
+                        lateralSq > static_cast<float>(radius * radius)) {
+                        continue;
+                    }
+                }
+                candidates.push_back({dist - kHeadingWeight * along, dx, dy, dz});
             }
         }
     }
     std::sort(candidates.begin(), candidates.end(),
               [](const Candidate& a, const Candidate& b) {
-                  return a.distSq < b.distSq;
+                  return a.score < b.score;
               });
 
     size_t queued = 0;
@@ -439,6 +935,9 @@ void AsyncChunkLoader::prefetchNeighbors(const RegionKey& center) {
         neighbor.x += candidate.dx;
         neighbor.y += candidate.dy;
         neighbor.z += candidate.dz;
+        if (!regionMayExist(neighbor)) {
+            continue;
+        }
         if (queueRegionLoad(neighbor)) {
             ++queued;
         }
@@ -446,22 +945,53 @@ void AsyncChunkLoader::prefetchNeighbors(const RegionKey& center) {
 }
 
 void AsyncChunkLoader::touch(const RegionKey& key) {
-    auto it = std::find(m_lru.begin(), m_lru.end(), key);
-    if (it != m_lru.end()) {
-        m_lru.erase(it);
+    auto it = m_lruIndex.find(key);
+    if (it != m_lruIndex.end()) {
+        m_lru.splice(m_lru.end(), m_lru, it->second);
+        return;
     }
-    m_lru.push_back(key);
+    m_lruIndex.emplace(key, m_lru.insert(m_lru.end(), key));
 }
 
 void AsyncChunkLoader::evictIfNeeded() {
-    if (m_maxCachedRegions == 0) {
-        return;
+    auto overLimit = [&]() {
+        return (m_maxCachedRegions > 0 && m_cache.size() > m_maxCachedRegions) ||
+            (m_maxCachedBytes > 0 && m_cachedBytes > m_maxCachedBytes);
+    };
+    while (m_lru.size() > 1 && overLimit()) {
+        RegionKey oldest = m_lru.front();
+        eraseCacheEntry(oldest);
+    }
+}
+
+void AsyncChunkLoader::eraseCacheEntry(const RegionKey& key) {
+    auto cacheIt = m_cache.find(key);
+    if (cacheIt != m_cache.end()) {
+        m_cachedBytes -= cacheIt->second.bytes;
+        m_cache.erase(cacheIt);
+    }
+    auto lruIt = m_lruIndex.find(key);
+    if (lruIt != m_lruIndex.end()) {
+        m_lru.erase(lruIt->second);
+        m_lruIndex.erase(lruIt);
+    }
+}
+
+void AsyncChunkLoader::refreshEntryBytes(RegionEntry& entry) {
+    size_t bytes = sizeof(RegionEntry);
+    if (entry.partial) {
+        for (const auto& [coord, piece] : entry.pieces) {
+            bytes += piece ? regionBytes(*piece) : 0;
+        }
+    } else if (entry.region) {
+        bytes += regionBytes(*entry.region);
     }
-    while (m_cache.size() > m_maxCachedRegions && !m_lru.empty()) {
-        RegionKey key = m_lru.front();
-        m_lru.pop_front();
-        m_cache.erase(key);
+    for (const auto& frame : entry.frames) {
+        bytes += frame ? regionBytes(*frame) : 0;
     }
+    m_cachedBytes -= entry.bytes;
+    entry.bytes = bytes;
+    m_cachedBytes += entry.bytes;
 }
 
 int AsyncChunkLoader::estimateRegionSpan() const {
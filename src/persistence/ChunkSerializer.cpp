@@ -1,5 +1,6 @@
 #include "Rigel/Persistence/ChunkSerializer.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace Rigel::Persistence {
@@ -86,4 +87,29 @@ void applyChunkData(const ChunkData& data, Voxel::Chunk& chunk, const Voxel::Blo
     }
 }
 
+void applyChunkData(const ChunkData& data, std::span<Voxel::BlockState> blocks) {
+    const ChunkSpan& span = data.span;
+    validateSpan(span);
+
+    if (data.blocks.size() != spanVolume(span)) {
+        throw std::runtime_error("ChunkSerializer: block data size mismatch");
+    }
+    if (blocks.size() != static_cast<size_t>(Voxel::Chunk::VOLUME)) {
+        throw std::runtime_error("ChunkSerializer: target block array size mismatch");
+    }
+
+    constexpr int kSize = Voxel::Chunk::SIZE;
+    for (int z = 0; z < span.sizeZ; ++z) {
+        for (int y = 0; y < span.sizeY; ++y) {
+            const size_t src = static_cast<size_t>(z * span.sizeX + y * span.sizeX * span.sizeZ);
+            const size_t dst = static_cast<size_t>(span.offsetX +
+                (span.offsetY + y) * kSize +
+                (span.offsetZ + z) * kSize * kSize);
+            std::copy_n(data.blocks.begin() + static_cast<std::ptrdiff_t>(src),
+                        span.sizeX,
+                        blocks.begin() + static_cast<std::ptrdiff_t>(dst));
+        }
+    }
+}
+
 } // namespace Rigel::Persistence
@@ -2,6 +2,8 @@
 
 #include "Rigel/Persistence/ChunkSerializer.h"
 
+#include <bitset>
+
 namespace Rigel::Persistence {
 
 namespace {
@@ -22,19 +24,45 @@ bool isSubchunkSpan(const ChunkSpan& span) {
         span.offsetY % Voxel::Chunk::SUBCHUNK_SIZE == 0 &&
         span.offsetZ % Voxel::Chunk::SUBCHUNK_SIZE == 0;
 }
+
+bool isInsideChunk(const ChunkSpan& span) {
+    return span.sizeX > 0 && span.sizeY > 0 && span.sizeZ > 0 &&
+        span.offsetX >= 0 && span.offsetY >= 0 && span.offsetZ >= 0 &&
+        span.offsetX + span.sizeX <= Voxel::Chunk::SIZE &&
+        span.offsetY + span.sizeY <= Voxel::Chunk::SIZE &&
+        span.offsetZ + span.sizeZ <= Voxel::Chunk::SIZE;
 }
 
-ChunkSpanMergeResult mergeChunkSpans(
-    Voxel::Chunk& chunk,
-    const Voxel::BlockRegistry& registry,
-    std::span<const ChunkSnapshot* const> spans,
-    const ChunkBaseFillFn& baseFill) {
+// Marks covered cells for spans that are neither full chunks nor whole subchunks
+// (e.g. slabs); most loads are decided by the cheaper checks before this.
+bool cellsCovered(std::span<const ChunkSnapshot* const> spans) {
+    constexpr int kSize = Voxel::Chunk::SIZE;
+    std::bitset<Voxel::Chunk::VOLUME> covered;
+    for (const ChunkSnapshot* snapshot : spans) {
+        if (!snapshot || !isInsideChunk(snapshot->data.span)) {
+            continue;
+        }
+        const ChunkSpan& span = snapshot->data.span;
+        for (int z = span.offsetZ; z < span.offsetZ + span.sizeZ; ++z) {
+            for (int y = span.offsetY; y < span.offsetY + span.sizeY; ++y) {
+                const size_t row = static_cast<size_t>(y * kSize + z * kSize * kSize);
+                for (int x = span.offsetX; x < span.offsetX + span.sizeX; ++x) {
+                    covered.set(row + static_cast<size_t>(x));
+                }
+            }
+        }
+    }
+    return covered.all();
+}
+
+ChunkSpanMergeResult summarizeSpans(std::span<const ChunkSnapshot* const> spans) {
     ChunkSpanMergeResult result;
     if (spans.empty()) {
         return result;
     }
 
     result.loadedFromDisk = true;
+    bool irregular = false;
     for (const ChunkSnapshot* snapshot : spans) {
         if (!snapshot) {
             continue;
@@ -42,8 +70,7 @@ ChunkSpanMergeResult mergeChunkSpans(
         const ChunkSpan& span = snapshot->data.span;
         if (isFullSpan(span)) {
             result.fullSpan = true;
-        }
-        if (isSubchunkSpan(span)) {
+        } else if (isSubchunkSpan(span)) {
             int sx = span.offsetX / Voxel::Chunk::SUBCHUNK_SIZE;
             int sy = span.offsetY / Voxel::Chunk::SUBCHUNK_SIZE;
             int sz = span.offsetZ / Voxel::Chunk::SUBCHUNK_SIZE;
@@ -51,16 +78,30 @@ ChunkSpanMergeResult mergeChunkSpans(
                 int index = sx + (sy << 1) + (sz << 2);
                 result.subchunkMask = static_cast<uint8_t>(result.subchunkMask | (1u << index));
             }
+        } else {
+            irregular = true;
         }
     }
 
     if (result.fullSpan) {
         result.subchunkMask = 0xFF;
     }
+    result.fullyCovered = result.subchunkMask == 0xFF || (irregular && cellsCovered(spans));
+    return result;
+}
+}
+
+ChunkSpanMergeResult mergeChunkSpans(
+    Voxel::Chunk& chunk,
+    const Voxel::BlockRegistry& registry,
+    std::span<const ChunkSnapshot* const> spans,
+    const ChunkBaseFillFn& baseFill) {
+    ChunkSpanMergeResult result = summarizeSpans(spans);
+    if (!result.loadedFromDisk) {
+        return result;
+    }
 
-    if (!result.fullSpan &&
-        result.subchunkMask != 0xFF &&
-        baseFill) {
+    if (!result.fullyCovered && baseFill) {
         baseFill(chunk, registry);
         result.appliedBase = true;
     }
@@ -75,4 +116,29 @@ ChunkSpanMergeResult mergeChunkSpans(
     return result;
 }
 
+ChunkSpanMergeResult mergeChunkSpans(
+    std::span<Voxel::BlockState> blocks,
+    std::span<const ChunkSnapshot* const> spans,
+    const ChunkBlocksBaseFillFn& baseFill) {
+    ChunkSpanMergeResult result = summarizeSpans(spans);
+    if (!result.loadedFromDisk) {
+        return result;
+    }
+
+    if (!result.fullyCovered && baseFill) {
+        baseFill(blocks);
+        result.appliedBase = true;
+    }
+
+    for (const ChunkSnapshot* snapshot : spans) {
+        if (!snapshot) {
+            continue;
+        }
+        applyChunkData(snapshot->data, blocks);
+    }
+
+    return result;
+}
+
 } // namespace Rigel::Persistence
+
@@ -89,6 +89,19 @@ void PersistenceConfig::applyYaml(const char* sourceName, const std::string& yam
         "zone_id",
         Util::readString(persistenceNode, "zoneId", zoneId));
 
+    if (persistenceNode.has_child("autosave")) {
+        ryml::ConstNodeRef autosaveNode = persistenceNode["autosave"];
+        autosave.enabled = Util::readBool(autosaveNode, "enabled", autosave.enabled);
+        autosave.chunksPerFrame = Util::readInt(autosaveNode, "chunks_per_frame", autosave.chunksPerFrame);
+        autosave.maxInFlightRegions =
+            Util::readInt(autosaveNode, "max_in_flight_regions", autosave.maxInFlightRegions);
+        autosave.settleSeconds = Util::readFloat(autosaveNode, "settle_seconds", autosave.settleSeconds);
+        autosave.maxDirtyAgeSeconds =
+            Util::readFloat(autosaveNode, "max_dirty_age_seconds", autosave.maxDirtyAgeSeconds);
+        autosave.ioThreads = Util::readInt(autosaveNode, "io_threads", autosave.ioThreads);
+        autosave.batchCommits = Util::readBool(autosaveNode, "batch_commits", autosave.batchCommits);
+    }
+
     if (persistenceNode.has_child("providers")) {
         ryml::ConstNodeRef providersNode = persistenceNode["providers"];
         if (providersNode.is_map()) {
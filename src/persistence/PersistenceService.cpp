@@ -2,6 +2,7 @@
 #include "Rigel/Persistence/Storage.h"
 
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -17,6 +18,11 @@ std::string parentPath(const std::string& path) {
     return path.substr(0, pos);
 }
 
+template <typename T>
+bool sameOwner(const std::weak_ptr<T>& cached, const std::shared_ptr<T>& current) {
+    return !cached.owner_before(current) && !current.owner_before(cached);
+}
+
 } // namespace
 
 PersistenceService::PersistenceService(FormatRegistry& registry)
@@ -27,6 +33,64 @@ std::unique_ptr<PersistenceFormat> PersistenceService::openFormat(const Persiste
     return resolve(context);
 }
 
+std::shared_ptr<PersistenceFormat> PersistenceService::sharedFormat(const PersistenceContext& context) const {
+    std::scoped_lock lock(m_sharedMutex);
+    std::erase_if(m_sharedFormats, [](const SharedFormatEntry& entry) {
+        return entry.storage.expired() || (entry.hasProviders && entry.providers.expired());
+    });
+    for (const auto& entry : m_sharedFormats) {
+        if (sameOwner(entry.storage, context.storage) &&
+            sameOwner(entry.providers, context.providers) &&
+            entry.rootPath == context.rootPath &&
+            entry.preferredFormat == context.preferredFormat &&
+            entry.manifestPath == context.manifestPath &&
+            entry.policies.unknownBlockPolicy == context.policies.unknownBlockPolicy &&
+            entry.policies.unknownEntityPolicy == context.policies.unknownEntityPolicy &&
+            entry.policies.unsupportedFeaturePolicy == context.policies.unsupportedFeaturePolicy) {
+            return entry.format;
+        }
+    }
+
+    // Resolution failures propagate without caching, so a world that has no files yet
+    // is probed again on the next call.
+    SharedFormatEntry entry;
+    entry.rootPath = context.rootPath;
+    entry.preferredFormat = context.preferredFormat;
+    entry.manifestPath = context.manifestPath;
+    entry.policies = context.policies;
+    entry.storage = context.storage;
+    entry.providers = context.providers;
+    entry.hasProviders = context.providers != nullptr;
+    entry.format = resolve(context);
+    m_sharedFormats.push_back(std::move(entry));
+    return m_sharedFormats.back().format;
+}
+
+void PersistenceService::releaseWorldFormats(const std::shared_ptr<ProviderRegistry>& providers) {
+    if (!providers) {
+        return;
+    }
+    std::scoped_lock lock(m_sharedMutex);
+    std::erase_if(m_sharedFormats, [&](const SharedFormatEntry& entry) {
+        return sameOwner(entry.providers, providers);
+    });
+}
+
+void PersistenceService::releaseStorageFormats(const std::shared_ptr<StorageBackend>& storage) {
+    if (!storage) {
+        return;
+    }
+    std::scoped_lock lock(m_sharedMutex);
+    std::erase_if(m_sharedFormats, [&](const SharedFormatEntry& entry) {
+        return sameOwner(entry.storage, storage);
+    });
+}
+
+void PersistenceService::clearSharedFormats() {
+    std::scoped_lock lock(m_sharedMutex);
+    m_sharedFormats.clear();
+}
+
 std::unique_ptr<PersistenceFormat> PersistenceService::resolve(const PersistenceContext& context) const {
     return m_registry.resolveFormat(context);
 }
@@ -1,8 +1,22 @@
 #include "Rigel/Persistence/Storage.h"
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <spdlog/spdlog.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace Rigel::Persistence {
 
@@ -216,13 +230,399 @@ private:
     FileByteWriter m_writer;
 };
 
+constexpr const char* kBatchTempSuffix = ".batchtmp";
+constexpr const char* kJournalPrefix = ".batch-";
+constexpr const char* kJournalSuffix = ".journal";
+constexpr const char* kJournalTempSuffix = ".journal.tmp";
+
+bool endsWith(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() &&
+        value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// fsync of a file or directory; a no-op where POSIX fsync is unavailable.
+void syncPath(const std::string& path, bool directory) {
+#if defined(__unix__) || defined(__APPLE__)
+    int flags = O_RDONLY;
+#if defined(O_DIRECTORY)
+    if (directory) {
+        flags |= O_DIRECTORY;
+    }
+#endif
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open for sync: " + path);
+    }
+    int rc = ::fsync(fd);
+    ::close(fd);
+    if (rc != 0) {
+        throw std::runtime_error("Failed to sync: " + path);
+    }
+#else
+    (void)path;
+    (void)directory;
+#endif
+}
+
+// One barrier for every file written under `root`: syncfs flushes the whole
+// filesystem once instead of one fsync per region file.
+void syncBatchData(const std::string& root, const std::vector<std::string>& files) {
+#if defined(__linux__)
+    int fd = ::open(root.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        int rc = ::syncfs(fd);
+        ::close(fd);
+        if (rc == 0) {
+            return;
+        }
+    }
+#else
+    (void)root;
+#endif
+    for (const auto& file : files) {
+        syncPath(file, false);
+    }
+}
+
+std::string parentDirectory(const std::string& path) {
+    std::string parent = std::filesystem::path(path).parent_path().string();
+    return parent.empty() ? std::string(".") : parent;
+}
+
+void renameReplacing(const std::string& from, const std::string& to) {
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to rename " + from + " to " + to);
+    }
+}
+
+// Journal: one field per line.
+//   W <temp> <final>   rename temp over final
+//   R <path>           remove path
+//   COMMIT <count>     trailer; a journal without it was never committed
+struct BatchJournal {
+    std::vector<std::pair<std::string, std::string>> writes;
+    std::vector<std::string> removals;
+};
+
+void writeJournal(const std::string& path, const BatchJournal& journal) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open batch journal: " + path);
+    }
+    for (const auto& [temp, final] : journal.writes) {
+        out << "W\n" << temp << '\n' << final << '\n';
+    }
+    for (const auto& removed : journal.removals) {
+        out << "R\n" << removed << '\n';
+    }
+    out << "COMMIT " << (journal.writes.size() + journal.removals.size()) << '\n';
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Failed to write batch journal: " + path);
+    }
+}
+
+bool readJournal(const std::string& path, BatchJournal& journal) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line == "W") {
+            std::string temp;
+            std::string final;
+            if (!std::getline(in, temp) || !std::getline(in, final)) {
+                return false;
+            }
+            journal.writes.emplace_back(std::move(temp), std::move(final));
+        } else if (line == "R") {
+            std::string removed;
+            if (!std::getline(in, removed)) {
+                return false;
+            }
+            journal.removals.push_back(std::move(removed));
+        } else if (line.rfind("COMMIT ", 0) == 0) {
+            std::istringstream count(line.substr(7));
+            size_t expected = 0;
+            count >> expected;
+            return !count.fail() && expected == journal.writes.size() + journal.removals.size();
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+void applyJournal(const BatchJournal& journal) {
+    for (const auto& [temp, final] : journal.writes) {
+        if (std::filesystem::exists(temp)) {
+            renameReplacing(temp, final);
+        }
+    }
+    for (const auto& removed : journal.removals) {
+        std::error_code ec;
+        std::filesystem::remove(removed, ec);
+    }
+}
+
+// Applies a committed journal, makes the renames durable and retires the journal.
+// Safe to repeat: writes whose temp is gone were already applied.
+void completeJournal(const std::string& journalPath, const BatchJournal& journal) {
+    std::set<std::string> directories;
+    for (const auto& [temp, final] : journal.writes) {
+        directories.insert(parentDirectory(final));
+    }
+    for (const auto& removed : journal.removals) {
+        directories.insert(parentDirectory(removed));
+    }
+    applyJournal(journal);
+    for (const auto& directory : directories) {
+        syncPath(directory, true);
+    }
+    std::filesystem::remove(journalPath);
+}
+
+std::string nextBatchId() {
+    static std::atomic<uint64_t> counter{0};
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    return std::to_string(static_cast<uint64_t>(ticks)) + "-" + std::to_string(counter.fetch_add(1));
+}
+
+class FilesystemBatch;
+
+class BatchFileWriteSession final : public AtomicWriteSession {
+public:
+    BatchFileWriteSession(std::shared_ptr<FilesystemBatch> batch, std::string finalPath, std::string tempPath)
+        : m_batch(std::move(batch)),
+          m_finalPath(std::move(finalPath)),
+          m_tempPath(std::move(tempPath)),
+          m_writer(m_tempPath) {
+    }
+
+    ByteWriter& writer() override {
+        return m_writer;
+    }
+
+    void commit() override;
+
+    void abort() override {
+        std::error_code ec;
+        std::filesystem::remove(m_tempPath, ec);
+    }
+
+private:
+    std::shared_ptr<FilesystemBatch> m_batch;
+    std::string m_finalPath;
+    std::string m_tempPath;
+    FileByteWriter m_writer;
+};
+
+class FilesystemBatch final : public StorageBatch, public std::enable_shared_from_this<FilesystemBatch> {
+public:
+    FilesystemBatch(FilesystemBackend& backend, std::string root)
+        : m_backend(backend), m_root(std::move(root)), m_id(nextBatchId()) {
+    }
+
+    ~FilesystemBatch() override {
+        if (!m_finished) {
+            discardTemps();
+        }
+    }
+
+    std::unique_ptr<ByteReader> openRead(const std::string& path) override {
+        std::string source = path;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_removals.count(path) > 0) {
+                throw std::runtime_error("Failed to open file for reading: " + path);
+            }
+            auto it = m_writes.find(path);
+            if (it != m_writes.end()) {
+                source = it->second;
+            }
+        }
+        return m_backend.openRead(source);
+    }
+
+    std::unique_ptr<AtomicWriteSession> openWrite(const std::string& path, AtomicWriteOptions options) override {
+        (void)options;
+        requireOpen();
+        std::filesystem::path p(path);
+        std::filesystem::create_directories(p.parent_path());
+        std::string tempPath = path + "." + m_id + kBatchTempSuffix;
+        return std::make_unique<BatchFileWriteSession>(shared_from_this(), path, std::move(tempPath));
+    }
+
+    bool exists(const std::string& path) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_removals.count(path) > 0) {
+                return false;
+            }
+            if (m_writes.count(path) > 0) {
+                return true;
+            }
+        }
+        return m_backend.exists(path);
+    }
+
+    std::vector<std::string> list(const std::string& path) override {
+        return m_backend.list(path);
+    }
+
+    void mkdirs(const std::string& path) override {
+        m_backend.mkdirs(path);
+    }
+
+    void remove(const std::string& path) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        requireOpenLocked();
+        auto it = m_writes.find(path);
+        if (it != m_writes.end()) {
+            std::error_code ec;
+            std::filesystem::remove(it->second, ec);
+            m_writes.erase(it);
+        }
+        m_removals.insert(path);
+    }
+
+    void stageWrite(const std::string& finalPath, const std::string& tempPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        requireOpenLocked();
+        m_removals.erase(finalPath);
+        m_writes[finalPath] = tempPath;
+    }
+
+    void commit() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        requireOpenLocked();
+        m_finished = true;
+        if (m_writes.empty() && m_removals.empty()) {
+            return;
+        }
+
+        BatchJournal journal;
+        std::vector<std::string> temps;
+        for (const auto& [final, temp] : m_writes) {
+            journal.writes.emplace_back(temp, final);
+            temps.push_back(temp);
+        }
+        for (const auto& removed : m_removals) {
+            journal.removals.push_back(removed);
+        }
+
+        // The journal rename is the commit point: recovery rolls a batch forward
+        // only once its journal exists under its final name.
+        const std::string journalPath = journalBase() + kJournalSuffix;
+        bool journalPublished = false;
+        try {
+            syncBatchData(m_root, temps);
+            std::filesystem::create_directories(m_root);
+            const std::string journalTemp = journalBase() + kJournalTempSuffix;
+            writeJournal(journalTemp, journal);
+            syncPath(journalTemp, false);
+            renameReplacing(journalTemp, journalPath);
+            journalPublished = true;
+            syncPath(m_root, true);
+        } catch (...) {
+            if (!journalPublished) {
+                discardTempsLocked();
+                throw;
+            }
+        }
+
+        // Committed from here on. If the journal cannot be applied now, the backend
+        // rolls it forward before anything newer is written under it.
+        try {
+            completeJournal(journalPath, journal);
+        } catch (const std::exception& e) {
+            spdlog::warn("Committed storage batch not applied yet, will retry: {}", e.what());
+            m_backend.deferJournal(journalPath);
+        }
+    }
+
+    void abort() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_finished) {
+            return;
+        }
+        m_finished = true;
+        discardTempsLocked();
+    }
+
+private:
+    std::string journalBase() const {
+        return (std::filesystem::path(m_root) / (std::string(kJournalPrefix) + m_id)).string();
+    }
+
+    void requireOpen() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        requireOpenLocked();
+    }
+
+    void requireOpenLocked() const {
+        if (m_finished) {
+            throw std::logic_error("StorageBatch used after commit or abort");
+        }
+    }
+
+    void discardTemps() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        discardTempsLocked();
+    }
+
+    // Temps already renamed into place are gone, so this only removes unpublished data.
+    void discardTempsLocked() {
+        for (const auto& [final, temp] : m_writes) {
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+        }
+        m_writes.clear();
+        m_removals.clear();
+    }
+
+    FilesystemBackend& m_backend;
+    std::string m_root;
+    std::string m_id;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::string> m_writes;
+    std::unordered_set<std::string> m_removals;
+    bool m_finished = false;
+};
+
+void BatchFileWriteSession::commit() {
+    m_writer.flush();
+    m_batch->stageWrite(m_finalPath, m_tempPath);
+}
+
 } // namespace
 
+void FilesystemBackend::deferJournal(const std::string& journalPath) {
+    std::lock_guard<std::mutex> lock(m_deferredMutex);
+    m_deferredJournals.push_back(journalPath);
+}
+
+void FilesystemBackend::completeDeferredJournals() {
+    std::lock_guard<std::mutex> lock(m_deferredMutex);
+    while (!m_deferredJournals.empty()) {
+        const std::string& journalPath = m_deferredJournals.front();
+        BatchJournal journal;
+        if (readJournal(journalPath, journal)) {
+            completeJournal(journalPath, journal);
+        }
+        m_deferredJournals.erase(m_deferredJournals.begin());
+    }
+}
+
 std::unique_ptr<ByteReader> FilesystemBackend::openRead(const std::string& path) {
     return std::make_unique<FileByteReader>(path);
 }
 
 std::unique_ptr<AtomicWriteSession> FilesystemBackend::openWrite(const std::string& path, AtomicWriteOptions options) {
+    completeDeferredJournals();
     std::filesystem::path p(path);
     std::filesystem::create_directories(p.parent_path());
 
@@ -257,7 +657,50 @@ void FilesystemBackend::mkdirs(const std::string& path) {
 }
 
 void FilesystemBackend::remove(const std::string& path) {
+    completeDeferredJournals();
     std::filesystem::remove(path);
 }
 
+std::shared_ptr<StorageBatch> FilesystemBackend::beginBatch(const std::string& root) {
+    completeDeferredJournals();
+    return std::make_shared<FilesystemBatch>(*this, root);
+}
+
+void FilesystemBackend::recoverBatches(const std::string& root) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) {
+        return;
+    }
+
+    // Roll committed batches forward first; whatever temps remain afterwards belong
+    // to batches that never reached their commit record.
+    for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind(kJournalPrefix, 0) != 0) {
+            continue;
+        }
+        if (endsWith(name, kJournalSuffix)) {
+            BatchJournal journal;
+            if (readJournal(entry.path().string(), journal)) {
+                applyJournal(journal);
+            }
+        }
+        if (endsWith(name, kJournalSuffix) || endsWith(name, kJournalTempSuffix)) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+    std::vector<std::filesystem::path> stale;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (it->is_regular_file(ec) && endsWith(it->path().filename().string(), kBatchTempSuffix)) {
+            stale.push_back(it->path());
+        }
+    }
+    for (const auto& path : stale) {
+        std::filesystem::remove(path, ec);
+    }
+}
+
 } // namespace Rigel::Persistence
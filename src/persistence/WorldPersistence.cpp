@@ -65,7 +65,7 @@ void loadWorldFromDisk(Voxel::World& world,
     world.chunkManager().clearDirtyFlags();
 
     std::string zoneId = resolveZoneId(service, context);
-    auto format = service.openFormat(context);
+    auto format = service.sharedFormat(context);
     std::unordered_set<Voxel::ChunkCoord, Voxel::ChunkCoordHash> touchedChunks;
 
     if (includesChunks(scope)) {
@@ -99,15 +99,45 @@ void loadWorldFromDisk(Voxel::World& world,
         return;
     }
 
+    // Regions repeat a few (type, model) pairs; the factory and asset lookups run
+    // once per pair rather than once per entity.
+    struct ResolvedType {
+        bool registered = false;
+        Asset::Handle<Entity::EntityModelAsset> model;
+    };
+    std::unordered_map<std::string, ResolvedType> resolvedTypes;
+    std::string typeKey;
+
     for (const auto& key : format->entityContainer().listRegions(zoneId)) {
         EntityRegionSnapshot region = format->entityContainer().loadRegion(key);
         if (region.chunks.empty()) {
             continue;
         }
+        size_t regionEntities = 0;
+        for (const auto& chunk : region.chunks) {
+            regionEntities += chunk.entities.size();
+        }
+        // reserve() grows geometrically, so per-region calls do not copy every
+        // entity loaded so far.
+        world.entities().reserve(world.entities().size() + regionEntities);
+
         for (const auto& chunk : region.chunks) {
             for (const auto& saved : chunk.entities) {
+                typeKey.assign(saved.typeId);
+                typeKey.push_back('\0');
+                typeKey.append(saved.modelId);
+                auto resolved = resolvedTypes.find(typeKey);
+                if (resolved == resolvedTypes.end()) {
+                    ResolvedType type;
+                    type.registered = Entity::EntityFactory::instance().hasType(saved.typeId);
+                    if (!saved.modelId.empty() && assets.exists(saved.modelId)) {
+                        type.model = assets.get<Entity::EntityModelAsset>(saved.modelId);
+                    }
+                    resolved = resolvedTypes.emplace(typeKey, std::move(type)).first;
+                }
+
                 std::unique_ptr<Entity::Entity> entity;
-                if (Entity::EntityFactory::instance().hasType(saved.typeId)) {
+                if (resolved->second.registered) {
                     entity = Entity::EntityFactory::instance().create(saved.typeId);
                 }
                 if (!entity) {
@@ -117,9 +147,8 @@ void loadWorldFromDisk(Voxel::World& world,
                 entity->setPosition(saved.position);
                 entity->setVelocity(saved.velocity);
                 entity->setViewDirection(saved.viewDirection);
-                if (!saved.modelId.empty() && assets.exists(saved.modelId)) {
-                    auto model = assets.get<Entity::EntityModelAsset>(saved.modelId);
-                    entity->setModel(std::move(model));
+                if (resolved->second.model) {
+                    entity->setModel(resolved->second.model);
                 }
                 world.entities().spawn(std::move(entity));
             }
@@ -131,7 +160,7 @@ void saveWorldToDisk(const Voxel::World& world,
                      PersistenceService& service,
                      PersistenceContext context) {
     std::string zoneId = resolveZoneId(service, context);
-    auto format = service.openFormat(context);
+    auto format = service.sharedFormat(context);
     const auto& layout = format->regionLayout();
 
     struct RegionSave {
@@ -285,7 +314,7 @@ bool loadChunkFromDisk(Voxel::World& world,
                        const Voxel::ChunkCoord& coord,
                        uint32_t worldGenVersion) {
     std::string zoneId = resolveZoneId(service, context);
-    auto format = service.openFormat(context);
+    auto format = service.sharedFormat(context);
     const auto& layout = format->regionLayout();
 
     RegionKey regionKey = layout.regionForChunk(zoneId, coord);
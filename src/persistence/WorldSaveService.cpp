@@ -0,0 +1,439 @@
+#include "Rigel/Persistence/WorldSaveService.h"
+
+#include "Rigel/Persistence/ChunkSerializer.h"
+#include "Rigel/Persistence/Containers.h"
+#include "Rigel/Persistence/RegionLayout.h"
+#include "Rigel/Voxel/Chunk.h"
+#include "Rigel/Voxel/World.h"
+#include "Rigel/Core/Profiler.h"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <map>
+#include <thread>
+#include <tuple>
+
+#include <spdlog/spdlog.h>
+
+namespace Rigel::Persistence {
+namespace {
+
+constexpr const char* kDefaultZoneId = "rigel:default";
+constexpr auto kScanInterval = std::chrono::milliseconds(250);
+constexpr auto kRetryDelay = std::chrono::seconds(5);
+
+std::string resolveZoneId(PersistenceService& service, const PersistenceContext& context) {
+    if (!context.zoneId.empty()) {
+        return context.zoneId;
+    }
+    try {
+        WorldMetadata metadata = service.loadWorldMetadata(context);
+        if (!metadata.defaultZoneId.empty()) {
+            return metadata.defaultZoneId;
+        }
+    } catch (const std::exception&) {
+    }
+    return kDefaultZoneId;
+}
+
+bool isAllAir(const ChunkData& data) {
+    for (const auto& block : data.blocks) {
+        if (!block.isAir()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float secondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<float>(to - from).count();
+}
+
+} // namespace
+
+size_t WorldSaveService::RegionKeyHash::operator()(const RegionKey& key) const {
+    size_t seed = std::hash<std::string>{}(key.zoneId);
+    size_t hx = std::hash<int32_t>{}(key.x);
+    size_t hy = std::hash<int32_t>{}(key.y);
+    size_t hz = std::hash<int32_t>{}(key.z);
+    seed ^= hx + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hy + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hz + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+WorldSaveService::WorldSaveService(PersistenceService& service,
+                                   PersistenceContext context,
+                                   Voxel::World& world,
+                                   size_t ioThreads)
+    : m_service(&service),
+      m_context(std::move(context)),
+      m_world(&world),
+      m_ioPool(ioThreads) {
+    m_zoneId = resolveZoneId(service, m_context);
+    if (m_context.zoneId.empty()) {
+        m_context.zoneId = m_zoneId;
+    }
+    m_format = m_service->sharedFormat(m_context);
+}
+
+WorldSaveService::~WorldSaveService() {
+    // Writes still queued finish here; results are dropped with the service.
+    m_ioPool.stop();
+}
+
+void WorldSaveService::setConfig(const AutosaveConfig& config) {
+    m_config = config;
+}
+
+void WorldSaveService::setRegionSavedCallback(RegionSavedCallback callback) {
+    m_regionSavedCallback = std::move(callback);
+}
+
+void WorldSaveService::update() {
+    PROFILE_SCOPE("Persistence/Autosave");
+    drainCompletions();
+    if (!m_config.enabled || !m_format) {
+        return;
+    }
+
+    auto now = Clock::now();
+    if (now >= m_nextScan) {
+        scanDirtyChunks(now);
+        m_nextScan = now + kScanInterval;
+    }
+
+    refreshMetrics(now);
+    if (m_metrics.dueChunks == 0) {
+        return;
+    }
+    size_t regionSlots = std::numeric_limits<size_t>::max();
+    if (m_config.maxInFlightRegions > 0) {
+        const size_t limit = static_cast<size_t>(m_config.maxInFlightRegions);
+        regionSlots = limit > m_inFlight.size() ? limit - m_inFlight.size() : 0;
+    }
+    if (regionSlots == 0) {
+        ++m_metrics.throttledUpdates;
+        return;
+    }
+    const size_t budget = m_config.chunksPerFrame > 0
+        ? static_cast<size_t>(m_config.chunksPerFrame)
+        : std::numeric_limits<size_t>::max();
+    if (queueDueChunks(now, budget, regionSlots, false) > 0) {
+        refreshMetrics(now);
+    }
+}
+
+void WorldSaveService::flush() {
+    if (!m_format) {
+        return;
+    }
+    drainCompletions();
+    scanDirtyChunks(Clock::now());
+    for (;;) {
+        drainCompletions();
+        const size_t queued = queueDueChunks(Clock::now(),
+                                             std::numeric_limits<size_t>::max(),
+                                             std::numeric_limits<size_t>::max(),
+                                             true);
+        if (queued == 0 && m_inFlight.empty()) {
+            break;
+        }
+        if (m_ioPool.threadCount() > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    refreshMetrics(Clock::now());
+}
+
+void WorldSaveService::scanDirtyChunks(Clock::time_point now) {
+    auto& chunks = m_world->chunkManager();
+    chunks.forEachChunk([&](Voxel::ChunkCoord coord, const Voxel::Chunk& chunk) {
+        if (!chunk.isPersistDirty()) {
+            return;
+        }
+        auto [it, inserted] = m_dirty.try_emplace(coord);
+        DirtyState& state = it->second;
+        if (inserted) {
+            state.revision = chunk.persistRevision();
+            state.firstDirty = now;
+            state.lastChange = now;
+        } else if (state.revision != chunk.persistRevision()) {
+            state.revision = chunk.persistRevision();
+            state.lastChange = now;
+        }
+    });
+
+    // Chunks saved elsewhere (shutdown save, reload) or unloaded drop out.
+    std::erase_if(m_dirty, [&](const auto& entry) {
+        if (entry.second.inFlight) {
+            return false;
+        }
+        const Voxel::Chunk* chunk = chunks.getChunk(entry.first);
+        return !chunk || !chunk->isPersistDirty();
+    });
+}
+
+bool WorldSaveService::isDue(const DirtyState& state, Clock::time_point now) const {
+    if (state.inFlight || now < state.retryAt) {
+        return false;
+    }
+    return secondsBetween(state.lastChange, now) >= m_config.settleSeconds ||
+        secondsBetween(state.firstDirty, now) >= m_config.maxDirtyAgeSeconds;
+}
+
+size_t WorldSaveService::queueDueChunks(Clock::time_point now,
+                                        size_t budget,
+                                        size_t regionSlots,
+                                        bool ignoreTiming) {
+    std::vector<std::pair<Clock::time_point, Voxel::ChunkCoord>> candidates;
+    for (const auto& [coord, state] : m_dirty) {
+        const bool eligible = ignoreTiming
+            ? (!state.inFlight && now >= state.retryAt)
+            : isDue(state, now);
+        if (eligible) {
+            candidates.emplace_back(state.firstDirty, coord);
+        }
+    }
+    if (candidates.empty()) {
+        return 0;
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) {
+            return a.first < b.first;
+        }
+        return std::tie(a.second.x, a.second.y, a.second.z) < std::tie(b.second.x, b.second.y, b.second.z);
+    });
+
+    const RegionLayout& layout = m_format->regionLayout();
+    std::unordered_map<RegionKey, RegionWrite, RegionKeyHash> batches;
+    size_t taken = 0;
+    for (const auto& [firstDirty, coord] : candidates) {
+        if (taken >= budget) {
+            break;
+        }
+        RegionKey key = layout.regionForChunk(m_zoneId, coord);
+        if (m_inFlight.find(key) != m_inFlight.end()) {
+            continue;
+        }
+        auto batchIt = batches.find(key);
+        if (batchIt == batches.end()) {
+            if (batches.size() >= regionSlots) {
+                continue;
+            }
+            batchIt = batches.emplace(key, RegionWrite{}).first;
+            batchIt->second.key = key;
+        }
+        Voxel::Chunk* chunk = m_world->chunkManager().getChunk(coord);
+        if (!chunk) {
+            m_dirty.erase(coord);
+            continue;
+        }
+
+        RegionWrite& write = batchIt->second;
+        for (const auto& storageKey : layout.storageKeysForChunk(m_zoneId, coord)) {
+            write.replacedKeys.push_back(storageKey);
+            ChunkData data = serializeChunkSpan(*chunk, layout.spanForStorageKey(storageKey));
+            if (isAllAir(data)) {
+                continue;
+            }
+            ChunkSnapshot snapshot;
+            snapshot.key = storageKey;
+            snapshot.data = std::move(data);
+            write.snapshots.push_back(std::move(snapshot));
+        }
+        write.chunks.emplace_back(coord, chunk->persistRevision());
+        m_dirty[coord].inFlight = true;
+        ++taken;
+    }
+
+    std::erase_if(batches, [](const auto& entry) { return entry.second.chunks.empty(); });
+    std::shared_ptr<PendingBatch> batch = beginBatch(batches.size());
+    for (auto& [key, write] : batches) {
+        queueRegionWrite(std::move(write), batch);
+    }
+    return taken;
+}
+
+std::shared_ptr<WorldSaveService::PendingBatch> WorldSaveService::beginBatch(size_t regions) {
+    if (!m_config.batchCommits || regions == 0 || !m_context.storage) {
+        return nullptr;
+    }
+    try {
+        auto storage = m_context.storage->beginBatch(m_context.rootPath);
+        if (!storage) {
+            return nullptr;
+        }
+        // A private format instance writes through the batch; the shared one keeps
+        // reading published files and is invalidated once the batch commits.
+        PersistenceContext batchContext = m_context;
+        batchContext.storage = storage;
+        auto batch = std::make_shared<PendingBatch>();
+        batch->storage = std::move(storage);
+        batch->format = m_service->openFormat(batchContext);
+        batch->remaining = regions;
+        return batch;
+    } catch (const std::exception& e) {
+        spdlog::warn("Autosave batch unavailable, writing regions individually: {}", e.what());
+        return nullptr;
+    }
+}
+
+void WorldSaveService::queueRegionWrite(RegionWrite write, std::shared_ptr<PendingBatch> batch) {
+    m_inFlight.insert(write.key);
+
+    std::shared_ptr<PersistenceFormat> format = batch ? batch->format : m_format;
+    auto job = [this, format = std::move(format), batch = std::move(batch), write = std::move(write)]() mutable {
+        auto start = Clock::now();
+        RegionWriteResult result;
+        result.key = write.key;
+        result.chunks = std::move(write.chunks);
+        try {
+            ChunkContainer& container = format->chunkContainer();
+            ChunkRegionSnapshot existing;
+            if (container.regionExists(write.key)) {
+                existing = container.loadRegion(write.key);
+            }
+
+            using KeyTuple = std::tuple<int32_t, int32_t, int32_t>;
+            std::map<KeyTuple, ChunkSnapshot> merged;
+            for (auto& snapshot : existing.chunks) {
+                merged.emplace(KeyTuple{snapshot.key.x, snapshot.key.y, snapshot.key.z}, std::move(snapshot));
+            }
+            for (const auto& key : write.replacedKeys) {
+                merged.erase(KeyTuple{key.x, key.y, key.z});
+            }
+            for (auto& snapshot : write.snapshots) {
+                KeyTuple key{snapshot.key.x, snapshot.key.y, snapshot.key.z};
+                merged[key] = std::move(snapshot);
+            }
+
+            ChunkRegionSnapshot out;
+            out.key = write.key;
+            out.chunks.reserve(merged.size());
+            for (auto& entry : merged) {
+                out.chunks.push_back(std::move(entry.second));
+            }
+            container.saveRegion(out);
+            result.ok = true;
+        } catch (const std::exception& e) {
+            spdlog::warn("Autosave of region ({} {} {}) failed: {}",
+                         write.key.x, write.key.y, write.key.z, e.what());
+            result.ok = false;
+        }
+        result.writeMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        if (!batch) {
+            m_complete.push(std::move(result));
+            return;
+        }
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            batch->results.push_back(std::move(result));
+            last = --batch->remaining == 0;
+        }
+        if (last) {
+            finishBatch(*batch);
+        }
+    };
+
+    if (m_ioPool.threadCount() > 0) {
+        m_ioPool.enqueue(std::move(job));
+    } else {
+        job();
+    }
+}
+
+void WorldSaveService::finishBatch(PendingBatch& batch) {
+    auto start = Clock::now();
+    const bool allOk = std::all_of(batch.results.begin(), batch.results.end(),
+                                   [](const RegionWriteResult& result) { return result.ok; });
+    bool committed = false;
+    try {
+        if (allOk) {
+            batch.storage->commit();
+            committed = true;
+        } else {
+            batch.storage->abort();
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Autosave batch of {} regions failed to commit: {}", batch.results.size(), e.what());
+    }
+
+    // The batch shares one commit, so its cost is spread over its regions.
+    const float commitMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() /
+        static_cast<float>(batch.results.size());
+    for (auto& result : batch.results) {
+        result.ok = committed;
+        result.writeMs += commitMs;
+        if (committed) {
+            m_format->chunkContainer().invalidateRegion(result.key);
+        }
+        m_complete.push(std::move(result));
+    }
+    batch.results.clear();
+}
+
+void WorldSaveService::drainCompletions() {
+    RegionWriteResult result;
+    while (m_complete.tryPop(result)) {
+        m_inFlight.erase(result.key);
+        auto now = Clock::now();
+        m_metrics.lastWriteMs = result.writeMs;
+        if (result.ok) {
+            ++m_metrics.regionsWritten;
+        } else {
+            ++m_metrics.writeFailures;
+        }
+
+        for (const auto& [coord, revision] : result.chunks) {
+            auto stateIt = m_dirty.find(coord);
+            Voxel::Chunk* chunk = m_world->chunkManager().getChunk(coord);
+            if (result.ok) {
+                ++m_metrics.chunksSaved;
+                if (chunk && chunk->persistRevision() == revision) {
+                    chunk->clearPersistDirty();
+                }
+            }
+            if (stateIt == m_dirty.end()) {
+                continue;
+            }
+            DirtyState& state = stateIt->second;
+            state.inFlight = false;
+            if (!chunk || !chunk->isPersistDirty()) {
+                m_dirty.erase(stateIt);
+                continue;
+            }
+            if (!result.ok) {
+                state.retryAt = now + kRetryDelay;
+            } else {
+                // Edited again while the write was in flight; the newer data starts
+                // a fresh dirty period.
+                state.revision = chunk->persistRevision();
+                state.firstDirty = now;
+                state.lastChange = now;
+            }
+        }
+
+        if (result.ok && m_regionSavedCallback) {
+            m_regionSavedCallback(result.key);
+        }
+    }
+}
+
+void WorldSaveService::refreshMetrics(Clock::time_point now) {
+    m_metrics.dirtyChunks = m_dirty.size();
+    m_metrics.inFlightRegions = m_inFlight.size();
+    m_metrics.dueChunks = 0;
+    m_metrics.oldestDirtySeconds = 0.0f;
+    for (const auto& [coord, state] : m_dirty) {
+        if (isDue(state, now)) {
+            ++m_metrics.dueChunks;
+        }
+        m_metrics.oldestDirtySeconds =
+            std::max(m_metrics.oldestDirtySeconds, secondsBetween(state.firstDirty, now));
+    }
+}
+
+} // namespace Rigel::Persistence
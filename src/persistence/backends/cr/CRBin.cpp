@@ -234,6 +234,7 @@ CRBinValue readValue(ByteReader& reader, CRSchemaType type, const std::vector<st
         CRBinObject obj;
         obj.schemaIndex = schemaIndex;
         const auto& schema = altSchemas[static_cast<size_t>(schemaIndex)];
+        obj.fields.reserve(schema.entries.size());
         for (const auto& entry : schema.entries) {
             obj.fields[entry.name] = readValue(reader, entry.type, strings, altSchemas);
         }
@@ -407,8 +408,321 @@ void writeValue(ByteWriter& writer, StringTable& table, const CRBinValue& value,
     }
 }
 
+std::vector<std::string> readStringTable(ByteReader& reader) {
+    int32_t numStrings = reader.readI32();
+    if (numStrings < 0) {
+        throw std::runtime_error("CRBinReader: invalid string table size");
+    }
+    std::vector<std::string> strings;
+    strings.reserve(static_cast<size_t>(numStrings));
+    for (int32_t i = 0; i < numStrings; ++i) {
+        strings.push_back(readString(reader));
+    }
+    return strings;
+}
+
+std::vector<CRSchema> readAltSchemas(ByteReader& reader) {
+    int32_t numAltSchemas = reader.readI32();
+    if (numAltSchemas < 0) {
+        throw std::runtime_error("CRBinReader: invalid alt schema count");
+    }
+    std::vector<CRSchema> altSchemas;
+    altSchemas.reserve(static_cast<size_t>(numAltSchemas));
+    for (int32_t i = 0; i < numAltSchemas; ++i) {
+        altSchemas.push_back(readSchema(reader));
+    }
+    return altSchemas;
+}
+
+void writeStringTable(ByteWriter& writer, const StringTable& table) {
+    writer.writeI32(static_cast<int32_t>(table.strings.size()));
+    for (const auto& value : table.strings) {
+        writeString(writer, value);
+    }
+}
+
+// Compiled fields: `dst`/`src` point at the struct member whose C++ type
+// detail::CRBinFieldType maps to the field's schema type.
+
+const std::string& lookupString(const std::vector<std::string>& strings, int32_t id) {
+    static const std::string empty;
+    if (id < 0 || id >= static_cast<int32_t>(strings.size())) {
+        return empty;
+    }
+    return strings[static_cast<size_t>(id)];
+}
+
+// Returns false for a stored null array, which leaves `dst` empty.
+template <typename V, typename ReadOne>
+bool readVector(ByteReader& reader, void* dst, ReadOne readOne) {
+    auto& out = *static_cast<std::vector<V>*>(dst);
+    out.clear();
+    int32_t length = reader.readI32();
+    if (length < 0) {
+        return false;
+    }
+    out.reserve(static_cast<size_t>(length));
+    for (int32_t i = 0; i < length; ++i) {
+        out.push_back(readOne());
+    }
+    return true;
+}
+
+// Returns false when the stored value was a null array.
+bool readBoundField(ByteReader& reader, CRSchemaType type, void* dst, const std::vector<std::string>& strings) {
+    switch (type) {
+    case CRSchemaType::Byte:
+        *static_cast<int8_t*>(dst) = static_cast<int8_t>(reader.readU8());
+        return true;
+    case CRSchemaType::Short:
+        *static_cast<int16_t*>(dst) = static_cast<int16_t>(reader.readU16());
+        return true;
+    case CRSchemaType::Int:
+        *static_cast<int32_t*>(dst) = reader.readI32();
+        return true;
+    case CRSchemaType::Long:
+        *static_cast<int64_t*>(dst) = readI64(reader);
+        return true;
+    case CRSchemaType::Float:
+        *static_cast<float*>(dst) = readFloat(reader);
+        return true;
+    case CRSchemaType::Double:
+        *static_cast<double*>(dst) = readDouble(reader);
+        return true;
+    case CRSchemaType::Boolean:
+        *static_cast<bool*>(dst) = reader.readU8() != 0;
+        return true;
+    case CRSchemaType::String:
+        *static_cast<std::string*>(dst) = lookupString(strings, reader.readI32());
+        return true;
+    case CRSchemaType::ByteArray:
+        return readVector<int8_t>(reader, dst, [&] { return static_cast<int8_t>(reader.readU8()); });
+    case CRSchemaType::ShortArray:
+        return readVector<int16_t>(reader, dst, [&] { return static_cast<int16_t>(reader.readU16()); });
+    case CRSchemaType::IntArray:
+        return readVector<int32_t>(reader, dst, [&] { return reader.readI32(); });
+    case CRSchemaType::LongArray:
+        return readVector<int64_t>(reader, dst, [&] { return readI64(reader); });
+    case CRSchemaType::FloatArray:
+        return readVector<float>(reader, dst, [&] { return readFloat(reader); });
+    case CRSchemaType::DoubleArray:
+        return readVector<double>(reader, dst, [&] { return readDouble(reader); });
+    case CRSchemaType::StringArray:
+        return readVector<std::string>(reader, dst, [&] { return lookupString(strings, reader.readI32()); });
+    default:
+        throw std::runtime_error("CRBinReader: type cannot be bound to a struct field");
+    }
+}
+
+// `storedNull`: the field was read as a null array; it is written back as one while
+// the vector stays empty.
+template <typename V, typename WriteOne>
+void writeVector(ByteWriter& writer, const void* src, bool storedNull, WriteOne writeOne) {
+    const auto& values = *static_cast<const std::vector<V>*>(src);
+    if (storedNull && values.empty()) {
+        writer.writeI32(-1);
+        return;
+    }
+    writer.writeI32(static_cast<int32_t>(values.size()));
+    for (const auto& value : values) {
+        writeOne(value);
+    }
+}
+
+void writeBoundField(ByteWriter& writer, CRSchemaType type, const void* src, bool storedNull, StringTable& table) {
+    switch (type) {
+    case CRSchemaType::Byte:
+        writer.writeU8(static_cast<uint8_t>(*static_cast<const int8_t*>(src)));
+        return;
+    case CRSchemaType::Short:
+        writer.writeU16(static_cast<uint16_t>(*static_cast<const int16_t*>(src)));
+        return;
+    case CRSchemaType::Int:
+        writer.writeI32(*static_cast<const int32_t*>(src));
+        return;
+    case CRSchemaType::Long:
+        writeI64(writer, *static_cast<const int64_t*>(src));
+        return;
+    case CRSchemaType::Float:
+        writeFloat(writer, *static_cast<const float*>(src));
+        return;
+    case CRSchemaType::Double:
+        writeDouble(writer, *static_cast<const double*>(src));
+        return;
+    case CRSchemaType::Boolean:
+        writer.writeU8(*static_cast<const bool*>(src) ? 1 : 0);
+        return;
+    case CRSchemaType::String:
+        writer.writeI32(table.add(*static_cast<const std::string*>(src)));
+        return;
+    case CRSchemaType::ByteArray:
+        writeVector<int8_t>(writer, src, storedNull, [&](int8_t v) { writer.writeU8(static_cast<uint8_t>(v)); });
+        return;
+    case CRSchemaType::ShortArray:
+        writeVector<int16_t>(writer, src, storedNull, [&](int16_t v) { writer.writeU16(static_cast<uint16_t>(v)); });
+        return;
+    case CRSchemaType::IntArray:
+        writeVector<int32_t>(writer, src, storedNull, [&](int32_t v) { writer.writeI32(v); });
+        return;
+    case CRSchemaType::LongArray:
+        writeVector<int64_t>(writer, src, storedNull, [&](int64_t v) { writeI64(writer, v); });
+        return;
+    case CRSchemaType::FloatArray:
+        writeVector<float>(writer, src, storedNull, [&](float v) { writeFloat(writer, v); });
+        return;
+    case CRSchemaType::DoubleArray:
+        writeVector<double>(writer, src, storedNull, [&](double v) { writeDouble(writer, v); });
+        return;
+    case CRSchemaType::StringArray:
+        writeVector<std::string>(writer, src, storedNull, [&](const std::string& v) { writer.writeI32(table.add(v)); });
+        return;
+    default:
+        throw std::runtime_error("CRBinWriter: type cannot be bound to a struct field");
+    }
+}
+
+void collectBoundStrings(StringTable& table, CRSchemaType type, const void* src) {
+    if (type == CRSchemaType::String) {
+        table.add(*static_cast<const std::string*>(src));
+    } else if (type == CRSchemaType::StringArray) {
+        for (const auto& value : *static_cast<const std::vector<std::string>*>(src)) {
+            table.add(value);
+        }
+    }
+}
+
+const detail::CRBinFieldBinding* findBinding(const std::vector<detail::CRBinFieldBinding>& fields,
+                                             const CRSchemaEntry& entry) {
+    for (const auto& binding : fields) {
+        if (binding.type == entry.type && binding.name == entry.name) {
+            return &binding;
+        }
+    }
+    return nullptr;
+}
+
+// Whether `unknown` records a null array stored under the bound field.
+bool isStoredNull(const CRBinUnknownFields* unknown, const detail::CRBinFieldBinding& binding) {
+    if (!unknown) {
+        return false;
+    }
+    for (const auto& entry : unknown->entries) {
+        if (entry.name == binding.name && entry.type == binding.type) {
+            const CRBinValue* value = findValue(unknown->values, entry.name);
+            return value && std::holds_alternative<std::monostate>(value->value);
+        }
+    }
+    return false;
+}
+
+bool isBoundName(const std::vector<detail::CRBinFieldBinding>& fields, const std::string& name) {
+    for (const auto& binding : fields) {
+        if (binding.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace
 
+namespace detail {
+
+void readCompiled(ByteReader& reader,
+                  const std::vector<CRBinFieldBinding>& fields,
+                  void* object,
+                  CRBinUnknownFields* unknown) {
+    std::vector<std::string> strings = readStringTable(reader);
+    CRSchema schema = readSchema(reader);
+    std::vector<CRSchema> altSchemas = readAltSchemas(reader);
+
+    if (unknown) {
+        *unknown = CRBinUnknownFields{};
+    }
+    for (const auto& entry : schema.entries) {
+        if (const CRBinFieldBinding* binding = findBinding(fields, entry)) {
+            if (!readBoundField(reader, binding->type, binding->member(object), strings) && unknown) {
+                // A std::vector has no null state; the null is kept alongside the
+                // unknown fields so writing the struct back restores it.
+                unknown->entries.push_back(entry);
+                unknown->values.fields[entry.name] = CRBinValue{};
+            }
+            continue;
+        }
+        CRBinValue value = readValue(reader, entry.type, strings, altSchemas);
+        if (unknown) {
+            unknown->entries.push_back(entry);
+            unknown->values.fields[entry.name] = std::move(value);
+        }
+    }
+    if (unknown && !unknown->entries.empty()) {
+        unknown->altSchemas = std::move(altSchemas);
+    }
+}
+
+void writeCompiled(ByteWriter& writer,
+                   const std::vector<CRBinFieldBinding>& fields,
+                   const void* object,
+                   const CRBinUnknownFields* unknown) {
+    // Bound names win over unknown fields of the same name.
+    std::vector<const CRSchemaEntry*> extras;
+    if (unknown) {
+        for (const auto& entry : unknown->entries) {
+            if (!isBoundName(fields, entry.name)) {
+                extras.push_back(&entry);
+            }
+        }
+    }
+    static const std::vector<CRSchema> kNoAltSchemas;
+    const std::vector<CRSchema>& altSchemas = unknown ? unknown->altSchemas : kNoAltSchemas;
+    // Bindings only hand out members for reading here; the struct is never modified.
+    void* mutableObject = const_cast<void*>(object);
+
+    StringTable table;
+    for (const auto& binding : fields) {
+        table.add(binding.name);
+    }
+    for (const CRSchemaEntry* entry : extras) {
+        table.add(entry->name);
+    }
+    for (const auto& schema : altSchemas) {
+        collectSchemaStrings(table, schema);
+    }
+    for (const auto& binding : fields) {
+        collectBoundStrings(table, binding.type, binding.member(mutableObject));
+    }
+    for (const CRSchemaEntry* entry : extras) {
+        if (const CRBinValue* value = findValue(unknown->values, entry->name)) {
+            collectStrings(table, *value);
+        }
+    }
+
+    writeStringTable(writer, table);
+    for (const auto& binding : fields) {
+        writer.writeU8(static_cast<uint8_t>(binding.type));
+        writeString(writer, binding.name);
+    }
+    for (const CRSchemaEntry* entry : extras) {
+        writer.writeU8(static_cast<uint8_t>(entry->type));
+        writeString(writer, entry->name);
+    }
+    writer.writeU8(static_cast<uint8_t>(CRSchemaType::SchemaEnd));
+    writer.writeI32(static_cast<int32_t>(altSchemas.size()));
+    for (const auto& schema : altSchemas) {
+        writeSchema(writer, schema);
+    }
+
+    for (const auto& binding : fields) {
+        writeBoundField(writer, binding.type, binding.member(mutableObject), isStoredNull(unknown, binding), table);
+    }
+    for (const CRSchemaEntry* entry : extras) {
+        const CRBinValue* value = findValue(unknown->values, entry->name);
+        writeValue(writer, table, value ? *value : CRBinValue{}, entry->type, altSchemas);
+    }
+}
+
+} // namespace detail
+
 CRSchemaType schemaTypeFromByte(uint8_t value) {
     switch (value) {
     case 0:
@@ -499,28 +813,12 @@ CRBinValue CRBinValue::fromObject(CRBinObject v) {
 CRBinDocument CRBinReader::read(ByteReader& reader) {
     CRBinDocument doc;
 
-    int32_t numStrings = reader.readI32();
-    if (numStrings < 0) {
-        throw std::runtime_error("CRBinReader: invalid string table size");
-    }
-    std::vector<std::string> strings;
-    strings.reserve(static_cast<size_t>(numStrings));
-    for (int32_t i = 0; i < numStrings; ++i) {
-        strings.push_back(readString(reader));
-    }
-
+    std::vector<std::string> strings = readStringTable(reader);
     doc.schema = readSchema(reader);
-
-    int32_t numAltSchemas = reader.readI32();
-    if (numAltSchemas < 0) {
-        throw std::runtime_error("CRBinReader: invalid alt schema count");
-    }
-    doc.altSchemas.reserve(static_cast<size_t>(numAltSchemas));
-    for (int32_t i = 0; i < numAltSchemas; ++i) {
-        doc.altSchemas.push_back(readSchema(reader));
-    }
+    doc.altSchemas = readAltSchemas(reader);
 
     doc.root.schemaIndex = -1;
+    doc.root.fields.reserve(doc.schema.entries.size());
     for (const auto& entry : doc.schema.entries) {
         doc.root.fields[entry.name] = readValue(reader, entry.type, strings, doc.altSchemas);
     }
@@ -536,11 +834,7 @@ void CRBinWriter::write(ByteWriter& writer, const CRBinDocument& doc) {
     }
     collectStrings(table, doc.root);
 
-    writer.writeI32(static_cast<int32_t>(table.strings.size()));
-    for (const auto& value : table.strings) {
-        writeString(writer, value);
-    }
-
+    writeStringTable(writer, table);
     writeSchema(writer, doc.schema);
 
     writer.writeI32(static_cast<int32_t>(doc.altSchemas.size()));
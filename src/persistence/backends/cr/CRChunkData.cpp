@@ -1,6 +1,7 @@
 #include "Rigel/Persistence/Backends/CR/CRChunkData.h"
 
 #include "Rigel/Persistence/Backends/CR/CRChunkMapping.h"
+#include "Rigel/Persistence/Backends/CR/CRLayerPacking.h"
 
 #include <algorithm>
 #include <array>
@@ -184,63 +185,25 @@ void readLayer(BufferReader& reader, uint8_t layerType, std::array<uint16_t, 256
         indices.fill(static_cast<uint16_t>(value));
         return;
     }
-    case kBlockLayerHalfNibble: {
-        std::array<uint8_t, 64> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 4;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                int mod = x % 4;
-                uint16_t value = 0;
-                switch (mod) {
-                case 0: value = b & 0x03; break;
-                case 1: value = (b & 0x0C) >> 2; break;
-                case 2: value = (b & 0x30) >> 4; break;
-                case 3: value = (b & 0xC0) >> 6; break;
-                }
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
-        return;
-    }
-    case kBlockLayerNibble: {
-        std::array<uint8_t, 128> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 2;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                uint16_t value = (x % 2 == 0) ? (b & 0x0F) : ((b & 0xF0) >> 4);
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
-        return;
-    }
-    case kBlockLayerByte: {
-        for (size_t i = 0; i < indices.size(); ++i) {
-            indices[i] = reader.readU8();
-        }
-        return;
-    }
     case kBlockLayerShort: {
         for (size_t i = 0; i < indices.size(); ++i) {
             indices[i] = reader.readU16();
         }
         return;
     }
-    case kBlockLayerBit: {
-        std::array<uint8_t, 32> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 8;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                int mod = x % 8;
-                uint16_t value = (b >> mod) & 0x01;
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
+    case kBlockLayerBit:
+    case kBlockLayerHalfNibble:
+    case kBlockLayerNibble:
+    case kBlockLayerByte: {
+        const int bits = layerType == kBlockLayerBit ? 1
+            : layerType == kBlockLayerHalfNibble ? 2
+            : layerType == kBlockLayerNibble ? 4
+            : 8;
+        std::array<uint8_t, 256> packed{};
+        std::array<uint8_t, 256> unpacked{};
+        reader.readBytes(packed.data(), packedLayerBytes(bits));
+        unpackLayerIndices(packed.data(), bits, unpacked.data());
+        std::copy(unpacked.begin(), unpacked.end(), indices.begin());
         return;
     }
     default:
@@ -1,6 +1,7 @@
 #include "Rigel/Persistence/Backends/CR/CRFormat.h"
 
 #include "Rigel/Persistence/Backends/CR/CRChunkMapping.h"
+#include "Rigel/Persistence/Backends/CR/CRLayerPacking.h"
 #include "Rigel/Persistence/Backends/CR/CRPaths.h"
 #include "Rigel/Persistence/Backends/CR/CRSettings.h"
 #include "Rigel/Persistence/Backends/CR/CRLz4.h"
@@ -16,6 +17,10 @@
 #include <cctype>
 #include <cstdio>
 #include <filesystem>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -32,9 +37,27 @@ namespace {
 
 constexpr int32_t kMagic = 0xFFECCEAC;
 constexpr int32_t kFileVersion = 4;
+constexpr int32_t kFramedFileVersion = 5;
+constexpr int32_t kDictionaryFileVersion = 6;
 constexpr int32_t kCompressionNone = 0;
 constexpr int32_t kCompressionLz4 = 1;
 
+constexpr int kRegionColumns = 16 * 16;
+constexpr size_t kRegionHeaderBytes = 16;
+constexpr size_t kFramedHeaderBytes = kRegionHeaderBytes + kRegionColumns * 4;
+constexpr size_t kFrameHeaderBytes = 9;
+constexpr uint8_t kFrameRaw = 0;
+constexpr uint8_t kFrameLz4 = 1;
+constexpr uint8_t kFrameLz4Dict = 2;
+// LZ4 expands a block at most this many times over; a larger raw size is corrupt.
+constexpr int64_t kMaxLz4Expansion = 255;
+
+// Shared LZ4 dictionary (version 6): sampled from the leading bytes of each column,
+// where chunk keys, block palettes and layer headers repeat across a region.
+constexpr size_t kDictionarySampleBytes = 256;
+constexpr size_t kMaxDictionaryBytes = 4 * 1024;
+constexpr size_t kMinDictionaryColumns = 4;
+
 constexpr int32_t kBlockNull = 0;
 constexpr int32_t kBlockSingle = 1;
 constexpr int32_t kBlockLayered = 2;
@@ -171,6 +194,22 @@ bool parseEntityRegionFilename(const std::string& name, int& rx, int& ry, int& r
     return std::sscanf(name.c_str(), "entityRegion_%d_%d_%d.crbin", &rx, &ry, &rz) == 3;
 }
 
+std::shared_ptr<CRPersistenceSettings> findSettings(const PersistenceContext& context) {
+    if (!context.providers) {
+        return nullptr;
+    }
+    return context.providers->findAs<CRPersistenceSettings>(kCRSettingsProviderId);
+}
+
+bool writesFramedRegions(const PersistenceContext& context) {
+    auto settings = findSettings(context);
+    return settings && settings->columnFrames;
+}
+
+int32_t regionFileVersion(const PersistenceContext& context) {
+    return writesFramedRegions(context) ? kDictionaryFileVersion : kFileVersion;
+}
+
 std::array<uint8_t, 4> encodeI32(int32_t value) {
     return {
         static_cast<uint8_t>((value >> 24) & 0xFF),
@@ -450,7 +489,31 @@ void readBlockLayerPayload(TrackingReader& reader, uint8_t layerType) {
     }
 }
 
+// Index width of the bit-packed layer types, 0 for the others.
+int packedLayerBits(uint8_t layerType) {
+    switch (layerType) {
+    case kBlockLayerBit:
+        return 1;
+    case kBlockLayerHalfNibble:
+        return 2;
+    case kBlockLayerNibble:
+        return 4;
+    case kBlockLayerByte:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
 void readLayer(TrackingReader& reader, uint8_t layerType, std::array<uint16_t, 256>& indices) {
+    if (int bits = packedLayerBits(layerType); bits > 0) {
+        std::array<uint8_t, kLayerBytesByte> packed{};
+        std::array<uint8_t, kLayerIndexCount> unpacked{};
+        reader.readBytes(packed.data(), packedLayerBytes(bits));
+        unpackLayerIndices(packed.data(), bits, unpacked.data());
+        std::copy(unpacked.begin(), unpacked.end(), indices.begin());
+        return;
+    }
     switch (layerType) {
     case kBlockLayerSingleByte: {
         uint16_t value = reader.readU8();
@@ -462,59 +525,12 @@ void readLayer(TrackingReader& reader, uint8_t layerType, std::array<uint16_t, 2
         indices.fill(value);
         return;
     }
-    case kBlockLayerHalfNibble: {
-        std::array<uint8_t, 64> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 4;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                int mod = x % 4;
-                uint8_t value = (b >> (mod * 2)) & 0x03;
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
-        return;
-    }
-    case kBlockLayerNibble: {
-        std::array<uint8_t, 128> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 2;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                uint16_t value = (x % 2 == 0) ? (b & 0x0F) : ((b & 0xF0) >> 4);
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
-        return;
-    }
-    case kBlockLayerByte: {
-        for (size_t i = 0; i < indices.size(); ++i) {
-            indices[i] = reader.readU8();
-        }
-        return;
-    }
     case kBlockLayerShort: {
         for (size_t i = 0; i < indices.size(); ++i) {
             indices[i] = reader.readU16();
         }
         return;
     }
-    case kBlockLayerBit: {
-        std::array<uint8_t, 32> bytes{};
-        reader.readBytes(bytes.data(), bytes.size());
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 8;
-                uint8_t b = bytes[static_cast<size_t>(idx)];
-                int mod = x % 8;
-                uint16_t value = (b >> mod) & 0x01;
-                indices[static_cast<size_t>(x + z * 16)] = value;
-            }
-        }
-        return;
-    }
     default:
         throw std::runtime_error("CRChunkCodec: unknown block layer type");
     }
@@ -589,64 +605,27 @@ std::vector<std::string> buildPalette(const std::vector<Voxel::BlockState>& bloc
 void writeLayer(ByteWriter& writer,
                 const std::array<uint16_t, 256>& indices,
                 uint16_t paletteSize) {
-    if (paletteSize <= 2) {
-        std::array<uint8_t, 32> bytes{};
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 8;
-                uint8_t bit = static_cast<uint8_t>(indices[static_cast<size_t>(x + z * 16)] & 0x01);
-                bytes[static_cast<size_t>(idx)] |= (bit << (x % 8));
-            }
-        }
-        writer.writeU8(kBlockLayerBit);
-        writer.writeBytes(bytes.data(), bytes.size());
-        return;
-    }
-
-    if (paletteSize <= 4) {
-        std::array<uint8_t, 64> bytes{};
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 4;
-                uint8_t value = static_cast<uint8_t>(indices[static_cast<size_t>(x + z * 16)] & 0x03);
-                bytes[static_cast<size_t>(idx)] |= (value << ((x % 4) * 2));
-            }
-        }
-        writer.writeU8(kBlockLayerHalfNibble);
-        writer.writeBytes(bytes.data(), bytes.size());
-        return;
-    }
-
-    if (paletteSize <= 16) {
-        std::array<uint8_t, 128> bytes{};
-        for (int z = 0; z < 16; ++z) {
-            for (int x = 0; x < 16; ++x) {
-                int idx = (x + z * 16) / 2;
-                uint8_t value = static_cast<uint8_t>(indices[static_cast<size_t>(x + z * 16)] & 0x0F);
-                if (x % 2 == 0) {
-                    bytes[static_cast<size_t>(idx)] |= value;
-                } else {
-                    bytes[static_cast<size_t>(idx)] |= static_cast<uint8_t>(value << 4);
-                }
-            }
-        }
-        writer.writeU8(kBlockLayerNibble);
-        writer.writeBytes(bytes.data(), bytes.size());
-        return;
-    }
-
-    if (paletteSize <= 256) {
-        writer.writeU8(kBlockLayerByte);
+    if (paletteSize > 256) {
+        writer.writeU8(kBlockLayerShort);
         for (size_t i = 0; i < indices.size(); ++i) {
-            writer.writeU8(static_cast<uint8_t>(indices[i]));
+            writer.writeU16(indices[i]);
         }
         return;
     }
 
-    writer.writeU8(kBlockLayerShort);
-    for (size_t i = 0; i < indices.size(); ++i) {
-        writer.writeU16(indices[i]);
-    }
+    uint8_t layerType = kBlockLayerByte;
+    if (paletteSize <= 2) {
+        layerType = kBlockLayerBit;
+    } else if (paletteSize <= 4) {
+        layerType = kBlockLayerHalfNibble;
+    } else if (paletteSize <= 16) {
+        layerType = kBlockLayerNibble;
+    }
+    const int bits = packedLayerBits(layerType);
+    std::array<uint8_t, kLayerBytesByte> packed{};
+    packLayerIndices(indices.data(), bits, packed.data());
+    writer.writeU8(layerType);
+    writer.writeBytes(packed.data(), packedLayerBytes(bits));
 }
 
 std::vector<Voxel::BlockState> decodeBlocks(TrackingReader& reader,
@@ -741,8 +720,16 @@ std::vector<Voxel::BlockState> decodeBlocks(TrackingReader& reader,
             paletteIds.push_back(resolveBlockId(id));
         }
 
+        // Packed layers (all but short/uniform ones) expand straight into block states.
+        const LayerPaletteLut lut = makeLayerPaletteLut(paletteIds);
         for (int layer = 0; layer < 16; ++layer) {
             uint8_t layerType = reader.readU8();
+            if (int bits = packedLayerBits(layerType); bits > 0) {
+                std::array<uint8_t, kLayerBytesByte> packed{};
+                reader.readBytes(packed.data(), packedLayerBytes(bits));
+                unpackLayerBlocks(packed.data(), bits, lut, blocks.data() + static_cast<size_t>(layer) * 256);
+                continue;
+            }
             std::array<uint16_t, 256> indices{};
             readLayer(reader, layerType, indices);
             for (int z = 0; z < 16; ++z) {
@@ -969,7 +956,7 @@ public:
         const std::string defaultZoneId =
             metadata.defaultZoneId.empty() ? std::string(kDefaultZoneId) : metadata.defaultZoneId;
         std::string text = "{\n";
-        text += "  \"latestRegionFileVersion\": " + std::to_string(kFileVersion) + ",\n";
+        text += "  \"latestRegionFileVersion\": " + std::to_string(regionFileVersion(m_context)) + ",\n";
         text += "  \"defaultZoneId\": \"" + defaultZoneId + "\",\n";
         text += "  \"worldDisplayName\": \"" + metadata.displayName + "\",\n";
         text += "  \"worldSeed\": 0,\n";
@@ -1059,12 +1046,14 @@ public:
 
     void saveRegion(const ChunkRegionSnapshot& region) override {
         auto path = CRPaths::regionPath(region.key, m_context);
+        dropOpenRegion(path);
         if (region.chunks.empty()) {
             m_storage->remove(path);
+            dropOpenRegion(path);
             return;
         }
 
-        std::vector<std::vector<ChunkSnapshot>> columns(16 * 16);
+        std::vector<std::vector<ChunkSnapshot>> columns(kRegionColumns);
         int32_t baseX = region.key.x * 16;
         int32_t baseY = region.key.y * 16;
         int32_t baseZ = region.key.z * 16;
@@ -1078,20 +1067,560 @@ public:
             int index = localX + localZ * 16;
             columns[index].push_back(chunk);
         }
+        for (auto& col : columns) {
+            std::sort(col.begin(), col.end(), [](const ChunkSnapshot& a, const ChunkSnapshot& b) {
+                return a.key.y < b.key.y;
+            });
+        }
 
-        std::vector<int32_t> offsets(16 * 16, -1);
+        auto settings = findSettings(m_context);
+        const bool useCompression = settings && settings->enableLz4;
+        if (useCompression && !CRLz4::available()) {
+            throw std::runtime_error("CRRegion: LZ4 compression requested but unavailable");
+        }
+        if (writesFramedRegions(m_context)) {
+            const bool useDictionary = useCompression && settings->lz4Dictionary && CRLz4::dictionaryAvailable();
+            writeFramedRegion(path, columns, useCompression, useDictionary);
+        } else {
+            writeLegacyRegion(path, columns, useCompression);
+        }
+        // A reader may have reopened the old file while we were writing.
+        dropOpenRegion(path);
+    }
+
+    void invalidateRegion(const RegionKey& key) override {
+        dropOpenRegion(CRPaths::regionPath(key, m_context));
+    }
+
+    ChunkRegionSnapshot loadRegion(const RegionKey& key) override {
+        ChunkRegionSnapshot region;
+        region.key = key;
+        for (auto& frame : readRegionFrames(key)) {
+            auto chunks = frame.decode();
+            std::move(chunks.begin(), chunks.end(), std::back_inserter(region.chunks));
+        }
+        return region;
+    }
+
+    std::vector<RegionFrame> readRegionFrames(const RegionKey& key) override {
+        std::vector<RegionFrame> frames;
+        auto open = acquireRegion(CRPaths::regionPath(key, m_context));
+        if (!open) {
+            return frames;
+        }
+        ChunkKey hint{key.zoneId, 0, 0, 0};
+        std::scoped_lock lock(open->mutex);
+        if (open->header.version < kFramedFileVersion) {
+            // The payload is one block, so it is read (and decompressed) here; each
+            // column's records still decode as their own frame.
+            for (auto& [column, bytes] : readLegacyColumns(*open->reader, open->header)) {
+                RegionFrame frame;
+                frame.keys = columnKeys(key, column);
+                auto stored = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+                frame.decode = [this, stored, hint]() {
+                    std::vector<ChunkSnapshot> out;
+                    decodeLegacyColumn(std::move(*stored), hint, out);
+                    return out;
+                };
+                frames.push_back(std::move(frame));
+            }
+            return frames;
+        }
+
+        // One frame per stored column; its keys are the column's 16 chunk slots.
+        for (int column = 0; column < kRegionColumns; ++column) {
+            int32_t offset = open->index.offsets[static_cast<size_t>(column)];
+            if (offset < 0) {
+                continue;
+            }
+            RegionFrame frame;
+            frame.keys = columnKeys(key, column);
+            auto stored = std::make_shared<ColumnFrame>(readColumnFrame(*open->reader, offset));
+            frame.decode = [this, stored, dictionary = open->index.dictionary, hint]() {
+                std::vector<ChunkSnapshot> out;
+                decodeColumnFrame(std::move(*stored), dictionary.get(), nullptr, hint, out);
+                return out;
+            };
+            frames.push_back(std::move(frame));
+        }
+        return frames;
+    }
+
+    ChunkRegionSnapshot loadRegionChunks(const RegionKey& key, const std::vector<ChunkKey>& keys) override {
+        ChunkRegionSnapshot region;
+        region.key = key;
+        for (auto& decode : readChunkFrames(key, keys)) {
+            auto chunks = decode();
+            std::move(chunks.begin(), chunks.end(), std::back_inserter(region.chunks));
+        }
+        return region;
+    }
+
+    std::vector<ChunkFrameDecoder> readChunkFrames(const RegionKey& key,
+                                                   const std::vector<ChunkKey>& keys) override {
+        std::vector<ChunkFrameDecoder> decoders;
+        if (keys.empty()) {
+            return decoders;
+        }
+        auto open = acquireRegion(CRPaths::regionPath(key, m_context));
+        if (!open) {
+            return decoders;
+        }
+        ChunkKey hint{key.zoneId, 0, 0, 0};
+        std::scoped_lock lock(open->mutex);
+        if (open->header.version < kFramedFileVersion) {
+            // Legacy regions are one compressed block: decode everything, keep the request.
+            std::vector<ChunkSnapshot> all;
+            readLegacyRegion(*open->reader, open->header, hint, all);
+            auto chunks = std::make_shared<std::vector<ChunkSnapshot>>();
+            for (auto& chunk : all) {
+                if (std::find(keys.begin(), keys.end(), chunk.key) != keys.end()) {
+                    chunks->push_back(std::move(chunk));
+                }
+            }
+            decoders.push_back([chunks]() { return std::move(*chunks); });
+            return decoders;
+        }
+
+        std::map<int, std::vector<int32_t>> wantedByColumn;
+        for (const auto& chunkKey : keys) {
+            int32_t localX = chunkKey.x - key.x * 16;
+            int32_t localY = chunkKey.y - key.y * 16;
+            int32_t localZ = chunkKey.z - key.z * 16;
+            if (localX < 0 || localX >= 16 || localZ < 0 || localZ >= 16 || localY < 0 || localY >= 16) {
+                continue;
+            }
+            wantedByColumn[localX + localZ * 16].push_back(chunkKey.y);
+        }
+
+        for (auto& [column, ys] : wantedByColumn) {
+            int32_t offset = open->index.offsets[static_cast<size_t>(column)];
+            if (offset < 0) {
+                continue;
+            }
+            auto frame = std::make_shared<ColumnFrame>(readColumnFrame(*open->reader, offset));
+            decoders.push_back([this, frame, dictionary = open->index.dictionary, ys = std::move(ys), hint]() {
+                std::vector<ChunkSnapshot> out;
+                decodeColumnFrame(std::move(*frame), dictionary.get(), &ys, hint, out);
+                return out;
+            });
+        }
+        return decoders;
+    }
+
+    std::vector<RegionKey> listRegions(const std::string& zoneId) override {
+        std::vector<RegionKey> regions;
+        std::string dir = CRPaths::zoneRoot(zoneId, m_context) + "/regions";
+        if (!m_storage->exists(dir)) {
+            return regions;
+        }
+        for (const auto& entry : m_storage->list(dir)) {
+            std::string name = std::filesystem::path(entry).filename().string();
+            int rx = 0;
+            int ry = 0;
+            int rz = 0;
+            if (!parseRegionFilename(name, rx, ry, rz)) {
+                continue;
+            }
+            regions.push_back(RegionKey{zoneId, rx, ry, rz});
+        }
+        return regions;
+    }
+
+private:
+    struct RegionHeader {
+        int32_t version = 0;
+        int32_t compressionType = kCompressionNone;
+    };
+
+    RegionHeader readRegionHeader(ByteReader& reader) {
+        int32_t magic = reader.readI32();
+        if (magic != kMagic) {
+            throw std::runtime_error("CRRegion: invalid magic");
+        }
+        RegionHeader header;
+        header.version = reader.readI32();
+        if (header.version > kDictionaryFileVersion) {
+            throw std::runtime_error("CRRegion: unsupported version");
+        }
+        header.compressionType = reader.readI32();
+        if (header.compressionType != kCompressionNone && header.compressionType != kCompressionLz4) {
+            throw std::runtime_error("CRRegion: unknown compression type");
+        }
+        reader.readI32();
+        return header;
+    }
+
+    struct ColumnFrame {
+        int32_t rawSize = 0;
+        uint8_t codec = kFrameRaw;
+        std::vector<uint8_t> stored;
+    };
+
+    struct FramedIndex {
+        std::vector<int32_t> offsets;
+        std::shared_ptr<const std::vector<uint8_t>> dictionary;
+    };
+
+    // A region file with its header (and, for framed layouts, offset table and
+    // dictionary) already parsed. Framed regions stay open between reads so each
+    // request costs only its frame reads; the reader is stateful, so use it under
+    // `mutex`.
+    struct OpenRegion {
+        std::mutex mutex;
+        std::unique_ptr<ByteReader> reader;
+        RegionHeader header;
+        FramedIndex index;
+    };
+
+    struct OpenRegionEntry {
+        std::shared_ptr<OpenRegion> region;
+        uint64_t lastUse = 0;
+    };
+
+    static constexpr size_t kMaxOpenRegions = 16;
+
+    // Returns nullptr when the region does not exist. Legacy regions are read once
+    // and not kept open.
+    std::shared_ptr<OpenRegion> acquireRegion(const std::string& path) {
+        uint64_t generation = 0;
+        {
+            std::scoped_lock lock(m_openMutex);
+            auto it = m_openRegions.find(path);
+            if (it != m_openRegions.end()) {
+                it->second.lastUse = ++m_openClock;
+                return it->second.region;
+            }
+            generation = m_openGeneration;
+        }
+        if (!m_storage->exists(path)) {
+            return nullptr;
+        }
+
+        auto open = std::make_shared<OpenRegion>();
+        open->reader = m_storage->openRead(path);
+        open->header = readRegionHeader(*open->reader);
+        if (open->header.version < kFramedFileVersion) {
+            return open;
+        }
+        open->index = readFramedIndex(*open->reader, open->header);
+
+        std::scoped_lock lock(m_openMutex);
+        // Skip caching if any region was rewritten while this one was being opened;
+        // the handle might point at the replaced file.
+        if (generation != m_openGeneration) {
+            return open;
+        }
+        if (m_openRegions.size() >= kMaxOpenRegions) {
+            auto oldest = std::min_element(m_openRegions.begin(), m_openRegions.end(),
+                                           [](const auto& a, const auto& b) {
+                                               return a.second.lastUse < b.second.lastUse;
+                                           });
+            m_openRegions.erase(oldest);
+        }
+        m_openRegions[path] = OpenRegionEntry{open, ++m_openClock};
+        return open;
+    }
+
+    void dropOpenRegion(const std::string& path) {
+        std::scoped_lock lock(m_openMutex);
+        ++m_openGeneration;
+        m_openRegions.erase(path);
+    }
+
+    // Version 5/6 layout: an uncompressed table of absolute column frame offsets
+    // follows the header, so any column can be located with one read. Version 6
+    // adds a shared dictionary section after the table (size 0 when unused).
+    void writeFramedRegion(const std::string& path,
+                           const std::vector<std::vector<ChunkSnapshot>>& columns,
+                           bool useCompression,
+                           bool useDictionary) {
+        std::vector<std::vector<uint8_t>> rawColumns(kRegionColumns);
+        size_t nonEmptyColumns = 0;
+        for (int index = 0; index < kRegionColumns; ++index) {
+            if (columns[index].empty()) {
+                continue;
+            }
+            VectorWriter rawWriter(rawColumns[index]);
+            writeFramedColumn(columns[index], rawWriter);
+            ++nonEmptyColumns;
+        }
+
+        std::vector<ColumnFrame> frames(kRegionColumns);
+        size_t framedBytes = 0;
+        for (int index = 0; index < kRegionColumns; ++index) {
+            if (!rawColumns[index].empty()) {
+                frames[index] = encodeColumnFrame(rawColumns[index], useCompression, nullptr);
+                framedBytes += frames[index].stored.size();
+            }
+        }
+
+        // The dictionary is only kept when it pays for its own bytes in the header.
+        std::vector<uint8_t> dictionary;
+        if (useDictionary && nonEmptyColumns >= kMinDictionaryColumns) {
+            dictionary = buildColumnDictionary(rawColumns);
+            std::vector<ColumnFrame> dictFrames(kRegionColumns);
+            size_t dictBytes = dictionary.size();
+            for (int index = 0; index < kRegionColumns; ++index) {
+                if (!rawColumns[index].empty()) {
+                    dictFrames[index] = encodeColumnFrame(rawColumns[index], true, &dictionary);
+                    if (dictFrames[index].stored.size() >= frames[index].stored.size()) {
+                        dictFrames[index] = std::move(frames[index]);
+                    }
+                    dictBytes += dictFrames[index].stored.size();
+                }
+            }
+            if (dictBytes < framedBytes) {
+                frames = std::move(dictFrames);
+            } else {
+                dictionary.clear();
+            }
+        }
+
+        const size_t framesStart = kFramedHeaderBytes + 4 + dictionary.size();
+        std::vector<int32_t> offsets(kRegionColumns, -1);
+        std::vector<uint8_t> body;
+        VectorWriter bodyWriter(body);
+        int32_t columnsWritten = 0;
+        for (int index = 0; index < kRegionColumns; ++index) {
+            if (rawColumns[index].empty()) {
+                continue;
+            }
+            const ColumnFrame& frame = frames[index];
+            offsets[index] = static_cast<int32_t>(framesStart + bodyWriter.tell());
+            ++columnsWritten;
+            bodyWriter.writeI32(static_cast<int32_t>(frame.stored.size()));
+            bodyWriter.writeI32(frame.rawSize);
+            bodyWriter.writeU8(frame.codec);
+            bodyWriter.writeBytes(frame.stored.data(), frame.stored.size());
+        }
+
+        auto session = m_storage->openWrite(path, AtomicWriteOptions{});
+        auto& writer = session->writer();
+        writer.writeI32(kMagic);
+        writer.writeI32(kDictionaryFileVersion);
+        writer.writeI32(useCompression ? kCompressionLz4 : kCompressionNone);
+        writer.writeI32(columnsWritten);
+        for (int32_t offset : offsets) {
+            writer.writeI32(offset);
+        }
+        writer.writeI32(static_cast<int32_t>(dictionary.size()));
+        if (!dictionary.empty()) {
+            writer.writeBytes(dictionary.data(), dictionary.size());
+        }
+        if (!body.empty()) {
+            writer.writeBytes(body.data(), body.size());
+        }
+        writer.flush();
+        session->commit();
+    }
+
+    static ColumnFrame encodeColumnFrame(const std::vector<uint8_t>& raw,
+                                         bool useCompression,
+                                         const std::vector<uint8_t>* dictionary) {
+        ColumnFrame frame;
+        frame.rawSize = static_cast<int32_t>(raw.size());
+        if (useCompression) {
+            std::vector<uint8_t> compressed(
+                static_cast<size_t>(CRLz4::compressBound(static_cast<int>(raw.size()))));
+            int compressedSize = dictionary
+                ? CRLz4::compressWithDict(raw.data(), raw.size(), compressed.data(), compressed.size(),
+                                          dictionary->data(), dictionary->size())
+                : CRLz4::compress(raw.data(), raw.size(), compressed.data(), compressed.size());
+            if (compressedSize <= 0) {
+                throw std::runtime_error("CRRegion: LZ4 compression failed");
+            }
+            if (static_cast<size_t>(compressedSize) < raw.size()) {
+                compressed.resize(static_cast<size_t>(compressedSize));
+                frame.codec = dictionary ? kFrameLz4Dict : kFrameLz4;
+                frame.stored = std::move(compressed);
+                return frame;
+            }
+        }
+        frame.codec = kFrameRaw;
+        frame.stored = raw;
+        return frame;
+    }
+
+    // LZ4 has no dictionary trainer; distinct column prefixes, strided across the
+    // region to fit the size cap, stand in for one.
+    static std::vector<uint8_t> buildColumnDictionary(const std::vector<std::vector<uint8_t>>& rawColumns) {
+        std::vector<std::string> samples;
+        std::unordered_map<std::string, size_t> seen;
+        for (const auto& raw : rawColumns) {
+            if (raw.empty()) {
+                continue;
+            }
+            size_t len = std::min(raw.size(), kDictionarySampleBytes);
+            std::string sample(reinterpret_cast<const char*>(raw.data()), len);
+            if (seen.emplace(sample, samples.size()).second) {
+                samples.push_back(std::move(sample));
+            }
+        }
+
+        std::vector<uint8_t> dictionary;
+        const size_t maxSamples = std::max<size_t>(1, kMaxDictionaryBytes / kDictionarySampleBytes);
+        const size_t stride = std::max<size_t>(1, (samples.size() + maxSamples - 1) / maxSamples);
+        for (size_t i = 0; i < samples.size(); i += stride) {
+            if (dictionary.size() + samples[i].size() > kMaxDictionaryBytes) {
+                break;
+            }
+            dictionary.insert(dictionary.end(), samples[i].begin(), samples[i].end());
+        }
+        return dictionary;
+    }
+
+    // Column body: chunk count, a (chunk y, record offset) index, then the chunk
+    // records. The index lets a reader decode only the chunks it asked for.
+    void writeFramedColumn(const std::vector<ChunkSnapshot>& col, ByteWriter& writer) {
+        if (col.size() > 255) {
+            throw std::runtime_error("CRRegion: too many chunks in column");
+        }
+        writer.writeU8(static_cast<uint8_t>(col.size()));
+        size_t indexStart = writer.tell();
+        for (size_t i = 0; i < col.size(); ++i) {
+            writer.writeI32(0);
+            writer.writeI32(0);
+        }
+        size_t recordsStart = writer.tell();
+        for (size_t i = 0; i < col.size(); ++i) {
+            auto yBytes = encodeI32(col[i].key.y);
+            auto offsetBytes = encodeI32(static_cast<int32_t>(writer.tell() - recordsStart));
+            writer.writeAt(indexStart + i * 8, yBytes.data(), yBytes.size());
+            writer.writeAt(indexStart + i * 8 + 4, offsetBytes.data(), offsetBytes.size());
+            m_codec.write(col[i], writer);
+        }
+    }
+
+    FramedIndex readFramedIndex(ByteReader& reader, const RegionHeader& header) {
+        FramedIndex index;
+        MemoryByteReader table(reader.readAt(kRegionHeaderBytes, kRegionColumns * 4));
+        size_t framesStart = kFramedHeaderBytes;
+        if (header.version >= kDictionaryFileVersion) {
+            MemoryByteReader sizeField(reader.readAt(kFramedHeaderBytes, 4));
+            int32_t dictSize = sizeField.readI32();
+            if (dictSize < 0 || kFramedHeaderBytes + 4 + static_cast<size_t>(dictSize) > reader.size()) {
+                throw std::runtime_error("CRRegion: invalid dictionary size");
+            }
+            if (dictSize > 0) {
+                index.dictionary = std::make_shared<const std::vector<uint8_t>>(
+                    reader.readAt(kFramedHeaderBytes + 4, static_cast<size_t>(dictSize)));
+            }
+            framesStart += 4 + static_cast<size_t>(dictSize);
+        }
+        index.offsets.assign(kRegionColumns, -1);
+        for (auto& offset : index.offsets) {
+            offset = table.readI32();
+            if (offset >= 0 && (static_cast<size_t>(offset) < framesStart ||
+                                static_cast<size_t>(offset) + kFrameHeaderBytes > reader.size())) {
+                throw std::runtime_error("CRRegion: column offset out of range");
+            }
+        }
+        return index;
+    }
+
+    static std::vector<ChunkKey> columnKeys(const RegionKey& key, int column) {
+        std::vector<ChunkKey> keys;
+        keys.reserve(16);
+        for (int32_t localY = 0; localY < 16; ++localY) {
+            keys.push_back(ChunkKey{key.zoneId,
+                                    key.x * 16 + column % 16,
+                                    key.y * 16 + localY,
+                                    key.z * 16 + column / 16});
+        }
+        return keys;
+    }
+
+    ColumnFrame readColumnFrame(ByteReader& reader, int32_t offset) {
+        MemoryByteReader frameHeader(reader.readAt(static_cast<size_t>(offset), kFrameHeaderBytes));
+        int32_t storedSize = frameHeader.readI32();
+        ColumnFrame frame;
+        frame.rawSize = frameHeader.readI32();
+        frame.codec = frameHeader.readU8();
+        size_t bodyOffset = static_cast<size_t>(offset) + kFrameHeaderBytes;
+        if (storedSize <= 0 || frame.rawSize <= 0 ||
+            bodyOffset + static_cast<size_t>(storedSize) > reader.size()) {
+            throw std::runtime_error("CRRegion: invalid column frame");
+        }
+        // The raw size is allocated before decompressing, so it must be one the
+        // stored bytes can actually expand to.
+        const int64_t maxRawSize = frame.codec == kFrameRaw
+            ? static_cast<int64_t>(storedSize)
+            : static_cast<int64_t>(storedSize) * kMaxLz4Expansion;
+        if (frame.rawSize > maxRawSize) {
+            throw std::runtime_error("CRRegion: invalid column frame");
+        }
+        frame.stored = reader.readAt(bodyOffset, static_cast<size_t>(storedSize));
+        return frame;
+    }
+
+    void decodeColumnFrame(ColumnFrame frame,
+                           const std::vector<uint8_t>* dictionary,
+                           const std::vector<int32_t>* wantedYs,
+                           const ChunkKey& hint,
+                           std::vector<ChunkSnapshot>& out) const {
+        std::vector<uint8_t> raw;
+        if (frame.codec == kFrameLz4 || frame.codec == kFrameLz4Dict) {
+            if (!CRLz4::available()) {
+                throw std::runtime_error("CRRegion: LZ4 compression unavailable");
+            }
+            raw.resize(static_cast<size_t>(frame.rawSize));
+            int result = 0;
+            if (frame.codec == kFrameLz4Dict) {
+                if (!dictionary) {
+                    throw std::runtime_error("CRRegion: column frame needs a missing dictionary");
+                }
+                result = CRLz4::decompressWithDict(frame.stored.data(), frame.stored.size(), raw.data(), raw.size(),
+                                                   dictionary->data(), dictionary->size());
+            } else {
+                result = CRLz4::decompress(frame.stored.data(), frame.stored.size(), raw.data(), raw.size());
+            }
+            if (result != frame.rawSize) {
+                throw std::runtime_error("CRRegion: LZ4 decompression failed");
+            }
+        } else if (frame.codec == kFrameRaw && frame.stored.size() == static_cast<size_t>(frame.rawSize)) {
+            raw = std::move(frame.stored);
+        } else {
+            throw std::runtime_error("CRRegion: unknown column frame codec");
+        }
+
+        MemoryByteReader column(std::move(raw));
+        uint8_t numChunks = column.readU8();
+        std::vector<std::pair<int32_t, int32_t>> index(numChunks);
+        for (auto& [y, recordOffset] : index) {
+            y = column.readI32();
+            recordOffset = column.readI32();
+        }
+        size_t recordsStart = column.tell();
+        for (const auto& [y, recordOffset] : index) {
+            if (recordOffset < 0 || recordsStart + static_cast<size_t>(recordOffset) >= column.size()) {
+                throw std::runtime_error("CRRegion: invalid column frame");
+            }
+        }
+        for (const auto& [y, recordOffset] : index) {
+            if (wantedYs && std::find(wantedYs->begin(), wantedYs->end(), y) == wantedYs->end()) {
+                continue;
+            }
+            column.seek(recordsStart + static_cast<size_t>(recordOffset));
+            out.push_back(m_codec.read(column, hint));
+        }
+    }
+
+    // Version <= 4 layout, still what Cosmic Reach itself reads: one payload holding
+    // the offset table and every column, optionally compressed as a single block.
+    void writeLegacyRegion(const std::string& path,
+                           const std::vector<std::vector<ChunkSnapshot>>& columns,
+                           bool useCompression) {
+        std::vector<int32_t> offsets(kRegionColumns, -1);
         std::vector<uint8_t> columnsBytes;
         VectorWriter columnsWriter(columnsBytes);
         int columnsWritten = 0;
 
-        for (int index = 0; index < 16 * 16; ++index) {
-            auto& col = columns[index];
+        for (int index = 0; index < kRegionColumns; ++index) {
+            const auto& col = columns[index];
             if (col.empty()) {
                 continue;
             }
-            std::sort(col.begin(), col.end(), [](const ChunkSnapshot& a, const ChunkSnapshot& b) {
-                return a.key.y < b.key.y;
-            });
             offsets[index] = static_cast<int32_t>(columnsWriter.size());
             ++columnsWritten;
 
@@ -1141,23 +1670,12 @@ public:
             payloadWriter.writeBytes(columnsBytes.data(), columnsBytes.size());
         }
 
-        bool useCompression = false;
-        if (m_context.providers) {
-            auto settings = m_context.providers->findAs<CRPersistenceSettings>(kCRSettingsProviderId);
-            if (settings) {
-                useCompression = settings->enableLz4;
-            }
-        }
-
         auto session = m_storage->openWrite(path, AtomicWriteOptions{});
         auto& writer = session->writer();
         writer.writeI32(kMagic);
         writer.writeI32(kFileVersion);
 
         if (useCompression) {
-            if (!CRLz4::available()) {
-                throw std::runtime_error("CRRegion: LZ4 compression requested but unavailable");
-            }
             int32_t decompressedSize = static_cast<int32_t>(payload.size());
             int bound = CRLz4::compressBound(decompressedSize);
             std::vector<uint8_t> compressed(static_cast<size_t>(bound));
@@ -1184,29 +1702,23 @@ public:
         session->commit();
     }
 
-    ChunkRegionSnapshot loadRegion(const RegionKey& key) override {
-        ChunkRegionSnapshot region;
-        region.key = key;
-        auto path = CRPaths::regionPath(key, m_context);
-        if (!m_storage->exists(path)) {
-            return region;
+    void readLegacyRegion(ByteReader& reader,
+                          const RegionHeader& header,
+                          const ChunkKey& hint,
+                          std::vector<ChunkSnapshot>& out) {
+        for (auto& [column, bytes] : readLegacyColumns(reader, header)) {
+            decodeLegacyColumn(std::move(bytes), hint, out);
         }
-        auto reader = m_storage->openRead(path);
-        int32_t magic = reader->readI32();
-        if (magic != kMagic) {
-            throw std::runtime_error("CRRegion: invalid magic");
-        }
-        int32_t version = reader->readI32();
-        if (version > kFileVersion) {
-            throw std::runtime_error("CRRegion: unsupported version");
-        }
-        int32_t compressionType = reader->readI32();
-        reader->readI32();
+    }
 
+    // Reads a version <= 4 payload and cuts it into (column index, column bytes) using
+    // its offset table. A column runs up to the next stored column or the payload end.
+    std::vector<std::pair<int, std::vector<uint8_t>>> readLegacyColumns(ByteReader& reader,
+                                                                        const RegionHeader& header) {
         std::unique_ptr<ByteReader> payloadReader;
-        if (compressionType == kCompressionLz4) {
-            int32_t compressedSize = reader->readI32();
-            int32_t decompressedSize = reader->readI32();
+        if (header.compressionType == kCompressionLz4) {
+            int32_t compressedSize = reader.readI32();
+            int32_t decompressedSize = reader.readI32();
             if (!CRLz4::available()) {
                 throw std::runtime_error("CRRegion: LZ4 compression unavailable");
             }
@@ -1214,20 +1726,18 @@ public:
                 throw std::runtime_error("CRRegion: invalid compressed sizes");
             }
             std::vector<uint8_t> compressed(static_cast<size_t>(compressedSize));
-            reader->readBytes(compressed.data(), compressed.size());
+            reader.readBytes(compressed.data(), compressed.size());
             std::vector<uint8_t> decompressed(static_cast<size_t>(decompressedSize));
             int result = CRLz4::decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
             if (result < 0) {
                 throw std::runtime_error("CRRegion: LZ4 decompression failed");
             }
             payloadReader = std::make_unique<MemoryByteReader>(std::move(decompressed));
-        } else if (compressionType != kCompressionNone) {
-            throw std::runtime_error("CRRegion: unknown compression type");
         }
 
-        ByteReader* dataReader = payloadReader ? payloadReader.get() : reader.get();
+        ByteReader* dataReader = payloadReader ? payloadReader.get() : &reader;
         uint8_t offsetType = dataReader->readU8();
-        std::vector<int32_t> offsets(16 * 16, -1);
+        std::vector<int32_t> offsets(kRegionColumns, -1);
         size_t tableStart = dataReader->tell();
         size_t offsetTableSize = 0;
         if (offsetType == 1) {
@@ -1253,49 +1763,53 @@ public:
             }
         }
 
-        ChunkKey hint{key.zoneId, 0, 0, 0};
+        const size_t payloadEnd = dataReader->size();
+        std::vector<int32_t> starts;
+        for (int32_t offset : offsets) {
+            if (offset >= 0) {
+                if (static_cast<size_t>(offset) >= payloadEnd) {
+                    throw std::runtime_error("CRRegion: column offset out of range");
+                }
+                starts.push_back(offset);
+            }
+        }
+        std::sort(starts.begin(), starts.end());
+
+        std::vector<std::pair<int, std::vector<uint8_t>>> columns;
         for (size_t index = 0; index < offsets.size(); ++index) {
             int32_t offset = offsets[index];
             if (offset < 0) {
                 continue;
             }
-            dataReader->seek(static_cast<size_t>(offset));
-            int32_t columnByteSize = dataReader->readI32();
-            if (columnByteSize <= 0) {
-                continue;
-            }
-            dataReader->readI32();
-            uint8_t numChunks = dataReader->readU8();
-            for (uint8_t i = 0; i < numChunks; ++i) {
-                region.chunks.push_back(m_codec.read(*dataReader, hint));
-            }
+            auto next = std::upper_bound(starts.begin(), starts.end(), offset);
+            size_t end = next == starts.end() ? payloadEnd : static_cast<size_t>(*next);
+            columns.emplace_back(static_cast<int>(index),
+                                 dataReader->readAt(static_cast<size_t>(offset), end - static_cast<size_t>(offset)));
         }
-        return region;
+        return columns;
     }
 
-    std::vector<RegionKey> listRegions(const std::string& zoneId) override {
-        std::vector<RegionKey> regions;
-        std::string dir = CRPaths::zoneRoot(zoneId, m_context) + "/regions";
-        if (!m_storage->exists(dir)) {
-            return regions;
+    void decodeLegacyColumn(std::vector<uint8_t> bytes, const ChunkKey& hint, std::vector<ChunkSnapshot>& out) const {
+        MemoryByteReader column(std::move(bytes));
+        int32_t columnByteSize = column.readI32();
+        if (columnByteSize <= 0) {
+            return;
         }
-        for (const auto& entry : m_storage->list(dir)) {
-            std::string name = std::filesystem::path(entry).filename().string();
-            int rx = 0;
-            int ry = 0;
-            int rz = 0;
-            if (!parseRegionFilename(name, rx, ry, rz)) {
-                continue;
-            }
-            regions.push_back(RegionKey{zoneId, rx, ry, rz});
+        column.readI32();
+        uint8_t numChunks = column.readU8();
+        for (uint8_t i = 0; i < numChunks; ++i) {
+            out.push_back(m_codec.read(column, hint));
         }
-        return regions;
     }
 
-private:
     std::shared_ptr<StorageBackend> m_storage;
     PersistenceContext m_context;
     CRChunkCodec& m_codec;
+
+    std::mutex m_openMutex;
+    std::unordered_map<std::string, OpenRegionEntry> m_openRegions;
+    uint64_t m_openClock = 0;
+    uint64_t m_openGeneration = 0;
 };
 
 class CREntityContainer final : public EntityContainer {
@@ -1374,7 +1888,11 @@ public:
         : m_storage(std::move(storage)),
           m_context(std::move(context)),
           m_chunkContainer(m_storage, m_context, m_chunkCodec),
-          m_entityContainer(m_storage, m_context) {
+          m_entityContainer(m_storage, m_context),
+          m_descriptor(Backends::CR::descriptor()) {
+        // Only worlds that opted into framed regions can serve single-chunk reads
+        // without decoding whole regions.
+        m_descriptor.capabilities.supportsRandomAccess = writesFramedRegions(m_context);
         m_worldCodec.setContext(m_context);
         m_chunkCodec.setPolicies(m_context.policies);
         if (m_context.providers) {
@@ -1392,7 +1910,7 @@ public:
     }
 
     const FormatDescriptor& descriptor() const override {
-        return Backends::CR::descriptor();
+        return m_descriptor;
     }
 
     WorldMetadataCodec& worldMetadataCodec() override {
@@ -1424,6 +1942,7 @@ private:
     CRChunkCodec m_chunkCodec;
     CRChunkContainer m_chunkContainer;
     CREntityContainer m_entityContainer;
+    FormatDescriptor m_descriptor;
 };
 
 } // namespace
@@ -0,0 +1,245 @@
+#include "Rigel/Persistence/Backends/CR/CRLayerPacking.h"
+
+#include "Rigel/Voxel/BlockRegistry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Rigel::Persistence::Backends::CR {
+namespace {
+
+void requirePackedWidth(int bitsPerIndex) {
+    if (!isPackedLayerWidth(bitsPerIndex)) {
+        throw std::invalid_argument("CRLayerPacking: unsupported index width");
+    }
+}
+
+#if defined(__SSE2__)
+// Field k of every byte in `v` (bits [k * Bits, (k + 1) * Bits)). The 16-bit shift pulls
+// bits of the neighbouring byte in from above, but only past the field mask.
+template <int Bits>
+__m128i field(__m128i v, int k) {
+    const __m128i mask = _mm_set1_epi8(static_cast<char>((1 << Bits) - 1));
+    return _mm_and_si128(_mm_srli_epi16(v, k * Bits), mask);
+}
+
+void store(uint8_t* out, __m128i v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+}
+
+// Each unpack step interleaves fields back into index order: fields of byte i are
+// indices i * (8 / Bits) .. in ascending order.
+void unpackNibbles(const uint8_t* packed, uint8_t* indices) {
+    for (size_t offset = 0; offset < kLayerIndexCount / 2; offset += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + offset));
+        const __m128i lo = field<4>(v, 0);
+        const __m128i hi = field<4>(v, 1);
+        store(indices + offset * 2, _mm_unpacklo_epi8(lo, hi));
+        store(indices + offset * 2 + 16, _mm_unpackhi_epi8(lo, hi));
+    }
+}
+
+void unpackHalfNibbles(const uint8_t* packed, uint8_t* indices) {
+    for (size_t offset = 0; offset < kLayerIndexCount / 4; offset += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + offset));
+        const __m128i c0 = field<2>(v, 0);
+        const __m128i c1 = field<2>(v, 1);
+        const __m128i c2 = field<2>(v, 2);
+        const __m128i c3 = field<2>(v, 3);
+        const __m128i p01Lo = _mm_unpacklo_epi8(c0, c1);
+        const __m128i p01Hi = _mm_unpackhi_epi8(c0, c1);
+        const __m128i p23Lo = _mm_unpacklo_epi8(c2, c3);
+        const __m128i p23Hi = _mm_unpackhi_epi8(c2, c3);
+        uint8_t* out = indices + offset * 4;
+        store(out, _mm_unpacklo_epi16(p01Lo, p23Lo));
+        store(out + 16, _mm_unpackhi_epi16(p01Lo, p23Lo));
+        store(out + 32, _mm_unpacklo_epi16(p01Hi, p23Hi));
+        store(out + 48, _mm_unpackhi_epi16(p01Hi, p23Hi));
+    }
+}
+
+void unpackBits(const uint8_t* packed, uint8_t* indices) {
+    for (size_t offset = 0; offset < kLayerIndexCount / 8; offset += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + offset));
+        __m128i pairs[8];
+        for (int k = 0; k < 8; k += 2) {
+            const __m128i a = field<1>(v, k);
+            const __m128i b = field<1>(v, k + 1);
+            pairs[k] = _mm_unpacklo_epi8(a, b);
+            pairs[k + 1] = _mm_unpackhi_epi8(a, b);
+        }
+        // quads[h][q]: fields 4h..4h+3 of bytes 4q..4q+3.
+        __m128i quads[2][4];
+        for (int h = 0; h < 2; ++h) {
+            const __m128i* p = pairs + h * 4;
+            quads[h][0] = _mm_unpacklo_epi16(p[0], p[2]);
+            quads[h][1] = _mm_unpackhi_epi16(p[0], p[2]);
+            quads[h][2] = _mm_unpacklo_epi16(p[1], p[3]);
+            quads[h][3] = _mm_unpackhi_epi16(p[1], p[3]);
+        }
+        uint8_t* out = indices + offset * 8;
+        for (int q = 0; q < 4; ++q) {
+            store(out + q * 32, _mm_unpacklo_epi32(quads[0][q], quads[1][q]));
+            store(out + q * 32 + 16, _mm_unpackhi_epi32(quads[0][q], quads[1][q]));
+        }
+    }
+}
+
+// 16 indices, masked to `mask`, narrowed to bytes.
+__m128i loadIndexBytes(const uint16_t* indices, __m128i mask) {
+    const __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices)), mask);
+    const __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + 8)), mask);
+    return _mm_packus_epi16(a, b);
+}
+
+void packBytes(const uint16_t* indices, uint8_t* packed) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (size_t i = 0; i < kLayerIndexCount; i += 16) {
+        store(packed + i, loadIndexBytes(indices + i, mask));
+    }
+}
+
+void packNibbles(const uint16_t* indices, uint8_t* packed) {
+    const __m128i mask = _mm_set1_epi16(0x000F);
+    for (size_t i = 0; i < kLayerIndexCount; i += 32) {
+        // Each 16-bit lane holds (even | odd << 8); fold it to (even | odd << 4).
+        const __m128i a = loadIndexBytes(indices + i, mask);
+        const __m128i b = loadIndexBytes(indices + i + 16, mask);
+        const __m128i foldA = _mm_or_si128(_mm_and_si128(a, mask), _mm_srli_epi16(a, 4));
+        const __m128i foldB = _mm_or_si128(_mm_and_si128(b, mask), _mm_srli_epi16(b, 4));
+        store(packed + i / 2, _mm_packus_epi16(foldA, foldB));
+    }
+}
+
+void packHalfNibbles(const uint16_t* indices, uint8_t* packed) {
+    const __m128i mask = _mm_set1_epi16(0x0003);
+    const __m128i nibble = _mm_set1_epi32(0x0000000F);
+    for (size_t i = 0; i < kLayerIndexCount; i += 64) {
+        __m128i words[4];
+        for (int j = 0; j < 4; ++j) {
+            const __m128i bytes = loadIndexBytes(indices + i + static_cast<size_t>(j) * 16, mask);
+            // (b0 | b1 << 8) -> (b0 | b1 << 2) per 16-bit lane, then pairs of those per 32-bit lane.
+            const __m128i pairs = _mm_and_si128(_mm_or_si128(bytes, _mm_srli_epi16(bytes, 6)),
+                                                _mm_set1_epi16(0x000F));
+            words[j] = _mm_or_si128(_mm_and_si128(pairs, nibble), _mm_srli_epi32(pairs, 12));
+        }
+        const __m128i lo = _mm_packs_epi32(words[0], words[1]);
+        const __m128i hi = _mm_packs_epi32(words[2], words[3]);
+        store(packed + i / 4, _mm_packus_epi16(lo, hi));
+    }
+}
+
+void packBits(const uint16_t* indices, uint8_t* packed) {
+    const __m128i mask = _mm_set1_epi16(0x0001);
+    for (size_t i = 0; i < kLayerIndexCount; i += 16) {
+        // Move each index bit to its byte's sign bit; movemask gathers 16 of them.
+        const __m128i bytes = loadIndexBytes(indices + i, mask);
+        const int bits = _mm_movemask_epi8(_mm_slli_epi16(bytes, 7));
+        packed[i / 8] = static_cast<uint8_t>(bits & 0xFF);
+        packed[i / 8 + 1] = static_cast<uint8_t>((bits >> 8) & 0xFF);
+    }
+}
+#endif
+
+} // namespace
+
+bool isPackedLayerWidth(int bitsPerIndex) {
+    return bitsPerIndex == 1 || bitsPerIndex == 2 || bitsPerIndex == 4 || bitsPerIndex == 8;
+}
+
+size_t packedLayerBytes(int bitsPerIndex) {
+    requirePackedWidth(bitsPerIndex);
+    return kLayerIndexCount * static_cast<size_t>(bitsPerIndex) / 8;
+}
+
+LayerPaletteLut makeLayerPaletteLut(std::span<const Voxel::BlockID> palette) {
+    LayerPaletteLut lut;
+    lut.fill(Voxel::BlockRegistry::airId());
+    std::copy_n(palette.begin(), std::min(palette.size(), lut.size()), lut.begin());
+    return lut;
+}
+
+void unpackLayerIndices(const uint8_t* packed, int bitsPerIndex, uint8_t* indices) {
+    requirePackedWidth(bitsPerIndex);
+#if defined(__SSE2__)
+    switch (bitsPerIndex) {
+    case 1:
+        unpackBits(packed, indices);
+        return;
+    case 2:
+        unpackHalfNibbles(packed, indices);
+        return;
+    case 4:
+        unpackNibbles(packed, indices);
+        return;
+    default:
+        std::memcpy(indices, packed, kLayerIndexCount);
+        return;
+    }
+#else
+    detail::unpackLayerIndicesScalar(packed, bitsPerIndex, indices);
+#endif
+}
+
+void packLayerIndices(const uint16_t* indices, int bitsPerIndex, uint8_t* packed) {
+    requirePackedWidth(bitsPerIndex);
+#if defined(__SSE2__)
+    switch (bitsPerIndex) {
+    case 1:
+        packBits(indices, packed);
+        return;
+    case 2:
+        packHalfNibbles(indices, packed);
+        return;
+    case 4:
+        packNibbles(indices, packed);
+        return;
+    default:
+        packBytes(indices, packed);
+        return;
+    }
+#else
+    detail::packLayerIndicesScalar(indices, bitsPerIndex, packed);
+#endif
+}
+
+void unpackLayerBlocks(const uint8_t* packed,
+                       int bitsPerIndex,
+                       const LayerPaletteLut& lut,
+                       Voxel::BlockState* out) {
+    alignas(16) std::array<uint8_t, kLayerIndexCount> indices;
+    unpackLayerIndices(packed, bitsPerIndex, indices.data());
+    for (size_t i = 0; i < kLayerIndexCount; ++i) {
+        out[i] = Voxel::BlockState{lut[indices[i]]};
+    }
+}
+
+namespace detail {
+
+void unpackLayerIndicesScalar(const uint8_t* packed, int bitsPerIndex, uint8_t* indices) {
+    requirePackedWidth(bitsPerIndex);
+    const unsigned mask = (1u << bitsPerIndex) - 1u;
+    for (size_t i = 0; i < kLayerIndexCount; ++i) {
+        const size_t bit = i * static_cast<size_t>(bitsPerIndex);
+        indices[i] = static_cast<uint8_t>((packed[bit / 8] >> (bit % 8)) & mask);
+    }
+}
+
+void packLayerIndicesScalar(const uint16_t* indices, int bitsPerIndex, uint8_t* packed) {
+    requirePackedWidth(bitsPerIndex);
+    const unsigned mask = (1u << bitsPerIndex) - 1u;
+    std::memset(packed, 0, packedLayerBytes(bitsPerIndex));
+    for (size_t i = 0; i < kLayerIndexCount; ++i) {
+        const size_t bit = i * static_cast<size_t>(bitsPerIndex);
+        packed[bit / 8] = static_cast<uint8_t>(packed[bit / 8] | ((indices[i] & mask) << (bit % 8)));
+    }
+}
+
+} // namespace detail
+
+} // namespace Rigel::Persistence::Backends::CR
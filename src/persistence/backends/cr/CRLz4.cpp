@@ -10,6 +10,13 @@ namespace {
 using CompressBoundFn = int (*)(int inputSize);
 using CompressFn = int (*)(const char* src, char* dst, int srcSize, int dstCapacity);
 using DecompressFn = int (*)(const char* src, char* dst, int compressedSize, int dstCapacity);
+using CreateStreamFn = void* (*)();
+using FreeStreamFn = int (*)(void* stream);
+using LoadDictFn = int (*)(void* stream, const char* dict, int dictSize);
+using CompressContinueFn = int (*)(void* stream, const char* src, char* dst,
+                                   int srcSize, int dstCapacity, int acceleration);
+using DecompressDictFn = int (*)(const char* src, char* dst, int compressedSize, int dstCapacity,
+                                 const char* dict, int dictSize);
 
 class Lz4Library {
 public:
@@ -30,7 +37,14 @@ public:
             compressBound = nullptr;
             compress = nullptr;
             decompress = nullptr;
+            return;
         }
+        // Optional: older liblz4 builds lack the streaming API.
+        createStream = reinterpret_cast<CreateStreamFn>(dlsym(handle, "LZ4_createStream"));
+        freeStream = reinterpret_cast<FreeStreamFn>(dlsym(handle, "LZ4_freeStream"));
+        loadDict = reinterpret_cast<LoadDictFn>(dlsym(handle, "LZ4_loadDict"));
+        compressContinue = reinterpret_cast<CompressContinueFn>(dlsym(handle, "LZ4_compress_fast_continue"));
+        decompressDict = reinterpret_cast<DecompressDictFn>(dlsym(handle, "LZ4_decompress_safe_usingDict"));
     }
 
     ~Lz4Library() {
@@ -43,6 +57,10 @@ public:
         return handle && compressBound && compress && decompress;
     }
 
+    bool dictionaryAvailable() const {
+        return available() && createStream && freeStream && loadDict && compressContinue && decompressDict;
+    }
+
     int bound(int size) const {
         return compressBound(size);
     }
@@ -57,11 +75,37 @@ public:
             static_cast<int>(srcSize), static_cast<int>(dstCapacity));
     }
 
+    int doCompressDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                       const uint8_t* dict, size_t dictSize) const {
+        // A fresh stream per call keeps this safe to use from several threads.
+        void* stream = createStream();
+        if (!stream) {
+            return 0;
+        }
+        loadDict(stream, reinterpret_cast<const char*>(dict), static_cast<int>(dictSize));
+        int result = compressContinue(stream, reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+            static_cast<int>(srcSize), static_cast<int>(dstCapacity), 1);
+        freeStream(stream);
+        return result;
+    }
+
+    int doDecompressDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                         const uint8_t* dict, size_t dictSize) const {
+        return decompressDict(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+            static_cast<int>(srcSize), static_cast<int>(dstCapacity),
+            reinterpret_cast<const char*>(dict), static_cast<int>(dictSize));
+    }
+
 private:
     void* handle = nullptr;
     CompressBoundFn compressBound = nullptr;
     CompressFn compress = nullptr;
     DecompressFn decompress = nullptr;
+    CreateStreamFn createStream = nullptr;
+    FreeStreamFn freeStream = nullptr;
+    LoadDictFn loadDict = nullptr;
+    CompressContinueFn compressContinue = nullptr;
+    DecompressDictFn decompressDict = nullptr;
 };
 
 Lz4Library& instance() {
@@ -96,4 +140,24 @@ int CRLz4::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t d
     return instance().doDecompress(src, srcSize, dst, dstCapacity);
 }
 
+bool CRLz4::dictionaryAvailable() {
+    return instance().dictionaryAvailable();
+}
+
+int CRLz4::compressWithDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                            const uint8_t* dict, size_t dictSize) {
+    if (!dictionaryAvailable()) {
+        throw std::runtime_error("CRLz4: dictionary API not available");
+    }
+    return instance().doCompressDict(src, srcSize, dst, dstCapacity, dict, dictSize);
+}
+
+int CRLz4::decompressWithDict(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity,
+                              const uint8_t* dict, size_t dictSize) {
+    if (!dictionaryAvailable()) {
+        throw std::runtime_error("CRLz4: dictionary API not available");
+    }
+    return instance().doDecompressDict(src, srcSize, dst, dstCapacity, dict, dictSize);
+}
+
 } // namespace Rigel::Persistence::Backends::CR
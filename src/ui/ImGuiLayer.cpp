@@ -1,6 +1,7 @@
 #include "Rigel/UI/ImGuiLayer.h"
 
 #include "Rigel/Core/Profiler.h"
+#include "Rigel/Persistence/WorldSaveService.h"
 #include "Rigel/Voxel/VoxelLod/VoxelSvoLodManager.h"
 
 #include <algorithm>
@@ -92,7 +93,8 @@ void endFrame() {
 
 void renderProfilerWindow(bool enabled,
                           const Rigel::Voxel::VoxelSvoConfig* voxelSvoConfig,
-                          const Rigel::Voxel::VoxelSvoTelemetry* voxelSvoTelemetry) {
+                          const Rigel::Voxel::VoxelSvoTelemetry* voxelSvoTelemetry,
+                          const Rigel::Persistence::WorldSaveMetrics* saveMetrics) {
 #if defined(RIGEL_ENABLE_IMGUI)
     if (!g_initialized || !enabled) {
         return;
@@ -317,6 +319,12 @@ void renderProfilerWindow(bool enabled,
                     voxelSvoTelemetry->evictedQueued,
                     voxelSvoTelemetry->evictedReadyCpu,
                     voxelSvoTelemetry->evictedReadyMesh);
+        ImGui::Text("Builds: in-flight %u, cancelled %u",
+                    voxelSvoTelemetry->buildsInFlight,
+                    voxelSvoTelemetry->buildsCancelled);
+        ImGui::Text("Disk cache: hits %" PRIu64 ", writes %" PRIu64,
+                    voxelSvoTelemetry->diskCacheHits,
+                    voxelSvoTelemetry->diskCacheWrites);
         ImGui::Text("Mesh blocked: missing-neighbors %u, leaf-mismatch %u",
                     voxelSvoTelemetry->meshBlockedMissingNeighbors,
                     voxelSvoTelemetry->meshBlockedLeafMismatch);
@@ -346,11 +354,29 @@ void renderProfilerWindow(bool enabled,
         ImGui::Text("Upload calls: %" PRIu64, voxelSvoTelemetry->uploadCalls);
     }
 
+    if (saveMetrics) {
+        ImGui::Separator();
+        ImGui::TextUnformatted("Autosave");
+        ImGui::Text("Dirty chunks: %zu (due %zu), oldest %.1f s",
+                    saveMetrics->dirtyChunks,
+                    saveMetrics->dueChunks,
+                    saveMetrics->oldestDirtySeconds);
+        ImGui::Text("Regions in flight: %zu, throttled updates %" PRIu64,
+                    saveMetrics->inFlightRegions,
+                    saveMetrics->throttledUpdates);
+        ImGui::Text("Saved: chunks %" PRIu64 ", regions %" PRIu64 ", failures %" PRIu64,
+                    saveMetrics->chunksSaved,
+                    saveMetrics->regionsWritten,
+                    saveMetrics->writeFailures);
+        ImGui::Text("Last region write: %.2f ms", saveMetrics->lastWriteMs);
+    }
+
     ImGui::End();
 #else
     (void)enabled;
     (void)voxelSvoConfig;
     (void)voxelSvoTelemetry;
+    (void)saveMetrics;
 #endif
 }
 
@@ -42,6 +42,7 @@ BlockRegistry::BlockRegistry() {
     air.lightAttenuation = 0;
 
     m_types.push_back(std::move(air));
+    m_solid.push_back(false);
     m_identifierMap["base:air"] = BlockID{0};
 
     spdlog::debug("BlockRegistry initialized with air (ID 0)");
@@ -74,6 +75,7 @@ BlockID BlockRegistry::registerBlock(const std::string& identifier, BlockType ty
 
     type.identifier = actualId;
 
+    m_solid.push_back(type.isSolid);
     m_types.push_back(std::move(type));
     m_identifierMap[actualId] = id;
 
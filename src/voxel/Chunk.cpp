@@ -101,7 +101,7 @@ void Chunk::setBlockInternal(int x, int y, int z, BlockState state, const BlockR
     }
 
     m_dirty = true;
-    m_persistDirty = true;
+    markPersistDirty();
     bumpMeshRevision();
 }
 
@@ -166,7 +166,7 @@ void Chunk::copyFromInternal(std::span<const BlockState> data, const BlockRegist
     }
 
     m_dirty = true;
-    m_persistDirty = true;
+    markPersistDirty();
     bumpMeshRevision();
 }
 
@@ -282,7 +282,7 @@ void Chunk::fillInternal(BlockState state, const BlockRegistry* registry) {
         m_nonAirCount = 0;
         m_opaqueCount = 0;
         m_dirty = true;
-        m_persistDirty = true;
+        markPersistDirty();
         bumpMeshRevision();
         return;
     }
@@ -302,7 +302,7 @@ void Chunk::fillInternal(BlockState state, const BlockRegistry* registry) {
     m_nonAirCount = VOLUME;
     m_opaqueCount = isOpaque ? VOLUME : 0;
     m_dirty = true;
-    m_persistDirty = true;
+    markPersistDirty();
     bumpMeshRevision();
 }
 
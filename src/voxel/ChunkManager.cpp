@@ -100,6 +100,10 @@ void ChunkManager::setBlock(int wx, int wy, int wz, BlockState state) {
             neighbor->markDirty();
         }
     }
+
+    if (m_blockChanged) {
+        m_blockChanged(wx, wy, wz);
+    }
 }
 
 void ChunkManager::loadChunk(ChunkCoord coord, std::span<const uint8_t> data) {
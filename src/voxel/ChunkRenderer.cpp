@@ -429,7 +429,7 @@ void ChunkRenderer::renderFarVoxelOpaquePass(const WorldRenderContext& ctx) {
         }
         keep.insert(entry.key);
 
-        const int span = pageSpanVoxels(entry.key.level);
+        const int span = pageSpanVoxels(entry.key.level) * std::max(1, entry.spanPages);
         glm::vec3 center = entry.worldMin + glm::vec3(static_cast<float>(span) * 0.5f);
         glm::vec3 delta = center - ctx.cameraPos;
         const float distanceSq = glm::dot(delta, delta);
@@ -450,9 +450,20 @@ void ChunkRenderer::renderFarVoxelOpaquePass(const WorldRenderContext& ctx) {
             VoxelGpuMeshEntry gpuEntry;
             gpuEntry.key = entry.key;
             gpuEntry.revision = entry.revision;
+            gpuEntry.spanPages = entry.spanPages;
             gpuEntry.worldMin = entry.worldMin;
             uploadMesh(gpuEntry.mesh, *entry.mesh);
             it = m_voxelMeshes.emplace(entry.key, std::move(gpuEntry)).first;
+        } else if (it->second.spanPages != entry.spanPages) {
+            // A cluster mesh and its min-corner page share a key; never draw one
+            // in place of the other.
+            if (!consumeVoxelUploadBudget(uploadBudget)) {
+                continue;
+            }
+            it->second.revision = entry.revision;
+            it->second.spanPages = entry.spanPages;
+            it->second.worldMin = entry.worldMin;
+            uploadMesh(it->second.mesh, *entry.mesh);
         } else if (it->second.revision != entry.revision) {
             it->second.worldMin = entry.worldMin;
             if (consumeVoxelUploadBudget(uploadBudget)) {
@@ -26,6 +26,9 @@ void World::initialize(WorldResources& resources) {
     m_resources = &resources;
     m_chunkManager.setRegistry(&m_resources->registry());
     m_entities.bind(this);
+    m_chunkManager.setBlockChangedCallback([this](int wx, int wy, int wz) {
+        m_entities.wakeNearBlock(wx, wy, wz);
+    });
     persistenceProviders().add(
         Persistence::kBlockRegistryProviderId,
         std::make_shared<Persistence::BlockRegistryProvider>(&m_resources->registry())
@@ -126,6 +126,29 @@ void applyTaaConfig(ryml::ConstNodeRef taaNode, TaaConfig& taa) {
     }
 }
 
+void applyEntityAnimationLodConfig(ryml::ConstNodeRef lodNode, EntityAnimationLodConfig& lod) {
+    if (!lodNode.readable()) {
+        return;
+    }
+
+    lod.enabled = Util::readBool(lodNode, "enabled", lod.enabled);
+    lod.fullDistance = Util::readFloat(lodNode, "full_distance", lod.fullDistance);
+    lod.reducedDistance = Util::readFloat(lodNode, "reduced_distance", lod.reducedDistance);
+    lod.reducedInterval = Util::readInt(lodNode, "reduced_interval", lod.reducedInterval);
+    lod.reducedMaxAnimations = Util::readInt(lodNode, "reduced_max_animations", lod.reducedMaxAnimations);
+    lod.freezeDistance = Util::readFloat(lodNode, "freeze_distance", lod.freezeDistance);
+    lod.lowInterval = Util::readInt(lodNode, "low_interval", lod.lowInterval);
+    lod.lowMaxAnimations = Util::readInt(lodNode, "low_max_animations", lod.lowMaxAnimations);
+
+    lod.fullDistance = std::max(lod.fullDistance, 0.0f);
+    lod.reducedDistance = std::max(lod.reducedDistance, lod.fullDistance);
+    lod.freezeDistance = std::max(lod.freezeDistance, lod.reducedDistance);
+    lod.reducedInterval = std::max(lod.reducedInterval, 1);
+    lod.lowInterval = std::max(lod.lowInterval, 1);
+    lod.reducedMaxAnimations = std::max(lod.reducedMaxAnimations, 1);
+    lod.lowMaxAnimations = std::max(lod.lowMaxAnimations, 1);
+}
+
 void applyVoxelSvoConfig(ryml::ConstNodeRef svoNode, VoxelSvoConfig& svo) {
     if (!svoNode.readable()) {
         return;
@@ -142,6 +165,7 @@ void applyVoxelSvoConfig(ryml::ConstNodeRef svoNode, VoxelSvoConfig& svo) {
     svo.levels = Util::readInt(svoNode, "levels", svo.levels);
     svo.pageSizeVoxels = Util::readInt(svoNode, "page_size_voxels", svo.pageSizeVoxels);
     svo.minLeafVoxels = Util::readInt(svoNode, "min_leaf_voxels", svo.minLeafVoxels);
+    svo.clusterPages = Util::readInt(svoNode, "cluster_pages", svo.clusterPages);
 
     svo.buildBudgetPagesPerFrame = Util::readInt(
         svoNode, "build_budget_pages_per_frame", svo.buildBudgetPagesPerFrame);
@@ -155,6 +179,7 @@ void applyVoxelSvoConfig(ryml::ConstNodeRef svoNode, VoxelSvoConfig& svo) {
         svoNode, "max_cpu_bytes", static_cast<int>(svo.maxCpuBytes)));
     svo.maxGpuBytes = static_cast<int64_t>(Util::readInt(
         svoNode, "max_gpu_bytes", static_cast<int>(svo.maxGpuBytes)));
+    svo.diskCache = Util::readBool(svoNode, "disk_cache", svo.diskCache);
 
     if (svo.nearMeshRadiusChunks < 0) {
         svo.nearMeshRadiusChunks = 0;
@@ -180,6 +205,7 @@ void applyVoxelSvoConfig(ryml::ConstNodeRef svoNode, VoxelSvoConfig& svo) {
     if (svo.minLeafVoxels > svo.pageSizeVoxels) {
         svo.minLeafVoxels = svo.pageSizeVoxels;
     }
+    svo.clusterPages = std::clamp(svo.clusterPages, 1, 8);
 
     if (svo.buildBudgetPagesPerFrame < 0) {
         svo.buildBudgetPagesPerFrame = 0;
@@ -231,6 +257,9 @@ void applyRenderYaml(const char* sourceName,
     if (renderNode.has_child("taa")) {
         applyTaaConfig(renderNode["taa"], config.taa);
     }
+    if (renderNode.has_child("entity_animation_lod")) {
+        applyEntityAnimationLodConfig(renderNode["entity_animation_lod"], config.entityAnimationLod);
+    }
     if (renderNode.has_child("svo_voxel")) {
         applyVoxelSvoConfig(renderNode["svo_voxel"], config.svoVoxel);
     }
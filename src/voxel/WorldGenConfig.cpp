@@ -4,6 +4,7 @@
 #include <ryml_std.hpp>
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <bit>
 
 #include "Rigel/Util/Yaml.h"
 #include "Rigel/Util/Ryml.h"
@@ -343,6 +344,12 @@ void WorldGenConfig::applyYaml(const char* sourceName, const std::string& yaml)
             stream.loadMaxCachedRegions = 0;
         }
 
+        stream.loadMaxCachedMegabytes =
+            Util::readInt(streamNode, "load_max_cached_mb", stream.loadMaxCachedMegabytes);
+        if (stream.loadMaxCachedMegabytes < 0) {
+            stream.loadMaxCachedMegabytes = 0;
+        }
+
         stream.loadMaxInFlightRegions =
             Util::readInt(streamNode, "load_max_inflight_regions", stream.loadMaxInFlightRegions);
         if (stream.loadMaxInFlightRegions < 0) {
@@ -438,4 +445,151 @@ bool WorldGenConfig::isFlagEnabled(const std::string& name) const {
     return it->second;
 }
 
+namespace {
+
+class GenerationHasher {
+public:
+    void u64(uint64_t v) {
+        m_hash ^= v;
+        m_hash *= 1099511628211ull;
+    }
+    void i32(int v) { u64(static_cast<uint32_t>(v)); }
+    void f32(float v) { u64(std::bit_cast<uint32_t>(v)); }
+    void flag(bool v) { u64(v ? 1u : 0u); }
+    void str(const std::string& v) {
+        u64(v.size());
+        for (char c : v) {
+            u64(static_cast<unsigned char>(c));
+        }
+    }
+    void noise(const WorldGenConfig::NoiseConfig& n) {
+        i32(n.octaves);
+        f32(n.frequency);
+        f32(n.lacunarity);
+        f32(n.persistence);
+        f32(n.scale);
+        f32(n.offset);
+    }
+    void climateLayer(const WorldGenConfig::ClimateLayerConfig& layer) {
+        noise(layer.temperature);
+        noise(layer.humidity);
+        noise(layer.continentalness);
+    }
+    template <typename Value, typename Fn>
+    void sortedMap(const std::unordered_map<std::string, Value>& map, Fn&& value) {
+        std::vector<const std::pair<const std::string, Value>*> entries;
+        entries.reserve(map.size());
+        for (const auto& entry : map) {
+            entries.push_back(&entry);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto* a, const auto* b) { return a->first < b->first; });
+        u64(entries.size());
+        for (const auto* entry : entries) {
+            str(entry->first);
+            value(entry->second);
+        }
+    }
+
+    uint64_t result() const { return m_hash; }
+
+private:
+    uint64_t m_hash = 1469598103934665603ull;
+};
+
+} // namespace
+
+uint64_t WorldGenConfig::generationHash() const {
+    GenerationHasher h;
+    h.u64(seed);
+    h.str(solidBlock);
+    h.str(surfaceBlock);
+
+    h.i32(world.minY);
+    h.i32(world.maxY);
+    h.i32(world.seaLevel);
+    h.i32(world.lavaLevel);
+    h.u64(world.version);
+
+    h.f32(terrain.baseHeight);
+    h.f32(terrain.heightVariation);
+    h.i32(terrain.surfaceDepth);
+    h.noise(terrain.heightNoise);
+    h.noise(terrain.densityNoise);
+    h.f32(terrain.densityStrength);
+    h.f32(terrain.gradientStrength);
+
+    h.climateLayer(climate.global);
+    h.climateLayer(climate.local);
+    h.f32(climate.localBlend);
+    h.f32(climate.latitudeScale);
+    h.f32(climate.latitudeStrength);
+    h.f32(climate.elevationLapse);
+
+    h.f32(biomes.blend.blendPower);
+    h.f32(biomes.blend.epsilon);
+    h.u64(biomes.entries.size());
+    for (const BiomeConfig& biome : biomes.entries) {
+        h.str(biome.name);
+        h.f32(biome.target.temperature);
+        h.f32(biome.target.humidity);
+        h.f32(biome.target.continentalness);
+        h.f32(biome.weight);
+        h.u64(biome.surface.size());
+        for (const SurfaceLayer& layer : biome.surface) {
+            h.str(layer.block);
+            h.i32(layer.depth);
+        }
+    }
+    h.str(biomes.coastBand.biome);
+    h.f32(biomes.coastBand.minContinentalness);
+    h.f32(biomes.coastBand.maxContinentalness);
+    h.flag(biomes.coastBand.enabled);
+
+    h.u64(densityGraph.nodes.size());
+    for (const DensityNodeConfig& node : densityGraph.nodes) {
+        h.str(node.id);
+        h.str(node.type);
+        h.u64(node.inputs.size());
+        for (const std::string& input : node.inputs) {
+            h.str(input);
+        }
+        h.str(node.field);
+        h.noise(node.noise);
+        h.f32(node.value);
+        h.f32(node.minValue);
+        h.f32(node.maxValue);
+        h.f32(node.scale);
+        h.f32(node.offset);
+        h.u64(node.splinePoints.size());
+        for (const auto& [x, y] : node.splinePoints) {
+            h.f32(x);
+            h.f32(y);
+        }
+    }
+    h.sortedMap(densityGraph.outputs, [&](const std::string& v) { h.str(v); });
+
+    h.flag(caves.enabled);
+    h.str(caves.densityOutput);
+    h.f32(caves.threshold);
+    h.i32(caves.sampleStep);
+
+    h.u64(structures.features.size());
+    for (const FeatureConfig& feature : structures.features) {
+        h.str(feature.name);
+        h.str(feature.block);
+        h.f32(feature.chance);
+        h.i32(feature.minHeight);
+        h.i32(feature.maxHeight);
+        h.u64(feature.biomes.size());
+        for (const std::string& biome : feature.biomes) {
+            h.str(biome);
+        }
+    }
+
+    h.sortedMap(stageEnabled, [&](bool v) { h.flag(v); });
+    h.sortedMap(flags, [&](bool v) { h.flag(v); });
+    return h.result();
+}
+
 } // namespace Rigel::Voxel
@@ -82,11 +82,26 @@ WorldView& WorldSet::view(WorldId id) {
 }
 
 void WorldSet::removeWorld(WorldId id) {
-    m_worlds.erase(id);
+    auto it = m_worlds.find(id);
+    if (it == m_worlds.end()) {
+        return;
+    }
+    if (it->second) {
+        m_persistenceService.releaseWorldFormats(it->second->world.persistenceProvidersHandle());
+    }
+    m_worlds.erase(it);
 }
 
 void WorldSet::clear() {
     m_worlds.clear();
+    m_persistenceService.clearSharedFormats();
+}
+
+void WorldSet::setPersistenceStorage(std::shared_ptr<Persistence::StorageBackend> storage) {
+    if (m_persistenceStorage && m_persistenceStorage != storage) {
+        m_persistenceService.releaseStorageFormats(m_persistenceStorage);
+    }
+    m_persistenceStorage = std::move(storage);
 }
 
 Persistence::PersistenceContext WorldSet::persistenceContext(WorldId id) const {
@@ -149,6 +149,10 @@ void WorldView::setVoxelPersistenceSource(std::shared_ptr<const IVoxelSource> so
     m_voxelSvoLod.setPersistenceSource(std::move(source));
 }
 
+void WorldView::setVoxelPageCache(std::shared_ptr<VoxelPageDiskCache> cache) {
+    m_voxelSvoLod.setPageCache(std::move(cache));
+}
+
 void WorldView::invalidateVoxelSvoChunk(ChunkCoord coord) {
     m_voxelSvoLod.invalidateChunk(coord);
 }
@@ -208,6 +212,9 @@ void WorldView::render(const glm::mat4& view,
     Entity::EntityRenderContext entityCtx;
     entityCtx.deltaTime = dt;
     entityCtx.frameIndex = ++m_frameCounter;
+    // Set before the shadow pass, which is the first to animate entities this frame.
+    entityCtx.cameraPos = cameraPos;
+    entityCtx.animationLod = m_renderConfig.entityAnimationLod;
 
     struct EntityShadowCaster final : IShadowCaster {
         Entity::EntityRenderer* renderer = nullptr;
@@ -301,6 +308,10 @@ void WorldView::rebuildChunkMesh(ChunkCoord coord) {
     if (chunk->isPersistDirty() || chunk->loadedFromDisk()) {
         m_voxelSvoLod.invalidateChunk(coord);
     }
+    if (chunk->isPersistDirty()) {
+        // Only unsaved block edits make disk-cached pages stale.
+        m_voxelSvoLod.invalidateCachedPages(coord);
+    }
 
     auto start = std::chrono::steady_clock::now();
     if (chunk->isEmpty()) {
@@ -61,7 +61,7 @@ void PersistenceSource::invalidateChunk(ChunkCoord coord) const {
     }
 
     try {
-        auto format = m_service->openFormat(m_context);
+        auto format = m_service->sharedFormat(m_context);
         Persistence::RegionLayout& layout = format->regionLayout();
         const Persistence::RegionKey regionKey = layout.regionForChunk(m_zoneId, coord);
         const std::string regionKeyString = regionCacheKey(regionKey);
@@ -186,7 +186,7 @@ bool PersistenceSource::tryLoadChunk(ChunkCoord coord,
         }
     }
 
-    auto format = m_service->openFormat(m_context);
+    auto format = m_service->sharedFormat(m_context);
     Persistence::RegionLayout& layout = format->regionLayout();
     const Persistence::RegionKey regionKey = layout.regionForChunk(m_zoneId, coord);
     const std::vector<Persistence::ChunkKey> storageKeys = layout.storageKeysForChunk(m_zoneId, coord);
@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <array>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace Rigel::Voxel {
 namespace {
 
@@ -16,25 +20,145 @@ size_t cellIndex(int x, int y, int z, int dim) {
         + static_cast<size_t>(z) * static_cast<size_t>(dim) * static_cast<size_t>(dim);
 }
 
-VoxelId dominantValue(std::array<VoxelId, 8> values) {
-    VoxelId best = values[0];
-    int bestCount = 1;
-
+#if defined(__SSE2__)
+template <int Lanes>
+__m128i rotateLanes16(__m128i v) {
+    return _mm_or_si128(_mm_srli_si128(v, Lanes * 2), _mm_slli_si128(v, 16 - Lanes * 2));
+}
+#endif
+
+// Most frequent value among the 8 children. Ties resolve to the value whose first
+// occurrence comes earliest in child order.
+VoxelId dominantValue(const std::array<VoxelId, 8>& values) {
+    std::array<int, 8> counts{};
+
+#if defined(__SSE2__)
+    // 8 x 16-bit ids fill one register. Comparing against each lane rotation leaves
+    // -(matches among the other 7 children) in every lane.
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+    __m128i matches = _mm_cmpeq_epi16(v, rotateLanes16<1>(v));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<2>(v)));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<3>(v)));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<4>(v)));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<5>(v)));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<6>(v)));
+    matches = _mm_add_epi16(matches, _mm_cmpeq_epi16(v, rotateLanes16<7>(v)));
+    alignas(16) std::array<int16_t, 8> negMatches{};
+    _mm_store_si128(reinterpret_cast<__m128i*>(negMatches.data()), matches);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = 1 - negMatches[i];
+    }
+#else
     for (size_t i = 0; i < values.size(); ++i) {
-        int count = 0;
         for (size_t j = 0; j < values.size(); ++j) {
-            if (values[j] == values[i]) {
-                ++count;
-            }
+            counts[i] += values[j] == values[i] ? 1 : 0;
         }
-        if (count > bestCount) {
-            bestCount = count;
+    }
+#endif
+
+    VoxelId best = values[0];
+    int bestCount = 1;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (counts[i] > bestCount) {
+            bestCount = counts[i];
             best = values[i];
         }
     }
     return best;
 }
 
+// Child rows feeding one row of parent cells: (y, z), (y + 1, z), (y, z + 1), (y + 1, z + 1).
+struct ChildRows {
+    const uint32_t* r00 = nullptr;
+    const uint32_t* r10 = nullptr;
+    const uint32_t* r01 = nullptr;
+    const uint32_t* r11 = nullptr;
+};
+
+uint32_t reduceMixedCell(const ChildRows& rows, int x) {
+    const int bx = x * 2;
+    const std::array<uint32_t, 8> childPacked{
+        rows.r00[bx], rows.r00[bx + 1],
+        rows.r10[bx], rows.r10[bx + 1],
+        rows.r01[bx], rows.r01[bx + 1],
+        rows.r11[bx], rows.r11[bx + 1],
+    };
+
+    std::array<VoxelId, 8> childValues{};
+    bool allUniform = true;
+    for (size_t i = 0; i < childPacked.size(); ++i) {
+        allUniform = allUniform && VoxelMipLevel::isUniform(childPacked[i]);
+        childValues[i] = VoxelMipLevel::value(childPacked[i]);
+    }
+
+    const bool sameValue =
+        std::all_of(childValues.begin() + 1, childValues.end(),
+                    [&](VoxelId v) { return v == childValues[0]; });
+
+    const bool uniform = allUniform && sameValue;
+    const VoxelId value = uniform ? childValues[0] : dominantValue(childValues);
+    return VoxelMipLevel::pack(uniform, value);
+}
+
+// A 2x2x2 block collapses when all 8 packed children are identical and carry the
+// uniform bit; the parent's packed value is then the child's packed value verbatim.
+bool isUniformBlock(const ChildRows& rows, int x) {
+    const int bx = x * 2;
+    const uint32_t first = rows.r00[bx];
+    return VoxelMipLevel::isUniform(first) &&
+        rows.r00[bx + 1] == first &&
+        rows.r10[bx] == first && rows.r10[bx + 1] == first &&
+        rows.r01[bx] == first && rows.r01[bx + 1] == first &&
+        rows.r11[bx] == first && rows.r11[bx + 1] == first;
+}
+
+void reduceRow(const ChildRows& rows, int nextDim, uint32_t* out) {
+    int x = 0;
+
+#if defined(__SSE2__)
+    // Two parents per iteration: 4 lanes from each child row.
+    for (; x + 2 <= nextDim; x += 2) {
+        const int bx = x * 2;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.r00 + bx));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.r10 + bx));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.r01 + bx));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.r11 + bx));
+        const __m128i swapped = _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1));
+
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, c));
+        eq = _mm_and_si128(eq, _mm_cmpeq_epi32(a, d));
+        eq = _mm_and_si128(eq, _mm_cmpeq_epi32(a, swapped));
+        eq = _mm_and_si128(eq, _mm_srai_epi32(a, 31)); // uniform bit
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+
+        out[x] = (mask & 0x3) == 0x3 ? rows.r00[bx] : reduceMixedCell(rows, x);
+        out[x + 1] = (mask & 0xC) == 0xC ? rows.r00[bx + 2] : reduceMixedCell(rows, x + 1);
+    }
+#endif
+
+    for (; x < nextDim; ++x) {
+        out[x] = isUniformBlock(rows, x) ? rows.r00[x * 2] : reduceMixedCell(rows, x);
+    }
+}
+
+void reduceLevel(const VoxelMipLevel& prev, VoxelMipLevel& next) {
+    const int prevDim = prev.dim;
+    const int nextDim = next.dim;
+    for (int z = 0; z < nextDim; ++z) {
+        for (int y = 0; y < nextDim; ++y) {
+            const int by = y * 2;
+            const int bz = z * 2;
+            const ChildRows rows{
+                &prev.cells[cellIndex(0, by + 0, bz + 0, prevDim)],
+                &prev.cells[cellIndex(0, by + 1, bz + 0, prevDim)],
+                &prev.cells[cellIndex(0, by + 0, bz + 1, prevDim)],
+                &prev.cells[cellIndex(0, by + 1, bz + 1, prevDim)],
+            };
+            reduceRow(rows, nextDim, &next.cells[cellIndex(0, y, z, nextDim)]);
+        }
+    }
+}
+
 } // namespace
 
 VoxelMipPyramid buildVoxelMipPyramid(std::span<const VoxelId> l0, int baseDim) {
@@ -51,17 +175,32 @@ VoxelMipPyramid buildVoxelMipPyramid(std::span<const VoxelId> l0, int baseDim) {
 
     out.baseDim = baseDim;
 
+    // Fully uniform pages (all air, all stone) skip the reduction entirely.
+    const VoxelId first = l0[0];
+    const bool pageUniform =
+        std::all_of(l0.begin() + 1, l0.end(), [first](VoxelId v) { return v == first; });
+    if (pageUniform) {
+        const uint32_t packed = VoxelMipLevel::pack(true, first);
+        for (int dim = baseDim; dim >= 1; dim /= 2) {
+            VoxelMipLevel level;
+            level.dim = dim;
+            level.cells.assign(static_cast<size_t>(dim) *
+                               static_cast<size_t>(dim) *
+                               static_cast<size_t>(dim), packed);
+            out.levels.push_back(std::move(level));
+        }
+        return out;
+    }
+
     VoxelMipLevel level0;
     level0.dim = baseDim;
     level0.cells.resize(expected);
-    for (size_t i = 0; i < expected; ++i) {
-        level0.cells[i] = VoxelMipLevel::pack(true, l0[i]);
-    }
+    std::transform(l0.begin(), l0.end(), level0.cells.begin(),
+                   [](VoxelId v) { return VoxelMipLevel::pack(true, v); });
     out.levels.push_back(std::move(level0));
 
     int prevDim = baseDim;
     while (prevDim > 1) {
-        const VoxelMipLevel& prev = out.levels.back();
         const int nextDim = prevDim / 2;
         VoxelMipLevel next;
         next.dim = nextDim;
@@ -69,40 +208,7 @@ VoxelMipPyramid buildVoxelMipPyramid(std::span<const VoxelId> l0, int baseDim) {
                           static_cast<size_t>(nextDim) *
                           static_cast<size_t>(nextDim));
 
-        for (int z = 0; z < nextDim; ++z) {
-            for (int y = 0; y < nextDim; ++y) {
-                for (int x = 0; x < nextDim; ++x) {
-                    const int bx = x * 2;
-                    const int by = y * 2;
-                    const int bz = z * 2;
-                    std::array<uint32_t, 8> childPacked{
-                        prev.cells[cellIndex(bx + 0, by + 0, bz + 0, prevDim)],
-                        prev.cells[cellIndex(bx + 1, by + 0, bz + 0, prevDim)],
-                        prev.cells[cellIndex(bx + 0, by + 1, bz + 0, prevDim)],
-                        prev.cells[cellIndex(bx + 1, by + 1, bz + 0, prevDim)],
-                        prev.cells[cellIndex(bx + 0, by + 0, bz + 1, prevDim)],
-                        prev.cells[cellIndex(bx + 1, by + 0, bz + 1, prevDim)],
-                        prev.cells[cellIndex(bx + 0, by + 1, bz + 1, prevDim)],
-                        prev.cells[cellIndex(bx + 1, by + 1, bz + 1, prevDim)],
-                    };
-
-                    std::array<VoxelId, 8> childValues{};
-                    bool allUniform = true;
-                    for (size_t i = 0; i < childPacked.size(); ++i) {
-                        allUniform = allUniform && VoxelMipLevel::isUniform(childPacked[i]);
-                        childValues[i] = VoxelMipLevel::value(childPacked[i]);
-                    }
-
-                    const bool sameValue =
-                        std::all_of(childValues.begin() + 1, childValues.end(),
-                                    [&](VoxelId v) { return v == childValues[0]; });
-
-                    const bool uniform = allUniform && sameValue;
-                    const VoxelId value = uniform ? childValues[0] : dominantValue(childValues);
-                    next.cells[cellIndex(x, y, z, nextDim)] = VoxelMipLevel::pack(uniform, value);
-                }
-            }
-        }
+        reduceLevel(out.levels.back(), next);
 
         out.levels.push_back(std::move(next));
         prevDim = nextDim;
@@ -112,4 +218,3 @@ VoxelMipPyramid buildVoxelMipPyramid(std::span<const VoxelId> l0, int baseDim) {
 }
 
 } // namespace Rigel::Voxel
-
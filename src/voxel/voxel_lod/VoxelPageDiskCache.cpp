@@ -0,0 +1,388 @@
+#include "Rigel/Voxel/VoxelLod/VoxelPageDiskCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace Rigel::Voxel {
+namespace {
+
+class EntryWriter {
+public:
+    void u8(uint8_t v) { m_bytes.push_back(v); }
+    void u16(uint16_t v) {
+        u8(static_cast<uint8_t>(v & 0xFF));
+        u8(static_cast<uint8_t>((v >> 8) & 0xFF));
+    }
+    void u32(uint32_t v) {
+        u16(static_cast<uint16_t>(v & 0xFFFF));
+        u16(static_cast<uint16_t>((v >> 16) & 0xFFFF));
+    }
+    void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+    void u64(uint64_t v) {
+        u32(static_cast<uint32_t>(v & 0xFFFFFFFFu));
+        u32(static_cast<uint32_t>(v >> 32));
+    }
+
+    const std::vector<uint8_t>& bytes() const { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+class EntryReader {
+public:
+    explicit EntryReader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+    uint8_t u8() {
+        ensure(1);
+        return m_data[m_pos++];
+    }
+    uint16_t u16() {
+        const uint16_t lo = u8();
+        const uint16_t hi = u8();
+        return static_cast<uint16_t>(lo | (hi << 8));
+    }
+    uint32_t u32() {
+        const uint32_t lo = u16();
+        const uint32_t hi = u16();
+        return lo | (hi << 16);
+    }
+    int32_t i32() { return static_cast<int32_t>(u32()); }
+    uint64_t u64() {
+        const uint64_t lo = u32();
+        const uint64_t hi = u32();
+        return lo | (hi << 32);
+    }
+
+    bool atEnd() const { return m_pos == m_data.size(); }
+
+private:
+    void ensure(size_t len) const {
+        if (m_pos + len > m_data.size()) {
+            throw std::runtime_error("VoxelPageDiskCache entry truncated");
+        }
+    }
+
+    const std::vector<uint8_t>& m_data;
+    size_t m_pos = 0;
+};
+
+// Palette + fixed-width index stream. Uniform arrays (air pages, solid mips) cost a
+// single palette entry and no index words.
+template <typename T>
+void writePaletted(EntryWriter& writer, std::span<const T> values) {
+    std::vector<T> palette;
+    std::unordered_map<T, uint32_t> paletteIndex;
+    std::vector<uint32_t> indices;
+    indices.reserve(values.size());
+    for (T value : values) {
+        auto [it, inserted] = paletteIndex.try_emplace(value, static_cast<uint32_t>(palette.size()));
+        if (inserted) {
+            palette.push_back(value);
+        }
+        indices.push_back(it->second);
+    }
+
+    const uint32_t bits = palette.size() <= 1
+        ? 0u
+        : static_cast<uint32_t>(std::bit_width(static_cast<uint32_t>(palette.size() - 1)));
+    writer.u32(static_cast<uint32_t>(values.size()));
+    writer.u32(static_cast<uint32_t>(palette.size()));
+    for (T value : palette) {
+        if constexpr (sizeof(T) == 2) {
+            writer.u16(value);
+        } else {
+            writer.u32(value);
+        }
+    }
+    writer.u8(static_cast<uint8_t>(bits));
+    if (bits == 0) {
+        return;
+    }
+
+    uint64_t acc = 0;
+    uint32_t accBits = 0;
+    for (uint32_t index : indices) {
+        acc |= static_cast<uint64_t>(index) << accBits;
+        accBits += bits;
+        if (accBits >= 32) {
+            writer.u32(static_cast<uint32_t>(acc & 0xFFFFFFFFu));
+            acc >>= 32;
+            accBits -= 32;
+        }
+    }
+    if (accBits > 0) {
+        writer.u32(static_cast<uint32_t>(acc & 0xFFFFFFFFu));
+    }
+}
+
+template <typename T>
+void readPaletted(EntryReader& reader, size_t expectedCount, std::vector<T>& out) {
+    const uint32_t count = reader.u32();
+    const uint32_t paletteSize = reader.u32();
+    if (count != expectedCount || paletteSize == 0 || paletteSize > count) {
+        throw std::runtime_error("VoxelPageDiskCache palette header mismatch");
+    }
+    std::vector<T> palette(paletteSize);
+    for (T& value : palette) {
+        if constexpr (sizeof(T) == 2) {
+            value = reader.u16();
+        } else {
+            value = reader.u32();
+        }
+    }
+    const uint32_t bits = reader.u8();
+    out.resize(count);
+    if (bits == 0) {
+        std::fill(out.begin(), out.end(), palette[0]);
+        return;
+    }
+    if (bits > 32) {
+        throw std::runtime_error("VoxelPageDiskCache palette index width invalid");
+    }
+
+    const uint64_t mask = (uint64_t{1} << bits) - 1;
+    uint64_t acc = 0;
+    uint32_t accBits = 0;
+    for (T& value : out) {
+        if (accBits < bits) {
+            acc |= static_cast<uint64_t>(reader.u32()) << accBits;
+            accBits += 32;
+        }
+        const uint32_t index = static_cast<uint32_t>(acc & mask);
+        acc >>= bits;
+        accBits -= bits;
+        if (index >= paletteSize) {
+            throw std::runtime_error("VoxelPageDiskCache palette index out of range");
+        }
+        value = palette[index];
+    }
+}
+
+size_t cubed(int dim) {
+    return static_cast<size_t>(dim) * static_cast<size_t>(dim) * static_cast<size_t>(dim);
+}
+
+} // namespace
+
+VoxelPageDiskCache::VoxelPageDiskCache(std::shared_ptr<Persistence::StorageBackend> storage,
+                                       std::string rootPath,
+                                       uint64_t contentHash)
+    : m_storage(std::move(storage))
+    , m_rootPath(std::move(rootPath))
+    , m_contentHash(contentHash) {
+}
+
+VoxelPageDiskCache::~VoxelPageDiskCache() = default;
+
+uint64_t VoxelPageDiskCache::makeContentHash(uint32_t worldSeed,
+                                             uint32_t generatorVersion,
+                                             uint64_t generatorConfigHash,
+                                             int pageSizeVoxels) {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    mix(kFormatVersion);
+    mix(worldSeed);
+    mix(generatorVersion);
+    mix(generatorConfigHash);
+    mix(static_cast<uint32_t>(pageSizeVoxels));
+    return h;
+}
+
+std::string VoxelPageDiskCache::pagePath(const VoxelPageKey& key) const {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(m_contentHash));
+    return m_rootPath + "/" + hash + "/" + std::to_string(key.level) + "/" +
+        std::to_string(key.x) + "." + std::to_string(key.y) + "." + std::to_string(key.z) + ".rvp";
+}
+
+bool VoxelPageDiskCache::load(const VoxelPageKey& key, int pageSizeVoxels, VoxelPageCpu& out) const {
+    if (!m_storage || pageSizeVoxels <= 0 || isTombstoned(key)) {
+        return false;
+    }
+    const std::string path = pagePath(key);
+    std::vector<uint8_t> data;
+    try {
+        if (!m_storage->exists(path)) {
+            return false;
+        }
+        auto reader = m_storage->openRead(path);
+        if (!reader) {
+            return false;
+        }
+        data = reader->readAt(0, reader->size());
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    try {
+        EntryReader reader(data);
+        if (reader.u32() != kMagic || reader.u16() != kFormatVersion ||
+            reader.u64() != m_contentHash) {
+            removeQuietly(path);
+            return false;
+        }
+        VoxelPageKey stored{};
+        stored.level = reader.i32();
+        stored.x = reader.i32();
+        stored.y = reader.i32();
+        stored.z = reader.i32();
+        const int dim = reader.i32();
+        if (!(stored == key) || dim != pageSizeVoxels) {
+            removeQuietly(path);
+            return false;
+        }
+
+        VoxelPageCpu page;
+        page.key = key;
+        page.dim = dim;
+        readPaletted(reader, cubed(dim), page.l0);
+
+        // Level 0 of the pyramid is the l0 brick with every cell uniform; it is rebuilt
+        // rather than stored.
+        const uint8_t levelCount = reader.u8();
+        page.mips.baseDim = dim;
+        page.mips.levels.reserve(levelCount);
+        VoxelMipLevel level0;
+        level0.dim = dim;
+        level0.cells.resize(page.l0.size());
+        std::transform(page.l0.begin(), page.l0.end(), level0.cells.begin(),
+                       [](VoxelId v) { return VoxelMipLevel::pack(true, v); });
+        page.mips.levels.push_back(std::move(level0));
+        int levelDim = dim;
+        for (uint8_t i = 1; i < levelCount; ++i) {
+            levelDim /= 2;
+            VoxelMipLevel level;
+            level.dim = levelDim;
+            readPaletted(reader, cubed(levelDim), level.cells);
+            page.mips.levels.push_back(std::move(level));
+        }
+        if (levelDim != 1 || !reader.atEnd()) {
+            throw std::runtime_error("VoxelPageDiskCache mip chain incomplete");
+        }
+
+        out = std::move(page);
+        return true;
+    } catch (const std::exception&) {
+        removeQuietly(path);
+        return false;
+    }
+}
+
+uint64_t VoxelPageDiskCache::generation(const VoxelPageKey&) const {
+    std::scoped_lock lock(m_generationMutex);
+    return m_epoch;
+}
+
+bool VoxelPageDiskCache::generationMatches(const VoxelPageKey& key, uint64_t generation) const {
+    std::scoped_lock lock(m_generationMutex);
+    if (generation < m_floorEpoch) {
+        return false;
+    }
+    auto it = m_invalidated.find(key);
+    return it == m_invalidated.end() || it->second <= generation;
+}
+
+bool VoxelPageDiskCache::isTombstoned(const VoxelPageKey& key) const {
+    std::scoped_lock lock(m_generationMutex);
+    return m_tombstones.find(key) != m_tombstones.end();
+}
+
+bool VoxelPageDiskCache::store(const VoxelPageCpu& page, uint64_t generation) {
+    if (!m_storage || page.dim <= 0 || page.l0.size() != cubed(page.dim) ||
+        page.mips.levels.empty() || page.mips.levels.size() > 255) {
+        return false;
+    }
+    if (!generationMatches(page.key, generation)) {
+        return false;
+    }
+
+    EntryWriter writer;
+    writer.u32(kMagic);
+    writer.u16(kFormatVersion);
+    writer.u64(m_contentHash);
+    writer.i32(page.key.level);
+    writer.i32(page.key.x);
+    writer.i32(page.key.y);
+    writer.i32(page.key.z);
+    writer.i32(page.dim);
+    writePaletted<VoxelId>(writer, page.l0);
+    writer.u8(static_cast<uint8_t>(page.mips.levels.size()));
+    for (size_t i = 1; i < page.mips.levels.size(); ++i) {
+        writePaletted<uint32_t>(writer, page.mips.levels[i].cells);
+    }
+
+    const std::string path = pagePath(page.key);
+    try {
+        auto session = m_storage->openWrite(path, Persistence::AtomicWriteOptions{});
+        session->writer().writeBytes(writer.bytes().data(), writer.bytes().size());
+        session->commit();
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    // invalidate() may have run while the entry was being written; its removal could
+    // have landed before our rename, so re-check and drop what we just wrote.
+    if (!generationMatches(page.key, generation)) {
+        removeQuietly(path);
+        return false;
+    }
+    return true;
+}
+
+void VoxelPageDiskCache::invalidate(const VoxelPageKey& key) {
+    {
+        std::scoped_lock lock(m_generationMutex);
+        const uint64_t epoch = ++m_epoch;
+        if (m_invalidated.size() >= kMaxTrackedInvalidations) {
+            // Forget per-page epochs; rejecting every older capture stays correct.
+            m_invalidated.clear();
+            m_floorEpoch = epoch;
+        } else {
+            m_invalidated[key] = epoch;
+        }
+        ++m_tombstones[key];
+    }
+
+    // One removal per invalidation, in order: the tombstone only lifts after the file
+    // written before the latest invalidate() is gone.
+    m_io.enqueue([this, key]() {
+        removeQuietly(pagePath(key));
+        std::scoped_lock lock(m_generationMutex);
+        auto it = m_tombstones.find(key);
+        if (it != m_tombstones.end() && --it->second == 0) {
+            m_tombstones.erase(it);
+        }
+    });
+}
+
+void VoxelPageDiskCache::flush() {
+    std::promise<void> done;
+    std::future<void> finished = done.get_future();
+    m_io.enqueue([&done]() { done.set_value(); });
+    finished.wait();
+}
+
+void VoxelPageDiskCache::removeQuietly(const std::string& path) const {
+    if (!m_storage) {
+        return;
+    }
+    try {
+        if (m_storage->exists(path)) {
+            m_storage->remove(path);
+        }
+    } catch (const std::exception&) {
+    }
+}
+
+} // namespace Rigel::Voxel
@@ -37,6 +37,66 @@ VoxelMaterialClass classifyOrDefault(const VoxelMaterialClassifier& classify, Vo
     return classify(id);
 }
 
+// Per-mip "subtree emits at least one node" flags, resolved bottom-up.
+//
+// A cell is occupied when it is uniform non-air, when it is at or below the leaf mip with a
+// non-air representative, or when it is mixed above the leaf mip and any child is occupied.
+class OccupancyPyramid {
+public:
+    OccupancyPyramid(const VoxelMipPyramid& mips, int leafMip, int rootMip)
+        : m_mips(mips), m_leafMip(leafMip) {
+        m_levels.resize(static_cast<size_t>(rootMip) + 1);
+        for (int mip = leafMip + 1; mip <= rootMip; ++mip) {
+            const VoxelMipLevel& level = mips.levels[static_cast<size_t>(mip)];
+            std::vector<uint8_t>& occupied = m_levels[static_cast<size_t>(mip)];
+            occupied.resize(level.cells.size());
+            for (int z = 0; z < level.dim; ++z) {
+                for (int y = 0; y < level.dim; ++y) {
+                    for (int x = 0; x < level.dim; ++x) {
+                        const size_t index = cellIndex(x, y, z, level.dim);
+                        const uint32_t packed = level.cells[index];
+                        if (VoxelMipLevel::isUniform(packed)) {
+                            occupied[index] = VoxelMipLevel::value(packed) != kVoxelAir;
+                            continue;
+                        }
+                        const uint8_t mask = childMask(mip, x, y, z);
+                        occupied[index] = mask != 0;
+                        m_mixedChildren += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+                    }
+                }
+            }
+        }
+    }
+
+    bool occupied(int mip, int x, int y, int z) const {
+        if (mip <= m_leafMip) {
+            const VoxelMipLevel& level = m_mips.levels[static_cast<size_t>(mip)];
+            return VoxelMipLevel::value(level.cells[cellIndex(x, y, z, level.dim)]) != kVoxelAir;
+        }
+        const int dim = m_mips.levels[static_cast<size_t>(mip)].dim;
+        return m_levels[static_cast<size_t>(mip)][cellIndex(x, y, z, dim)] != 0;
+    }
+
+    uint8_t childMask(int mip, int x, int y, int z) const {
+        uint8_t mask = 0;
+        for (int child = 0; child < 8; ++child) {
+            if (occupied(mip - 1, x * 2 + (child & 1), y * 2 + ((child >> 1) & 1), z * 2 + ((child >> 2) & 1))) {
+                mask |= static_cast<uint8_t>(1u << child);
+            }
+        }
+        return mask;
+    }
+
+    // Children emitted under every mixed, occupied cell; the tree holds this plus the root.
+    size_t mixedChildCount() const { return m_mixedChildren; }
+
+private:
+    const VoxelMipPyramid& m_mips;
+    int m_leafMip = 0;
+    std::vector<std::vector<uint8_t>> m_levels;
+    size_t m_mixedChildren = 0;
+};
+
 } // namespace
 
 VoxelPageTree buildVoxelPageTree(const VoxelPageCpu& page,
@@ -66,98 +126,74 @@ VoxelPageTree buildVoxelPageTree(const VoxelPageCpu& page,
         return out;
     }
 
-    auto makeLeaf = [&](VoxelSvoNodeKind kind, VoxelId material, uint16_t leafSize) -> uint32_t {
-        VoxelSvoNode node{};
-        node.kind = kind;
-        node.leafSizeVoxels = leafSize;
-        if (kind == VoxelSvoNodeKind::Solid) {
+    const int leafMip = log2Pow2(out.minLeafVoxels);
+    const OccupancyPyramid occupancy(page.mips, leafMip, rootMip);
+
+    out.nodes.resize(1 + occupancy.mixedChildCount());
+    out.root = 0;
+
+    if (!occupancy.occupied(rootMip, 0, 0, 0)) {
+        VoxelSvoNode& node = out.nodes[0];
+        node.kind = VoxelSvoNodeKind::Empty;
+        node.leafSizeVoxels = static_cast<uint16_t>(baseDim);
+        return out;
+    }
+
+    // Depth-first emission: each mixed node reserves a contiguous block for its present
+    // children, which are then filled (and their own blocks appended) before its siblings.
+    struct PendingNode {
+        uint32_t index = 0;
+        int mip = 0;
+        int x = 0;
+        int y = 0;
+        int z = 0;
+    };
+    std::vector<PendingNode> stack;
+    stack.reserve(static_cast<size_t>(rootMip + 1) * 8);
+    stack.push_back(PendingNode{0, rootMip, 0, 0, 0});
+    uint32_t nextFree = 1;
+
+    while (!stack.empty()) {
+        const PendingNode pending = stack.back();
+        stack.pop_back();
+
+        const VoxelMipLevel& level = page.mips.levels[static_cast<size_t>(pending.mip)];
+        const uint32_t packed = level.cells[cellIndex(pending.x, pending.y, pending.z, level.dim)];
+        VoxelSvoNode& node = out.nodes[pending.index];
+
+        if (VoxelMipLevel::isUniform(packed) || pending.mip <= leafMip) {
+            const VoxelId material = VoxelMipLevel::value(packed);
+            node.kind = VoxelSvoNodeKind::Solid;
             node.materialId = material;
             node.materialClass = classifyOrDefault(classify, material);
+            node.leafSizeVoxels = static_cast<uint16_t>(1 << pending.mip);
+            continue;
         }
-        uint32_t index = static_cast<uint32_t>(out.nodes.size());
-        out.nodes.push_back(node);
-        return index;
-    };
 
-    auto makeMixed = [&]() -> uint32_t {
-        VoxelSvoNode node{};
+        const uint8_t mask = occupancy.childMask(pending.mip, pending.x, pending.y, pending.z);
         node.kind = VoxelSvoNodeKind::Mixed;
-        uint32_t index = static_cast<uint32_t>(out.nodes.size());
-        out.nodes.push_back(node);
-        return index;
-    };
-
-    std::function<uint32_t(int, int, int, int, bool)> buildRegion;
-    buildRegion = [&](int x0, int y0, int z0, int size, bool isRoot) -> uint32_t {
-        const int mip = log2Pow2(size);
-        const VoxelMipLevel& level = page.mips.levels[mip];
-        const int cellX = x0 >> mip;
-        const int cellY = y0 >> mip;
-        const int cellZ = z0 >> mip;
-        uint32_t packed = level.cells[cellIndex(cellX, cellY, cellZ, level.dim)];
-        const bool uniform = VoxelMipLevel::isUniform(packed);
-        const VoxelId rep = VoxelMipLevel::value(packed);
-
-        if (uniform) {
-            if (rep == 0) {
-                if (isRoot) {
-                    return makeLeaf(VoxelSvoNodeKind::Empty, 0, static_cast<uint16_t>(size));
-                }
-                return VoxelSvoNode::kInvalidChild;
-            }
-            return makeLeaf(VoxelSvoNodeKind::Solid, rep, static_cast<uint16_t>(size));
-        }
+        node.childMask = mask;
+        node.childOffset = nextFree - pending.index;
 
-        if (size <= out.minLeafVoxels) {
-            if (rep == 0) {
-                if (isRoot) {
-                    return makeLeaf(VoxelSvoNodeKind::Empty, 0, static_cast<uint16_t>(size));
-                }
-                return VoxelSvoNode::kInvalidChild;
-            }
-            return makeLeaf(VoxelSvoNodeKind::Solid, rep, static_cast<uint16_t>(size));
-        }
+        nextFree += static_cast<uint32_t>(std::popcount(static_cast<unsigned>(mask)));
 
-        const int half = size / 2;
-        uint8_t childMask = 0;
-        std::array<uint32_t, 8> children = {
-            VoxelSvoNode::kInvalidChild, VoxelSvoNode::kInvalidChild,
-            VoxelSvoNode::kInvalidChild, VoxelSvoNode::kInvalidChild,
-            VoxelSvoNode::kInvalidChild, VoxelSvoNode::kInvalidChild,
-            VoxelSvoNode::kInvalidChild, VoxelSvoNode::kInvalidChild
-        };
-
-        for (int child = 0; child < 8; ++child) {
-            const int dx = (child & 1) ? half : 0;
-            const int dy = (child & 2) ? half : 0;
-            const int dz = (child & 4) ? half : 0;
-            uint32_t childIndexNode =
-                buildRegion(x0 + dx, y0 + dy, z0 + dz, half, false);
-            if (childIndexNode == VoxelSvoNode::kInvalidChild) {
+        // Push in reverse slot order so slot 0 is expanded first.
+        uint32_t slotIndex = nextFree;
+        for (int child = 7; child >= 0; --child) {
+            if ((mask & (1u << child)) == 0) {
                 continue;
             }
-            childMask |= static_cast<uint8_t>(1u << child);
-            children[child] = childIndexNode;
-        }
-
-        if (childMask == 0) {
-            if (isRoot) {
-                return makeLeaf(VoxelSvoNodeKind::Empty, 0, static_cast<uint16_t>(size));
-            }
-            return VoxelSvoNode::kInvalidChild;
+            --slotIndex;
+            stack.push_back(PendingNode{
+                slotIndex,
+                pending.mip - 1,
+                pending.x * 2 + (child & 1),
+                pending.y * 2 + ((child >> 1) & 1),
+                pending.z * 2 + ((child >> 2) & 1)
+            });
         }
-
-        uint32_t nodeIndex = makeMixed();
-        VoxelSvoNode& node = out.nodes[nodeIndex];
-        node.childMask = childMask;
-        node.children = children;
-        return nodeIndex;
-    };
-
-    out.root = buildRegion(0, 0, 0, baseDim, true);
-    if (out.root == VoxelSvoNode::kInvalidChild) {
-        out.nodes.clear();
     }
+
     return out;
 }
 
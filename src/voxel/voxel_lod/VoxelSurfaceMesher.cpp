@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace Rigel::Voxel {
@@ -58,8 +59,190 @@ uint8_t clampLayer(uint16_t layer) {
     return static_cast<uint8_t>(std::min<uint16_t>(layer, 255));
 }
 
+// A quad flattened onto its face plane. (u,v) follow the SurfaceQuad span convention.
+struct PlaneQuad {
+    Direction normal = Direction::PosY;
+    int plane = 0;
+    int u = 0;
+    int v = 0;
+    int spanU = 1;
+    int spanV = 1;
+    VoxelId material = kVoxelAir;
+};
+
+PlaneQuad toPlaneQuad(const SurfaceQuad& quad, const glm::ivec3& offset) {
+    const glm::ivec3 cell = quad.cellMin + offset;
+    PlaneQuad out;
+    out.normal = quad.normal;
+    out.spanU = std::max(1, quad.span.x);
+    out.spanV = std::max(1, quad.span.y);
+    out.material = quad.material;
+    switch (quad.normal) {
+        case Direction::PosX:
+        case Direction::NegX:
+            out.plane = cell.x;
+            out.u = cell.z;
+            out.v = cell.y;
+            break;
+        case Direction::PosY:
+        case Direction::NegY:
+            out.plane = cell.y;
+            out.u = cell.x;
+            out.v = cell.z;
+            break;
+        case Direction::PosZ:
+        case Direction::NegZ:
+            out.plane = cell.z;
+            out.u = cell.x;
+            out.v = cell.y;
+            break;
+    }
+    return out;
+}
+
+SurfaceQuad fromPlane(Direction normal, int plane, int u, int v, int spanU, int spanV, VoxelId material) {
+    glm::ivec3 cell(0);
+    switch (normal) {
+        case Direction::PosX:
+        case Direction::NegX:
+            cell = glm::ivec3(plane, v, u);
+            break;
+        case Direction::PosY:
+        case Direction::NegY:
+            cell = glm::ivec3(u, plane, v);
+            break;
+        case Direction::PosZ:
+        case Direction::NegZ:
+            cell = glm::ivec3(u, v, plane);
+            break;
+    }
+    return SurfaceQuad{
+        .normal = normal,
+        .cellMin = cell,
+        .span = glm::ivec2(spanU, spanV),
+        .material = material
+    };
+}
+
+// Same row-major greedy rectangle cover as surface extraction, so a plane that fits
+// inside a single page merges exactly as extraction would have.
+template <typename Emit>
+void greedyMergeMask(int width, int height, std::vector<VoxelId>& mask, Emit emit) {
+    auto at = [&](int i, int j) -> VoxelId& {
+        return mask[static_cast<size_t>(i) + static_cast<size_t>(j) * static_cast<size_t>(width)];
+    };
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            const VoxelId material = at(i, j);
+            if (material == kVoxelAir) {
+                continue;
+            }
+
+            int runW = 1;
+            while (i + runW < width && at(i + runW, j) == material) {
+                ++runW;
+            }
+
+            int runH = 1;
+            bool done = false;
+            while (j + runH < height && !done) {
+                for (int k = 0; k < runW; ++k) {
+                    if (at(i + k, j + runH) != material) {
+                        done = true;
+                        break;
+                    }
+                }
+                if (!done) {
+                    ++runH;
+                }
+            }
+
+            emit(i, j, runW, runH, material);
+
+            for (int y = 0; y < runH; ++y) {
+                std::fill_n(&at(i, j + y), runW, kVoxelAir);
+            }
+        }
+    }
+}
+
+void mergePlane(std::span<const PlaneQuad> quads, std::vector<SurfaceQuad>& out) {
+    const PlaneQuad& first = quads.front();
+    if (quads.size() == 1) {
+        out.push_back(fromPlane(first.normal, first.plane, first.u, first.v,
+                                first.spanU, first.spanV, first.material));
+        return;
+    }
+
+    int minU = first.u;
+    int minV = first.v;
+    int maxU = first.u + first.spanU;
+    int maxV = first.v + first.spanV;
+    for (const PlaneQuad& quad : quads) {
+        minU = std::min(minU, quad.u);
+        minV = std::min(minV, quad.v);
+        maxU = std::max(maxU, quad.u + quad.spanU);
+        maxV = std::max(maxV, quad.v + quad.spanV);
+    }
+
+    const int width = maxU - minU;
+    const int height = maxV - minV;
+    std::vector<VoxelId> mask(static_cast<size_t>(width) * static_cast<size_t>(height), kVoxelAir);
+    for (const PlaneQuad& quad : quads) {
+        for (int y = 0; y < quad.spanV; ++y) {
+            const size_t row = static_cast<size_t>(quad.v - minV + y) * static_cast<size_t>(width);
+            std::fill_n(mask.begin() + static_cast<std::ptrdiff_t>(row + static_cast<size_t>(quad.u - minU)),
+                        quad.spanU,
+                        quad.material);
+        }
+    }
+
+    greedyMergeMask(width, height, mask, [&](int u, int v, int spanU, int spanV, VoxelId material) {
+        out.push_back(fromPlane(first.normal, first.plane, minU + u, minV + v, spanU, spanV, material));
+    });
+}
+
 } // namespace
 
+void mergeSurfaceQuadsAcrossPages(std::span<const SurfaceQuadPage> pages,
+                                  std::vector<SurfaceQuad>& out) {
+    size_t total = 0;
+    for (const SurfaceQuadPage& page : pages) {
+        total += page.quads.size();
+    }
+
+    std::vector<PlaneQuad> planeQuads;
+    planeQuads.reserve(total);
+    for (const SurfaceQuadPage& page : pages) {
+        for (const SurfaceQuad& quad : page.quads) {
+            if (quad.material == kVoxelAir) {
+                continue;
+            }
+            planeQuads.push_back(toPlaneQuad(quad, page.cellOffset));
+        }
+    }
+
+    std::sort(planeQuads.begin(), planeQuads.end(), [](const PlaneQuad& a, const PlaneQuad& b) {
+        if (a.normal != b.normal) {
+            return a.normal < b.normal;
+        }
+        return a.plane < b.plane;
+    });
+
+    out.reserve(out.size() + planeQuads.size());
+    size_t begin = 0;
+    while (begin < planeQuads.size()) {
+        size_t end = begin + 1;
+        while (end < planeQuads.size() &&
+               planeQuads[end].normal == planeQuads[begin].normal &&
+               planeQuads[end].plane == planeQuads[begin].plane) {
+            ++end;
+        }
+        mergePlane(std::span<const PlaneQuad>(planeQuads).subspan(begin, end - begin), out);
+        begin = end;
+    }
+}
+
 ChunkMesh buildSurfaceMeshFromQuads(
     std::span<const SurfaceQuad> quads,
     int cellSizeVoxels,
@@ -125,6 +125,31 @@ glm::vec3 pageWorldMin(const VoxelPageKey& key, int pageSizeVoxels) {
     );
 }
 
+VoxelPageKey clusterMemberKey(const VoxelPageKey& clusterKey, int clusterPages, const glm::ivec3& offset) {
+    return VoxelPageKey{
+        clusterKey.level,
+        clusterKey.x * clusterPages + offset.x,
+        clusterKey.y * clusterPages + offset.y,
+        clusterKey.z * clusterPages + offset.z
+    };
+}
+
+float pageDistanceSq(const VoxelPageKey& key, int pageSizeVoxels, const glm::ivec3& cameraVoxel) {
+    const int span = pageSpanVoxels(key, pageSizeVoxels);
+    const glm::vec3 pageCenter =
+        pageWorldMin(key, pageSizeVoxels) + glm::vec3(static_cast<float>(span) * 0.5f);
+    const glm::vec3 delta = pageCenter - glm::vec3(cameraVoxel);
+    return glm::dot(delta, delta);
+}
+
+bool isBuildCancelled(const std::shared_ptr<std::atomic_bool>& cancel) {
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+// An in-flight build is preempted only by a candidate at least 2x closer, so small
+// camera moves do not thrash the pool.
+constexpr float kBuildPreemptDistanceSqRatio = 4.0f;
+
 uint8_t evictionPriority(VoxelPageState state) {
     switch (state) {
         case VoxelPageState::Missing:
@@ -178,9 +203,29 @@ uint64_t VoxelSvoLodManager::estimatePageCpuBytes(const PageRecord& record) {
     bytes += record.tree.cpuBytes();
     bytes += record.mesh.vertices.size() * sizeof(VoxelVertex);
     bytes += record.mesh.indices.size() * sizeof(uint32_t);
+    bytes += record.quads.size() * sizeof(SurfaceQuad);
     return bytes;
 }
 
+uint64_t VoxelSvoLodManager::estimateClusterCpuBytes(const ClusterRecord& cluster) {
+    return cluster.mesh.vertices.size() * sizeof(VoxelVertex) +
+        cluster.mesh.indices.size() * sizeof(uint32_t);
+}
+
+uint64_t VoxelSvoLodManager::estimateClusterGpuBytes(const ClusterRecord& cluster) {
+    return cluster.active ? estimateClusterCpuBytes(cluster) : 0;
+}
+
+bool VoxelSvoLodManager::pageNeedsQuads(const PageRecord& record) const {
+    // Meshed while clustering was off: the mesh is current but its quads were not kept.
+    return m_config.clusterPages > 1 &&
+        record.state == VoxelPageState::ReadyMesh &&
+        record.meshRevision != 0 &&
+        record.meshRevision == record.appliedRevision &&
+        record.quads.empty() &&
+        !record.mesh.isEmpty();
+}
+
 uint64_t VoxelSvoLodManager::estimatePageGpuBytes(const PageRecord& record) {
     if (record.state != VoxelPageState::ReadyMesh) {
         return 0;
@@ -214,6 +259,8 @@ VoxelSvoConfig VoxelSvoLodManager::sanitizeConfig(VoxelSvoConfig config) {
         config.minLeafVoxels = config.pageSizeVoxels;
     }
 
+    config.clusterPages = std::clamp(config.clusterPages, 1, 8);
+
     if (config.buildBudgetPagesPerFrame < 0) {
         config.buildBudgetPagesPerFrame = 0;
     }
@@ -237,7 +284,19 @@ VoxelSvoConfig VoxelSvoLodManager::sanitizeConfig(VoxelSvoConfig config) {
 }
 
 void VoxelSvoLodManager::setConfig(const VoxelSvoConfig& config) {
+    const int previousClusterPages = m_config.clusterPages;
     m_config = sanitizeConfig(config);
+    if (m_config.clusterPages != previousClusterPages) {
+        // Cluster keys depend on the cluster size; rebuild them from the pages.
+        m_clusters.clear();
+        if (m_config.clusterPages <= 1) {
+            // Quads only feed cluster merges; stop charging them to the CPU budget.
+            for (auto& [key, record] : m_pages) {
+                (void)key;
+                std::vector<SurfaceQuad>().swap(record.quads);
+            }
+        }
+    }
 }
 
 void VoxelSvoLodManager::setBuildThreads(size_t threadCount) {
@@ -256,6 +315,10 @@ void VoxelSvoLodManager::setPersistenceSource(std::shared_ptr<const IVoxelSource
     m_persistenceSource = std::move(source);
 }
 
+void VoxelSvoLodManager::setPageCache(std::shared_ptr<VoxelPageDiskCache> cache) {
+    m_pageCache = std::move(cache);
+}
+
 void VoxelSvoLodManager::invalidateChunk(ChunkCoord coord) {
     if (m_persistenceSource) {
         m_persistenceSource->invalidateChunk(coord);
@@ -304,6 +367,34 @@ void VoxelSvoLodManager::invalidateChunk(ChunkCoord coord) {
             }
         }
     }
+
+}
+
+void VoxelSvoLodManager::invalidateCachedPages(ChunkCoord coord) {
+    if (!m_pageCache) {
+        return;
+    }
+
+    const int pageSize = std::max(1, m_config.pageSizeVoxels);
+    const int worldMinX = coord.x * Chunk::SIZE;
+    const int worldMinY = coord.y * Chunk::SIZE;
+    const int worldMinZ = coord.z * Chunk::SIZE;
+    const int worldMaxX = worldMinX + Chunk::SIZE - 1;
+    const int worldMaxY = worldMinY + Chunk::SIZE - 1;
+    const int worldMaxZ = worldMinZ + Chunk::SIZE - 1;
+
+    // Cached pages at every level cover this chunk, not just the resident level-0 ones.
+    const int levelCount = std::clamp(m_config.levels, 1, 16);
+    for (int level = 0; level < levelCount; ++level) {
+        const int span = pageSpanVoxels(VoxelPageKey{level, 0, 0, 0}, pageSize);
+        for (int pz = floorDiv(worldMinZ, span); pz <= floorDiv(worldMaxZ, span); ++pz) {
+            for (int py = floorDiv(worldMinY, span); py <= floorDiv(worldMaxY, span); ++py) {
+                for (int px = floorDiv(worldMinX, span); px <= floorDiv(worldMaxX, span); ++px) {
+                    m_pageCache->invalidate(VoxelPageKey{level, px, py, pz});
+                }
+            }
+        }
+    }
 }
 
 void VoxelSvoLodManager::bind(const ChunkManager* chunkManager,
@@ -412,6 +503,7 @@ void VoxelSvoLodManager::processBuildCompletions() {
         record->meshQueuedRevision = 0;
         if (record->meshRevision != output.revision) {
             record->mesh = ChunkMesh{};
+            record->quads.clear();
             record->meshRevision = 0;
             record->state = VoxelPageState::ReadyCpu;
         } else {
@@ -429,6 +521,9 @@ void VoxelSvoLodManager::processBuildCompletions() {
 
         // Per-update mip timing (accumulated across applied pages).
         m_telemetry.mipBuildMicros += output.mipBuildMicros;
+
+        m_telemetry.diskCacheHits += output.diskCacheHit ? 1u : 0u;
+        m_telemetry.diskCacheWrites += output.diskCacheWrite ? 1u : 0u;
     }
 }
 
@@ -484,7 +579,8 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
         if (!record.desiredVisible) {
             continue;
         }
-        if (record.state != VoxelPageState::ReadyCpu) {
+        const bool needsQuads = pageNeedsQuads(record);
+        if (record.state != VoxelPageState::ReadyCpu && !needsQuads) {
             continue;
         }
         if (record.appliedRevision == 0) {
@@ -493,7 +589,7 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
         if (record.meshQueued) {
             continue;
         }
-        if (record.meshRevision == record.appliedRevision) {
+        if (record.meshRevision == record.appliedRevision && !needsQuads) {
             continue;
         }
         bool missingNeighbors = false;
@@ -528,7 +624,9 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
         if (!center) {
             continue;
         }
-        if (center->meshQueued || center->meshRevision == center->appliedRevision) {
+        // A page re-meshed only for its quads keeps drawing its current mesh meanwhile.
+        const bool remeshForQuads = pageNeedsQuads(*center);
+        if (center->meshQueued || (center->meshRevision == center->appliedRevision && !remeshForQuads)) {
             continue;
         }
 
@@ -538,6 +636,7 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
         MacroVoxelGrid centerGrid = buildMacroGridFromPage(center->cpu, sampleCellSize);
         if (centerGrid.empty()) {
             center->mesh = ChunkMesh{};
+            center->quads.clear();
             center->meshRevision = center->appliedRevision;
             center->state = VoxelPageState::ReadyMesh;
             continue;
@@ -569,9 +668,12 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
         const uint64_t revision = center->appliedRevision;
         center->meshQueued = true;
         center->meshQueuedRevision = revision;
-        center->state = VoxelPageState::QueuedMesh;
+        if (!remeshForQuads) {
+            center->state = VoxelPageState::QueuedMesh;
+        }
 
         const auto faceLayers = m_faceTextureLayers;
+        const bool keepQuads = m_config.clusterPages > 1;
 
         m_buildPool->enqueue([this,
                               key,
@@ -584,6 +686,7 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
                               neighborNegZ = std::move(neighborGrids[4]),
                               neighborPosZ = std::move(neighborGrids[5]),
                               worldCellSize,
+                              keepQuads,
                               faceLayers = std::move(faceLayers)]() mutable {
             MeshBuildOutput output{};
             output.key = key;
@@ -601,9 +704,14 @@ void VoxelSvoLodManager::enqueueMeshBuilds() {
             std::vector<SurfaceQuad> quads;
             extractSurfaceQuadsGreedy(centerGrid, workerNeighbors, VoxelBoundaryPolicy::OutsideSolid, quads);
             output.mesh = buildSurfaceMeshFromQuads(quads, worldCellSize, faceLayers);
+            if (keepQuads) {
+                output.quads = std::move(quads);
+            }
             m_meshBuildComplete.push(std::move(output));
         });
-        center->state = VoxelPageState::Meshing;
+        if (!remeshForQuads) {
+            center->state = VoxelPageState::Meshing;
+        }
 
         --budget;
     }
@@ -660,10 +768,203 @@ void VoxelSvoLodManager::processMeshCompletions() {
         record->meshQueuedRevision = 0;
         record->meshRevision = output.revision;
         record->mesh = std::move(output.mesh);
+        if (m_config.clusterPages > 1) {
+            record->quads = std::move(output.quads);
+        } else {
+            record->quads.clear();
+        }
         record->state = VoxelPageState::ReadyMesh;
     }
 }
 
+VoxelPageKey VoxelSvoLodManager::clusterKeyForPage(const VoxelPageKey& key) const {
+    const int n = std::max(1, m_config.clusterPages);
+    return VoxelPageKey{key.level, floorDiv(key.x, n), floorDiv(key.y, n), floorDiv(key.z, n)};
+}
+
+bool VoxelSvoLodManager::clusterSignature(const VoxelPageKey& clusterKey,
+                                          uint64_t* outSignature,
+                                          uint16_t* outCellSizeVoxels) const {
+    // A cluster is usable only when every member is visible and meshed at the same
+    // cell size; otherwise its pages keep rendering individually.
+    const int n = std::max(1, m_config.clusterPages);
+    uint64_t signature = 1469598103934665603ull;
+    uint16_t cellSize = 0;
+    for (int dz = 0; dz < n; ++dz) {
+        for (int dy = 0; dy < n; ++dy) {
+            for (int dx = 0; dx < n; ++dx) {
+                const PageRecord* member = findPage(clusterMemberKey(clusterKey, n, glm::ivec3(dx, dy, dz)));
+                if (!member || !member->desiredVisible ||
+                    member->state != VoxelPageState::ReadyMesh ||
+                    member->meshRevision == 0 || member->cpu.dim <= 0 ||
+                    member->meshQueued || pageNeedsQuads(*member)) {
+                    return false;
+                }
+                if (cellSize == 0) {
+                    cellSize = member->leafMinVoxels;
+                } else if (member->leafMinVoxels != cellSize) {
+                    return false;
+                }
+                signature ^= member->meshRevision;
+                signature *= 1099511628211ull;
+            }
+        }
+    }
+    if (outSignature) {
+        *outSignature = signature;
+    }
+    if (outCellSizeVoxels) {
+        *outCellSizeVoxels = cellSize;
+    }
+    return true;
+}
+
+const VoxelSvoLodManager::ClusterRecord* VoxelSvoLodManager::findActiveCluster(
+    const VoxelPageKey& pageKey) const {
+    if (m_config.clusterPages <= 1) {
+        return nullptr;
+    }
+    auto it = m_clusters.find(clusterKeyForPage(pageKey));
+    if (it == m_clusters.end() || !it->second.active) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void VoxelSvoLodManager::processClusterCompletions() {
+    ClusterBuildOutput output;
+    while (m_clusterBuildComplete.tryPop(output)) {
+        auto it = m_clusters.find(output.key);
+        if (it == m_clusters.end()) {
+            continue;
+        }
+        ClusterRecord& cluster = it->second;
+        if (!cluster.queued || cluster.queuedSignature != output.signature) {
+            continue;
+        }
+        cluster.queued = false;
+        cluster.queuedSignature = 0;
+        cluster.meshSignature = output.signature;
+        cluster.revision = ++m_clusterRevisionCounter;
+        cluster.mesh = std::move(output.mesh);
+    }
+}
+
+void VoxelSvoLodManager::updatePageClusters() {
+    const int n = m_config.clusterPages;
+    if (n <= 1) {
+        m_clusters.clear();
+        return;
+    }
+
+    for (const auto& [key, record] : m_pages) {
+        if (record.desiredVisible && record.state == VoxelPageState::ReadyMesh) {
+            const VoxelPageKey clusterKey = clusterKeyForPage(key);
+            m_clusters.try_emplace(clusterKey).first->second.key = clusterKey;
+        }
+    }
+
+    struct Candidate {
+        VoxelPageKey key{};
+        uint64_t signature = 0;
+        uint16_t cellSizeVoxels = 1;
+        float distanceSq = 0.0f;
+    };
+    std::vector<Candidate> candidates;
+
+    const int pageSize = std::max(1, m_config.pageSizeVoxels);
+    for (auto it = m_clusters.begin(); it != m_clusters.end();) {
+        ClusterRecord& cluster = it->second;
+        uint64_t signature = 0;
+        uint16_t cellSize = 1;
+        if (!clusterSignature(cluster.key, &signature, &cellSize)) {
+            bool anyMember = false;
+            for (int dz = 0; dz < n && !anyMember; ++dz) {
+                for (int dy = 0; dy < n && !anyMember; ++dy) {
+                    for (int dx = 0; dx < n && !anyMember; ++dx) {
+                        anyMember = findPage(clusterMemberKey(cluster.key, n, glm::ivec3(dx, dy, dz))) != nullptr;
+                    }
+                }
+            }
+            if (!anyMember) {
+                it = m_clusters.erase(it);
+                continue;
+            }
+            cluster.active = false;
+            ++it;
+            continue;
+        }
+
+        cluster.active = cluster.revision != 0 && cluster.meshSignature == signature;
+        if (!cluster.active && !(cluster.queued && cluster.queuedSignature == signature)) {
+            const VoxelPageKey minPage = clusterMemberKey(cluster.key, n, glm::ivec3(0));
+            const float span = static_cast<float>(pageSpanVoxels(minPage, pageSize)) * static_cast<float>(n);
+            const glm::vec3 center = pageWorldMin(minPage, pageSize) + glm::vec3(span * 0.5f);
+            const glm::vec3 delta = center - m_lastCameraPos;
+            candidates.push_back(Candidate{cluster.key, signature, cellSize, glm::dot(delta, delta)});
+        }
+        ++it;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distanceSq < b.distanceSq;
+    });
+
+    int budget = std::max(0, m_config.applyBudgetPagesPerFrame);
+    for (const Candidate& candidate : candidates) {
+        if (budget <= 0) {
+            break;
+        }
+        ClusterRecord& cluster = m_clusters[candidate.key];
+
+        std::vector<std::vector<SurfaceQuad>> memberQuads;
+        std::vector<glm::ivec3> memberOffsets;
+        memberQuads.reserve(static_cast<size_t>(n) * n * n);
+        memberOffsets.reserve(static_cast<size_t>(n) * n * n);
+        for (int dz = 0; dz < n; ++dz) {
+            for (int dy = 0; dy < n; ++dy) {
+                for (int dx = 0; dx < n; ++dx) {
+                    const PageRecord* member =
+                        findPage(clusterMemberKey(candidate.key, n, glm::ivec3(dx, dy, dz)));
+                    const int cellsPerPage = member->cpu.dim / std::max(1, static_cast<int>(candidate.cellSizeVoxels));
+                    memberQuads.push_back(member->quads);
+                    memberOffsets.push_back(glm::ivec3(dx, dy, dz) * cellsPerPage);
+                }
+            }
+        }
+
+        const VoxelPageKey key = candidate.key;
+        const uint64_t signature = candidate.signature;
+        const int worldCellSize = static_cast<int>(candidate.cellSizeVoxels) * pageScaleForLevel(key.level);
+        cluster.queued = true;
+        cluster.queuedSignature = signature;
+
+        m_buildPool->enqueue([this,
+                              key,
+                              signature,
+                              worldCellSize,
+                              memberQuads = std::move(memberQuads),
+                              memberOffsets = std::move(memberOffsets),
+                              faceLayers = m_faceTextureLayers]() {
+            std::vector<SurfaceQuadPage> pages;
+            pages.reserve(memberQuads.size());
+            for (size_t i = 0; i < memberQuads.size(); ++i) {
+                pages.push_back(SurfaceQuadPage{memberOffsets[i], memberQuads[i]});
+            }
+            std::vector<SurfaceQuad> merged;
+            mergeSurfaceQuadsAcrossPages(pages, merged);
+
+            ClusterBuildOutput output{};
+            output.key = key;
+            output.signature = signature;
+            output.mesh = buildSurfaceMeshFromQuads(merged, worldCellSize, faceLayers);
+            m_clusterBuildComplete.push(std::move(output));
+        });
+
+        --budget;
+    }
+}
+
 void VoxelSvoLodManager::seedDesiredPages(const glm::vec3& cameraPos) {
     if (!m_config.enabled) {
         return;
@@ -975,6 +1276,8 @@ void VoxelSvoLodManager::enqueueBuild(const VoxelPageKey& key, uint64_t revision
     GeneratorSource::ChunkGenerateCallback generator = m_chunkGenerator;
     std::shared_ptr<const IVoxelSource> persistenceSource = m_persistenceSource;
     std::shared_ptr<std::atomic_bool> cancel = record->cancel;
+    std::shared_ptr<VoxelPageDiskCache> pageCache = m_pageCache;
+    const uint64_t cacheGeneration = pageCache ? pageCache->generation(key) : 0;
 
     BrickSampleDesc desc;
     desc.worldMinVoxel = glm::ivec3(key.x * pageSpan, key.y * pageSpan, key.z * pageSpan);
@@ -994,6 +1297,8 @@ void VoxelSvoLodManager::enqueueBuild(const VoxelPageKey& key, uint64_t revision
                           registry,
                           generator,
                           persistenceSource = std::move(persistenceSource),
+                          pageCache = std::move(pageCache),
+                          cacheGeneration,
                           cancel,
                           desc,
                           loadedSnapshots = std::move(loadedSnapshots)]() {
@@ -1008,7 +1313,22 @@ void VoxelSvoLodManager::enqueueBuild(const VoxelPageKey& key, uint64_t revision
             return;
         }
 
+        VoxelMaterialClassifier classifier = [registry](VoxelId id) {
+            return classifyVoxel(registry, id);
+        };
+
+        // Loaded chunks are authoritative over anything on disk, so pages touching
+        // them always resample.
+        if (pageCache && loadedSnapshots.empty() && pageCache->load(key, pageSize, output.cpu)) {
+            output.sampleStatus = BrickSampleStatus::Hit;
+            output.diskCacheHit = true;
+            output.tree = buildVoxelPageTree(output.cpu, minLeaf, classifier);
+            m_buildComplete.push(std::move(output));
+            return;
+        }
+
         std::vector<VoxelId> l0(desc.outVoxelCount(), kVoxelAir);
+        const bool usedLoadedChunks = !loadedSnapshots.empty();
         LoadedChunkSource loaded(std::move(loadedSnapshots));
         GeneratorSource generated(generator);
         VoxelSourceChain chain;
@@ -1034,15 +1354,74 @@ void VoxelSvoLodManager::enqueueBuild(const VoxelPageKey& key, uint64_t revision
         output.mipBuildMicros = clampU64Micros(
             std::chrono::duration_cast<std::chrono::microseconds>(mipEnd - mipStart).count());
 
-        VoxelMaterialClassifier classifier = [registry](VoxelId id) {
-            return classifyVoxel(registry, id);
-        };
+        // Loaded chunks may hold edits that are not saved yet; only pages sampled
+        // purely from persisted or generated data are worth keeping across sessions.
+        if (pageCache && !usedLoadedChunks && output.sampleStatus == BrickSampleStatus::Hit) {
+            output.diskCacheWrite = pageCache->store(output.cpu, cacheGeneration);
+        }
+
         output.tree = buildVoxelPageTree(output.cpu, minLeaf, classifier);
 
         m_buildComplete.push(std::move(output));
     });
 }
 
+size_t VoxelSvoLodManager::maxInFlightBuilds() const {
+    // Enough to keep every worker busy plus one frame of budget; anything beyond that
+    // only queues work that camera movement is likely to make obsolete.
+    return std::max<size_t>(m_buildThreads * 2,
+                            static_cast<size_t>(std::max(1, m_config.buildBudgetPagesPerFrame)));
+}
+
+void VoxelSvoLodManager::rescoreInFlightBuilds(const glm::vec3& cameraPos) {
+    const glm::ivec3 cameraVoxel = snapToChunkOriginVoxel(cameraPos);
+    const bool moved = !m_hasScoreAnchor || cameraVoxel != m_lastScoreAnchor;
+    m_lastScoreAnchor = cameraVoxel;
+    m_hasScoreAnchor = true;
+
+    const int pageSize = std::max(1, m_config.pageSizeVoxels);
+    m_buildsInFlight = 0;
+    for (auto& [key, record] : m_pages) {
+        if (record.state != VoxelPageState::Sampling || isBuildCancelled(record.cancel)) {
+            continue;
+        }
+        if (!record.desiredBuild) {
+            // Fell out of the desired set: stop sampling cooperatively. The completion
+            // comes back as Cancelled and returns the page to Missing.
+            if (record.cancel) {
+                record.cancel->store(true, std::memory_order_relaxed);
+            }
+            ++m_telemetry.buildsCancelled;
+            continue;
+        }
+        if (moved) {
+            record.buildScore = pageDistanceSq(key, pageSize, cameraVoxel);
+        }
+        ++m_buildsInFlight;
+    }
+}
+
+bool VoxelSvoLodManager::preemptWorstBuild(float candidateScore) {
+    PageRecord* worst = nullptr;
+    for (auto& [key, record] : m_pages) {
+        (void)key;
+        if (record.state != VoxelPageState::Sampling || isBuildCancelled(record.cancel)) {
+            continue;
+        }
+        if (!worst || record.buildScore > worst->buildScore) {
+            worst = &record;
+        }
+    }
+    if (!worst || !worst->cancel ||
+        worst->buildScore <= candidateScore * kBuildPreemptDistanceSqRatio) {
+        return false;
+    }
+    worst->cancel->store(true, std::memory_order_relaxed);
+    ++m_telemetry.buildsCancelled;
+    --m_buildsInFlight;
+    return true;
+}
+
 void VoxelSvoLodManager::enforcePageLimit(const glm::vec3& cameraPos) {
     const size_t maxResident = static_cast<size_t>(std::max(0, m_config.maxResidentPages));
     const uint64_t maxCpuBytes = static_cast<uint64_t>(std::max<int64_t>(0, m_config.maxCpuBytes));
@@ -1059,6 +1438,11 @@ void VoxelSvoLodManager::enforcePageLimit(const glm::vec3& cameraPos) {
         totalCpuBytes += estimatePageCpuBytes(record);
         totalGpuBytes += estimatePageGpuBytes(record);
     }
+    for (const auto& [key, cluster] : m_clusters) {
+        (void)key;
+        totalCpuBytes += estimateClusterCpuBytes(cluster);
+        totalGpuBytes += estimateClusterGpuBytes(cluster);
+    }
 
     auto overLimits = [&]() {
         const bool overResident = (maxResident > 0) && (m_pages.size() > maxResident);
@@ -1159,6 +1543,16 @@ void VoxelSvoLodManager::enforcePageLimit(const glm::vec3& cameraPos) {
             accountEviction(it->second.state);
             m_buildQueued.erase(entry.key);
             m_pages.erase(it);
+
+            // A cluster cannot outlive a member; its merged mesh goes with it.
+            if (m_config.clusterPages > 1) {
+                auto clusterIt = m_clusters.find(clusterKeyForPage(entry.key));
+                if (clusterIt != m_clusters.end()) {
+                    totalCpuBytes -= estimateClusterCpuBytes(clusterIt->second);
+                    totalGpuBytes -= estimateClusterGpuBytes(clusterIt->second);
+                    m_clusters.erase(clusterIt);
+                }
+            }
         }
     };
 
@@ -1181,11 +1575,14 @@ void VoxelSvoLodManager::update(const glm::vec3& cameraPos) {
         m_telemetry.evictedQueued = 0;
         m_telemetry.evictedReadyCpu = 0;
         m_telemetry.evictedReadyMesh = 0;
+        m_telemetry.buildsInFlight = 0;
+        m_telemetry.buildsCancelled = 0;
         m_telemetry.meshBlockedMissingNeighbors = 0;
         m_telemetry.meshBlockedLeafMismatch = 0;
         m_telemetry.desiredVisibleCount = 0;
         m_telemetry.desiredBuildCount = 0;
         m_telemetry.visibleReadyMeshCount = 0;
+        m_telemetry.activeClusters = 0;
         m_telemetry.readyCpuPagesPerLevel = {};
         m_telemetry.readyCpuNodesPerLevel = {};
         m_telemetry.bricksSampled = 0;
@@ -1208,11 +1605,14 @@ void VoxelSvoLodManager::update(const glm::vec3& cameraPos) {
     m_telemetry.evictedQueued = 0;
     m_telemetry.evictedReadyCpu = 0;
     m_telemetry.evictedReadyMesh = 0;
+    m_telemetry.buildsCancelled = 0;
     m_telemetry.meshBlockedMissingNeighbors = 0;
     m_telemetry.meshBlockedLeafMismatch = 0;
     processBuildCompletions();
     processMeshCompletions();
+    processClusterCompletions();
     seedDesiredPages(cameraPos);
+    rescoreInFlightBuilds(cameraPos);
 
     enforcePageLimit(cameraPos);
 
@@ -1263,28 +1663,40 @@ void VoxelSvoLodManager::update(const glm::vec3& cameraPos) {
         m_buildQueued.insert(sampleQueue[i].key);
     }
 
-    // Enqueue new builds (budgeted).
+    // Enqueue new builds (budgeted). Once the pool holds maxInFlightBuilds() jobs, a
+    // new page only starts by preempting a much farther in-flight build.
     int budget = std::max(0, m_config.buildBudgetPagesPerFrame);
+    const size_t inFlightCap = maxInFlightBuilds();
     while (budget > 0 && !m_buildQueue.empty()) {
         VoxelPageKey key = m_buildQueue.front();
-        m_buildQueue.pop_front();
-        m_buildQueued.erase(key);
         PageRecord* record = findPage(key);
-        if (!record) {
+        if (!record || record->state != VoxelPageState::QueuedSample) {
+            m_buildQueue.pop_front();
+            m_buildQueued.erase(key);
             continue;
         }
-        if (record->state != VoxelPageState::QueuedSample) {
-            continue;
+
+        const float score = pageDistanceSq(key, pageSize, cameraVoxel);
+        if (m_buildsInFlight >= inFlightCap && !preemptWorstBuild(score)) {
+            break;
         }
+        m_buildQueue.pop_front();
+        m_buildQueued.erase(key);
 
         enqueueBuild(key, record->desiredRevision);
+        if (record->state == VoxelPageState::Sampling) {
+            record->buildScore = score;
+            ++m_buildsInFlight;
+        }
         --budget;
     }
 
     enqueueMeshBuilds();
+    updatePageClusters();
 
     // Update telemetry (current state).
     m_telemetry.activePages = static_cast<uint32_t>(m_pages.size());
+    m_telemetry.buildsInFlight = static_cast<uint32_t>(m_buildsInFlight);
     m_telemetry.pagesQueued = 0;
     m_telemetry.pagesBuilding = 0;
     m_telemetry.pagesReadyCpu = 0;
@@ -1292,11 +1704,21 @@ void VoxelSvoLodManager::update(const glm::vec3& cameraPos) {
     m_telemetry.desiredVisibleCount = 0;
     m_telemetry.desiredBuildCount = 0;
     m_telemetry.visibleReadyMeshCount = 0;
+    m_telemetry.activeClusters = 0;
     m_telemetry.readyCpuPagesPerLevel = {};
     m_telemetry.readyCpuNodesPerLevel = {};
     m_telemetry.cpuBytesCurrent = 0;
     m_telemetry.gpuBytesCurrent = 0;
 
+    for (const auto& [key, cluster] : m_clusters) {
+        (void)key;
+        m_telemetry.cpuBytesCurrent += estimateClusterCpuBytes(cluster);
+        m_telemetry.gpuBytesCurrent += estimateClusterGpuBytes(cluster);
+        if (cluster.active) {
+            ++m_telemetry.activeClusters;
+        }
+    }
+
     for (const auto& [key, record] : m_pages) {
         (void)key;
         if (record.desiredVisible) {
@@ -1365,6 +1787,7 @@ void VoxelSvoLodManager::reset() {
         }
     }
     m_pages.clear();
+    m_clusters.clear();
     m_buildQueue.clear();
     m_buildQueued.clear();
     if (m_buildPool) {
@@ -1372,6 +1795,8 @@ void VoxelSvoLodManager::reset() {
         m_buildPool.reset();
     }
     m_frameCounter = 0;
+    m_hasScoreAnchor = false;
+    m_buildsInFlight = 0;
     m_initialized = false;
 }
 
@@ -1418,10 +1843,32 @@ void VoxelSvoLodManager::collectOpaqueMeshes(std::vector<OpaqueMeshEntry>& out)
     out.clear();
     out.reserve(m_pages.size());
     const int pageSize = std::max(1, m_config.pageSizeVoxels);
+    const int n = m_config.clusterPages;
+    if (n > 1) {
+        for (const auto& [key, cluster] : m_clusters) {
+            if (!cluster.active || cluster.mesh.isEmpty()) {
+                continue;
+            }
+            const auto& opaque = cluster.mesh.layers[static_cast<size_t>(RenderLayer::Opaque)];
+            if (opaque.isEmpty()) {
+                continue;
+            }
+            OpaqueMeshEntry entry{};
+            entry.key = clusterMemberKey(key, n, glm::ivec3(0));
+            entry.revision = cluster.revision;
+            entry.worldMin = pageWorldMin(entry.key, pageSize);
+            entry.mesh = &cluster.mesh;
+            entry.spanPages = n;
+            out.push_back(entry);
+        }
+    }
     for (const auto& [key, record] : m_pages) {
         if (!record.desiredVisible) {
             continue;
         }
+        if (findActiveCluster(key)) {
+            continue;
+        }
         if (record.state != VoxelPageState::ReadyMesh) {
             continue;
         }
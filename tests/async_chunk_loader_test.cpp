@@ -1,15 +1,21 @@
 #include "TestFramework.h"
 
 #include "Rigel/Persistence/AsyncChunkLoader.h"
+#include "Rigel/Persistence/Backends/CR/CRChunkMapping.h"
+#include "Rigel/Persistence/Backends/CR/CRFormat.h"
+#include "Rigel/Persistence/Backends/CR/CRLz4.h"
+#include "Rigel/Persistence/Backends/CR/CRSettings.h"
 #include "Rigel/Persistence/Backends/Memory/MemoryFormat.h"
 #include "Rigel/Persistence/ChunkSerializer.h"
 #include "Rigel/Persistence/PersistenceService.h"
+#include "Rigel/Persistence/Providers.h"
 #include "Rigel/Persistence/Storage.h"
 #include "Rigel/Voxel/WorldResources.h"
 #include "Rigel/Voxel/World.h"
 
 #include <chrono>
 #include <filesystem>
+#include <limits>
 #include <optional>
 #include <random>
 #include <thread>
@@ -199,6 +205,54 @@ void saveRegionForPayloads(PersistenceService& service,
     }
     format->chunkContainer().saveRegion(region);
 }
+void useCRFormat(MemoryContext& ctx, BlockRegistry& registry, bool lz4) {
+    ctx.formats.registerFormat(
+        Backends::CR::descriptor(),
+        Backends::CR::factory(),
+        Backends::CR::probe());
+    ctx.context.preferredFormat = "cr";
+    ctx.context.zoneId = "rigel:default";
+    auto providers = std::make_shared<ProviderRegistry>();
+    providers->add(kBlockRegistryProviderId, std::make_shared<BlockRegistryProvider>(&registry));
+    auto settings = std::make_shared<Backends::CR::CRPersistenceSettings>();
+    settings->enableLz4 = lz4;
+    // Chunk-by-chunk reads need framed regions, which a world has to opt into.
+    settings->columnFrames = true;
+    providers->add(Backends::CR::kCRSettingsProviderId, settings);
+    ctx.context.providers = providers;
+}
+
+std::vector<ChunkData> saveCRChunks(MemoryContext& ctx,
+                                    BlockRegistry& registry,
+                                    const std::vector<BlockID>& palette,
+                                    const std::vector<ChunkCoord>& coords) {
+    std::vector<ChunkData> payloads;
+    ChunkRegionSnapshot region;
+    auto format = ctx.service.openFormat(ctx.context);
+    region.key = format->regionLayout().regionForChunk("rigel:default", coords.front());
+    for (const ChunkCoord& coord : coords) {
+        payloads.push_back(buildPayload(coord, registry, palette, false, std::nullopt, false));
+        for (int32_t sub = 0; sub < 8; ++sub) {
+            ChunkSpan span;
+            span.chunkX = coord.x;
+            span.chunkY = coord.y;
+            span.chunkZ = coord.z;
+            span.offsetX = (sub & 1) * 16;
+            span.offsetY = ((sub >> 1) & 1) * 16;
+            span.offsetZ = ((sub >> 2) & 1) * 16;
+            span.sizeX = 16;
+            span.sizeY = 16;
+            span.sizeZ = 16;
+            ChunkSnapshot snapshot;
+            snapshot.key = Backends::CR::toCRChunk({coord.x, coord.y, coord.z, sub});
+            snapshot.key.zoneId = "rigel:default";
+            snapshot.data = buildPayload(coord, registry, palette, false, span, false);
+            region.chunks.push_back(std::move(snapshot));
+        }
+    }
+    format->chunkContainer().saveRegion(region);
+    return payloads;
+}
 }
 
 TEST_CASE(AsyncChunkLoader_Request_Completes_Deterministic) {
@@ -463,6 +517,115 @@ TEST_CASE(AsyncChunkLoader_PartialSpan_BaseFill) {
     CHECK(!outside.isAir());
 }
 
+TEST_CASE(AsyncChunkLoader_RandomAccessFormat_ReadsSingleChunks) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_a");
+    BlockID testB = registerTestBlock(registry, "rigel:test_b");
+    std::vector<BlockID> palette = {BlockRegistry::airId(), testA, testB};
+
+    MemoryContext ctx;
+    useCRFormat(ctx, registry, false);
+
+    // Two stored chunks in the same region; each is written as its eight CR subchunks.
+    const std::vector<ChunkCoord> stored = {{0, 0, 0}, {1, 0, 0}};
+    std::vector<ChunkData> payloads = saveCRChunks(ctx, registry, palette, stored);
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+
+    CHECK(loader.request(stored[0]));
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    Chunk* loaded = world.chunkManager().getChunk(stored[0]);
+    CHECK(loaded != nullptr);
+    if (loaded) {
+        verifyPayloadMatches(*loaded, payloads[0]);
+    }
+    CHECK(world.chunkManager().getChunk(stored[1]) == nullptr);
+
+    // Unstored neighbours in the same region resolve as "not on disk" without a load.
+    ChunkCoord missing{2, 0, 0};
+    CHECK(loader.request(missing));
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    CHECK(!loader.isPending(missing));
+    CHECK(!loader.request(missing));
+
+    CHECK(loader.request(stored[1]));
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    loaded = world.chunkManager().getChunk(stored[1]);
+    CHECK(loaded != nullptr);
+    if (loaded) {
+        verifyPayloadMatches(*loaded, payloads[1]);
+    }
+}
+
+TEST_CASE(AsyncChunkLoader_RandomAccessFormat_DecodesFramesOnWorkers) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_a");
+    BlockID testB = registerTestBlock(registry, "rigel:test_b");
+    std::vector<BlockID> palette = {BlockRegistry::airId(), testA, testB};
+
+    MemoryContext ctx;
+    useCRFormat(ctx, registry, Backends::CR::CRLz4::available());
+    const std::vector<ChunkCoord> stored = {{0, 0, 0}, {1, 0, 1}, {2, 1, 0}, {3, 0, 3}};
+    std::vector<ChunkData> payloads = saveCRChunks(ctx, registry, palette, stored);
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        1,
+        2,
+        1,
+        generator);
+
+    for (const ChunkCoord& coord : stored) {
+        CHECK(loader.request(coord));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    bool pending = true;
+    while (pending && std::chrono::steady_clock::now() < deadline) {
+        loader.drainCompletions(std::numeric_limits<size_t>::max());
+        pending = false;
+        for (const ChunkCoord& coord : stored) {
+            pending = pending || loader.isPending(coord);
+        }
+        if (pending) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    CHECK(!pending);
+
+    for (size_t i = 0; i < stored.size(); ++i) {
+        Chunk* loaded = world.chunkManager().getChunk(stored[i]);
+        CHECK(loaded != nullptr);
+        if (loaded) {
+            verifyPayloadMatches(*loaded, payloads[i]);
+        }
+    }
+}
+
 TEST_CASE(AsyncChunkLoader_MissingRegion_UsesNegativeCache) {
     WorldResources resources;
     World world;
@@ -540,3 +703,300 @@ TEST_CASE(AsyncChunkLoader_DestroyWithInFlightJobs) {
 
     CHECK(true);
 }
+
+TEST_CASE(AsyncChunkLoader_ByteLimitEvictsLeastRecentRegions) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_bytes_a");
+    std::vector<BlockID> palette = {BlockRegistry::airId(), testA};
+
+    MemoryContext ctx;
+    auto format = ctx.service.openFormat(ctx.context);
+    const auto& layout = format->regionLayout();
+    std::vector<ChunkCoord> coords = {{0, 0, 0}};
+    while (coords.size() < 3) {
+        ChunkCoord next = coords.back();
+        do {
+            ++next.x;
+        } while (layout.regionForChunk("rigel:default", next) ==
+                 layout.regionForChunk("rigel:default", coords.back()));
+        coords.push_back(next);
+    }
+    for (const ChunkCoord& coord : coords) {
+        saveRegionForPayload(ctx.service, ctx.context, "rigel:default", coord,
+                             buildPayload(coord, registry, palette, false, std::nullopt, true));
+    }
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+    loader.setPrefetchRadius(0);
+    loader.setMaxCachedRegions(0);
+
+    CHECK(loader.request(coords[0]));
+    loader.drainCompletions(1);
+    const size_t oneRegion = loader.cachedBytes();
+    CHECK(oneRegion > 0);
+    CHECK_EQ(loader.cachedRegionCount(), static_cast<size_t>(1));
+
+    // Room for one region but not two.
+    loader.setMaxCachedBytes(oneRegion + oneRegion / 2);
+    for (size_t i = 1; i < coords.size(); ++i) {
+        CHECK(loader.request(coords[i]));
+        loader.drainCompletions(1);
+        CHECK_EQ(loader.cachedRegionCount(), static_cast<size_t>(1));
+        CHECK(loader.cachedBytes() <= oneRegion + oneRegion / 2);
+        CHECK(loader.hasCachedRegion(layout.regionForChunk("rigel:default", coords[i])));
+        CHECK(!loader.hasCachedRegion(layout.regionForChunk("rigel:default", coords[i - 1])));
+        CHECK(world.chunkManager().getChunk(coords[i]) != nullptr);
+    }
+}
+
+TEST_CASE(AsyncChunkLoader_PrefetchFollowsViewerHeading) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    MemoryContext ctx;
+    auto format = ctx.service.openFormat(ctx.context);
+    const auto& layout = format->regionLayout();
+    int regionChunks = 1;
+    while (layout.regionForChunk("rigel:default", ChunkCoord{regionChunks, 0, 0}).x == 0) {
+        ++regionChunks;
+    }
+    const float regionWorld = static_cast<float>(regionChunks * Chunk::SIZE);
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+    loader.setPrefetchRadius(0);
+    loader.updateViewer(glm::vec3(0.0f), 0.0f);
+
+    // One region per half second: two regions per second, so two regions of lookahead.
+    loader.setPrefetchRadius(1);
+    loader.setPrefetchPerRequest(2);
+    loader.updateViewer(glm::vec3(regionWorld + 1.0f, 1.0f, 1.0f), 0.5f);
+    loader.drainCompletions(8);
+
+    RegionKey ahead1 = layout.regionForChunk("rigel:default", ChunkCoord{2 * regionChunks, 0, 0});
+    RegionKey ahead2 = layout.regionForChunk("rigel:default", ChunkCoord{3 * regionChunks, 0, 0});
+    RegionKey behind = layout.regionForChunk("rigel:default", ChunkCoord{0, 0, 0});
+    CHECK(loader.hasCachedRegion(ahead1));
+    CHECK(loader.hasCachedRegion(ahead2));
+    CHECK(!loader.hasCachedRegion(behind));
+    CHECK_EQ(loader.cachedRegionCount(), static_cast<size_t>(2));
+}
+
+TEST_CASE(AsyncChunkLoader_StreamedRegion_AppliesChunksBeforeRegionCompletes) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_stream_a");
+    BlockID testB = registerTestBlock(registry, "rigel:test_stream_b");
+    std::vector<BlockID> palette = {BlockRegistry::airId(), testA, testB};
+
+    MemoryContext ctx;
+    useCRFormat(ctx, registry, true);
+
+    // Opposite corners of one region: four CR columns each, first and last in file order.
+    const std::vector<ChunkCoord> stored = {{0, 0, 0}, {7, 0, 7}};
+    std::vector<ChunkData> payloads = saveCRChunks(ctx, registry, palette, stored);
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+
+    // Walk +x from region -2 into region -1 so the prefetch picks region 0 first.
+    const float regionWorld = static_cast<float>(8 * Chunk::SIZE);
+    loader.setPrefetchRadius(0);
+    loader.updateViewer(glm::vec3(-2.0f * regionWorld + 1.0f, 1.0f, 1.0f), 0.0f);
+    loader.setPrefetchRadius(1);
+    loader.setPrefetchPerRequest(1);
+    loader.updateViewer(glm::vec3(-regionWorld + 1.0f, 1.0f, 1.0f), 0.5f);
+
+    // Requests inside the prefetched region wait for its frames instead of reading chunks.
+    CHECK(loader.request(stored[0]));
+    CHECK(loader.request(stored[1]));
+
+    // Header plus the first four column frames: enough for the first chunk only.
+    loader.setRegionDrainBudget(5);
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    Chunk* first = world.chunkManager().getChunk(stored[0]);
+    CHECK(first != nullptr);
+    if (first) {
+        verifyPayloadMatches(*first, payloads[0]);
+    }
+    CHECK(world.chunkManager().getChunk(stored[1]) == nullptr);
+    CHECK(loader.isPending(stored[1]));
+    CHECK(!loader.hasCachedRegion(RegionKey{"rigel:default", 0, 0, 0}));
+
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    Chunk* second = world.chunkManager().getChunk(stored[1]);
+    CHECK(second != nullptr);
+    if (second) {
+        verifyPayloadMatches(*second, payloads[1]);
+    }
+    CHECK(!loader.isPending(stored[1]));
+    CHECK(loader.hasCachedRegion(RegionKey{"rigel:default", 0, 0, 0}));
+
+    // Once cached, unstored coords of the region answer immediately.
+    CHECK(!loader.request(ChunkCoord{3, 0, 3}));
+}
+
+TEST_CASE(AsyncChunkLoader_InvalidateRegion_DropsInFlightLoad) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_a");
+    BlockID testB = registerTestBlock(registry, "rigel:test_b");
+    const std::vector<BlockID> before = {BlockRegistry::airId(), testA, testB};
+    const std::vector<BlockID> after = {testB, testA, BlockRegistry::airId()};
+
+    ChunkCoord coord{0, 0, 0};
+    MemoryContext ctx;
+    saveRegionForPayload(ctx.service, ctx.context, "rigel:default", coord,
+                         buildPayload(coord, registry, before, false, std::nullopt, false));
+
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+
+    // Without IO threads the load runs inside request(); its result waits in the queue.
+    CHECK(loader.request(coord));
+
+    ChunkData rewritten = buildPayload(coord, registry, after, false, std::nullopt, false);
+    saveRegionForPayload(ctx.service, ctx.context, "rigel:default", coord, rewritten);
+    auto format = ctx.service.openFormat(ctx.context);
+    loader.invalidateRegion(format->regionLayout().regionForChunk("rigel:default", coord));
+
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    Chunk* loaded = world.chunkManager().getChunk(coord);
+    CHECK(loaded != nullptr);
+    if (loaded) {
+        verifyPayloadMatches(*loaded, rewritten);
+    }
+    CHECK(!loader.isPending(coord));
+}
+
+TEST_CASE(AsyncChunkLoader_InvalidateRegion_DropsInFlightStreamsAndChunkReads) {
+    WorldResources resources;
+    World world;
+    world.initialize(resources);
+    auto& registry = resources.registry();
+
+    auto generator = makeGenerator(registry);
+    world.setGenerator(generator);
+
+    BlockID testA = registerTestBlock(registry, "rigel:test_stream_a");
+    BlockID testB = registerTestBlock(registry, "rigel:test_stream_b");
+    const std::vector<BlockID> before = {BlockRegistry::airId(), testA, testB};
+    const std::vector<BlockID> after = {testB, testA, BlockRegistry::airId()};
+
+    MemoryContext ctx;
+    useCRFormat(ctx, registry, false);
+    const std::vector<ChunkCoord> stored = {{0, 0, 0}, {7, 0, 7}};
+    const RegionKey region{"rigel:default", 0, 0, 0};
+
+    // A chunk read of the old file, then the whole region streaming in as a prefetch.
+    {
+        saveCRChunks(ctx, registry, before, stored);
+        AsyncChunkLoader loader(
+            ctx.service,
+            ctx.context,
+            world,
+            generator->config().world.version,
+            0,
+            0,
+            1,
+            generator);
+        CHECK(loader.request(stored[0]));
+
+        std::vector<ChunkData> rewritten = saveCRChunks(ctx, registry, after, stored);
+        loader.invalidateRegion(region);
+        loader.drainCompletions(std::numeric_limits<size_t>::max());
+        Chunk* loaded = world.chunkManager().getChunk(stored[0]);
+        CHECK(loaded != nullptr);
+        if (loaded) {
+            verifyPayloadMatches(*loaded, rewritten[0]);
+        }
+        CHECK(!loader.isPending(stored[0]));
+    }
+
+    world.chunkManager().unloadChunk(stored[0]);
+    saveCRChunks(ctx, registry, before, stored);
+    AsyncChunkLoader loader(
+        ctx.service,
+        ctx.context,
+        world,
+        generator->config().world.version,
+        0,
+        0,
+        1,
+        generator);
+    const float regionWorld = static_cast<float>(8 * Chunk::SIZE);
+    loader.setPrefetchRadius(0);
+    loader.updateViewer(glm::vec3(-2.0f * regionWorld + 1.0f, 1.0f, 1.0f), 0.0f);
+    loader.setPrefetchRadius(1);
+    loader.setPrefetchPerRequest(1);
+    loader.updateViewer(glm::vec3(-regionWorld + 1.0f, 1.0f, 1.0f), 0.5f);
+    CHECK(loader.request(stored[0]));
+    CHECK(loader.request(stored[1]));
+
+    // The old file's header and frames are queued; the reissued load follows them.
+    std::vector<ChunkData> rewritten = saveCRChunks(ctx, registry, after, stored);
+    loader.invalidateRegion(region);
+    loader.drainCompletions(std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < stored.size(); ++i) {
+        Chunk* loaded = world.chunkManager().getChunk(stored[i]);
+        CHECK(loaded != nullptr);
+        if (loaded) {
+            verifyPayloadMatches(*loaded, rewritten[i]);
+        }
+        CHECK(!loader.isPending(stored[i]));
+    }
+    CHECK(loader.hasCachedRegion(region));
+}
@@ -5,6 +5,10 @@
 #include "Rigel/Voxel/BlockRegistry.h"
 #include "Rigel/Voxel/BlockType.h"
 
+#include <algorithm>
+#include <span>
+#include <vector>
+
 using namespace Rigel::Voxel;
 using namespace Rigel::Persistence;
 
@@ -145,3 +149,79 @@ TEST_CASE(ChunkSpanMerge_EmptySpansNoOp) {
     CHECK(!result.loadedFromDisk);
     CHECK(!baseCalled);
 }
+
+TEST_CASE(ChunkSpanMerge_SlabsCoveringChunkSkipBaseFill) {
+    BlockRegistry registry;
+    BlockID lowerId = registerBlock(registry, "test:lower");
+    BlockID upperId = registerBlock(registry, "test:upper");
+
+    ChunkCoord coord{0, 0, 0};
+    ChunkSpan lower;
+    lower.sizeX = Chunk::SIZE;
+    lower.sizeY = Chunk::SIZE / 2;
+    lower.sizeZ = Chunk::SIZE;
+    ChunkSpan upper = lower;
+    upper.offsetY = Chunk::SIZE / 2;
+
+    ChunkSnapshot lowerSnapshot = makeSnapshot(coord, lower, registry, lowerId);
+    ChunkSnapshot upperSnapshot = makeSnapshot(coord, upper, registry, upperId);
+    std::vector<const ChunkSnapshot*> spans = {&lowerSnapshot, &upperSnapshot};
+
+    bool baseCalled = false;
+    std::vector<BlockState> blocks(Chunk::VOLUME);
+    ChunkSpanMergeResult result = mergeChunkSpans(
+        std::span<BlockState>(blocks), spans,
+        [&](std::span<BlockState>) { baseCalled = true; });
+
+    CHECK(result.loadedFromDisk);
+    CHECK(!result.fullSpan);
+    CHECK(result.fullyCovered);
+    CHECK(!baseCalled);
+    CHECK_EQ(blocks[static_cast<size_t>(3 + 2 * Chunk::SIZE + 5 * Chunk::SIZE * Chunk::SIZE)].id, lowerId);
+    CHECK_EQ(blocks[static_cast<size_t>(3 + 20 * Chunk::SIZE + 5 * Chunk::SIZE * Chunk::SIZE)].id, upperId);
+}
+
+TEST_CASE(ChunkSpanMerge_DenseMergeMatchesChunkMerge) {
+    BlockRegistry registry;
+    BlockID baseId = registerBlock(registry, "test:base");
+    BlockID diskId = registerBlock(registry, "test:disk");
+
+    ChunkCoord coord{1, -2, 3};
+    ChunkSpan span;
+    span.chunkX = coord.x;
+    span.chunkY = coord.y;
+    span.chunkZ = coord.z;
+    span.offsetX = Chunk::SUBCHUNK_SIZE;
+    span.offsetY = 4;
+    span.offsetZ = 0;
+    span.sizeX = Chunk::SUBCHUNK_SIZE;
+    span.sizeY = 10;
+    span.sizeZ = Chunk::SIZE;
+    ChunkSnapshot snapshot = makeSnapshot(coord, span, registry, diskId);
+    std::vector<const ChunkSnapshot*> spans = {&snapshot};
+
+    Chunk chunk(coord);
+    ChunkSpanMergeResult chunkResult = mergeChunkSpans(
+        chunk, registry, spans,
+        [&](Chunk& target, const BlockRegistry& reg) {
+            BlockState state;
+            state.id = baseId;
+            target.fill(state, reg);
+        });
+
+    std::vector<BlockState> blocks(Chunk::VOLUME);
+    ChunkSpanMergeResult denseResult = mergeChunkSpans(
+        std::span<BlockState>(blocks), spans,
+        [&](std::span<BlockState> target) {
+            BlockState state;
+            state.id = baseId;
+            std::fill(target.begin(), target.end(), state);
+        });
+
+    CHECK(chunkResult.appliedBase);
+    CHECK(denseResult.appliedBase);
+    CHECK(!denseResult.fullyCovered);
+    std::vector<BlockState> expected(Chunk::VOLUME);
+    chunk.copyBlocks(expected);
+    CHECK(blocks == expected);
+}
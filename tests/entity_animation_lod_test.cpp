@@ -0,0 +1,76 @@
+#include "TestFramework.h"
+
+#include "Rigel/Entity/EntityAnimationLod.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <limits>
+#include <vector>
+
+using namespace Rigel::Entity;
+
+namespace {
+
+bool sameMatrix(const glm::mat4& a, const glm::mat4& b) {
+    for (int column = 0; column < 4; ++column) {
+        if (glm::length(a[column] - b[column]) > 1e-6f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(EntityAnimationLod_SelectsTierByDistance) {
+    Rigel::Voxel::EntityAnimationLodConfig config;
+    config.enabled = true;
+
+    EntityAnimationLod full = selectAnimationLod(config, 10.0f);
+    CHECK_EQ(full.updateInterval, 1u);
+    CHECK_EQ(full.maxAnimations, std::numeric_limits<size_t>::max());
+
+    EntityAnimationLod reduced = selectAnimationLod(config, 40.0f);
+    CHECK_EQ(reduced.updateInterval, static_cast<uint32_t>(config.reducedInterval));
+    CHECK_EQ(reduced.maxAnimations, static_cast<size_t>(config.reducedMaxAnimations));
+
+    EntityAnimationLod low = selectAnimationLod(config, 100.0f);
+    CHECK_EQ(low.updateInterval, static_cast<uint32_t>(config.lowInterval));
+    CHECK_EQ(low.maxAnimations, static_cast<size_t>(config.lowMaxAnimations));
+
+    EntityAnimationLod frozen = selectAnimationLod(config, 500.0f);
+    CHECK_EQ(frozen.updateInterval, 0u);
+    CHECK_EQ(frozen.maxAnimations, static_cast<size_t>(config.lowMaxAnimations));
+
+    config.enabled = false;
+    EntityAnimationLod disabled = selectAnimationLod(config, 500.0f);
+    CHECK_EQ(disabled.updateInterval, 1u);
+    CHECK_EQ(disabled.maxAnimations, std::numeric_limits<size_t>::max());
+}
+
+TEST_CASE(EntityAnimationLod_BlendPalettesInterpolates) {
+    const std::vector<glm::mat4> from = {
+        glm::mat4(1.0f),
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, 0.0f)),
+    };
+    const std::vector<glm::mat4> to = {
+        glm::translate(glm::mat4(1.0f), glm::vec3(4.0f, 0.0f, 0.0f)),
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 6.0f, -2.0f)),
+    };
+    std::vector<glm::mat4> out(2);
+
+    blendPalettes(from, to, 0.0f, out);
+    CHECK(sameMatrix(out[0], from[0]));
+    CHECK(sameMatrix(out[1], from[1]));
+
+    blendPalettes(from, to, 1.0f, out);
+    CHECK(sameMatrix(out[0], to[0]));
+    CHECK(sameMatrix(out[1], to[1]));
+
+    blendPalettes(from, to, 0.5f, out);
+    CHECK_NEAR(out[0][3].x, 2.0f, 1e-6f);
+    CHECK_NEAR(out[1][3].y, 4.0f, 1e-6f);
+    CHECK_NEAR(out[1][3].z, -1.0f, 1e-6f);
+    CHECK_NEAR(out[1][1].y, 1.0f, 1e-6f);
+}
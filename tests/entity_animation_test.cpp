@@ -5,6 +5,10 @@
 #include "Rigel/Entity/EntityModelLoader.h"
 #include "Rigel/Entity/EntityAnimation.h"
 
+#include <iterator>
+#include <memory>
+#include <vector>
+
 using namespace Rigel::Asset;
 using namespace Rigel::Entity;
 
@@ -27,3 +31,50 @@ TEST_CASE(EntityAnimation_Advances) {
     CHECK(rot.y > 100.0f);
     CHECK(rot.y < 260.0f);
 }
+
+TEST_CASE(EntityAnimation_CursorSamplingMatchesSearch) {
+    EntityAnimationTrack track;
+    const float times[] = {0.0f, 0.1f, 0.25f, 0.25f, 0.4f, 0.8f, 1.0f};
+    for (size_t i = 0; i < std::size(times); ++i) {
+        track.keys.push_back({times[i], glm::vec3(static_cast<float>(i), static_cast<float>(i * i), 1.0f)});
+    }
+
+    EntityTrackCursor cursor;
+    // Forward playback across two loops, then a backwards jump.
+    for (int step = 0; step < 130; ++step) {
+        float time = static_cast<float>(step) * 0.017f;
+        glm::vec3 expected = track.sample(time, true, 1.2f, glm::vec3(0.0f));
+        glm::vec3 actual = track.sample(time, true, 1.2f, glm::vec3(0.0f), cursor);
+        CHECK(actual == expected);
+    }
+    glm::vec3 rewound = track.sample(0.3f, false, 1.2f, glm::vec3(0.0f), cursor);
+    CHECK(rewound == track.sample(0.3f, false, 1.2f, glm::vec3(0.0f)));
+    CHECK_EQ(cursor.key, static_cast<uint32_t>(3));
+}
+
+TEST_CASE(EntityAnimation_ClipResolvesBonesByIndex) {
+    auto animations = std::make_shared<EntityAnimationSetAsset>();
+    EntityAnimation& walk = animations->set.animations["walk"];
+    walk.bones["leg"].rotation.keys.push_back({0.0f, glm::vec3(10.0f, 0.0f, 0.0f)});
+    walk.bones["head"].position.keys.push_back({0.0f, glm::vec3(0.0f, 1.0f, 0.0f)});
+    walk.bones["tail"].scale.keys.push_back({0.0f, glm::vec3(2.0f)});
+
+    EntityModelAsset model;
+    model.bones.resize(3);
+    model.bones[0].name = "head";
+    model.bones[1].name = "body";
+    model.bones[2].name = "leg";
+    model.animationSet = Handle<EntityAnimationSetAsset>(animations, "entity_anims/test_walk");
+    model.compileAnimationClips();
+
+    const EntityAnimationClip* clip = model.findClip(&walk);
+    CHECK(clip != nullptr);
+    CHECK(clip->animation == &walk);
+    CHECK_EQ(clip->bones.size(), static_cast<size_t>(3));
+    CHECK(clip->bones[0] == walk.findBone("head"));
+    CHECK(clip->bones[1] == nullptr);
+    CHECK(clip->bones[2] == walk.findBone("leg"));
+
+    EntityAnimation other;
+    CHECK(model.findClip(&other) == nullptr);
+}
@@ -17,3 +17,26 @@ TEST_CASE(EntityChunk_AddRemove) {
     chunk.removeEntity(&entity);
     CHECK(!chunk.contains(&entity));
 }
+
+TEST_CASE(EntityChunk_SwapRemoveKeepsOthersIndexed) {
+    Entity a("rigel:test_entity");
+    Entity b("rigel:test_entity");
+    Entity c("rigel:test_entity");
+    EntityChunk chunk(Rigel::Voxel::ChunkCoord{0, 0, 0});
+    chunk.addEntity(&a);
+    chunk.addEntity(&b);
+    chunk.addEntity(&c);
+    chunk.addEntity(&b);
+    CHECK_EQ(chunk.entities().size(), static_cast<size_t>(3));
+
+    chunk.removeEntity(&a);
+    CHECK(!chunk.contains(&a));
+    CHECK(chunk.contains(&b));
+    CHECK(chunk.contains(&c));
+    CHECK_EQ(chunk.entities()[c.chunkSlot()], &c);
+
+    chunk.removeEntity(&c);
+    chunk.removeEntity(&c);
+    CHECK_EQ(chunk.entities().size(), static_cast<size_t>(1));
+    CHECK_EQ(chunk.entities()[b.chunkSlot()], &b);
+}
@@ -4,6 +4,11 @@
 #include "Rigel/Asset/DefinitionRegistry.h"
 #include "Rigel/Entity/EntityPersistence.h"
 
+#include <algorithm>
+#include <span>
+#include <string>
+#include <vector>
+
 using namespace Rigel::Entity;
 using Rigel::Voxel::ChunkCoord;
 namespace AssetIR = Rigel::Asset::IR;
@@ -111,3 +116,72 @@ TEST_CASE(EntityPersistence_RoundTrip_CompatibleWithEntityDefinitionRegistryIds)
     CHECK_EQ(decoded[0].entities[0].modelId, interceptorDef->modelRef);
     CHECK(entityTypes.find(decoded[0].entities[0].typeId) != nullptr);
 }
+
+namespace {
+
+std::vector<EntityPersistedChunk> makeCrowdedChunks() {
+    const char* types[] = {"rigel:item", "rigel:cow", "rigel:chicken"};
+    const char* models[] = {"", "entity_models/cow", "entity_models/chicken"};
+    std::vector<EntityPersistedChunk> chunks;
+    uint32_t counter = 1;
+    for (int c = 0; c < 3; ++c) {
+        EntityPersistedChunk chunk;
+        chunk.coord = ChunkCoord{c, -1, 2 * c};
+        for (int i = 0; i < 200; ++i) {
+            EntityPersistedEntity entity;
+            entity.typeId = types[(i + c) % 3];
+            entity.modelId = models[(i + c) % 3];
+            entity.id = EntityId{1000u + static_cast<uint64_t>(i), 77u, counter++};
+            entity.position = glm::vec3(static_cast<float>(i) * 0.25f, -3.5f, static_cast<float>(c));
+            entity.velocity = glm::vec3(0.0f, static_cast<float>(i % 7) - 3.0f, 0.125f);
+            entity.viewDirection = glm::vec3(1.0f, 0.0f, 0.0f);
+            chunk.entities.push_back(entity);
+        }
+        chunks.push_back(chunk);
+    }
+    chunks.push_back(EntityPersistedChunk{ChunkCoord{9, 9, 9}, {}});
+    return chunks;
+}
+
+size_t countOccurrences(const std::vector<uint8_t>& payload, const std::string& text) {
+    size_t count = 0;
+    auto it = payload.begin();
+    while ((it = std::search(it, payload.end(), text.begin(), text.end())) != payload.end()) {
+        ++count;
+        ++it;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE(EntityPersistence_RegionTablesStoreStringsOnce) {
+    const std::vector<EntityPersistedChunk> chunks = makeCrowdedChunks();
+    const std::vector<uint8_t> payload = encodeEntityRegionPayload(chunks);
+    const std::vector<uint8_t> inlinePayload = detail::encodeEntityRegionPayloadInline(chunks);
+
+    CHECK_EQ(countOccurrences(payload, "rigel:chicken"), static_cast<size_t>(1));
+    CHECK_EQ(countOccurrences(payload, "entity_models/cow"), static_cast<size_t>(1));
+    CHECK(payload.size() < inlinePayload.size());
+
+    std::vector<EntityPersistedChunk> decoded;
+    CHECK(decodeEntityRegionPayload(payload, decoded));
+    CHECK(decoded == chunks);
+}
+
+TEST_CASE(EntityPersistence_DecodesInlineVersion) {
+    const std::vector<EntityPersistedChunk> chunks = makeCrowdedChunks();
+    std::vector<EntityPersistedChunk> decoded;
+    CHECK(decodeEntityRegionPayload(detail::encodeEntityRegionPayloadInline(chunks), decoded));
+    CHECK(decoded == chunks);
+}
+
+TEST_CASE(EntityPersistence_RejectsTruncatedPayload) {
+    const std::vector<EntityPersistedChunk> chunks = makeCrowdedChunks();
+    const std::vector<uint8_t> payload = encodeEntityRegionPayload(chunks);
+    std::vector<EntityPersistedChunk> decoded;
+    for (size_t length = 0; length < payload.size(); length += 7) {
+        CHECK(!decodeEntityRegionPayload(std::span<const uint8_t>(payload.data(), length), decoded));
+    }
+    CHECK(!decodeEntityRegionPayload(std::span<const uint8_t>(payload.data(), payload.size() - 1), decoded));
+}
@@ -1,10 +1,13 @@
 #include "TestFramework.h"
 
 #include "Rigel/Entity/Entity.h"
+#include "Rigel/Entity/VoxelCollision.h"
 #include "Rigel/Voxel/World.h"
 #include "Rigel/Voxel/WorldResources.h"
 #include "Rigel/Voxel/BlockType.h"
 
+#include <cmath>
+
 using namespace Rigel::Entity;
 using namespace Rigel::Voxel;
 
@@ -33,3 +36,90 @@ TEST_CASE(EntityPhysics_FloorCollision) {
     CHECK(entity.position().y >= 1.35f);
     CHECK(entity.position().y <= 1.45f);
 }
+
+TEST_CASE(EntityPhysics_FastFallStopsOnThinFloor) {
+    WorldResources resources;
+    World world(resources);
+
+    BlockType solid;
+    solid.identifier = "rigel:stone";
+    solid.isSolid = true;
+    auto solidId = resources.registry().registerBlock(solid.identifier, solid);
+    for (int x = -2; x <= 2; ++x) {
+        for (int z = -2; z <= 2; ++z) {
+            world.setBlock(x, 0, z, BlockState{solidId});
+        }
+    }
+
+    Entity entity("rigel:test_entity");
+    entity.setLocalBounds(Aabb{glm::vec3(-0.4f), glm::vec3(0.4f)});
+    entity.setPosition(0.0f, 40.0f, 0.0f);
+    // One step covers ~45 blocks; checking only the destination box would skip the floor.
+    entity.setVelocity(glm::vec3(0.0f, -900.0f, 0.0f));
+    entity.update(world, 1.0f / 20.0f);
+
+    CHECK(entity.collidedY());
+    CHECK(entity.isOnGround());
+    CHECK(entity.position().y >= 1.35f);
+    CHECK(entity.position().y <= 1.45f);
+}
+
+TEST_CASE(VoxelCollisionQuery_MatchesWorldLookups) {
+    WorldResources resources;
+    World world(resources);
+
+    BlockType solid;
+    solid.identifier = "rigel:stone";
+    solid.isSolid = true;
+    auto solidId = resources.registry().registerBlock(solid.identifier, solid);
+    BlockType grass;
+    grass.identifier = "rigel:tall_grass";
+    grass.isSolid = false;
+    auto grassId = resources.registry().registerBlock(grass.identifier, grass);
+
+    for (int i = 0; i < 400; ++i) {
+        int x = (i * 37) % 71 - 35;
+        int y = (i * 53) % 67 - 33;
+        int z = (i * 19) % 61 - 30;
+        world.setBlock(x, y, z, BlockState{(i % 3 == 0) ? grassId : solidId});
+    }
+
+    VoxelCollisionQuery query(world, Aabb{glm::vec3(-20.0f), glm::vec3(20.0f)});
+    for (int x = -36; x <= 36; ++x) {
+        for (int y = -34; y <= 34; ++y) {
+            for (int z = -31; z <= 31; ++z) {
+                const bool expected = resources.registry().getType(world.getBlock(x, y, z).id).isSolid;
+                CHECK_EQ(query.isSolid(x, y, z), expected);
+            }
+        }
+    }
+}
+
+TEST_CASE(VoxelCollisionQuery_SweepStopsAtFirstSolidLayer) {
+    WorldResources resources;
+    World world(resources);
+
+    BlockType solid;
+    solid.identifier = "rigel:stone";
+    solid.isSolid = true;
+    auto solidId = resources.registry().registerBlock(solid.identifier, solid);
+    world.setBlock(5, 0, 0, BlockState{solidId});
+    world.setBlock(9, 0, 0, BlockState{solidId});
+    world.setBlock(-4, 0, 0, BlockState{solidId});
+
+    VoxelCollisionQuery query(world, Aabb{glm::vec3(-16.0f), glm::vec3(16.0f)});
+    const Aabb box{glm::vec3(0.1f, 0.1f, 0.1f), glm::vec3(0.9f, 0.9f, 0.9f)};
+
+    bool hit = false;
+    float moved = query.sweep(box, Axis::X, 20.0f, hit);
+    CHECK(hit);
+    CHECK(std::abs(box.max.x + moved - 5.0f) < 1.0e-3f);
+
+    moved = query.sweep(box, Axis::X, -20.0f, hit);
+    CHECK(hit);
+    CHECK(std::abs(box.min.x + moved + 3.0f) < 1.0e-3f);
+
+    moved = query.sweep(box, Axis::Y, 3.0f, hit);
+    CHECK(!hit);
+    CHECK_EQ(moved, 3.0f);
+}
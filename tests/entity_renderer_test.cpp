@@ -2,10 +2,20 @@
 
 #include "Rigel/Entity/EntityRenderer.h"
 #include "Rigel/Entity/Aabb.h"
+#include "Rigel/Entity/EntityModel.h"
+#include "Rigel/Entity/WorldEntities.h"
+#include "Rigel/Voxel/World.h"
+#include "Rigel/Voxel/WorldResources.h"
 
 #include <glm/mat4x4.hpp>
 
+#include <memory>
+#include <vector>
+
 using namespace Rigel::Entity;
+using Rigel::Asset::Handle;
+using Rigel::Voxel::World;
+using Rigel::Voxel::WorldResources;
 
 TEST_CASE(EntityRenderer_CullsOutsideFrustum) {
     Aabb inside;
@@ -21,3 +31,51 @@ TEST_CASE(EntityRenderer_CullsOutsideFrustum) {
     CHECK(EntityRenderer::isVisible(inside, viewProjection));
     CHECK(!EntityRenderer::isVisible(outside, viewProjection));
 }
+
+TEST_CASE(EntityRenderer_DrawListCullsAndGroupsByModel) {
+    WorldResources resources;
+    World world(resources);
+
+    auto modelA = std::make_shared<EntityModelAsset>();
+    auto modelB = std::make_shared<EntityModelAsset>();
+    const Handle<EntityModelAsset> handleA(modelA, "entity_models/a");
+    const Handle<EntityModelAsset> handleB(modelB, "entity_models/b");
+
+    // Alternate models so grouping has to reorder; every third entity is off-screen.
+    std::vector<EntityId> expectedCulled;
+    for (int i = 0; i < 12; ++i) {
+        auto entity = std::make_unique<Entity>("rigel:test_entity");
+        entity->setModel(i % 2 == 0 ? handleA : handleB);
+        entity->setLocalBounds(Aabb{glm::vec3(-0.05f), glm::vec3(0.05f)});
+        const float x = (i % 3 == 2) ? 5.0f : -0.8f + 0.1f * static_cast<float>(i);
+        entity->setPosition(x, 0.0f, 0.0f);
+        EntityId id = world.entities().spawn(std::move(entity));
+        if (i % 3 == 2) {
+            expectedCulled.push_back(id);
+        }
+    }
+
+    EntityDrawList list;
+    EntityRenderer::buildDrawList(world.entities(), glm::mat4(1.0f), list);
+
+    CHECK_EQ(list.culled.size(), expectedCulled.size());
+    for (size_t i = 0; i < list.culled.size(); ++i) {
+        CHECK(list.culled[i]->id() == expectedCulled[i]);
+    }
+    CHECK_EQ(list.visible.size(), static_cast<size_t>(8));
+    CHECK_EQ(list.batches.size(), static_cast<size_t>(2));
+
+    size_t covered = 0;
+    for (const EntityDrawList::Batch& batch : list.batches) {
+        CHECK_EQ(batch.first, covered);
+        CHECK_EQ(batch.count, static_cast<size_t>(4));
+        for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+            CHECK(list.visible[i].entity->model().get() == batch.model);
+            CHECK(list.visible[i].model == batch.model);
+            CHECK_EQ(list.visible[i].animationKey, batch.animationKey);
+            CHECK(list.visible[i].modelMatrix[3][0] == list.visible[i].entity->position().x);
+        }
+        covered += batch.count;
+    }
+    CHECK(list.batches[0].model != list.batches[1].model);
+}
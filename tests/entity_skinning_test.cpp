@@ -0,0 +1,162 @@
+#include "TestFramework.h"
+
+#include "Rigel/Entity/EntityModel.h"
+#include "Rigel/Entity/EntityModelInstance.h"
+#include "Rigel/Entity/EntitySkinning.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace Rigel::Entity;
+using Rigel::Asset::Handle;
+using TextureMap = std::unordered_map<std::string, Handle<Rigel::Asset::TextureAsset>>;
+
+namespace {
+
+EntityModelAsset makeSkinTestModel() {
+    EntityModelAsset model;
+    model.texWidth = 64.0f;
+    model.texHeight = 32.0f;
+    model.bones.resize(3);
+
+    model.bones[0].name = "body";
+    EntityModelCube body;
+    body.origin = glm::vec3(-4.0f, 0.0f, -2.0f);
+    body.size = glm::vec3(8.0f, 12.0f, 4.0f);
+    body.uv = glm::vec2(16.0f, 16.0f);
+    body.hasUv = true;
+    model.bones[0].cubes.push_back(body);
+
+    model.bones[1].name = "head";
+    model.bones[1].parentIndex = 0;
+    EntityModelCube head;
+    head.origin = glm::vec3(-4.0f, 12.0f, -4.0f);
+    head.size = glm::vec3(8.0f);
+    head.inflate = 0.5f;
+    head.pivot = glm::vec3(0.0f, 12.0f, 0.0f);
+    head.rotation = glm::vec3(10.0f, 25.0f, -5.0f);
+    head.hasUv = true;
+    head.mirror = true;
+    model.bones[1].cubes.push_back(head);
+
+    model.bones[2].name = "arm";
+    model.bones[2].parentIndex = 0;
+    EntityModelCube arm;
+    arm.origin = glm::vec3(4.0f, 0.0f, -2.0f);
+    arm.size = glm::vec3(4.0f, 12.0f, 4.0f);
+    model.bones[2].cubes.push_back(arm);
+    model.bones[2].cubes.push_back(head);
+    return model;
+}
+
+std::vector<glm::mat4> makePalette(float phase) {
+    glm::mat4 body = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, phase, -1.0f));
+    body = glm::scale(body, glm::vec3(1.0f, 1.2f, 0.9f));
+    glm::mat4 head = glm::rotate(body, glm::radians(30.0f + phase * 10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 arm = glm::rotate(body, glm::radians(-45.0f * phase), glm::vec3(1.0f, 0.0f, 0.0f));
+    arm = glm::translate(arm, glm::vec3(0.0f, -phase, 0.0f));
+    return {body, head, arm};
+}
+
+bool nearVec(const glm::vec3& a, const glm::vec3& b, float eps) {
+    return glm::length(a - b) <= eps;
+}
+
+} // namespace
+
+TEST_CASE(EntitySkinning_PaletteMatchesRebuiltMesh) {
+    const EntityModelAsset model = makeSkinTestModel();
+    auto mesh = buildSkinMesh(model);
+    CHECK_EQ(mesh->boneCount, static_cast<size_t>(3));
+    CHECK_EQ(mesh->vertices.size(), static_cast<size_t>(4 * 36));
+
+    for (float phase : {0.0f, 0.35f, 1.5f}) {
+        const std::vector<glm::mat4> palette = makePalette(phase);
+        std::vector<EntitySkinVertex> reference;
+        detail::buildPosedMesh(model, palette, reference);
+        std::vector<EntitySkinVertex> skinned(mesh->vertices.size());
+        skinMesh(*mesh, palette, skinned.data());
+
+        CHECK_EQ(skinned.size(), reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            CHECK(nearVec(skinned[i].position, reference[i].position, 1e-4f));
+            CHECK(nearVec(skinned[i].normal, reference[i].normal, 1e-4f));
+            CHECK(skinned[i].uv == reference[i].uv);
+            CHECK_EQ(skinned[i].bone, reference[i].bone);
+        }
+    }
+}
+
+TEST_CASE(EntitySkinning_BatchMatchesPerInstance) {
+    const EntityModelAsset model = makeSkinTestModel();
+    auto mesh = buildSkinMesh(model);
+    const size_t vertexCount = mesh->vertices.size();
+
+    constexpr size_t kInstances = 5;
+    std::vector<glm::mat4> palettes;
+    for (size_t i = 0; i < kInstances; ++i) {
+        std::vector<glm::mat4> palette = makePalette(static_cast<float>(i) * 0.4f);
+        palettes.insert(palettes.end(), palette.begin(), palette.end());
+    }
+
+    std::vector<EntitySkinVertex> batch(vertexCount * kInstances);
+    skinMeshBatch(*mesh, palettes, kInstances, batch.data());
+
+    std::vector<EntitySkinVertex> single(vertexCount);
+    for (size_t i = 0; i < kInstances; ++i) {
+        skinMesh(*mesh, std::span<const glm::mat4>(palettes).subspan(i * 3, 3), single.data());
+        for (size_t v = 0; v < vertexCount; ++v) {
+            CHECK(batch[i * vertexCount + v].position == single[v].position);
+            CHECK(batch[i * vertexCount + v].normal == single[v].normal);
+        }
+    }
+
+    CHECK_THROWS(skinMeshBatch(*mesh, palettes, kInstances + 1, batch.data()));
+}
+
+TEST_CASE(EntitySkinning_PoseBatchMatchesSinglePoses) {
+    auto animations = std::make_shared<EntityAnimationSetAsset>();
+    EntityAnimation& wave = animations->set.animations["wave"];
+    wave.duration = 2.0f;
+    wave.bones["arm"].rotation.keys = {{0.0f, glm::vec3(0.0f)}, {2.0f, glm::vec3(180.0f, 0.0f, 0.0f)}};
+    wave.bones["head"].position.keys = {{0.0f, glm::vec3(0.0f)}, {2.0f, glm::vec3(0.0f, 4.0f, 0.0f)}};
+
+    auto model = std::make_shared<EntityModelAsset>(makeSkinTestModel());
+    model->animationSet = Handle<EntityAnimationSetAsset>(animations, "entity_anims/test_wave");
+    model->compileAnimationClips();
+    model->skinMesh = buildSkinMesh(*model);
+
+    // No shader, so every instance skins on the CPU; each is a different time into the clip.
+    constexpr size_t kInstances = 4;
+    std::vector<std::unique_ptr<EntityModelInstance>> batched;
+    std::vector<std::unique_ptr<EntityModelInstance>> single;
+    std::vector<EntityModelInstance*> batch;
+    for (size_t i = 0; i < kInstances; ++i) {
+        EntityRenderContext ctx;
+        ctx.deltaTime = 0.3f * static_cast<float>(i + 1);
+        for (auto* list : {&batched, &single}) {
+            list->push_back(std::make_unique<EntityModelInstance>(model, Handle<Rigel::Asset::ShaderAsset>{}, TextureMap{}));
+            list->back()->addAnimation("wave");
+            list->back()->advance(ctx, glm::mat4(1.0f));
+        }
+        batch.push_back(batched.back().get());
+        EntityModelInstance* alone = single.back().get();
+        EntityModelInstance::poseBatch(std::span<EntityModelInstance* const>(&alone, 1));
+    }
+    EntityModelInstance::poseBatch(batch);
+
+    for (size_t i = 0; i < kInstances; ++i) {
+        const std::vector<EntitySkinVertex>& expected = single[i]->cpuVertices();
+        const std::vector<EntitySkinVertex>& actual = batched[i]->cpuVertices();
+        CHECK_EQ(expected.size(), model->skinMesh->vertices.size());
+        CHECK_EQ(actual.size(), expected.size());
+        for (size_t v = 0; v < expected.size() && v < actual.size(); ++v) {
+            CHECK(actual[v].position == expected[v].position);
+            CHECK(actual[v].normal == expected[v].normal);
+        }
+    }
+    CHECK(!(batched[0]->cpuVertices().back().position == batched[1]->cpuVertices().back().position));
+}
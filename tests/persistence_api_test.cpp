@@ -2,6 +2,7 @@
 
 #include "Rigel/Persistence/PersistenceService.h"
 #include "Rigel/Persistence/Backends/Memory/MemoryFormat.h"
+#include "Rigel/Persistence/Providers.h"
 #include "Rigel/Persistence/Storage.h"
 #include "Rigel/Voxel/Block.h"
 
@@ -427,6 +428,34 @@ TEST_CASE(Persistence_RegionRoundTrip) {
     CHECK_EQ(loaded.chunks[0], chunk);
 }
 
+TEST_CASE(Persistence_SharedFormatReleasedWithItsOwners) {
+    FormatRegistry registry;
+    registry.registerFormat(Backends::Memory::descriptor(), Backends::Memory::factory(), Backends::Memory::probe());
+    PersistenceService service(registry);
+
+    PersistenceContext context;
+    context.rootPath = "root";
+    context.preferredFormat = "memory";
+    context.storage = std::make_shared<InMemoryStorageBackend>();
+    context.providers = std::make_shared<ProviderRegistry>();
+
+    auto first = service.sharedFormat(context);
+    CHECK(first == service.sharedFormat(context));
+
+    // A registry created after the old one died must not inherit its cached format,
+    // even if it lands at the same address.
+    context.providers = std::make_shared<ProviderRegistry>();
+    auto second = service.sharedFormat(context);
+    CHECK(second != first);
+
+    service.releaseWorldFormats(context.providers);
+    auto third = service.sharedFormat(context);
+    CHECK(third != second);
+
+    service.releaseStorageFormats(context.storage);
+    CHECK(service.sharedFormat(context) != third);
+}
+
 TEST_CASE(Persistence_EntityRegionRoundTrip) {
     auto storage = std::make_shared<InMemoryStorageBackend>();
 
@@ -271,6 +271,33 @@ std::shared_ptr<ProviderRegistry> makeBlockProviders(const Rigel::Voxel::BlockRe
     return providers;
 }
 
+// Framed (version 6) regions are a per-world opt-in.
+std::shared_ptr<CRPersistenceSettings> enableFramedRegions(ProviderRegistry& providers) {
+    auto settings = std::make_shared<CRPersistenceSettings>();
+    settings->columnFrames = true;
+    providers.add(kCRSettingsProviderId, settings);
+    return settings;
+}
+
+std::vector<uint8_t> readStoredFile(InMemoryStorageBackend& storage, const std::string& path) {
+    auto reader = storage.openRead(path);
+    std::vector<uint8_t> bytes(reader->size());
+    reader->seek(0);
+    if (!bytes.empty()) {
+        reader->readBytes(bytes.data(), bytes.size());
+    }
+    return bytes;
+}
+
+void writeStoredFile(InMemoryStorageBackend& storage, const std::string& path, const std::vector<uint8_t>& bytes) {
+    auto session = storage.openWrite(path, AtomicWriteOptions{});
+    if (!bytes.empty()) {
+        session->writer().writeBytes(bytes.data(), bytes.size());
+    }
+    session->writer().flush();
+    session->commit();
+}
+
 void rewriteIdentifierInRegion(InMemoryStorageBackend& storage,
                                const std::string& path,
                                const std::string& from,
@@ -278,12 +305,7 @@ void rewriteIdentifierInRegion(InMemoryStorageBackend& storage,
     if (from.size() != to.size()) {
         throw std::runtime_error("rewriteIdentifierInRegion: identifier lengths must match");
     }
-    auto reader = storage.openRead(path);
-    std::vector<uint8_t> bytes(reader->size());
-    reader->seek(0);
-    if (!bytes.empty()) {
-        reader->readBytes(bytes.data(), bytes.size());
-    }
+    std::vector<uint8_t> bytes = readStoredFile(storage, path);
 
     const std::vector<uint8_t> fromBytes(from.begin(), from.end());
     const std::vector<uint8_t> toBytes(to.begin(), to.end());
@@ -302,12 +324,31 @@ void rewriteIdentifierInRegion(InMemoryStorageBackend& storage,
         throw std::runtime_error("rewriteIdentifierInRegion: source identifier not found in payload");
     }
 
-    auto session = storage.openWrite(path, AtomicWriteOptions{});
-    if (!bytes.empty()) {
-        session->writer().writeBytes(bytes.data(), bytes.size());
+    writeStoredFile(storage, path, bytes);
+}
+
+int32_t peekI32(const std::vector<uint8_t>& bytes, size_t at) {
+    return static_cast<int32_t>((static_cast<uint32_t>(bytes[at]) << 24) |
+                                (static_cast<uint32_t>(bytes[at + 1]) << 16) |
+                                (static_cast<uint32_t>(bytes[at + 2]) << 8) |
+                                static_cast<uint32_t>(bytes[at + 3]));
+}
+
+void pokeI32(std::vector<uint8_t>& bytes, size_t at, int32_t value) {
+    const auto bits = static_cast<uint32_t>(value);
+    bytes[at] = static_cast<uint8_t>(bits >> 24);
+    bytes[at + 1] = static_cast<uint8_t>(bits >> 16);
+    bytes[at + 2] = static_cast<uint8_t>(bits >> 8);
+    bytes[at + 3] = static_cast<uint8_t>(bits);
+}
+
+std::string loadRegionError(PersistenceService& service, const RegionKey& key, const PersistenceContext& context) {
+    try {
+        service.loadRegion(key, context);
+    } catch (const std::exception& e) {
+        return e.what();
     }
-    session->writer().flush();
-    session->commit();
+    return {};
 }
 
 const CRBinValue& requireField(const CRBinObject& obj, const std::string& name) {
@@ -606,6 +647,454 @@ TEST_CASE(CRBackend_region_roundtrip_lz4) {
     CHECK_EQ(loaded.chunks[0].data, chunk.data);
 }
 
+TEST_CASE(CRBackend_load_region_chunks_reads_requested_columns) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+    Rigel::Voxel::BlockID dirtId = registerOpaqueBlock(registry, "base:dirt");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/random_access";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = makeBlockProviders(registry);
+    enableFramedRegions(*context.providers);
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    const std::vector<ChunkKey> keys = {
+        ChunkKey{"base:earth", 0, 0, 0},
+        ChunkKey{"base:earth", 0, 1, 0},
+        ChunkKey{"base:earth", 3, 0, 5},
+        ChunkKey{"base:earth", 15, 2, 15},
+    };
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ChunkSnapshot chunk;
+        chunk.key = keys[i];
+        chunk.data = makeMinimalChunkData(chunk.key);
+        fillChunkData(chunk.data, (i % 2 == 0) ? stoneId : dirtId, dirtId);
+        region.chunks.push_back(chunk);
+    }
+    service.saveRegion(region, context);
+
+    auto format = service.openFormat(context);
+    CHECK(format->descriptor().capabilities.supportsRandomAccess);
+    ChunkContainer& container = format->chunkContainer();
+
+    auto loaded = container.loadRegionChunks(region.key, {keys[1], keys[3], ChunkKey{"base:earth", 7, 7, 7}});
+    CHECK_EQ(loaded.chunks.size(), static_cast<size_t>(2));
+    std::sort(loaded.chunks.begin(), loaded.chunks.end(),
+              [](const ChunkSnapshot& a, const ChunkSnapshot& b) { return a.key.x < b.key.x; });
+    CHECK_EQ(loaded.chunks[0].key, keys[1]);
+    CHECK_EQ(loaded.chunks[0].data, region.chunks[1].data);
+    CHECK_EQ(loaded.chunks[1].key, keys[3]);
+    CHECK_EQ(loaded.chunks[1].data, region.chunks[3].data);
+
+    auto none = container.loadRegionChunks(region.key, {ChunkKey{"base:earth", 8, 0, 8}});
+    CHECK(none.chunks.empty());
+
+    auto full = service.loadRegion(region.key, context);
+    CHECK_EQ(full.chunks.size(), keys.size());
+}
+
+TEST_CASE(CRBackend_read_region_frames_splits_by_column) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+    Rigel::Voxel::BlockID dirtId = registerOpaqueBlock(registry, "base:dirt");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/region_frames";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = makeBlockProviders(registry);
+    enableFramedRegions(*context.providers);
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    const std::vector<ChunkKey> keys = {
+        ChunkKey{"base:earth", 0, 0, 0},
+        ChunkKey{"base:earth", 0, 1, 0},
+        ChunkKey{"base:earth", 3, 0, 5},
+        ChunkKey{"base:earth", 15, 2, 15},
+    };
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ChunkSnapshot chunk;
+        chunk.key = keys[i];
+        chunk.data = makeMinimalChunkData(chunk.key);
+        fillChunkData(chunk.data, (i % 2 == 0) ? stoneId : dirtId, dirtId);
+        region.chunks.push_back(chunk);
+    }
+    service.saveRegion(region, context);
+
+    auto format = service.openFormat(context);
+    auto frames = format->chunkContainer().readRegionFrames(region.key);
+    CHECK_EQ(frames.size(), static_cast<size_t>(3));
+
+    size_t decoded = 0;
+    for (auto& frame : frames) {
+        CHECK_EQ(frame.keys.size(), static_cast<size_t>(16));
+        for (const auto& chunk : frame.decode()) {
+            CHECK(std::find(frame.keys.begin(), frame.keys.end(), chunk.key) != frame.keys.end());
+            auto it = std::find(keys.begin(), keys.end(), chunk.key);
+            CHECK(it != keys.end());
+            if (it != keys.end()) {
+                CHECK_EQ(chunk.data, region.chunks[static_cast<size_t>(it - keys.begin())].data);
+            }
+            ++decoded;
+        }
+    }
+    CHECK_EQ(decoded, keys.size());
+    CHECK(format->chunkContainer().readRegionFrames(RegionKey{"base:earth", 4, 0, 0}).empty());
+}
+
+TEST_CASE(CRBackend_corrupt_column_frames_are_rejected) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/corrupt_frames";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = makeBlockProviders(registry);
+    auto settings = enableFramedRegions(*context.providers);
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    ChunkSnapshot chunk;
+    chunk.key = ChunkKey{"base:earth", 0, 0, 0};
+    chunk.data = makeMinimalChunkData(chunk.key);
+    fillChunkData(chunk.data, stoneId, stoneId);
+    region.chunks.push_back(chunk);
+
+    // Column 0's frame: stored size, raw size, codec, then (uncompressed) the
+    // chunk count and each chunk's y and record offset.
+    constexpr size_t kColumnTable = 16;
+    constexpr size_t kRecordOffsetField = 9 + 1 + 4;
+    const std::string path = CRPaths::regionPath(region.key, context);
+    service.saveRegion(region, context);
+    const std::vector<uint8_t> original = readStoredFile(*storage, path);
+    const size_t frame = static_cast<size_t>(peekI32(original, kColumnTable));
+    CHECK_EQ(original[frame + 8], static_cast<uint8_t>(0));
+    const int32_t rawSize = peekI32(original, frame + 4);
+
+    for (int32_t recordOffset : {-1, rawSize}) {
+        std::vector<uint8_t> bytes = original;
+        pokeI32(bytes, frame + kRecordOffsetField, recordOffset);
+        writeStoredFile(*storage, path, bytes);
+        CHECK_EQ(loadRegionError(service, region.key, context), "CRRegion: invalid column frame");
+    }
+
+    if (!CRLz4::available()) {
+        SKIP_TEST("LZ4 not available");
+    }
+    settings->enableLz4 = true;
+    service.saveRegion(region, context);
+    std::vector<uint8_t> compressed = readStoredFile(*storage, path);
+    const size_t lz4Frame = static_cast<size_t>(peekI32(compressed, kColumnTable));
+    CHECK(compressed[lz4Frame + 8] != 0);
+    pokeI32(compressed, lz4Frame + 4, peekI32(compressed, lz4Frame) * 255 + 1);
+    writeStoredFile(*storage, path, compressed);
+    CHECK_EQ(loadRegionError(service, region.key, context), "CRRegion: invalid column frame");
+}
+
+TEST_CASE(CRBackend_legacy_region_layout_still_loads) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    auto providers = makeBlockProviders(registry);
+    auto settings = std::make_shared<CRPersistenceSettings>();
+    settings->columnFrames = false;
+    providers->add(kCRSettingsProviderId, settings);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/legacy";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = providers;
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    for (int x = 0; x < 3; ++x) {
+        ChunkSnapshot chunk;
+        chunk.key = ChunkKey{"base:earth", x, 0, 0};
+        chunk.data = makeMinimalChunkData(chunk.key);
+        fillChunkData(chunk.data, stoneId, stoneId);
+        region.chunks.push_back(chunk);
+    }
+    service.saveRegion(region, context);
+
+    auto reader = storage->openRead(CRPaths::regionPath(region.key, context));
+    CHECK_EQ(reader->readI32(), static_cast<int32_t>(0xFFECCEAC));
+    CHECK_EQ(reader->readI32(), 4);
+
+    auto loaded = service.loadRegion(region.key, context);
+    CHECK_EQ(loaded.chunks.size(), static_cast<size_t>(3));
+
+    auto format = service.openFormat(context);
+    auto partial = format->chunkContainer().loadRegionChunks(region.key, {ChunkKey{"base:earth", 1, 0, 0}});
+    CHECK_EQ(partial.chunks.size(), static_cast<size_t>(1));
+    CHECK_EQ(partial.chunks[0].key, region.chunks[1].key);
+    CHECK_EQ(partial.chunks[0].data, region.chunks[1].data);
+
+    // Version 4 regions still stream column by column.
+    auto frames = format->chunkContainer().readRegionFrames(region.key);
+    CHECK_EQ(frames.size(), static_cast<size_t>(3));
+    for (auto& frame : frames) {
+        CHECK_EQ(frame.keys.size(), static_cast<size_t>(16));
+        auto chunks = frame.decode();
+        CHECK_EQ(chunks.size(), static_cast<size_t>(1));
+        CHECK(std::find(frame.keys.begin(), frame.keys.end(), chunks[0].key) != frame.keys.end());
+        CHECK_EQ(chunks[0].data, region.chunks[static_cast<size_t>(chunks[0].key.x)].data);
+    }
+}
+
+TEST_CASE(CRBackend_framed_regions_are_per_world_opt_in) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    FormatRegistry registry;
+    registry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(registry);
+    CHECK_EQ(Backends::CR::descriptor().version, 4);
+
+    PersistenceContext plain;
+    plain.rootPath = "worlds/plain";
+    plain.preferredFormat = "cr";
+    plain.storage = storage;
+
+    PersistenceContext framed = plain;
+    framed.rootPath = "worlds/framed";
+    framed.providers = std::make_shared<ProviderRegistry>();
+    enableFramedRegions(*framed.providers);
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"zone:default", 0, 0, 0};
+    ChunkSnapshot chunk;
+    chunk.key = ChunkKey{"zone:default", 1, 0, 0};
+    chunk.data = makeMinimalChunkData(chunk.key);
+    region.chunks.push_back(chunk);
+
+    auto headerVersion = [&](const PersistenceContext& context) {
+        auto reader = storage->openRead(CRPaths::regionPath(region.key, context));
+        CHECK_EQ(reader->readI32(), static_cast<int32_t>(0xFFECCEAC));
+        return reader->readI32();
+    };
+
+    // Worlds that did not opt in keep the layout Cosmic Reach reads.
+    service.saveRegion(region, plain);
+    CHECK_EQ(headerVersion(plain), 4);
+    CHECK(!service.openFormat(plain)->descriptor().capabilities.supportsRandomAccess);
+
+    service.saveRegion(region, framed);
+    CHECK_EQ(headerVersion(framed), 6);
+    auto format = service.openFormat(framed);
+    CHECK(format->descriptor().capabilities.supportsRandomAccess);
+    auto partial = format->chunkContainer().loadRegionChunks(region.key, {chunk.key});
+    CHECK_EQ(partial.chunks.size(), static_cast<size_t>(1));
+    CHECK_EQ(partial.chunks[0].data, chunk.data);
+}
+
+TEST_CASE(CRBackend_region_dictionary_roundtrip) {
+    if (!CRLz4::dictionaryAvailable()) {
+        SKIP_TEST("LZ4 dictionary API not available");
+    }
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+    Rigel::Voxel::BlockID dirtId = registerOpaqueBlock(registry, "base:dirt");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    auto providers = makeBlockProviders(registry);
+    auto settings = std::make_shared<CRPersistenceSettings>();
+    settings->enableLz4 = true;
+    settings->columnFrames = true;
+    settings->lz4Dictionary = true;
+    providers->add(kCRSettingsProviderId, settings);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/dictionary";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = providers;
+
+    // Many small, similar columns: the case a shared dictionary is meant for.
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            ChunkSnapshot chunk;
+            chunk.key = ChunkKey{"base:earth", x, 0, z};
+            chunk.data = makeMinimalChunkData(chunk.key);
+            fillChunkData(chunk.data, stoneId, dirtId);
+            region.chunks.push_back(chunk);
+        }
+    }
+    service.saveRegion(region, context);
+
+    auto path = CRPaths::regionPath(region.key, context);
+    auto reader = storage->openRead(path);
+    CHECK_EQ(reader->readI32(), static_cast<int32_t>(0xFFECCEAC));
+    CHECK_EQ(reader->readI32(), 6);
+    reader->seek(16 + 256 * 4);
+    CHECK(reader->readI32() > 0);
+
+    auto loaded = service.loadRegion(region.key, context);
+    CHECK_EQ(loaded.chunks.size(), region.chunks.size());
+    std::sort(loaded.chunks.begin(), loaded.chunks.end(), [](const ChunkSnapshot& a, const ChunkSnapshot& b) {
+        return std::make_pair(a.key.z, a.key.x) < std::make_pair(b.key.z, b.key.x);
+    });
+    for (size_t i = 0; i < region.chunks.size(); ++i) {
+        CHECK_EQ(loaded.chunks[i].key, region.chunks[i].key);
+        CHECK_EQ(loaded.chunks[i].data, region.chunks[i].data);
+    }
+
+    auto format = service.openFormat(context);
+    auto frames = format->chunkContainer().readChunkFrames(
+        region.key, {ChunkKey{"base:earth", 3, 0, 4}, ChunkKey{"base:earth", 9, 0, 1}});
+    CHECK_EQ(frames.size(), static_cast<size_t>(2));
+    size_t decoded = 0;
+    for (auto& decode : frames) {
+        decoded += decode().size();
+    }
+    CHECK_EQ(decoded, static_cast<size_t>(2));
+}
+
+TEST_CASE(CRBackend_region_dictionary_needs_framed_opt_in) {
+    if (!CRLz4::dictionaryAvailable()) {
+        SKIP_TEST("LZ4 dictionary API not available");
+    }
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    Rigel::Voxel::BlockRegistry registry;
+    Rigel::Voxel::BlockID stoneId = registerOpaqueBlock(registry, "base:stone_shale");
+    Rigel::Voxel::BlockID dirtId = registerOpaqueBlock(registry, "base:dirt");
+
+    FormatRegistry formatRegistry;
+    formatRegistry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(formatRegistry);
+
+    auto providers = makeBlockProviders(registry);
+    auto settings = std::make_shared<CRPersistenceSettings>();
+    settings->enableLz4 = true;
+    providers->add(kCRSettingsProviderId, settings);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/dictionary_opt_in";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = providers;
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"base:earth", 0, 0, 0};
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            ChunkSnapshot chunk;
+            chunk.key = ChunkKey{"base:earth", x, 0, z};
+            chunk.data = makeMinimalChunkData(chunk.key);
+            fillChunkData(chunk.data, stoneId, dirtId);
+            region.chunks.push_back(chunk);
+        }
+    }
+    const std::string path = CRPaths::regionPath(region.key, context);
+
+    // Neither option is on by default.
+    CHECK(!CRPersistenceSettings{}.lz4Dictionary);
+
+    // A dictionary request alone leaves the world on the version 4 layout.
+    settings->lz4Dictionary = true;
+    service.saveRegion(region, context);
+    auto reader = storage->openRead(path);
+    CHECK_EQ(reader->readI32(), static_cast<int32_t>(0xFFECCEAC));
+    CHECK_EQ(reader->readI32(), 4);
+
+    // Framed regions without the dictionary option write an empty dictionary section.
+    settings->lz4Dictionary = false;
+    settings->columnFrames = true;
+    service.saveRegion(region, context);
+    reader = storage->openRead(path);
+    CHECK_EQ(reader->readI32(), static_cast<int32_t>(0xFFECCEAC));
+    CHECK_EQ(reader->readI32(), 6);
+    reader->seek(16 + 256 * 4);
+    CHECK_EQ(reader->readI32(), 0);
+    CHECK_EQ(service.loadRegion(region.key, context).chunks.size(), region.chunks.size());
+}
+
+TEST_CASE(CRBackend_version5_region_still_loads) {
+    auto storage = std::make_shared<InMemoryStorageBackend>();
+    FormatRegistry registry;
+    registry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(registry);
+
+    PersistenceContext context;
+    context.rootPath = "worlds/version5";
+    context.preferredFormat = "cr";
+    context.storage = storage;
+    context.providers = std::make_shared<ProviderRegistry>();
+    enableFramedRegions(*context.providers);
+
+    ChunkRegionSnapshot region;
+    region.key = RegionKey{"zone:default", 0, 0, 0};
+    for (int x = 0; x < 2; ++x) {
+        ChunkSnapshot chunk;
+        chunk.key = ChunkKey{"zone:default", x, 1, 0};
+        chunk.data = makeMinimalChunkData(chunk.key);
+        region.chunks.push_back(chunk);
+    }
+    service.saveRegion(region, context);
+
+    // Rewrite the version 6 file as version 5: drop the empty dictionary section and
+    // shift the column offsets back over it.
+    auto path = CRPaths::regionPath(region.key, context);
+    auto reader = storage->openRead(path);
+    std::vector<uint8_t> bytes = reader->readAt(0, reader->size());
+    constexpr size_t kTableEnd = 16 + 256 * 4;
+    CHECK_EQ(bytes[kTableEnd + 3], static_cast<uint8_t>(0));
+    bytes.erase(bytes.begin() + kTableEnd, bytes.begin() + kTableEnd + 4);
+    auto patchI32 = [&](size_t at, int32_t value) {
+        bytes[at] = static_cast<uint8_t>((value >> 24) & 0xFF);
+        bytes[at + 1] = static_cast<uint8_t>((value >> 16) & 0xFF);
+        bytes[at + 2] = static_cast<uint8_t>((value >> 8) & 0xFF);
+        bytes[at + 3] = static_cast<uint8_t>(value & 0xFF);
+    };
+    patchI32(4, 5);
+    InMemoryByteReader table(std::vector<uint8_t>(bytes.begin() + 16, bytes.begin() + kTableEnd));
+    for (size_t i = 0; i < 256; ++i) {
+        int32_t offset = table.readI32();
+        if (offset >= 0) {
+            patchI32(16 + i * 4, offset - 4);
+        }
+    }
+    auto session = storage->openWrite(path, AtomicWriteOptions{});
+    session->writer().writeBytes(bytes.data(), bytes.size());
+    session->commit();
+
+    auto loaded = service.loadRegion(region.key, context);
+    CHECK_EQ(loaded.chunks.size(), static_cast<size_t>(2));
+    auto format = service.openFormat(context);
+    auto partial = format->chunkContainer().loadRegionChunks(region.key, {ChunkKey{"zone:default", 1, 1, 0}});
+    CHECK_EQ(partial.chunks.size(), static_cast<size_t>(1));
+    CHECK_EQ(partial.chunks[0].data, region.chunks[1].data);
+}
+
 TEST_CASE(CRBin_roundtrip_basic) {
     CRBinDocument doc;
     doc.schema.entries = {
@@ -661,6 +1150,152 @@ TEST_CASE(CRBin_roundtrip_basic) {
     CHECK_EQ(asFloat(requireField(childObj, "value")), 1.25f);
 }
 
+namespace {
+
+struct CompiledHeader {
+    int32_t id = 0;
+    std::string name;
+    bool flag = false;
+    std::vector<int32_t> items;
+    double scale = 1.0;
+};
+
+const CRBinStructSchema<CompiledHeader>& compiledHeaderSchema() {
+    static const auto schema = CRBinStructSchema<CompiledHeader>()
+        .field<&CompiledHeader::id>("id")
+        .field<&CompiledHeader::name>("name")
+        .field<&CompiledHeader::flag>("flag")
+        .field<&CompiledHeader::items>("items")
+        .field<&CompiledHeader::scale>("scale");
+    return schema;
+}
+
+} // namespace
+
+TEST_CASE(CRBin_compiled_schema_matches_dynamic_document) {
+    CompiledHeader header;
+    header.id = -7;
+    header.name = "region";
+    header.flag = true;
+    header.items = {4, 5, 6};
+    header.scale = 0.5;
+
+    std::vector<uint8_t> bytes;
+    InMemoryByteWriter writer(bytes);
+    compiledHeaderSchema().write(writer, header);
+
+    InMemoryByteReader dynamicReader(bytes);
+    auto doc = CRBinReader::read(dynamicReader);
+    CHECK_EQ(doc.schema.entries.size(), static_cast<size_t>(5));
+    CHECK_EQ(asInt(requireField(doc.root, "id")), -7);
+    CHECK_EQ(asString(requireField(doc.root, "name")), "region");
+    CHECK_EQ(asBool(requireField(doc.root, "flag")), true);
+
+    InMemoryByteReader compiledReader(bytes);
+    CRBinUnknownFields unknown;
+    CompiledHeader loaded = compiledHeaderSchema().read(compiledReader, &unknown);
+    CHECK_EQ(loaded.id, -7);
+    CHECK_EQ(loaded.name, "region");
+    CHECK(loaded.flag);
+    CHECK(loaded.items == header.items);
+    CHECK_EQ(loaded.scale, 0.5);
+    CHECK(unknown.entries.empty());
+}
+
+TEST_CASE(CRBin_compiled_schema_keeps_unknown_fields) {
+    CRBinDocument doc;
+    doc.schema.entries = {
+        {"id", CRSchemaType::Int},
+        {"child", CRSchemaType::Object},
+        {"name", CRSchemaType::String},
+        {"flag", CRSchemaType::Short}
+    };
+    CRSchema childSchema;
+    childSchema.entries = {{"label", CRSchemaType::String}};
+    doc.altSchemas.push_back(childSchema);
+    doc.root.fields["id"] = CRBinValue::fromInt(9);
+    doc.root.fields["name"] = CRBinValue::fromString("old");
+    doc.root.fields["flag"] = CRBinValue::fromInt(3);
+    CRBinObject child;
+    child.schemaIndex = 0;
+    child.fields["label"] = CRBinValue::fromString("nested");
+    doc.root.fields["child"] = CRBinValue::fromObject(std::move(child));
+
+    std::vector<uint8_t> bytes;
+    InMemoryByteWriter writer(bytes);
+    CRBinWriter::write(writer, doc);
+
+    // "flag" is stored as a Short but bound as a Boolean, so it stays unknown.
+    InMemoryByteReader reader(bytes);
+    CRBinUnknownFields unknown;
+    CompiledHeader header = compiledHeaderSchema().read(reader, &unknown);
+    CHECK_EQ(header.id, 9);
+    CHECK_EQ(header.name, "old");
+    CHECK(!header.flag);
+    CHECK_EQ(header.scale, 1.0);
+    CHECK_EQ(unknown.entries.size(), static_cast<size_t>(2));
+    CHECK_EQ(unknown.altSchemas.size(), static_cast<size_t>(1));
+
+    header.name = "new";
+    std::vector<uint8_t> rewritten;
+    InMemoryByteWriter rewriter(rewritten);
+    compiledHeaderSchema().write(rewriter, header, &unknown);
+
+    InMemoryByteReader rereader(rewritten);
+    auto reloaded = CRBinReader::read(rereader);
+    CHECK_EQ(asString(requireField(reloaded.root, "name")), "new");
+    CHECK_EQ(asInt(requireField(reloaded.root, "id")), 9);
+    // Bound names replace same-named unknown fields.
+    CHECK_EQ(asBool(requireField(reloaded.root, "flag")), false);
+    const auto& childValue = requireField(reloaded.root, "child");
+    CHECK(std::holds_alternative<CRBinObject>(childValue.value));
+    CHECK_EQ(asString(requireField(std::get<CRBinObject>(childValue.value), "label")), "nested");
+}
+
+TEST_CASE(CRBin_compiled_schema_round_trips_null_arrays) {
+    CRBinDocument doc;
+    doc.schema.entries = {
+        {"id", CRSchemaType::Int},
+        {"items", CRSchemaType::IntArray}
+    };
+    doc.root.fields["id"] = CRBinValue::fromInt(3);
+    doc.root.fields["items"] = CRBinValue{};
+
+    std::vector<uint8_t> bytes;
+    InMemoryByteWriter writer(bytes);
+    CRBinWriter::write(writer, doc);
+
+    InMemoryByteReader dynamicReader(bytes);
+    auto loaded = CRBinReader::read(dynamicReader);
+    CHECK(std::holds_alternative<std::monostate>(requireField(loaded.root, "items").value));
+
+    InMemoryByteReader compiledReader(bytes);
+    CRBinUnknownFields unknown;
+    CompiledHeader header = compiledHeaderSchema().read(compiledReader, &unknown);
+    CHECK_EQ(header.id, 3);
+    CHECK(header.items.empty());
+    CHECK_EQ(unknown.entries.size(), static_cast<size_t>(1));
+
+    std::vector<uint8_t> rewritten;
+    InMemoryByteWriter rewriter(rewritten);
+    compiledHeaderSchema().write(rewriter, header, &unknown);
+    InMemoryByteReader rewrittenReader(rewritten);
+    auto reloaded = CRBinReader::read(rewrittenReader);
+    CHECK(std::holds_alternative<std::monostate>(requireField(reloaded.root, "items").value));
+    CHECK_EQ(reloaded.schema.entries.size(), static_cast<size_t>(5));
+
+    // Filling the vector replaces the stored null.
+    header.items = {4, 5};
+    std::vector<uint8_t> filled;
+    InMemoryByteWriter filledWriter(filled);
+    compiledHeaderSchema().write(filledWriter, header, &unknown);
+    InMemoryByteReader filledReader(filled);
+    CHECK(compiledHeaderSchema().read(filledReader).items == header.items);
+
+    InMemoryByteReader withoutUnknown(bytes);
+    CHECK(compiledHeaderSchema().read(withoutUnknown).items.empty());
+}
+
 TEST_CASE(CRBackend_filesystem_region_roundtrip) {
     std::filesystem::path root = ".cache/cr_backend_fs_test";
     std::error_code ec;
@@ -694,3 +1329,57 @@ TEST_CASE(CRBackend_filesystem_region_roundtrip) {
     CHECK_EQ(loaded.chunks[0].key, chunk.key);
     CHECK_EQ(loaded.chunks[0].data, chunk.data);
 }
+
+TEST_CASE(CRBackend_shared_format_reuses_open_regions) {
+    std::filesystem::path root = ".cache/cr_backend_shared_format_test";
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+
+    auto storage = std::make_shared<FilesystemBackend>();
+    FormatRegistry registry;
+    registry.registerFormat(Backends::CR::descriptor(), Backends::CR::factory(), Backends::CR::probe());
+    PersistenceService service(registry);
+
+    PersistenceContext context;
+    context.rootPath = root.string();
+    context.preferredFormat = "cr";
+    context.storage = storage;
+
+    auto shared = service.sharedFormat(context);
+    CHECK(shared == service.sharedFormat(context));
+    PersistenceContext otherRoot = context;
+    otherRoot.rootPath = (root / "other").string();
+    CHECK(shared != service.sharedFormat(otherRoot));
+
+    const RegionKey regionKey{"zone:default", 0, 0, 0};
+    auto saveOne = [&](ChunkContainer& container, const ChunkKey& key) {
+        ChunkRegionSnapshot region;
+        region.key = regionKey;
+        ChunkSnapshot chunk;
+        chunk.key = key;
+        chunk.data = makeMinimalChunkData(key);
+        region.chunks.push_back(chunk);
+        container.saveRegion(region);
+    };
+    const ChunkKey first{"zone:default", 1, 0, 0};
+    const ChunkKey second{"zone:default", 2, 0, 0};
+    const ChunkKey third{"zone:default", 3, 0, 0};
+    ChunkContainer& container = shared->chunkContainer();
+
+    saveOne(container, first);
+    CHECK_EQ(container.loadRegionChunks(regionKey, {first}).chunks.size(), 1u);
+
+    // Writes through the shared instance drop its open handle.
+    saveOne(container, second);
+    CHECK(container.loadRegionChunks(regionKey, {first}).chunks.empty());
+    CHECK_EQ(container.loadRegionChunks(regionKey, {second}).chunks.size(), 1u);
+
+    // Another instance's write is picked up once the region is invalidated.
+    auto separate = service.openFormat(context);
+    saveOne(separate->chunkContainer(), third);
+    container.invalidateRegion(regionKey);
+    auto loaded = container.loadRegionChunks(regionKey, {second, third});
+    CHECK_EQ(loaded.chunks.size(), 1u);
+    CHECK_EQ(loaded.chunks[0].key, third);
+    CHECK_EQ(container.loadRegion(regionKey).chunks.size(), 1u);
+}
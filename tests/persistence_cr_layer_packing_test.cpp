@@ -0,0 +1,89 @@
+#include "TestFramework.h"
+
+#include "Rigel/Persistence/Backends/CR/CRLayerPacking.h"
+
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace Rigel::Persistence::Backends::CR;
+using Rigel::Voxel::BlockID;
+using Rigel::Voxel::BlockState;
+
+namespace {
+
+std::array<uint16_t, kLayerIndexCount> randomIndices(int bits, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, (1 << bits) - 1);
+    std::array<uint16_t, kLayerIndexCount> indices{};
+    for (auto& index : indices) {
+        index = static_cast<uint16_t>(dist(rng));
+    }
+    return indices;
+}
+
+} // namespace
+
+TEST_CASE(CRLayerPacking_MatchesScalarAndRoundTrips) {
+    for (int bits : {1, 2, 4, 8}) {
+        for (uint32_t seed = 1; seed <= 8; ++seed) {
+            const auto indices = randomIndices(bits, seed * 31u + static_cast<uint32_t>(bits));
+            const size_t bytes = packedLayerBytes(bits);
+
+            std::vector<uint8_t> packed(bytes, 0xAA);
+            std::vector<uint8_t> reference(bytes, 0x55);
+            packLayerIndices(indices.data(), bits, packed.data());
+            detail::packLayerIndicesScalar(indices.data(), bits, reference.data());
+            CHECK(packed == reference);
+
+            std::array<uint8_t, kLayerIndexCount> unpacked{};
+            std::array<uint8_t, kLayerIndexCount> unpackedReference{};
+            unpackLayerIndices(packed.data(), bits, unpacked.data());
+            detail::unpackLayerIndicesScalar(packed.data(), bits, unpackedReference.data());
+            CHECK(unpacked == unpackedReference);
+            for (size_t i = 0; i < kLayerIndexCount; ++i) {
+                CHECK_EQ(static_cast<uint16_t>(unpacked[i]), indices[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE(CRLayerPacking_BitOrderIsLowFirst) {
+    std::array<uint16_t, kLayerIndexCount> indices{};
+    indices[0] = 1;
+    indices[9] = 1;
+    std::array<uint8_t, 32> packed{};
+    packLayerIndices(indices.data(), 1, packed.data());
+    CHECK_EQ(packed[0], static_cast<uint8_t>(0x01));
+    CHECK_EQ(packed[1], static_cast<uint8_t>(0x02));
+
+    indices.fill(0);
+    indices[1] = 3;
+    indices[2] = 2;
+    std::array<uint8_t, 128> nibbles{};
+    packLayerIndices(indices.data(), 4, nibbles.data());
+    CHECK_EQ(nibbles[0], static_cast<uint8_t>(0x30));
+    CHECK_EQ(nibbles[1], static_cast<uint8_t>(0x02));
+
+    std::array<uint8_t, 64> pairs{};
+    packLayerIndices(indices.data(), 2, pairs.data());
+    CHECK_EQ(pairs[0], static_cast<uint8_t>((3 << 2) | (2 << 4)));
+}
+
+TEST_CASE(CRLayerPacking_FusedLookupMapsOutOfRangeToAir) {
+    const std::vector<BlockID> palette = {BlockID{0}, BlockID{7}, BlockID{42}};
+    const LayerPaletteLut lut = makeLayerPaletteLut(palette);
+    const auto indices = randomIndices(2, 99);
+
+    std::array<uint8_t, 64> packed{};
+    packLayerIndices(indices.data(), 2, packed.data());
+    std::vector<BlockState> blocks(kLayerIndexCount, BlockState{BlockID{5}, 3, 9});
+    unpackLayerBlocks(packed.data(), 2, lut, blocks.data());
+
+    for (size_t i = 0; i < kLayerIndexCount; ++i) {
+        const BlockID expected = indices[i] < palette.size() ? palette[indices[i]] : BlockID{0};
+        CHECK(blocks[i].id == expected);
+        CHECK_EQ(blocks[i].metadata, static_cast<uint8_t>(0));
+        CHECK_EQ(blocks[i].lightLevel, static_cast<uint8_t>(0));
+    }
+}
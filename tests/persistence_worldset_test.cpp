@@ -1,5 +1,6 @@
 #include "TestFramework.h"
 
+#include "Rigel/Persistence/Backends/Memory/MemoryFormat.h"
 #include "Rigel/Persistence/Providers.h"
 #include "Rigel/Persistence/Storage.h"
 #include "Rigel/Voxel/WorldSet.h"
@@ -62,3 +63,27 @@ TEST_CASE(WorldSet_PersistenceContextIncludesProviders) {
     CHECK(ctx.providers != nullptr);
     CHECK(ctx.providers->findAs<DummyProvider>("dummy") == provider);
 }
+
+TEST_CASE(WorldSet_RemovingWorldReleasesSharedFormats) {
+    Voxel::WorldSet worldSet;
+    worldSet.persistenceFormats().registerFormat(
+        Persistence::Backends::Memory::descriptor(),
+        Persistence::Backends::Memory::factory(),
+        Persistence::Backends::Memory::probe());
+    worldSet.setPersistenceRoot("root");
+    worldSet.setPersistenceStorage(std::make_shared<DummyStorage>());
+    worldSet.setPersistencePreferredFormat("memory");
+
+    auto& world = worldSet.createWorld(Voxel::WorldSet::defaultWorldId());
+    auto ctx = worldSet.persistenceContext(world.id());
+    auto& service = worldSet.persistenceService();
+    auto format = service.sharedFormat(ctx);
+    CHECK(format == service.sharedFormat(ctx));
+
+    worldSet.removeWorld(Voxel::WorldSet::defaultWorldId());
+    auto reopened = service.sharedFormat(ctx);
+    CHECK(reopened != format);
+
+    worldSet.setPersistenceStorage(std::make_shared<DummyStorage>());
+    CHECK(service.sharedFormat(ctx) != reopened);
+}
@@ -51,6 +51,15 @@ render:
     enabled: true
     blend: 0.8
     jitter_scale: 1.5
+  entity_animation_lod:
+    enabled: true
+    full_distance: 16.0
+    reduced_distance: 8.0
+    reduced_interval: 3
+    reduced_max_animations: 0
+    freeze_distance: 96.0
+    low_interval: 6
+    low_max_animations: 1
   svo_voxel:
     enabled: true
     near_mesh_radius_chunks: 7
@@ -94,6 +103,15 @@ render:
     CHECK(config.taa.enabled);
     CHECK_NEAR(config.taa.blend, 0.8f, 0.0001f);
     CHECK_NEAR(config.taa.jitterScale, 1.5f, 0.0001f);
+    CHECK(config.entityAnimationLod.enabled);
+    CHECK_NEAR(config.entityAnimationLod.fullDistance, 16.0f, 0.0001f);
+    // Tier distances never shrink outward; counts are at least 1.
+    CHECK_NEAR(config.entityAnimationLod.reducedDistance, 16.0f, 0.0001f);
+    CHECK_EQ(config.entityAnimationLod.reducedInterval, 3);
+    CHECK_EQ(config.entityAnimationLod.reducedMaxAnimations, 1);
+    CHECK_NEAR(config.entityAnimationLod.freezeDistance, 96.0f, 0.0001f);
+    CHECK_EQ(config.entityAnimationLod.lowInterval, 6);
+    CHECK_EQ(config.entityAnimationLod.lowMaxAnimations, 1);
     CHECK(config.svoVoxel.enabled);
     CHECK_EQ(config.svoVoxel.nearMeshRadiusChunks, 7);
     CHECK_EQ(config.svoVoxel.maxRadiusChunks, 48);
@@ -2,6 +2,7 @@
 
 #include "Rigel/Voxel/VoxelLod/VoxelMipPyramid.h"
 
+#include <array>
 #include <random>
 
 namespace Rigel::Voxel {
@@ -13,6 +14,71 @@ size_t idx(int x, int y, int z, int dim) {
         + static_cast<size_t>(z) * static_cast<size_t>(dim) * static_cast<size_t>(dim);
 }
 
+// Straightforward per-cell reduction the optimized builder must match bit for bit.
+VoxelMipPyramid buildReferencePyramid(const std::vector<VoxelId>& l0, int dim) {
+    VoxelMipPyramid out;
+    out.baseDim = dim;
+    VoxelMipLevel level0;
+    level0.dim = dim;
+    for (VoxelId v : l0) {
+        level0.cells.push_back(VoxelMipLevel::pack(true, v));
+    }
+    out.levels.push_back(std::move(level0));
+
+    for (int prevDim = dim; prevDim > 1; prevDim /= 2) {
+        const VoxelMipLevel& prev = out.levels.back();
+        VoxelMipLevel next;
+        next.dim = prevDim / 2;
+        next.cells.resize(static_cast<size_t>(next.dim) * next.dim * next.dim);
+        for (int z = 0; z < next.dim; ++z) {
+            for (int y = 0; y < next.dim; ++y) {
+                for (int x = 0; x < next.dim; ++x) {
+                    std::array<uint32_t, 8> children{};
+                    for (int i = 0; i < 8; ++i) {
+                        children[static_cast<size_t>(i)] = prev.cells[idx(x * 2 + (i & 1),
+                                                                          y * 2 + ((i >> 1) & 1),
+                                                                          z * 2 + ((i >> 2) & 1),
+                                                                          prevDim)];
+                    }
+                    bool uniform = true;
+                    for (uint32_t child : children) {
+                        uniform = uniform && VoxelMipLevel::isUniform(child) &&
+                            VoxelMipLevel::value(child) == VoxelMipLevel::value(children[0]);
+                    }
+                    VoxelId best = VoxelMipLevel::value(children[0]);
+                    int bestCount = 1;
+                    for (uint32_t candidate : children) {
+                        int count = 0;
+                        for (uint32_t other : children) {
+                            if (VoxelMipLevel::value(other) == VoxelMipLevel::value(candidate)) {
+                                ++count;
+                            }
+                        }
+                        if (count > bestCount) {
+                            bestCount = count;
+                            best = VoxelMipLevel::value(candidate);
+                        }
+                    }
+                    next.cells[idx(x, y, z, next.dim)] = VoxelMipLevel::pack(uniform, best);
+                }
+            }
+        }
+        out.levels.push_back(std::move(next));
+    }
+    return out;
+}
+
+void checkMatchesReference(const std::vector<VoxelId>& l0, int dim) {
+    const VoxelMipPyramid expected = buildReferencePyramid(l0, dim);
+    const VoxelMipPyramid actual = buildVoxelMipPyramid(l0, dim);
+    CHECK_EQ(actual.baseDim, expected.baseDim);
+    CHECK_EQ(actual.levelCount(), expected.levelCount());
+    for (size_t levelIndex = 0; levelIndex < expected.levelCount(); ++levelIndex) {
+        CHECK_EQ(actual.levels[levelIndex].dim, expected.levels[levelIndex].dim);
+        CHECK(actual.levels[levelIndex].cells == expected.levels[levelIndex].cells);
+    }
+}
+
 TEST_CASE(VoxelMipPyramid_AllAirIsUniformEverywhere) {
     constexpr int dim = 8;
     std::vector<VoxelId> l0(static_cast<size_t>(dim) * dim * dim, kVoxelAir);
@@ -120,6 +186,52 @@ TEST_CASE(VoxelMipPyramid_UniformImpliesAllChildrenUniformAndSameValue) {
     }
 }
 
+TEST_CASE(VoxelMipPyramid_RandomPagesMatchReferenceReduction) {
+    std::mt19937 rng(4242);
+    for (int dim : {2, 4, 8, 16, 64}) {
+        for (int palette : {2, 3, 16}) {
+            std::uniform_int_distribution<int> dist(0, palette - 1);
+            std::vector<VoxelId> l0(static_cast<size_t>(dim) * dim * dim);
+            for (auto& v : l0) {
+                v = static_cast<VoxelId>(dist(rng));
+            }
+            checkMatchesReference(l0, dim);
+        }
+    }
+}
+
+TEST_CASE(VoxelMipPyramid_TerrainLikePagesMatchReferenceReduction) {
+    // Mostly uniform strata with sparse noise: exercises the uniform fast path next to mixed blocks.
+    constexpr int dim = 64;
+    std::mt19937 rng(77);
+    std::uniform_int_distribution<int> heightDist(8, 56);
+    std::uniform_int_distribution<int> noiseDist(0, 63);
+    std::uniform_int_distribution<int> oreDist(2, 9);
+
+    for (int trial = 0; trial < 4; ++trial) {
+        const int surface = heightDist(rng);
+        std::vector<VoxelId> l0(static_cast<size_t>(dim) * dim * dim, kVoxelAir);
+        for (int z = 0; z < dim; ++z) {
+            for (int y = 0; y < dim; ++y) {
+                for (int x = 0; x < dim; ++x) {
+                    VoxelId v = y < surface ? VoxelId{1} : kVoxelAir;
+                    if (y < surface && noiseDist(rng) == 0) {
+                        v = static_cast<VoxelId>(oreDist(rng));
+                    }
+                    l0[idx(x, y, z, dim)] = v;
+                }
+            }
+        }
+        checkMatchesReference(l0, dim);
+    }
+}
+
+TEST_CASE(VoxelMipPyramid_UniformPageMatchesReferenceReduction) {
+    constexpr int dim = 32;
+    checkMatchesReference(std::vector<VoxelId>(static_cast<size_t>(dim) * dim * dim, VoxelId{0xFFFF}), dim);
+    checkMatchesReference(std::vector<VoxelId>(1, VoxelId{5}), 1);
+}
+
 } // namespace
 } // namespace Rigel::Voxel
 
@@ -0,0 +1,163 @@
+#include "TestFramework.h"
+
+#include "Rigel/Voxel/VoxelLod/VoxelPageDiskCache.h"
+#include "Rigel/Voxel/WorldGenConfig.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace Rigel::Voxel;
+using Rigel::Persistence::FilesystemBackend;
+
+namespace {
+
+struct TempCacheDir {
+    std::filesystem::path root;
+
+    TempCacheDir() {
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        root = std::filesystem::temp_directory_path() /
+            ("rigel_voxel_page_cache_test_" + std::to_string(now));
+        std::filesystem::create_directories(root);
+    }
+
+    ~TempCacheDir() {
+        std::filesystem::remove_all(root);
+    }
+};
+
+VoxelPageCpu makeTestPage(const VoxelPageKey& key, int dim) {
+    std::vector<VoxelId> l0(static_cast<size_t>(dim) * dim * dim, kVoxelAir);
+    for (int z = 0; z < dim; ++z) {
+        for (int y = 0; y < dim / 2; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                const size_t idx = static_cast<size_t>(x + y * dim + z * dim * dim);
+                l0[idx] = static_cast<VoxelId>(1 + ((x + z) % 3));
+            }
+        }
+    }
+    return buildVoxelPageCpu(key, l0, dim);
+}
+
+} // namespace
+
+TEST_CASE(VoxelPageDiskCache_RoundTripsPage) {
+    TempCacheDir dir;
+    auto storage = std::make_shared<FilesystemBackend>();
+    VoxelPageDiskCache cache(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(7, 1, 0, 16));
+
+    const VoxelPageKey key{2, -3, 1, 5};
+    const VoxelPageCpu page = makeTestPage(key, 16);
+    CHECK(cache.store(page, cache.generation(key)));
+    CHECK(std::filesystem::exists(cache.pagePath(key)));
+
+    VoxelPageCpu loaded;
+    CHECK(cache.load(key, 16, loaded));
+    CHECK(loaded.key == key);
+    CHECK_EQ(loaded.dim, 16);
+    CHECK(loaded.l0 == page.l0);
+    CHECK_EQ(loaded.mips.baseDim, page.mips.baseDim);
+    CHECK_EQ(loaded.mips.levels.size(), page.mips.levels.size());
+    for (size_t i = 0; i < page.mips.levels.size(); ++i) {
+        CHECK_EQ(loaded.mips.levels[i].dim, page.mips.levels[i].dim);
+        CHECK(loaded.mips.levels[i].cells == page.mips.levels[i].cells);
+    }
+
+    VoxelPageCpu missing;
+    CHECK(!cache.load(VoxelPageKey{2, -3, 1, 6}, 16, missing));
+}
+
+TEST_CASE(VoxelPageDiskCache_ContentHashChangeMisses) {
+    TempCacheDir dir;
+    auto storage = std::make_shared<FilesystemBackend>();
+    const VoxelPageKey key{0, 0, 0, 0};
+    {
+        VoxelPageDiskCache cache(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(7, 1, 0, 16));
+        CHECK(cache.store(makeTestPage(key, 16), 0));
+    }
+
+    CHECK(VoxelPageDiskCache::makeContentHash(7, 1, 0, 16) != VoxelPageDiskCache::makeContentHash(7, 2, 0, 16));
+    VoxelPageDiskCache otherGenerator(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(7, 2, 0, 16));
+    VoxelPageCpu out;
+    CHECK(!otherGenerator.load(key, 16, out));
+
+    VoxelPageDiskCache sameWorld(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(7, 1, 0, 16));
+    CHECK(sameWorld.load(key, 16, out));
+    CHECK(!sameWorld.load(key, 32, out));
+}
+
+TEST_CASE(VoxelPageDiskCache_InvalidateDropsEntryAndStaleStores) {
+    TempCacheDir dir;
+    auto storage = std::make_shared<FilesystemBackend>();
+    VoxelPageDiskCache cache(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(1, 1, 0, 8));
+
+    const VoxelPageKey key{1, 4, 0, -2};
+    const VoxelPageCpu page = makeTestPage(key, 8);
+    const uint64_t before = cache.generation(key);
+    CHECK(cache.store(page, before));
+
+    cache.invalidate(key);
+    VoxelPageCpu out;
+    CHECK(!cache.load(key, 8, out));
+
+    // A build that sampled before the invalidation must not repopulate the entry.
+    CHECK(!cache.store(page, before));
+    cache.flush();
+    CHECK(!std::filesystem::exists(cache.pagePath(key)));
+
+    CHECK(cache.store(page, cache.generation(key)));
+    CHECK(cache.load(key, 8, out));
+}
+
+TEST_CASE(VoxelPageDiskCache_RejectsAndRemovesCorruptEntry) {
+    TempCacheDir dir;
+    auto storage = std::make_shared<FilesystemBackend>();
+    VoxelPageDiskCache cache(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(1, 1, 0, 8));
+
+    const VoxelPageKey key{0, 1, 2, 3};
+    CHECK(cache.store(makeTestPage(key, 8), 0));
+    const std::string path = cache.pagePath(key);
+    const auto fullSize = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, fullSize / 2);
+
+    VoxelPageCpu out;
+    CHECK(!cache.load(key, 8, out));
+    CHECK(!std::filesystem::exists(path));
+}
+
+TEST_CASE(VoxelPageDiskCache_InvalidationTrackingIsBounded) {
+    TempCacheDir dir;
+    auto storage = std::make_shared<FilesystemBackend>();
+    VoxelPageDiskCache cache(storage, dir.root.string(), VoxelPageDiskCache::makeContentHash(1, 1, 0, 8));
+
+    const VoxelPageKey key{0, 0, 0, 0};
+    const VoxelPageCpu page = makeTestPage(key, 8);
+    const uint64_t before = cache.generation(key);
+
+    // Overflowing the per-page table must still reject every capture taken earlier.
+    for (int i = 0; i <= static_cast<int>(VoxelPageDiskCache::kMaxTrackedInvalidations); ++i) {
+        cache.invalidate(VoxelPageKey{0, i + 1, 0, 0});
+    }
+    CHECK(!cache.store(page, before));
+    CHECK(cache.store(page, cache.generation(key)));
+    cache.flush();
+
+    VoxelPageCpu out;
+    CHECK(cache.load(key, 8, out));
+}
+
+TEST_CASE(VoxelPageDiskCache_GeneratorConfigChangesContentHash) {
+    WorldGenConfig config;
+    const uint64_t base = config.generationHash();
+
+    WorldGenConfig streamOnly = config;
+    streamOnly.stream.viewDistanceChunks += 4;
+    CHECK_EQ(streamOnly.generationHash(), base);
+
+    WorldGenConfig terrain = config;
+    terrain.terrain.baseHeight += 1.0f;
+    CHECK(terrain.generationHash() != base);
+    CHECK(VoxelPageDiskCache::makeContentHash(7, 1, base, 16) !=
+          VoxelPageDiskCache::makeContentHash(7, 1, terrain.generationHash(), 16));
+}
@@ -2,7 +2,9 @@
 
 #include "Rigel/Voxel/VoxelLod/VoxelPageTree.h"
 
+#include <algorithm>
 #include <random>
+#include <tuple>
 
 namespace {
 using namespace Rigel::Voxel;
@@ -17,25 +19,112 @@ void validateTreeInvariants(const VoxelPageTree& tree) {
 
     for (size_t i = 0; i < tree.nodes.size(); ++i) {
         const VoxelSvoNode& node = tree.nodes[i];
+        const uint32_t nodeIndex = static_cast<uint32_t>(i);
         if (node.kind == VoxelSvoNodeKind::Mixed) {
             CHECK_NE(node.childMask, 0);
+            CHECK(node.childOffset > 0);
+            CHECK(nodeIndex + node.childOffset + static_cast<uint32_t>(node.childCount()) <= tree.nodes.size());
+            uint32_t expectedNext = nodeIndex + node.childOffset;
             for (int child = 0; child < 8; ++child) {
                 const bool present = (node.childMask & (1u << child)) != 0;
-                const uint32_t idx = node.children[child];
+                const uint32_t idx = tree.childIndex(nodeIndex, child);
                 if (present) {
-                    CHECK_NE(idx, VoxelSvoNode::kInvalidChild);
+                    // Present children are contiguous, in slot order, and stored after the parent.
+                    CHECK_EQ(idx, expectedNext);
+                    CHECK(idx > nodeIndex);
                     CHECK(idx < tree.nodes.size());
+                    ++expectedNext;
                 } else {
                     CHECK_EQ(idx, VoxelSvoNode::kInvalidChild);
                 }
             }
         } else {
             CHECK_EQ(node.childMask, 0);
-            for (int child = 0; child < 8; ++child) {
-                CHECK_EQ(node.children[child], VoxelSvoNode::kInvalidChild);
-            }
+            CHECK_EQ(node.childOffset, 0u);
+        }
+    }
+}
+
+struct LeafRecord {
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    int size = 0;
+    VoxelSvoNodeKind kind = VoxelSvoNodeKind::Empty;
+    VoxelId material = 0;
+
+    bool operator==(const LeafRecord&) const = default;
+    bool operator<(const LeafRecord& other) const {
+        return std::tie(x, y, z, size) < std::tie(other.x, other.y, other.z, other.size);
+    }
+};
+
+void collectTreeLeaves(const VoxelPageTree& tree, uint32_t nodeIndex,
+                       int x, int y, int z, int size, std::vector<LeafRecord>& out) {
+    const VoxelSvoNode& node = tree.nodes[nodeIndex];
+    if (node.isLeaf()) {
+        CHECK_EQ(static_cast<int>(node.leafSizeVoxels), size);
+        out.push_back(LeafRecord{x, y, z, size, node.kind, node.materialId});
+        return;
+    }
+    const int half = size / 2;
+    for (int child = 0; child < 8; ++child) {
+        const uint32_t childIndex = tree.childIndex(nodeIndex, child);
+        if (childIndex == VoxelSvoNode::kInvalidChild) {
+            continue;
         }
+        collectTreeLeaves(tree, childIndex,
+                          x + ((child & 1) ? half : 0),
+                          y + ((child & 2) ? half : 0),
+                          z + ((child & 4) ? half : 0),
+                          half, out);
+    }
+}
+
+// Top-down recursive reference over the mip pyramid; returns false when the region emits nothing.
+bool collectReferenceLeaves(const VoxelPageCpu& page, int minLeaf,
+                            int x, int y, int z, int size, std::vector<LeafRecord>& out) {
+    int mip = 0;
+    while ((1 << mip) < size) {
+        ++mip;
+    }
+    const VoxelMipLevel& level = page.mips.levels[static_cast<size_t>(mip)];
+    const uint32_t packed = level.cells[static_cast<size_t>((x >> mip) + (y >> mip) * level.dim +
+                                                            (z >> mip) * level.dim * level.dim)];
+    const VoxelId rep = VoxelMipLevel::value(packed);
+    if (VoxelMipLevel::isUniform(packed) || size <= minLeaf) {
+        if (rep == 0) {
+            return false;
+        }
+        out.push_back(LeafRecord{x, y, z, size, VoxelSvoNodeKind::Solid, rep});
+        return true;
+    }
+    const int half = size / 2;
+    bool any = false;
+    for (int child = 0; child < 8; ++child) {
+        any = collectReferenceLeaves(page, minLeaf,
+                                     x + ((child & 1) ? half : 0),
+                                     y + ((child & 2) ? half : 0),
+                                     z + ((child & 4) ? half : 0),
+                                     half, out) || any;
+    }
+    return any;
+}
+
+void checkLeavesMatchReference(const VoxelPageCpu& page, int minLeaf) {
+    const VoxelPageTree tree = buildVoxelPageTree(page, minLeaf, basicClassifier);
+    validateTreeInvariants(tree);
+
+    std::vector<LeafRecord> expected;
+    if (!collectReferenceLeaves(page, minLeaf, 0, 0, 0, page.dim, expected)) {
+        expected.push_back(LeafRecord{0, 0, 0, page.dim, VoxelSvoNodeKind::Empty, 0});
     }
+    std::vector<LeafRecord> actual;
+    collectTreeLeaves(tree, tree.root, 0, 0, 0, page.dim, actual);
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CHECK(actual == expected);
 }
 
 } // namespace
@@ -112,5 +201,45 @@ TEST_CASE(VoxelPageTree_RandomInputMaintainsInvariants) {
     validateTreeInvariants(tree);
 }
 
+TEST_CASE(VoxelPageTree_MatchesRecursiveReferenceLeaves) {
+    std::mt19937 rng(99);
+    for (int dim : {8, 32}) {
+        for (int density : {1, 4, 32}) {
+            std::uniform_int_distribution<int> dist(0, density * 3);
+            std::vector<VoxelId> l0(static_cast<size_t>(dim * dim * dim), 0);
+            for (VoxelId& v : l0) {
+                const int roll = dist(rng);
+                v = roll < 3 ? static_cast<VoxelId>(roll + 1) : 0;
+            }
+            VoxelPageCpu page = buildVoxelPageCpu(VoxelPageKey{0, 0, 0, 0}, l0, dim);
+            for (int minLeaf : {1, 2, 4, dim}) {
+                checkLeavesMatchReference(page, minLeaf);
+            }
+        }
+    }
+}
+
+TEST_CASE(VoxelPageTree_SolidBelowAirEmitsCompactTree) {
+    // Half solid / half air: the root splits once and each uniform half collapses immediately.
+    constexpr int dim = 64;
+    std::vector<VoxelId> l0(static_cast<size_t>(dim * dim * dim), 0);
+    for (int z = 0; z < dim; ++z) {
+        for (int y = 0; y < dim / 2; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                l0[static_cast<size_t>(x + y * dim + z * dim * dim)] = 3;
+            }
+        }
+    }
+
+    VoxelPageCpu page = buildVoxelPageCpu(VoxelPageKey{0, 0, 0, 0}, l0, dim);
+    VoxelPageTree tree = buildVoxelPageTree(page, 1, basicClassifier);
+    validateTreeInvariants(tree);
+    CHECK_EQ(tree.nodes.size(), static_cast<size_t>(5));
+    CHECK_EQ(tree.nodes[tree.root].kind, VoxelSvoNodeKind::Mixed);
+    CHECK_EQ(tree.nodes[tree.root].childMask, static_cast<uint8_t>(0x33));
+    CHECK_EQ(tree.cpuBytes(), tree.nodes.size() * sizeof(VoxelSvoNode));
+    checkLeavesMatchReference(page, 1);
+}
+
 } // namespace
 } // namespace Rigel::Voxel
@@ -4,11 +4,45 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace Rigel::Voxel {
 namespace {
 
+using CoveredFace = std::tuple<int, int, int, int>; // normal, x, y, z
+
+// Expand quads to the per-cell faces they cover.
+std::map<CoveredFace, VoxelId> coveredFaces(const std::vector<SurfaceQuad>& quads,
+                                            const glm::ivec3& offset = glm::ivec3(0)) {
+    std::map<CoveredFace, VoxelId> faces;
+    for (const SurfaceQuad& quad : quads) {
+        for (int v = 0; v < quad.span.y; ++v) {
+            for (int u = 0; u < quad.span.x; ++u) {
+                glm::ivec3 cell = quad.cellMin + offset;
+                switch (quad.normal) {
+                    case Direction::PosX:
+                    case Direction::NegX:
+                        cell += glm::ivec3(0, v, u);
+                        break;
+                    case Direction::PosY:
+                    case Direction::NegY:
+                        cell += glm::ivec3(u, 0, v);
+                        break;
+                    case Direction::PosZ:
+                    case Direction::NegZ:
+                        cell += glm::ivec3(u, v, 0);
+                        break;
+                }
+                faces[{static_cast<int>(quad.normal), cell.x, cell.y, cell.z}] = quad.material;
+            }
+        }
+    }
+    return faces;
+}
+
 TEST_CASE(VoxelSurfaceMesher_BuildsQuadVerticesAndIndices) {
     SurfaceQuad quad;
     quad.normal = Direction::PosY;
@@ -56,6 +90,101 @@ TEST_CASE(VoxelSurfaceMesher_BuildsQuadVerticesAndIndices) {
     }
 }
 
+TEST_CASE(VoxelSurfaceMesher_MergesFlatSurfaceAcrossPages) {
+    const SurfaceQuad top{
+        .normal = Direction::PosY,
+        .cellMin = glm::ivec3(0, 2, 0),
+        .span = glm::ivec2(4, 4),
+        .material = static_cast<VoxelId>(1)
+    };
+    const std::array<SurfaceQuadPage, 4> pages{
+        SurfaceQuadPage{glm::ivec3(0, 0, 0), {&top, 1}},
+        SurfaceQuadPage{glm::ivec3(4, 0, 0), {&top, 1}},
+        SurfaceQuadPage{glm::ivec3(0, 0, 4), {&top, 1}},
+        SurfaceQuadPage{glm::ivec3(4, 0, 4), {&top, 1}},
+    };
+
+    std::vector<SurfaceQuad> merged;
+    mergeSurfaceQuadsAcrossPages(pages, merged);
+    CHECK_EQ(merged.size(), static_cast<size_t>(1));
+    CHECK(merged[0].normal == Direction::PosY);
+    CHECK_EQ(merged[0].cellMin.x, 0);
+    CHECK_EQ(merged[0].cellMin.y, 2);
+    CHECK_EQ(merged[0].cellMin.z, 0);
+    CHECK_EQ(merged[0].span.x, 8);
+    CHECK_EQ(merged[0].span.y, 8);
+    CHECK_EQ(merged[0].material, static_cast<VoxelId>(1));
+}
+
+TEST_CASE(VoxelSurfaceMesher_CrossPageMergeKeepsPlanesAndMaterialsApart) {
+    const std::vector<SurfaceQuad> a{
+        SurfaceQuad{Direction::PosY, glm::ivec3(0, 2, 0), glm::ivec2(4, 4), static_cast<VoxelId>(1)},
+        SurfaceQuad{Direction::NegY, glm::ivec3(0, 2, 0), glm::ivec2(4, 4), static_cast<VoxelId>(1)},
+    };
+    const std::vector<SurfaceQuad> b{
+        SurfaceQuad{Direction::PosY, glm::ivec3(0, 2, 0), glm::ivec2(4, 4), static_cast<VoxelId>(2)},
+        SurfaceQuad{Direction::PosY, glm::ivec3(0, 3, 0), glm::ivec2(4, 4), static_cast<VoxelId>(1)},
+    };
+    const std::array<SurfaceQuadPage, 2> pages{
+        SurfaceQuadPage{glm::ivec3(0), a},
+        SurfaceQuadPage{glm::ivec3(4, 0, 0), b},
+    };
+
+    std::vector<SurfaceQuad> merged;
+    mergeSurfaceQuadsAcrossPages(pages, merged);
+    CHECK_EQ(merged.size(), static_cast<size_t>(4));
+
+    std::map<CoveredFace, VoxelId> expected = coveredFaces(a);
+    for (const auto& [face, material] : coveredFaces(b, glm::ivec3(4, 0, 0))) {
+        expected[face] = material;
+    }
+    CHECK(coveredFaces(merged) == expected);
+}
+
+TEST_CASE(VoxelSurfaceMesher_CrossPageMergePreservesCoverage) {
+    // Terrain-like pages: a height field with per-page material bands, so some planes
+    // merge across seams and some must stay split.
+    constexpr int kPageCells = 8;
+    uint32_t state = 12345u;
+    auto next = [&]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 16;
+    };
+
+    std::vector<std::vector<SurfaceQuad>> pageQuads;
+    std::vector<glm::ivec3> offsets;
+    for (int pz = 0; pz < 2; ++pz) {
+        for (int px = 0; px < 2; ++px) {
+            std::vector<SurfaceQuad> quads;
+            for (int z = 0; z < kPageCells; ++z) {
+                for (int x = 0; x < kPageCells; ++x) {
+                    const int height = 3 + static_cast<int>(next() % 2);
+                    const VoxelId material = static_cast<VoxelId>(1 + (next() % 8 == 0 ? 1 : 0));
+                    quads.push_back(SurfaceQuad{
+                        Direction::PosY, glm::ivec3(x, height, z), glm::ivec2(1, 1), material});
+                }
+            }
+            pageQuads.push_back(std::move(quads));
+            offsets.push_back(glm::ivec3(px * kPageCells, 0, pz * kPageCells));
+        }
+    }
+
+    std::vector<SurfaceQuadPage> pages;
+    std::map<CoveredFace, VoxelId> expected;
+    size_t inputCount = 0;
+    for (size_t i = 0; i < pageQuads.size(); ++i) {
+        pages.push_back(SurfaceQuadPage{offsets[i], pageQuads[i]});
+        inputCount += pageQuads[i].size();
+        for (const auto& [face, material] : coveredFaces(pageQuads[i], offsets[i])) {
+            expected[face] = material;
+        }
+    }
+
+    std::vector<SurfaceQuad> merged;
+    mergeSurfaceQuadsAcrossPages(pages, merged);
+    CHECK(merged.size() < inputCount);
+    CHECK(coveredFaces(merged) == expected);
+}
+
 } // namespace
 } // namespace Rigel::Voxel
-
@@ -1,9 +1,11 @@
 #include "TestFramework.h"
 
+#include "Rigel/Voxel/ChunkManager.h"
 #include "Rigel/Voxel/VoxelLod/VoxelSvoLodManager.h"
 
 #include <atomic>
 #include <chrono>
+#include <filesystem>
 #include <limits>
 #include <thread>
 #include <unordered_set>
@@ -71,6 +73,7 @@ TEST_CASE(VoxelSvoLodManager_ConfigIsSanitized) {
     config.levels = 0;
     config.pageSizeVoxels = 9;
     config.minLeafVoxels = 7;
+    config.clusterPages = 0;
     config.buildBudgetPagesPerFrame = -1;
     config.applyBudgetPagesPerFrame = -2;
     config.uploadBudgetPagesPerFrame = -3;
@@ -88,6 +91,7 @@ TEST_CASE(VoxelSvoLodManager_ConfigIsSanitized) {
     CHECK_EQ(effective.levels, 1);
     CHECK_EQ(effective.pageSizeVoxels, 16);
     CHECK_EQ(effective.minLeafVoxels, 8);
+    CHECK_EQ(effective.clusterPages, 1);
     CHECK_EQ(effective.buildBudgetPagesPerFrame, 0);
     CHECK_EQ(effective.applyBudgetPagesPerFrame, 0);
     CHECK_EQ(effective.uploadBudgetPagesPerFrame, 0);
@@ -709,6 +713,160 @@ TEST_CASE(VoxelSvoLodManager_VisiblePagesEventuallyReachReadyMeshWhenGeneratorAv
     CHECK(manager.telemetry().visibleReadyMeshCount > 0u);
 }
 
+TEST_CASE(VoxelSvoLodManager_ClusterMeshesReplaceMemberPages) {
+    VoxelSvoLodManager manager;
+    manager.setBuildThreads(1);
+    manager.setChunkGenerator([](ChunkCoord coord,
+                                 std::array<BlockState, Chunk::VOLUME>& outBlocks,
+                                 const std::atomic_bool* cancel) {
+        (void)cancel;
+        for (int z = 0; z < Chunk::SIZE; ++z) {
+            for (int y = 0; y < Chunk::SIZE; ++y) {
+                const int worldY = coord.y * Chunk::SIZE + y;
+                for (int x = 0; x < Chunk::SIZE; ++x) {
+                    BlockState state;
+                    state.id.type = (worldY < 8) ? 1 : 0;
+                    outBlocks[static_cast<size_t>(x + y * Chunk::SIZE + z * Chunk::SIZE * Chunk::SIZE)] = state;
+                }
+            }
+        }
+    });
+
+    VoxelSvoConfig config;
+    config.enabled = true;
+    config.nearMeshRadiusChunks = 0;
+    config.maxRadiusChunks = 8;
+    config.levels = 1;
+    config.pageSizeVoxels = 16;
+    config.minLeafVoxels = 4;
+    config.clusterPages = 2;
+    config.maxResidentPages = 1024;
+    config.buildBudgetPagesPerFrame = 64;
+    config.applyBudgetPagesPerFrame = 64;
+    manager.setConfig(config);
+    manager.initialize();
+
+    std::vector<VoxelSvoLodManager::OpaqueMeshEntry> meshes;
+    bool sawCluster = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(3000);
+    while (std::chrono::steady_clock::now() < deadline && !sawCluster) {
+        manager.update(glm::vec3(0.0f));
+        manager.collectOpaqueMeshes(meshes);
+        for (const auto& entry : meshes) {
+            sawCluster = sawCluster || entry.spanPages == 2;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(sawCluster);
+    CHECK(manager.telemetry().activeClusters > 0u);
+
+    // A flat ground plane spanning 2x2 pages collapses to one quad per cluster face.
+    std::unordered_set<VoxelPageKey, VoxelPageKeyHash> covered;
+    for (const auto& entry : meshes) {
+        if (entry.spanPages != 2) {
+            continue;
+        }
+        CHECK(entry.mesh != nullptr);
+        CHECK_EQ(entry.key.x % 2, 0);
+        CHECK_EQ(entry.key.y % 2, 0);
+        CHECK_EQ(entry.key.z % 2, 0);
+        for (int dz = 0; dz < 2; ++dz) {
+            for (int dy = 0; dy < 2; ++dy) {
+                for (int dx = 0; dx < 2; ++dx) {
+                    covered.insert(VoxelPageKey{entry.key.level, entry.key.x + dx, entry.key.y + dy, entry.key.z + dz});
+                }
+            }
+        }
+    }
+    for (const auto& entry : meshes) {
+        if (entry.spanPages == 1) {
+            CHECK(covered.find(entry.key) == covered.end());
+        }
+    }
+
+    // Cluster meshes count against the CPU budget and go when a member is evicted.
+    // One byte under the current total: the pages alone already fit.
+    const uint64_t limit = manager.telemetry().cpuBytesCurrent - 1;
+    CHECK(limit > 0u);
+    config.maxCpuBytes = static_cast<int64_t>(limit);
+    manager.setConfig(config);
+    for (int frame = 0; frame < 20; ++frame) {
+        manager.update(glm::vec3(0.0f));
+        CHECK(manager.telemetry().cpuBytesCurrent <= limit);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST_CASE(VoxelSvoLodManager_EnablingClustersAtRuntimeMergesMeshedPages) {
+    VoxelSvoLodManager manager;
+    manager.setBuildThreads(1);
+    manager.setChunkGenerator([](ChunkCoord coord,
+                                 std::array<BlockState, Chunk::VOLUME>& outBlocks,
+                                 const std::atomic_bool* cancel) {
+        (void)cancel;
+        for (int z = 0; z < Chunk::SIZE; ++z) {
+            for (int y = 0; y < Chunk::SIZE; ++y) {
+                const int worldY = coord.y * Chunk::SIZE + y;
+                for (int x = 0; x < Chunk::SIZE; ++x) {
+                    BlockState state;
+                    state.id.type = (worldY < 8) ? 1 : 0;
+                    outBlocks[static_cast<size_t>(x + y * Chunk::SIZE + z * Chunk::SIZE * Chunk::SIZE)] = state;
+                }
+            }
+        }
+    });
+
+    VoxelSvoConfig config;
+    config.enabled = true;
+    config.nearMeshRadiusChunks = 0;
+    config.maxRadiusChunks = 8;
+    config.levels = 1;
+    config.pageSizeVoxels = 16;
+    config.minLeafVoxels = 4;
+    config.clusterPages = 1;
+    config.maxResidentPages = 1024;
+    config.buildBudgetPagesPerFrame = 64;
+    config.applyBudgetPagesPerFrame = 64;
+    manager.setConfig(config);
+    manager.initialize();
+
+    // Mesh every page with clustering off first: wait until the mesh count settles.
+    std::vector<VoxelSvoLodManager::OpaqueMeshEntry> meshes;
+    size_t settledCount = 0;
+    auto settledSince = std::chrono::steady_clock::now();
+    auto deadline = settledSince + std::chrono::milliseconds(5000);
+    while (std::chrono::steady_clock::now() < deadline) {
+        manager.update(glm::vec3(0.0f));
+        manager.collectOpaqueMeshes(meshes);
+        const auto now = std::chrono::steady_clock::now();
+        if (meshes.size() != settledCount) {
+            settledCount = meshes.size();
+            settledSince = now;
+        } else if (settledCount > 0 && now - settledSince > std::chrono::milliseconds(300)) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(settledCount >= 8u);
+
+    // The pages meshed before the switch must still merge into non-empty clusters;
+    // they are re-meshed for their quads without dropping out of the draw list.
+    config.clusterPages = 2;
+    manager.setConfig(config);
+    bool sawCluster = false;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(3000);
+    while (std::chrono::steady_clock::now() < deadline && !sawCluster) {
+        manager.update(glm::vec3(0.0f));
+        manager.collectOpaqueMeshes(meshes);
+        CHECK(!meshes.empty());
+        for (const auto& entry : meshes) {
+            sawCluster = sawCluster || (entry.spanPages == 2 && entry.mesh && !entry.mesh->isEmpty());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(sawCluster);
+}
+
 TEST_CASE(VoxelSvoLodManager_MovementDoesNotCollapseReadyMeshToZeroUnderResidentCap) {
     VoxelSvoLodManager manager;
     manager.setBuildThreads(1);
@@ -1053,6 +1211,64 @@ TEST_CASE(VoxelSvoLodManager_ResetCancelsInFlightBuildJobs) {
     CHECK(manager.telemetry().updateCalls > 0u);
 }
 
+TEST_CASE(VoxelSvoLodManager_CameraMoveCancelsObsoleteInFlightBuilds) {
+    VoxelSvoLodManager manager;
+    manager.setBuildThreads(1);
+    manager.setChunkGenerator([](ChunkCoord,
+                                 std::array<BlockState, Chunk::VOLUME>& outBlocks,
+                                 const std::atomic_bool* cancel) {
+        outBlocks.fill(BlockState{});
+        for (int i = 0; i < 200; ++i) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    VoxelSvoConfig config;
+    config.enabled = true;
+    config.nearMeshRadiusChunks = 0;
+    config.maxRadiusChunks = 4;
+    config.levels = 1;
+    config.pageSizeVoxels = 16;
+    config.minLeafVoxels = 4;
+    config.maxResidentPages = 512;
+    config.buildBudgetPagesPerFrame = 4;
+    config.applyBudgetPagesPerFrame = 0;
+    manager.setConfig(config);
+    manager.initialize();
+
+    // The in-flight set is capped instead of growing by the budget every frame.
+    for (int i = 0; i < 8; ++i) {
+        manager.update(glm::vec3(0.0f));
+        CHECK(manager.telemetry().buildsInFlight <= 4u);
+    }
+    CHECK(manager.telemetry().buildsInFlight > 0u);
+    CHECK_EQ(manager.telemetry().buildsCancelled, 0u);
+
+    // Teleporting away makes every in-flight build obsolete.
+    manager.update(glm::vec3(8192.0f, 0.0f, 0.0f));
+    CHECK(manager.telemetry().buildsCancelled > 0u);
+    CHECK(manager.telemetry().buildsInFlight <= 4u);
+
+    // Cancelled jobs drain quickly and the pages around the new position get built.
+    bool sampledNewArea = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(3000);
+    while (std::chrono::steady_clock::now() < deadline && !sampledNewArea) {
+        manager.update(glm::vec3(8192.0f, 0.0f, 0.0f));
+        std::vector<std::pair<VoxelPageKey, VoxelSvoPageInfo>> pages;
+        manager.collectDebugPages(pages);
+        for (const auto& [key, info] : pages) {
+            if (key.x * 16 > 4096 && info.appliedRevision > 0) {
+                sampledNewArea = true;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(sampledNewArea);
+}
+
 TEST_CASE(VoxelSvoLodManager_PersistenceSource_InvalidationRebuildsFromUpdatedData) {
     auto source = std::make_shared<TogglePatternSource>();
 
@@ -1115,3 +1331,82 @@ TEST_CASE(VoxelSvoLodManager_PersistenceSource_InvalidationRebuildsFromUpdatedDa
     CHECK(secondRevision > firstRevision);
     CHECK(secondNodeCount > firstNodeCount);
 }
+
+TEST_CASE(VoxelSvoLodManager_DiskCacheRestoresPagesWithoutSampling) {
+    auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::filesystem::path root = std::filesystem::temp_directory_path() /
+        ("rigel_svo_disk_cache_test_" + std::to_string(now));
+    auto storage = std::make_shared<Rigel::Persistence::FilesystemBackend>();
+    const uint64_t contentHash = VoxelPageDiskCache::makeContentHash(42, 1, 0, 8);
+
+    VoxelSvoConfig config;
+    config.enabled = true;
+    config.nearMeshRadiusChunks = 0;
+    config.maxRadiusChunks = 0;
+    config.levels = 1;
+    config.pageSizeVoxels = 8;
+    config.minLeafVoxels = 4;
+    config.maxResidentPages = 7;
+    config.buildBudgetPagesPerFrame = 1;
+    config.applyBudgetPagesPerFrame = 0;
+
+    auto runUntilCenterReady = [&](std::atomic<int>& generatorCalls,
+                                   const ChunkManager* loadedChunks = nullptr) {
+        VoxelSvoLodManager manager;
+        if (loadedChunks) {
+            manager.bind(loadedChunks, nullptr, nullptr);
+        }
+        manager.setBuildThreads(1);
+        manager.setChunkGenerator([&generatorCalls](ChunkCoord coord,
+                                                    std::array<BlockState, Chunk::VOLUME>& outBlocks,
+                                                    const std::atomic_bool*) {
+            generatorCalls.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < outBlocks.size(); ++i) {
+                const int worldY = coord.y * Chunk::SIZE + static_cast<int>((i / Chunk::SIZE) % Chunk::SIZE);
+                outBlocks[i].id.type = worldY < 4 ? 1 : 0;
+            }
+        });
+        manager.setPageCache(std::make_shared<VoxelPageDiskCache>(storage, root.string(), contentHash));
+        manager.setConfig(config);
+        manager.initialize();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        while (std::chrono::steady_clock::now() < deadline) {
+            manager.update(glm::vec3(0.0f));
+            auto info = manager.pageInfo(VoxelPageKey{0, 0, 0, 0});
+            if (info && info->appliedRevision > 0 &&
+                (info->state == VoxelPageState::ReadyCpu || info->state == VoxelPageState::ReadyMesh)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto info = manager.pageInfo(VoxelPageKey{0, 0, 0, 0});
+        CHECK(info.has_value());
+        CHECK(info->appliedRevision > 0);
+        CHECK(info->nodeCount > 0u);
+        return manager.telemetry();
+    };
+
+    std::atomic<int> coldCalls{0};
+    const VoxelSvoTelemetry cold = runUntilCenterReady(coldCalls);
+    CHECK(cold.diskCacheWrites >= 1u);
+    CHECK_EQ(cold.diskCacheHits, 0u);
+    CHECK(coldCalls.load() > 0);
+
+    std::atomic<int> warmCalls{0};
+    const VoxelSvoTelemetry warm = runUntilCenterReady(warmCalls);
+    CHECK(warm.diskCacheHits >= 1u);
+
+    // Pages sampled from loaded chunks may carry unsaved edits and are never cached.
+    std::filesystem::remove_all(root);
+    ChunkManager loadedChunks;
+    BlockState solid;
+    solid.id.type = 1;
+    loadedChunks.getOrCreateChunk(ChunkCoord{0, 0, 0}).setBlock(0, 0, 0, solid);
+    std::atomic<int> loadedCalls{0};
+    runUntilCenterReady(loadedCalls, &loadedChunks);
+    VoxelPageDiskCache probe(storage, root.string(), contentHash);
+    CHECK(!std::filesystem::exists(probe.pagePath(VoxelPageKey{0, 0, 0, 0})));
+
+    std::filesystem::remove_all(root);
+}
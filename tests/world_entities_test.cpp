@@ -1,10 +1,17 @@
 #include "TestFramework.h"
 
+#include "Rigel/Entity/EntityComponents.h"
 #include "Rigel/Entity/WorldEntities.h"
 #include "Rigel/Voxel/World.h"
 #include "Rigel/Voxel/WorldResources.h"
 #include "Rigel/Voxel/BlockType.h"
 
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 using namespace Rigel::Entity;
 using namespace Rigel::Voxel;
 
@@ -28,3 +35,533 @@ TEST_CASE(WorldEntities_SpawnDespawn) {
     CHECK(world.entities().despawn(id));
     CHECK_EQ(world.entities().size(), static_cast<size_t>(0));
 }
+
+namespace {
+
+Entity* spawnAt(World& world, float x, float y, float z, float halfExtent = 0.4f) {
+    auto entity = std::make_unique<Entity>("rigel:test_entity");
+    entity->setLocalBounds(Aabb{glm::vec3(-halfExtent), glm::vec3(halfExtent)});
+    entity->setPosition(x, y, z);
+    EntityId id = world.entities().spawn(std::move(entity));
+    return world.entities().get(id);
+}
+
+} // namespace
+
+TEST_CASE(WorldEntities_BroadphaseMatchesBruteForce) {
+    WorldResources resources;
+    World world(resources);
+
+    std::vector<Entity*> all;
+    for (int i = 0; i < 300; ++i) {
+        // Spread across chunk borders, with a few large entities mixed in.
+        float x = static_cast<float>((i * 37) % 97) - 48.0f + 0.25f;
+        float y = static_cast<float>((i * 11) % 7);
+        float z = static_cast<float>((i * 53) % 89) - 44.0f + 0.5f;
+        all.push_back(spawnAt(world, x, y, z, (i % 50 == 0) ? 3.0f : 0.6f));
+    }
+
+    size_t expectedPairs = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        for (size_t j = i + 1; j < all.size(); ++j) {
+            if (all[i]->worldBounds().intersects(all[j]->worldBounds())) {
+                ++expectedPairs;
+            }
+        }
+    }
+    size_t pairs = 0;
+    world.entities().forEachOverlappingPair([&](Entity& a, Entity& b) {
+        CHECK(&a != &b);
+        CHECK(a.worldBounds().intersects(b.worldBounds()));
+        ++pairs;
+    });
+    CHECK(expectedPairs > 0);
+    CHECK_EQ(pairs, expectedPairs);
+
+    const Aabb box{glm::vec3(-31.0f, 0.0f, -2.0f), glm::vec3(1.0f, 2.0f, 30.0f)};
+    std::vector<Entity*> inBox;
+    world.entities().queryAabb(box, inBox);
+    size_t expectedInBox = 0;
+    for (Entity* entity : all) {
+        if (entity->worldBounds().intersects(box)) {
+            ++expectedInBox;
+        }
+    }
+    CHECK_EQ(inBox.size(), expectedInBox);
+
+    const glm::vec3 center(1.0f, 3.0f, -1.0f);
+    std::vector<Entity*> inRadius;
+    world.entities().queryRadius(center, 20.0f, inRadius);
+    size_t expectedInRadius = 0;
+    Entity* nearest = nullptr;
+    float nearestSq = 0.0f;
+    for (Entity* entity : all) {
+        glm::vec3 d = entity->position() - center;
+        float dSq = glm::dot(d, d);
+        if (dSq <= 400.0f) {
+            ++expectedInRadius;
+        }
+        if (!nearest || dSq < nearestSq) {
+            nearest = entity;
+            nearestSq = dSq;
+        }
+    }
+    CHECK_EQ(inRadius.size(), expectedInRadius);
+    CHECK_EQ(world.entities().findNearest(center, 200.0f), nearest);
+    CHECK(world.entities().findNearest(center, 200.0f, [&](const Entity& e) { return &e != nearest; }) != nearest);
+}
+
+TEST_CASE(WorldEntities_OverlapsAcrossCrowdedChunkBorder) {
+    WorldResources resources;
+    World world(resources);
+
+    // Two crowds on either side of the x = 0 chunk border, pressed against it.
+    std::vector<Entity*> all;
+    for (int i = 0; i < 120; ++i) {
+        float x = (i % 2 == 0 ? -1.0f : 1.0f) * (0.05f + 0.01f * static_cast<float>(i % 30));
+        float y = 0.5f + 0.3f * static_cast<float>(i % 5);
+        float z = 0.5f + 0.3f * static_cast<float>(i % 7);
+        all.push_back(spawnAt(world, x, y, z, 0.2f));
+    }
+
+    size_t expectedPairs = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        for (size_t j = i + 1; j < all.size(); ++j) {
+            if (all[i]->worldBounds().intersects(all[j]->worldBounds())) {
+                ++expectedPairs;
+            }
+        }
+    }
+    size_t pairs = 0;
+    size_t crossing = 0;
+    world.entities().forEachOverlappingPair([&](Entity& a, Entity& b) {
+        CHECK(a.worldBounds().intersects(b.worldBounds()));
+        if (a.currentChunk() != b.currentChunk()) {
+            ++crossing;
+        }
+        ++pairs;
+    });
+    CHECK(crossing > 0);
+    CHECK_EQ(pairs, expectedPairs);
+}
+
+TEST_CASE(WorldEntities_BoundsReachShrinksWhenLargeEntitiesLeave) {
+    WorldResources resources;
+    World world(resources);
+
+    spawnAt(world, 0.5f, 0.5f, 0.5f, 0.4f);
+    Entity* large = spawnAt(world, 10.5f, 0.5f, 0.5f, 40.0f);
+    Entity* medium = spawnAt(world, 20.5f, 0.5f, 0.5f, 2.0f);
+    CHECK_NEAR(world.entities().maxBoundsReach(), 40.0f, 1e-5f);
+
+    world.entities().despawn(large->id());
+    CHECK_NEAR(world.entities().maxBoundsReach(), 2.0f, 1e-5f);
+
+    medium->setLocalBounds(Aabb{glm::vec3(-0.3f), glm::vec3(0.3f)});
+    world.entities().updateEntityChunk(*medium);
+    CHECK_NEAR(world.entities().maxBoundsReach(), 0.4f, 1e-5f);
+
+    world.entities().clear();
+    CHECK_EQ(world.entities().maxBoundsReach(), 0.0f);
+}
+
+TEST_CASE(WorldEntities_BroadphaseFollowsMovedEntities) {
+    WorldResources resources;
+    World world(resources);
+
+    Entity* a = spawnAt(world, 0.5f, 0.5f, 0.5f);
+    Entity* b = spawnAt(world, 100.5f, 0.5f, 0.5f);
+
+    std::vector<Entity*> found;
+    world.entities().queryRadius(glm::vec3(100.0f, 0.0f, 0.0f), 2.0f, found);
+    CHECK_EQ(found.size(), static_cast<size_t>(1));
+
+    a->setPosition(100.0f, 0.5f, 0.9f);
+    world.entities().updateEntityChunk(*a);
+    found.clear();
+    world.entities().queryRadius(glm::vec3(100.0f, 0.0f, 0.0f), 2.0f, found);
+    CHECK_EQ(found.size(), static_cast<size_t>(2));
+
+    size_t pairs = 0;
+    world.entities().forEachOverlappingPair([&](Entity& first, Entity& second) {
+        CHECK((&first == a && &second == b) || (&first == b && &second == a));
+        ++pairs;
+    });
+    CHECK_EQ(pairs, static_cast<size_t>(1));
+}
+
+namespace {
+
+class DespawnOnUpdate final : public IUpdateEntityComponent {
+public:
+    DespawnOnUpdate(WorldEntities& entities, EntityId target)
+        : m_entities(entities), m_target(target) {}
+
+    void update(World&, Entity&, float) override {
+        m_entities.despawn(m_target);
+    }
+
+private:
+    WorldEntities& m_entities;
+    EntityId m_target;
+};
+
+} // namespace
+
+TEST_CASE(WorldEntities_TickDefersDespawnsAndHandlesGoStale) {
+    WorldResources resources;
+    World world(resources);
+    WorldEntities& entities = world.entities();
+
+    Entity* first = spawnAt(world, 0.5f, 0.5f, 0.5f);
+    Entity* second = spawnAt(world, 1.5f, 0.5f, 0.5f);
+    Entity* third = spawnAt(world, 2.5f, 0.5f, 0.5f);
+    const EntityId secondId = second->id();
+    const EntityHandle secondHandle = entities.handle(secondId);
+    CHECK(!secondHandle.isNull());
+    CHECK_EQ(entities.get(secondHandle), second);
+
+    DespawnOnUpdate despawner(entities, secondId);
+    first->addUpdateComponent(&despawner);
+    third->addUpdateComponent(&despawner);
+
+    entities.tick(0.05f);
+    // Both despawn requests were deferred to the end of the tick.
+    CHECK_EQ(entities.size(), static_cast<size_t>(2));
+    CHECK(entities.get(secondId) == nullptr);
+    CHECK(entities.get(secondHandle) == nullptr);
+
+    first->removeUpdateComponent(&despawner);
+    third->removeUpdateComponent(&despawner);
+
+    // The freed slot is reused under a new generation.
+    Entity* fourth = spawnAt(world, 3.5f, 0.5f, 0.5f);
+    const EntityHandle fourthHandle = entities.handle(fourth->id());
+    CHECK_EQ(fourthHandle.index, secondHandle.index);
+    CHECK(fourthHandle.generation != secondHandle.generation);
+    CHECK(entities.get(secondHandle) == nullptr);
+    CHECK_EQ(entities.get(fourthHandle), fourth);
+
+    size_t visited = 0;
+    entities.forEach([&](Entity&) { ++visited; });
+    CHECK_EQ(visited, static_cast<size_t>(3));
+    CHECK(third->currentChunk()->contains(third));
+}
+
+TEST_CASE(WorldEntities_ClearInvalidatesHandles) {
+    WorldResources resources;
+    World world(resources);
+    WorldEntities& entities = world.entities();
+
+    Entity* first = spawnAt(world, 0.5f, 0.5f, 0.5f);
+    spawnAt(world, 1.5f, 0.5f, 0.5f);
+    const EntityHandle before = entities.handle(first->id());
+    CHECK(!before.isNull());
+
+    entities.clear();
+    CHECK_EQ(entities.size(), static_cast<size_t>(0));
+    CHECK(entities.get(before) == nullptr);
+
+    // Spawns after clear() reuse the slots under newer generations.
+    Entity* later = spawnAt(world, 0.5f, 0.5f, 0.5f);
+    spawnAt(world, 1.5f, 0.5f, 0.5f);
+    CHECK(entities.get(before) == nullptr);
+    CHECK_EQ(entities.get(entities.handle(later->id())), later);
+}
+
+namespace {
+
+// On its entity's first update, spawns `count` entities with fixed ids starting at
+// `firstCounter`, despawning `target` (when set) between the first and second spawn.
+class SpawnOnFirstUpdate final : public IUpdateEntityComponent {
+public:
+    SpawnOnFirstUpdate(WorldEntities& entities, uint32_t firstCounter, int count, EntityId target = {})
+        : m_entities(entities), m_firstCounter(firstCounter), m_count(count), m_target(target) {}
+
+    void update(World&, Entity& entity, float) override {
+        if (m_done) {
+            return;
+        }
+        m_done = true;
+        for (int i = 0; i < m_count; ++i) {
+            auto spawned = std::make_unique<Entity>("rigel:test_entity");
+            spawned->setId(EntityId{9, 0, m_firstCounter + static_cast<uint32_t>(i)});
+            spawned->setLocalBounds(Aabb{glm::vec3(-0.3f), glm::vec3(0.3f)});
+            spawned->setPosition(entity.position() + glm::vec3(0.0f, 1.0f + static_cast<float>(i), 0.0f));
+            m_entities.spawn(std::move(spawned));
+            if (i == 0 && !m_target.isNull()) {
+                m_entities.despawn(m_target);
+            }
+        }
+    }
+
+private:
+    WorldEntities& m_entities;
+    uint32_t m_firstCounter;
+    int m_count;
+    EntityId m_target;
+    bool m_done = false;
+};
+
+// Clusters of entities in several EntityRegions over small floor patches; ids are
+// fixed so both worlds can be compared entity by entity.
+std::vector<std::unique_ptr<IUpdateEntityComponent>> populateForDeterminism(WorldResources& resources,
+                                                                            World& world,
+                                                                            std::vector<EntityId>& ids) {
+    WorldEntities& entities = world.entities();
+    BlockType solid;
+    solid.identifier = "rigel:stone";
+    solid.isSolid = true;
+    auto solidId = resources.registry().registerBlock(solid.identifier, solid);
+
+    const glm::ivec2 centers[] = {{8, 8}, {600, 8}, {8, -600}, {-600, 600}, {1200, -40}, {-40, 1200}};
+    uint32_t counter = 1;
+    for (const glm::ivec2& center : centers) {
+        for (int x = -8; x < 8; ++x) {
+            for (int z = -8; z < 8; ++z) {
+                world.setBlock(center.x + x, 0, center.y + z, BlockState{solidId});
+            }
+        }
+        for (int i = 0; i < 60; ++i) {
+            auto entity = std::make_unique<Entity>("rigel:test_entity");
+            entity->setId(EntityId{7, 0, counter++});
+            entity->setLocalBounds(Aabb{glm::vec3(-0.3f), glm::vec3(0.3f)});
+            entity->setPosition(static_cast<float>(center.x + (i % 12) - 6) + 0.5f,
+                                2.0f + static_cast<float>(i % 5),
+                                static_cast<float>(center.y + (i / 12) - 3) + 0.5f);
+            entity->setVelocity(glm::vec3(static_cast<float>((i * 7) % 11) - 5.0f,
+                                          static_cast<float>(i % 3),
+                                          static_cast<float>((i * 5) % 9) - 4.0f));
+            ids.push_back(entities.get(entities.spawn(std::move(entity)))->id());
+        }
+    }
+    std::vector<std::unique_ptr<IUpdateEntityComponent>> components;
+    // Entities in two different regions ask for the same despawn in one tick.
+    components.push_back(std::make_unique<DespawnOnUpdate>(entities, ids[5]));
+    entities.get(ids[70])->addUpdateComponent(components.back().get());
+    entities.get(ids[130])->addUpdateComponent(components.back().get());
+    // Spawners in three regions, in that same first tick; their ids run against dense
+    // order so an id-sorted apply would be caught.
+    components.push_back(std::make_unique<SpawnOnFirstUpdate>(entities, 300, 2));
+    entities.get(ids[10])->addUpdateComponent(components.back().get());
+    components.push_back(std::make_unique<SpawnOnFirstUpdate>(entities, 200, 2, ids[80]));
+    entities.get(ids[75])->addUpdateComponent(components.back().get());
+    components.push_back(std::make_unique<SpawnOnFirstUpdate>(entities, 100, 2));
+    entities.get(ids[200])->addUpdateComponent(components.back().get());
+    return components;
+}
+
+// Counters of the last `count` entities in dense order.
+std::vector<uint32_t> lastDenseCounters(WorldEntities& entities, size_t count) {
+    std::vector<uint32_t> counters;
+    entities.forEach([&](Entity& e) { counters.push_back(e.id().counter); });
+    counters.erase(counters.begin(), counters.end() - static_cast<std::ptrdiff_t>(count));
+    return counters;
+}
+
+} // namespace
+
+TEST_CASE(WorldEntities_ParallelTickMatchesSerial) {
+    WorldResources serialResources;
+    World serialWorld(serialResources);
+    WorldResources parallelResources;
+    World parallelWorld(parallelResources);
+
+    std::vector<EntityId> serialIds;
+    std::vector<EntityId> parallelIds;
+    auto serialComponents = populateForDeterminism(serialResources, serialWorld, serialIds);
+    auto parallelComponents = populateForDeterminism(parallelResources, parallelWorld, parallelIds);
+
+    parallelWorld.entities().setUpdateThreads(4);
+    CHECK_EQ(parallelWorld.entities().updateThreads(), static_cast<size_t>(4));
+
+    constexpr float dt = 1.0f / 60.0f;
+    serialWorld.tickEntities(dt);
+    parallelWorld.tickEntities(dt);
+    // Despawns first, then spawns by spawner dense index and call order.
+    const std::vector<uint32_t> expectedSpawns = {300, 301, 200, 201, 100, 101};
+    CHECK(lastDenseCounters(serialWorld.entities(), 6) == expectedSpawns);
+    CHECK(lastDenseCounters(parallelWorld.entities(), 6) == expectedSpawns);
+
+    for (int frame = 1; frame < 90; ++frame) {
+        serialWorld.tickEntities(dt);
+        parallelWorld.tickEntities(dt);
+    }
+
+    CHECK_EQ(serialWorld.entities().size(), serialIds.size() - 2 + 6);
+    CHECK_EQ(parallelWorld.entities().size(), serialWorld.entities().size());
+    CHECK(parallelWorld.entities().get(serialIds[5]) == nullptr);
+    CHECK(parallelWorld.entities().get(serialIds[80]) == nullptr);
+
+    // Same dense order, same positions and chunk membership, bit for bit.
+    std::vector<Entity*> serialOrder;
+    std::vector<Entity*> parallelOrder;
+    serialWorld.entities().forEach([&](Entity& e) { serialOrder.push_back(&e); });
+    parallelWorld.entities().forEach([&](Entity& e) { parallelOrder.push_back(&e); });
+    CHECK_EQ(parallelOrder.size(), serialOrder.size());
+    for (size_t i = 0; i < serialOrder.size() && i < parallelOrder.size(); ++i) {
+        Entity& a = *serialOrder[i];
+        Entity& b = *parallelOrder[i];
+        CHECK(a.id() == b.id());
+        CHECK(a.position() == b.position());
+        CHECK(a.velocity() == b.velocity());
+        CHECK(b.currentChunk() != nullptr);
+        CHECK(a.currentChunk()->coord() == b.currentChunk()->coord());
+        CHECK(b.currentChunk()->contains(&b));
+    }
+}
+
+namespace {
+
+class TeleportOnUpdate final : public IUpdateEntityComponent {
+public:
+    explicit TeleportOnUpdate(glm::vec3 target) : m_target(target) {}
+
+    void update(World&, Entity& entity, float) override { entity.setPosition(m_target); }
+
+private:
+    glm::vec3 m_target;
+};
+
+class QueryOnUpdate final : public IUpdateEntityComponent {
+public:
+    QueryOnUpdate(WorldEntities& entities, Aabb box) : m_entities(entities), m_box(box) {}
+
+    void update(World&, Entity&, float) override {
+        m_hits.clear();
+        m_entities.queryAabb(m_box, m_hits);
+    }
+
+    size_t hits() const { return m_hits.size(); }
+
+private:
+    WorldEntities& m_entities;
+    Aabb m_box;
+    std::vector<Entity*> m_hits;
+};
+
+class ThrowOnUpdate final : public IUpdateEntityComponent {
+public:
+    void update(World&, Entity&, float) override { throw std::runtime_error("update failed"); }
+};
+
+} // namespace
+
+TEST_CASE(WorldEntities_UpdatesSeeStartOfTickBucketsInBothModes) {
+    for (size_t threads : {size_t{0}, size_t{4}}) {
+        WorldResources resources;
+        World world(resources);
+        WorldEntities& entities = world.entities();
+        entities.setUpdateThreads(threads);
+
+        // The mover updates first and jumps far away; the watcher queries both spots.
+        Entity* mover = spawnAt(world, 0.5f, 0.5f, 0.5f);
+        Entity* watcher = spawnAt(world, 4.5f, 0.5f, 0.5f);
+        mover->addTag(EntityTags::NoClip);
+        watcher->addTag(EntityTags::NoClip);
+        const glm::vec3 target(200.5f, 0.5f, 0.5f);
+        TeleportOnUpdate teleport(target);
+        QueryOnUpdate atTarget(entities, Aabb{target - glm::vec3(1.0f), target + glm::vec3(1.0f)});
+        mover->addUpdateComponent(&teleport);
+        watcher->addUpdateComponent(&atTarget);
+
+        entities.tick(0.05f);
+        CHECK_EQ(atTarget.hits(), static_cast<size_t>(0));
+        std::vector<Entity*> found;
+        entities.queryAabb(Aabb{target - glm::vec3(1.0f), target + glm::vec3(1.0f)}, found);
+        CHECK_EQ(found.size(), static_cast<size_t>(1));
+
+        mover->removeUpdateComponent(&teleport);
+        watcher->removeUpdateComponent(&atTarget);
+    }
+}
+
+TEST_CASE(WorldEntities_ThrowingUpdateEndsTheTick) {
+    for (size_t threads : {size_t{0}, size_t{4}}) {
+        WorldResources resources;
+        World world(resources);
+        WorldEntities& entities = world.entities();
+        entities.setUpdateThreads(threads);
+
+        Entity* first = spawnAt(world, 0.5f, 0.5f, 0.5f);
+        Entity* second = spawnAt(world, 1.5f, 0.5f, 0.5f);
+        Entity* third = spawnAt(world, 2.5f, 0.5f, 0.5f);
+        const EntityId secondId = second->id();
+        DespawnOnUpdate despawner(entities, secondId);
+        ThrowOnUpdate thrower;
+        first->addUpdateComponent(&despawner);
+        third->addUpdateComponent(&thrower);
+
+        CHECK_THROWS(entities.tick(0.05f));
+        // The despawn queued before the failure was still applied.
+        CHECK(entities.get(secondId) == nullptr);
+        first->removeUpdateComponent(&despawner);
+        third->removeUpdateComponent(&thrower);
+
+        // Outside a tick, spawns and despawns apply immediately again.
+        Entity* later = spawnAt(world, 3.5f, 0.5f, 0.5f);
+        CHECK(later != nullptr);
+        CHECK_EQ(entities.size(), static_cast<size_t>(3));
+        CHECK(entities.despawn(later->id()));
+        CHECK_EQ(entities.size(), static_cast<size_t>(2));
+    }
+}
+
+TEST_CASE(WorldEntities_RestingEntitiesSleepAndWake) {
+    WorldResources resources;
+    World world(resources);
+    WorldEntities& entities = world.entities();
+
+    BlockType solid;
+    solid.identifier = "rigel:stone";
+    solid.isSolid = true;
+    auto solidId = resources.registry().registerBlock(solid.identifier, solid);
+    for (int x = -4; x <= 8; ++x) {
+        for (int z = -4; z <= 4; ++z) {
+            world.setBlock(x, 0, z, BlockState{solidId});
+        }
+    }
+
+    Entity* lone = spawnAt(world, 0.5f, 1.4f, 0.5f);
+    // A row of three touching entities: one island.
+    Entity* pushed = spawnAt(world, 4.5f, 1.4f, 0.5f);
+    Entity* middle = spawnAt(world, 5.3f, 1.4f, 0.5f);
+    Entity* far = spawnAt(world, 6.1f, 1.4f, 0.5f);
+
+    constexpr float dt = 1.0f / 60.0f;
+    for (int i = 0; i < 60; ++i) {
+        entities.tick(dt);
+    }
+    CHECK(lone->isSleeping());
+    CHECK(pushed->isSleeping());
+    CHECK(middle->isSleeping());
+    CHECK(far->isSleeping());
+    const glm::vec3 restPosition = lone->position();
+    entities.tick(dt);
+    CHECK(lone->position() == restPosition);
+
+    // Removing the block underneath wakes only the entity resting on it.
+    world.setBlock(0, 0, 0, BlockState{});
+    CHECK(!lone->isSleeping());
+    CHECK(pushed->isSleeping());
+    for (int i = 0; i < 10; ++i) {
+        entities.tick(dt);
+    }
+    CHECK(lone->position().y < restPosition.y);
+    CHECK(!lone->isSleeping());
+
+    // An impulse wakes its entity, which wakes everything it touches transitively.
+    pushed->applyImpulse(glm::vec3(2.0f, 0.0f, 0.0f));
+    CHECK(!pushed->isSleeping());
+    CHECK(middle->isSleeping());
+    entities.tick(dt);
+    CHECK(!middle->isSleeping());
+    CHECK(!far->isSleeping());
+
+    for (int i = 0; i < 120; ++i) {
+        entities.tick(dt);
+    }
+    CHECK(pushed->isSleeping());
+    CHECK(middle->isSleeping());
+    CHECK(far->isSleeping());
+}
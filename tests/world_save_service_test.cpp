@@ -0,0 +1,362 @@
+#include "TestFramework.h"
+
+#include "Rigel/Asset/AssetManager.h"
+#include "Rigel/Persistence/Backends/Memory/MemoryFormat.h"
+#include "Rigel/Persistence/PersistenceService.h"
+#include "Rigel/Persistence/Storage.h"
+#include "Rigel/Persistence/WorldPersistence.h"
+#include "Rigel/Persistence/WorldSaveService.h"
+#include "Rigel/Voxel/Chunk.h"
+#include "Rigel/Voxel/World.h"
+#include "Rigel/Voxel/WorldResources.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace Rigel;
+
+namespace {
+
+struct SaveFixture {
+    Voxel::WorldResources resources;
+    Voxel::BlockID stone;
+    Voxel::World world;
+    Persistence::FormatRegistry formats;
+    Persistence::PersistenceService service;
+    Persistence::PersistenceContext context;
+    std::filesystem::path root;
+
+    SaveFixture()
+        : world(resources),
+          service(formats) {
+        const std::string identifier = "rigel:test_autosave";
+        Voxel::BlockType block;
+        block.identifier = identifier;
+        block.isOpaque = true;
+        block.isSolid = true;
+        stone = resources.registry().registerBlock(identifier, std::move(block));
+        world.setId(1);
+
+        formats.registerFormat(
+            Persistence::Backends::Memory::descriptor(),
+            Persistence::Backends::Memory::factory(),
+            Persistence::Backends::Memory::probe());
+
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        root = std::filesystem::temp_directory_path() /
+            ("rigel_world_save_service_test_" + std::to_string(now));
+        std::filesystem::create_directories(root);
+        context.rootPath = root.string();
+        context.preferredFormat = "memory";
+        context.storage = std::make_shared<Persistence::FilesystemBackend>();
+        context.providers = world.persistenceProvidersHandle();
+    }
+
+    ~SaveFixture() {
+        std::filesystem::remove_all(root);
+    }
+
+    Voxel::BlockID loadBlock(int wx, int wy, int wz) {
+        Voxel::World loaded(resources);
+        loaded.setId(1);
+        Voxel::ChunkCoord coord = Voxel::worldToChunk(wx, wy, wz);
+        if (!Persistence::loadChunkFromDisk(loaded, service, context, coord, 0)) {
+            return Voxel::BlockRegistry::airId();
+        }
+        return loaded.getBlock(wx, wy, wz).id;
+    }
+};
+
+Persistence::AutosaveConfig immediateConfig() {
+    Persistence::AutosaveConfig config;
+    config.settleSeconds = 0.0f;
+    config.maxDirtyAgeSeconds = 0.0f;
+    return config;
+}
+
+} // namespace
+
+TEST_CASE(WorldSaveService_SavesDirtyChunkAndClearsFlag) {
+    SaveFixture fx;
+    fx.world.setBlock(1, 2, 3, Voxel::BlockState{fx.stone});
+    Voxel::Chunk* chunk = fx.world.chunkManager().getChunk(Voxel::ChunkCoord{0, 0, 0});
+    CHECK(chunk != nullptr);
+    CHECK(chunk->isPersistDirty());
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    saver.setConfig(immediateConfig());
+    std::vector<Persistence::RegionKey> saved;
+    saver.setRegionSavedCallback([&](const Persistence::RegionKey& key) { saved.push_back(key); });
+
+    saver.update();
+    saver.update();
+
+    CHECK(!chunk->isPersistDirty());
+    CHECK_EQ(saved.size(), static_cast<size_t>(1));
+    CHECK_EQ(saver.metrics().chunksSaved, static_cast<uint64_t>(1));
+    CHECK_EQ(saver.metrics().dirtyChunks, static_cast<size_t>(0));
+    CHECK_EQ(fx.loadBlock(1, 2, 3), fx.stone);
+}
+
+TEST_CASE(WorldSaveService_WaitsForChunkToSettle) {
+    SaveFixture fx;
+    fx.world.setBlock(0, 0, 0, Voxel::BlockState{fx.stone});
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    Persistence::AutosaveConfig config;
+    config.settleSeconds = 3600.0f;
+    config.maxDirtyAgeSeconds = 3600.0f;
+    saver.setConfig(config);
+
+    saver.update();
+    CHECK_EQ(saver.metrics().dirtyChunks, static_cast<size_t>(1));
+    CHECK_EQ(saver.metrics().dueChunks, static_cast<size_t>(0));
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(0));
+
+    saver.flush();
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(1));
+    CHECK(!fx.world.chunkManager().getChunk(Voxel::ChunkCoord{0, 0, 0})->isPersistDirty());
+    CHECK_EQ(fx.loadBlock(0, 0, 0), fx.stone);
+}
+
+TEST_CASE(WorldSaveService_EditDuringWriteKeepsChunkDirty) {
+    SaveFixture fx;
+    fx.world.setBlock(0, 0, 0, Voxel::BlockState{fx.stone});
+    Voxel::Chunk* chunk = fx.world.chunkManager().getChunk(Voxel::ChunkCoord{0, 0, 0});
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    saver.setConfig(immediateConfig());
+
+    // Without IO threads the region is written inside update(); the completion is
+    // only applied on the next update, so this edit lands after the snapshot.
+    saver.update();
+    fx.world.setBlock(4, 0, 0, Voxel::BlockState{fx.stone});
+    saver.update();
+    CHECK(chunk->isPersistDirty());
+    CHECK_EQ(fx.loadBlock(0, 0, 0), fx.stone);
+
+    saver.flush();
+    CHECK(!chunk->isPersistDirty());
+    CHECK_EQ(fx.loadBlock(4, 0, 0), fx.stone);
+}
+
+TEST_CASE(WorldSaveService_BoundsRegionsInFlight) {
+    SaveFixture fx;
+    auto format = fx.service.openFormat(fx.context);
+    const auto& layout = format->regionLayout();
+
+    const Voxel::ChunkCoord first{0, 0, 0};
+    Voxel::ChunkCoord second{1, 0, 0};
+    while (layout.regionForChunk("rigel:default", second).x ==
+           layout.regionForChunk("rigel:default", first).x) {
+        ++second.x;
+    }
+    fx.world.setBlock(0, 0, 0, Voxel::BlockState{fx.stone});
+    fx.world.setBlock(second.x * Voxel::Chunk::SIZE, 0, 0, Voxel::BlockState{fx.stone});
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    Persistence::AutosaveConfig config = immediateConfig();
+    config.maxInFlightRegions = 1;
+    saver.setConfig(config);
+
+    saver.update();
+    CHECK_EQ(saver.metrics().inFlightRegions, static_cast<size_t>(1));
+    CHECK_EQ(saver.metrics().dueChunks, static_cast<size_t>(1));
+
+    saver.update();
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(1));
+    saver.update();
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(2));
+    CHECK_EQ(saver.metrics().dirtyChunks, static_cast<size_t>(0));
+}
+
+TEST_CASE(WorldSaveService_DisabledDoesNothing) {
+    SaveFixture fx;
+    fx.world.setBlock(0, 0, 0, Voxel::BlockState{fx.stone});
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    Persistence::AutosaveConfig config = immediateConfig();
+    config.enabled = false;
+    saver.setConfig(config);
+    saver.update();
+
+    CHECK(fx.world.chunkManager().getChunk(Voxel::ChunkCoord{0, 0, 0})->isPersistDirty());
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(0));
+}
+
+namespace {
+
+std::vector<uint8_t> readAll(Persistence::StorageBackend& storage, const std::string& path) {
+    auto reader = storage.openRead(path);
+    std::vector<uint8_t> bytes(reader->size());
+    reader->readBytes(bytes.data(), bytes.size());
+    return bytes;
+}
+
+void writeAll(Persistence::StorageBackend& storage, const std::string& path, std::vector<uint8_t> bytes) {
+    auto session = storage.openWrite(path, Persistence::AtomicWriteOptions{});
+    session->writer().writeBytes(bytes.data(), bytes.size());
+    session->commit();
+}
+
+size_t countStagingFiles(const std::filesystem::path& root) {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        const std::string name = entry.path().filename().string();
+        if (name.find(".batchtmp") != std::string::npos || name.find(".journal") != std::string::npos) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE(StorageBatch_PublishesWritesOnlyOnCommit) {
+    SaveFixture fx;
+    Persistence::FilesystemBackend storage;
+    const std::string a = (fx.root / "regions" / "a.bin").string();
+    const std::string b = (fx.root / "b.bin").string();
+    writeAll(storage, a, {1});
+
+    auto batch = storage.beginBatch(fx.context.rootPath);
+    CHECK(batch != nullptr);
+    writeAll(*batch, a, {2, 2});
+    writeAll(*batch, b, {3});
+
+    CHECK(readAll(storage, a) == std::vector<uint8_t>{1});
+    CHECK(!storage.exists(b));
+    CHECK(readAll(*batch, a) == (std::vector<uint8_t>{2, 2}));
+    CHECK(batch->exists(b));
+
+    batch->commit();
+    CHECK(readAll(storage, a) == (std::vector<uint8_t>{2, 2}));
+    CHECK(readAll(storage, b) == std::vector<uint8_t>{3});
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+
+    auto aborted = storage.beginBatch(fx.context.rootPath);
+    writeAll(*aborted, a, {9});
+    aborted->remove(b);
+    aborted->abort();
+    CHECK(readAll(storage, a) == (std::vector<uint8_t>{2, 2}));
+    CHECK(storage.exists(b));
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+}
+
+TEST_CASE(StorageBatch_RecoveryRollsCommittedForwardAndDropsTheRest) {
+    SaveFixture fx;
+    Persistence::FilesystemBackend storage;
+    const std::string committed = (fx.root / "committed.bin").string();
+    const std::string uncommitted = (fx.root / "uncommitted.bin").string();
+    const std::string removed = (fx.root / "removed.bin").string();
+    writeAll(storage, uncommitted, {1});
+    writeAll(storage, removed, {1});
+
+    // A batch that reached its journal but crashed before renaming...
+    writeAll(storage, committed + ".1-0.batchtmp", {5});
+    {
+        std::ofstream journal(fx.root / ".batch-1-0.journal", std::ios::binary);
+        journal << "W\n" << committed << ".1-0.batchtmp\n" << committed << "\n"
+                << "R\n" << removed << "\n"
+                << "COMMIT 2\n";
+    }
+    // ...and one that crashed before its commit record.
+    writeAll(storage, uncommitted + ".2-0.batchtmp", {6});
+    {
+        std::ofstream journal(fx.root / ".batch-2-0.journal.tmp", std::ios::binary);
+        journal << "W\n" << uncommitted << ".2-0.batchtmp\n" << uncommitted << "\n";
+    }
+
+    storage.recoverBatches(fx.context.rootPath);
+
+    CHECK(readAll(storage, committed) == std::vector<uint8_t>{5});
+    CHECK(!storage.exists(removed));
+    CHECK(readAll(storage, uncommitted) == std::vector<uint8_t>{1});
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+}
+
+TEST_CASE(StorageBatch_FailureAfterCommitPointIsRolledForwardByRecovery) {
+    SaveFixture fx;
+    Persistence::FilesystemBackend storage;
+    const std::string blocked = (fx.root / "blocked.bin").string();
+    const std::string other = (fx.root / "other.bin").string();
+
+    auto batch = storage.beginBatch(fx.context.rootPath);
+    writeAll(*batch, blocked, {7});
+    writeAll(*batch, other, {8});
+
+    // A non-empty directory in the way makes applying the journal fail after it was
+    // published; the batch still counts as committed.
+    std::filesystem::create_directories(fx.root / "blocked.bin" / "inner");
+    batch->commit();
+    CHECK(countStagingFiles(fx.root) >= static_cast<size_t>(2));
+
+    std::filesystem::remove_all(fx.root / "blocked.bin");
+    storage.recoverBatches(fx.context.rootPath);
+    CHECK(readAll(storage, blocked) == std::vector<uint8_t>{7});
+    CHECK(readAll(storage, other) == std::vector<uint8_t>{8});
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+}
+
+TEST_CASE(StorageBatch_NewerBatchWaitsForCommittedJournal) {
+    SaveFixture fx;
+    Persistence::FilesystemBackend storage;
+    const std::string blocked = (fx.root / "blocked.bin").string();
+    const std::string other = (fx.root / "other.bin").string();
+
+    auto first = storage.beginBatch(fx.context.rootPath);
+    writeAll(*first, blocked, {1});
+    writeAll(*first, other, {2});
+    std::filesystem::create_directories(fx.root / "blocked.bin" / "inner");
+    first->commit();
+
+    // Nothing newer may be written while the committed journal cannot be applied.
+    CHECK_THROWS(storage.beginBatch(fx.context.rootPath));
+    CHECK_THROWS(storage.openWrite(other, Persistence::AtomicWriteOptions{}));
+
+    std::filesystem::remove_all(fx.root / "blocked.bin");
+    auto second = storage.beginBatch(fx.context.rootPath);
+    CHECK(readAll(storage, blocked) == std::vector<uint8_t>{1});
+    CHECK(readAll(storage, other) == std::vector<uint8_t>{2});
+    writeAll(*second, blocked, {3});
+    second->commit();
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+
+    // A restart's recovery must not replay the older batch over the newer one.
+    storage.recoverBatches(fx.context.rootPath);
+    CHECK(readAll(storage, blocked) == std::vector<uint8_t>{3});
+    CHECK(readAll(storage, other) == std::vector<uint8_t>{2});
+}
+
+TEST_CASE(WorldSaveService_BatchesRegionsQueuedTogether) {
+    SaveFixture fx;
+    auto format = fx.service.openFormat(fx.context);
+    const auto& layout = format->regionLayout();
+
+    const Voxel::ChunkCoord first{0, 0, 0};
+    Voxel::ChunkCoord second{1, 0, 0};
+    while (layout.regionForChunk("rigel:default", second).x ==
+           layout.regionForChunk("rigel:default", first).x) {
+        ++second.x;
+    }
+    const int secondX = second.x * Voxel::Chunk::SIZE;
+    fx.world.setBlock(0, 0, 0, Voxel::BlockState{fx.stone});
+    fx.world.setBlock(secondX, 0, 0, Voxel::BlockState{fx.stone});
+
+    Persistence::WorldSaveService saver(fx.service, fx.context, fx.world, 0);
+    saver.setConfig(immediateConfig());
+    std::vector<Persistence::RegionKey> saved;
+    saver.setRegionSavedCallback([&](const Persistence::RegionKey& key) { saved.push_back(key); });
+
+    saver.update();
+    saver.update();
+
+    CHECK_EQ(saver.metrics().regionsWritten, static_cast<uint64_t>(2));
+    CHECK_EQ(saved.size(), static_cast<size_t>(2));
+    CHECK_EQ(saver.metrics().dirtyChunks, static_cast<size_t>(0));
+    CHECK_EQ(countStagingFiles(fx.root), static_cast<size_t>(0));
+    CHECK_EQ(fx.loadBlock(0, 0, 0), fx.stone);
+    CHECK_EQ(fx.loadBlock(secondX, 0, 0), fx.stone);
+}